@@ -34,6 +34,9 @@ namespace adbcpq {
 
 /// \brief Set an error based on a PGresult, inferring the proper ADBC status
 ///   code from the PGresult.
+///
+/// Defined by each driver (error.cc), since the diagnostic fields available
+/// depend on the libpq the driver is built against.
 AdbcStatusCode SetError(struct AdbcError* error, PGresult* result, const char* format,
                         ...) ADBC_CHECK_PRINTF_ATTRIBUTE(3, 4);
 
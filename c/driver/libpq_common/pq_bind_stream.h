@@ -0,0 +1,589 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Binding an ArrowArrayStream as statement parameters, shared by the
+// PostgreSQL and Netezza drivers. The backend-specific pieces are supplied
+// by a Dialect policy class:
+//
+//   struct Dialect {
+//     // The COPY dialect (see pq_copy_reader.h), used for epochs and COPY
+//     using CopyDialect = ...;
+//     // The type resolver and type ID enum (e.g., PostgresTypeResolver)
+//     using TypeResolver = ...;
+//     using TypeId = ...;
+//     // The status PQprepare reports on success
+//     static constexpr ExecStatusType kPrepareStatus = ...;
+//     // Execute the unnamed prepared statement with binary parameters
+//     static PGresult* ExecPrepared(PGconn* conn, int n_params,
+//                                   const char* const* values, const int* lengths,
+//                                   const int* formats);
+//     // Send COPY data and terminate the COPY (PQputCopyData/PQputCopyEnd)
+//     static int PutCopyData(PGconn* conn, const char* data, int size);
+//     static int PutCopyEnd(PGconn* conn);
+//   };
+
+#pragma once
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <adbc.h>
+#include <libpq-fe.h>
+#include <nanoarrow/nanoarrow.hpp>
+
+#include "common/utils.h"
+#include "libpq_common/error.h"
+#include "libpq_common/pq_copy_reader.h"
+#include "libpq_common/pq_util.h"
+
+namespace adbcpq {
+
+/// The flag indicating to PostgreSQL that we want binary-format values.
+constexpr int kPgBinaryFormat = 1;
+
+/// Helper to manage bind parameters with a prepared statement
+template <typename Dialect>
+struct PqBindStream {
+  static constexpr int32_t kDateEpoch = Dialect::CopyDialect::kDateEpoch;
+  static constexpr int64_t kTimestampEpoch = Dialect::CopyDialect::kTimestampEpoch;
+
+  Handle<struct ArrowArrayStream> bind;
+  Handle<struct ArrowSchema> bind_schema;
+  struct ArrowSchemaView bind_schema_view;
+  std::vector<struct ArrowSchemaView> bind_schema_fields;
+
+  // OIDs for parameter types
+  std::vector<uint32_t> param_types;
+  std::vector<char*> param_values;
+  std::vector<int> param_lengths;
+  std::vector<int> param_formats;
+  std::vector<size_t> param_values_offsets;
+  std::vector<char> param_values_buffer;
+  // XXX: this assumes fixed-length fields only - will need more
+  // consideration to deal with variable-length fields
+
+  bool has_tz_field = false;
+  std::string tz_setting;
+
+  struct ArrowError na_error;
+
+  explicit PqBindStream(struct ArrowArrayStream&& bind) {
+    this->bind.value = std::move(bind);
+    std::memset(&na_error, 0, sizeof(na_error));
+  }
+
+  template <typename Callback>
+  AdbcStatusCode Begin(Callback&& callback, struct AdbcError* error) {
+    CHECK_NA(INTERNAL, bind->get_schema(&bind.value, &bind_schema.value), error);
+    CHECK_NA(
+        INTERNAL,
+        ArrowSchemaViewInit(&bind_schema_view, &bind_schema.value, /*error*/ nullptr),
+        error);
+
+    if (bind_schema_view.type != ArrowType::NANOARROW_TYPE_STRUCT) {
+      SetError(error, "%s", "[libpq] Bind parameters must have type STRUCT");
+      return ADBC_STATUS_INVALID_STATE;
+    }
+
+    bind_schema_fields.resize(bind_schema->n_children);
+    for (size_t i = 0; i < bind_schema_fields.size(); i++) {
+      CHECK_NA(INTERNAL,
+               ArrowSchemaViewInit(&bind_schema_fields[i], bind_schema->children[i],
+                                   /*error*/ nullptr),
+               error);
+    }
+
+    return std::move(callback)();
+  }
+
+  AdbcStatusCode SetParamTypes(const typename Dialect::TypeResolver& type_resolver,
+                               struct AdbcError* error) {
+    param_types.resize(bind_schema->n_children);
+    param_values.resize(bind_schema->n_children);
+    param_lengths.resize(bind_schema->n_children);
+    param_formats.resize(bind_schema->n_children, kPgBinaryFormat);
+    param_values_offsets.reserve(bind_schema->n_children);
+
+    for (size_t i = 0; i < bind_schema_fields.size(); i++) {
+      typename Dialect::TypeId type_id;
+      switch (bind_schema_fields[i].type) {
+        case ArrowType::NANOARROW_TYPE_BOOL:
+          type_id = Dialect::TypeId::kBool;
+          param_lengths[i] = 1;
+          break;
+        case ArrowType::NANOARROW_TYPE_INT8:
+        case ArrowType::NANOARROW_TYPE_INT16:
+          type_id = Dialect::TypeId::kInt2;
+          param_lengths[i] = 2;
+          break;
+        case ArrowType::NANOARROW_TYPE_INT32:
+          type_id = Dialect::TypeId::kInt4;
+          param_lengths[i] = 4;
+          break;
+        case ArrowType::NANOARROW_TYPE_INT64:
+          type_id = Dialect::TypeId::kInt8;
+          param_lengths[i] = 8;
+          break;
+        case ArrowType::NANOARROW_TYPE_FLOAT:
+          type_id = Dialect::TypeId::kFloat4;
+          param_lengths[i] = 4;
+          break;
+        case ArrowType::NANOARROW_TYPE_DOUBLE:
+          type_id = Dialect::TypeId::kFloat8;
+          param_lengths[i] = 8;
+          break;
+        case ArrowType::NANOARROW_TYPE_STRING:
+        case ArrowType::NANOARROW_TYPE_LARGE_STRING:
+          type_id = Dialect::TypeId::kText;
+          param_lengths[i] = 0;
+          break;
+        case ArrowType::NANOARROW_TYPE_BINARY:
+          type_id = Dialect::TypeId::kBytea;
+          param_lengths[i] = 0;
+          break;
+        case ArrowType::NANOARROW_TYPE_DATE32:
+          type_id = Dialect::TypeId::kDate;
+          param_lengths[i] = 4;
+          break;
+        case ArrowType::NANOARROW_TYPE_TIMESTAMP:
+          type_id = Dialect::TypeId::kTimestamp;
+          param_lengths[i] = 8;
+          break;
+        case ArrowType::NANOARROW_TYPE_DURATION:
+        case ArrowType::NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO:
+          type_id = Dialect::TypeId::kInterval;
+          param_lengths[i] = 16;
+          break;
+        case ArrowType::NANOARROW_TYPE_DICTIONARY: {
+          struct ArrowSchemaView value_view;
+          CHECK_NA(INTERNAL,
+                   ArrowSchemaViewInit(&value_view, bind_schema->children[i]->dictionary,
+                                       nullptr),
+                   error);
+          switch (value_view.type) {
+            case NANOARROW_TYPE_BINARY:
+            case NANOARROW_TYPE_LARGE_BINARY:
+              type_id = Dialect::TypeId::kBytea;
+              param_lengths[i] = 0;
+              break;
+            case NANOARROW_TYPE_STRING:
+            case NANOARROW_TYPE_LARGE_STRING:
+              type_id = Dialect::TypeId::kText;
+              param_lengths[i] = 0;
+              break;
+            default:
+              SetError(error, "%s%" PRIu64 "%s%s%s%s", "[libpq] Field #",
+                       static_cast<uint64_t>(i + 1), " ('",
+                       bind_schema->children[i]->name,
+                       "') has unsupported dictionary value parameter type ",
+                       ArrowTypeString(value_view.type));
+              return ADBC_STATUS_NOT_IMPLEMENTED;
+          }
+          break;
+        }
+        default:
+          SetError(error, "%s%" PRIu64 "%s%s%s%s", "[libpq] Field #",
+                   static_cast<uint64_t>(i + 1), " ('", bind_schema->children[i]->name,
+                   "') has unsupported parameter type ",
+                   ArrowTypeString(bind_schema_fields[i].type));
+          return ADBC_STATUS_NOT_IMPLEMENTED;
+      }
+
+      param_types[i] = type_resolver.GetOID(type_id);
+      if (param_types[i] == 0) {
+        SetError(error, "%s%" PRIu64 "%s%s%s%s%s%s", "[libpq] Field #",
+                 static_cast<uint64_t>(i + 1), " ('", bind_schema->children[i]->name,
+                 "') has type with no corresponding ", Dialect::CopyDialect::kName,
+                 " type ", ArrowTypeString(bind_schema_fields[i].type));
+        return ADBC_STATUS_NOT_IMPLEMENTED;
+      }
+    }
+
+    size_t param_values_length = 0;
+    for (int length : param_lengths) {
+      param_values_offsets.push_back(param_values_length);
+      param_values_length += length;
+    }
+    param_values_buffer.resize(param_values_length);
+    return ADBC_STATUS_OK;
+  }
+
+  AdbcStatusCode Prepare(PGconn* conn, const std::string& query, struct AdbcError* error,
+                         const bool autocommit) {
+    // tz-aware timestamps require special handling to set the timezone to UTC
+    // prior to sending over the binary protocol; must be reset after execute
+    for (int64_t col = 0; col < bind_schema->n_children; col++) {
+      if ((bind_schema_fields[col].type == ArrowType::NANOARROW_TYPE_TIMESTAMP) &&
+          (strcmp("", bind_schema_fields[col].timezone))) {
+        has_tz_field = true;
+
+        if (autocommit) {
+          PGresult* begin_result = PQexec(conn, "BEGIN");
+          if (PQresultStatus(begin_result) != PGRES_COMMAND_OK) {
+            AdbcStatusCode code =
+                SetError(error, begin_result,
+                         "[libpq] Failed to begin transaction for timezone data: %s",
+                         PQerrorMessage(conn));
+            PQclear(begin_result);
+            return code;
+          }
+          PQclear(begin_result);
+        }
+
+        PGresult* get_tz_result = PQexec(conn, "SELECT current_setting('TIMEZONE')");
+        if (PQresultStatus(get_tz_result) != PGRES_TUPLES_OK) {
+          AdbcStatusCode code = SetError(error, get_tz_result,
+                                         "[libpq] Could not query current timezone: %s",
+                                         PQerrorMessage(conn));
+          PQclear(get_tz_result);
+          return code;
+        }
+
+        tz_setting = std::string(PQgetvalue(get_tz_result, 0, 0));
+        PQclear(get_tz_result);
+
+        PGresult* set_utc_result = PQexec(conn, "SET TIME ZONE 'UTC'");
+        if (PQresultStatus(set_utc_result) != PGRES_COMMAND_OK) {
+          AdbcStatusCode code = SetError(error, set_utc_result,
+                                         "[libpq] Failed to set time zone to UTC: %s",
+                                         PQerrorMessage(conn));
+          PQclear(set_utc_result);
+          return code;
+        }
+        PQclear(set_utc_result);
+        break;
+      }
+    }
+
+    PGresult* result = PQprepare(conn, /*stmtName=*/"", query.c_str(),
+                                 /*nParams=*/bind_schema->n_children, param_types.data());
+    if (PQresultStatus(result) != Dialect::kPrepareStatus) {
+      AdbcStatusCode code =
+          SetError(error, result, "[libpq] Failed to prepare query: %s\nQuery was:%s",
+                   PQerrorMessage(conn), query.c_str());
+      PQclear(result);
+      return code;
+    }
+    PQclear(result);
+    return ADBC_STATUS_OK;
+  }
+
+  AdbcStatusCode Execute(PGconn* conn, int64_t* rows_affected, struct AdbcError* error) {
+    if (rows_affected) *rows_affected = 0;
+    PGresult* result = nullptr;
+
+    while (true) {
+      Handle<struct ArrowArray> array;
+      int res = bind->get_next(&bind.value, &array.value);
+      if (res != 0) {
+        SetError(error,
+                 "[libpq] Failed to read next batch from stream of bind parameters: "
+                 "(%d) %s %s",
+                 res, std::strerror(res), bind->get_last_error(&bind.value));
+        return ADBC_STATUS_IO;
+      }
+      if (!array->release) break;
+
+      Handle<struct ArrowArrayView> array_view;
+      // TODO: include error messages
+      CHECK_NA(
+          INTERNAL,
+          ArrowArrayViewInitFromSchema(&array_view.value, &bind_schema.value, nullptr),
+          error);
+      CHECK_NA(INTERNAL, ArrowArrayViewSetArray(&array_view.value, &array.value, nullptr),
+               error);
+
+      for (int64_t row = 0; row < array->length; row++) {
+        for (int64_t col = 0; col < array_view->n_children; col++) {
+          if (ArrowArrayViewIsNull(array_view->children[col], row)) {
+            param_values[col] = nullptr;
+            continue;
+          } else {
+            param_values[col] = param_values_buffer.data() + param_values_offsets[col];
+          }
+          switch (bind_schema_fields[col].type) {
+            case ArrowType::NANOARROW_TYPE_BOOL: {
+              const int8_t val = ArrowBitGet(
+                  array_view->children[col]->buffer_views[1].data.as_uint8, row);
+              std::memcpy(param_values[col], &val, sizeof(int8_t));
+              break;
+            }
+
+            case ArrowType::NANOARROW_TYPE_INT8: {
+              const int16_t val =
+                  array_view->children[col]->buffer_views[1].data.as_int8[row];
+              const uint16_t value = ToNetworkInt16(val);
+              std::memcpy(param_values[col], &value, sizeof(int16_t));
+              break;
+            }
+            case ArrowType::NANOARROW_TYPE_INT16: {
+              const uint16_t value = ToNetworkInt16(
+                  array_view->children[col]->buffer_views[1].data.as_int16[row]);
+              std::memcpy(param_values[col], &value, sizeof(int16_t));
+              break;
+            }
+            case ArrowType::NANOARROW_TYPE_INT32: {
+              const uint32_t value = ToNetworkInt32(
+                  array_view->children[col]->buffer_views[1].data.as_int32[row]);
+              std::memcpy(param_values[col], &value, sizeof(int32_t));
+              break;
+            }
+            case ArrowType::NANOARROW_TYPE_INT64: {
+              const int64_t value = ToNetworkInt64(
+                  array_view->children[col]->buffer_views[1].data.as_int64[row]);
+              std::memcpy(param_values[col], &value, sizeof(int64_t));
+              break;
+            }
+            case ArrowType::NANOARROW_TYPE_FLOAT: {
+              const uint32_t value = ToNetworkFloat4(
+                  array_view->children[col]->buffer_views[1].data.as_float[row]);
+              std::memcpy(param_values[col], &value, sizeof(uint32_t));
+              break;
+            }
+            case ArrowType::NANOARROW_TYPE_DOUBLE: {
+              const uint64_t value = ToNetworkFloat8(
+                  array_view->children[col]->buffer_views[1].data.as_double[row]);
+              std::memcpy(param_values[col], &value, sizeof(uint64_t));
+              break;
+            }
+            case ArrowType::NANOARROW_TYPE_STRING:
+            case ArrowType::NANOARROW_TYPE_LARGE_STRING:
+            case ArrowType::NANOARROW_TYPE_BINARY: {
+              const ArrowBufferView view =
+                  ArrowArrayViewGetBytesUnsafe(array_view->children[col], row);
+              // TODO: overflow check?
+              param_lengths[col] = static_cast<int>(view.size_bytes);
+              param_values[col] = const_cast<char*>(view.data.as_char);
+              break;
+            }
+            case ArrowType::NANOARROW_TYPE_DATE32: {
+              const int32_t raw_value =
+                  array_view->children[col]->buffer_views[1].data.as_int32[row];
+              if (raw_value < INT32_MIN + kDateEpoch) {
+                SetError(error, "[libpq] Field #%" PRId64 "%s%s%s%" PRId64 "%s%s%s",
+                         col + 1, "('", bind_schema->children[col]->name, "') Row #",
+                         row + 1, "has value which exceeds ", Dialect::CopyDialect::kName,
+                         " date limits");
+                return ADBC_STATUS_INVALID_ARGUMENT;
+              }
+
+              const uint32_t value = ToNetworkInt32(raw_value - kDateEpoch);
+              std::memcpy(param_values[col], &value, sizeof(int32_t));
+              break;
+            }
+            case ArrowType::NANOARROW_TYPE_DURATION:
+            case ArrowType::NANOARROW_TYPE_TIMESTAMP: {
+              int64_t val = array_view->children[col]->buffer_views[1].data.as_int64[row];
+
+              bool overflow_safe = true;
+
+              auto unit = bind_schema_fields[col].time_unit;
+
+              switch (unit) {
+                case NANOARROW_TIME_UNIT_SECOND:
+                  if ((overflow_safe = val <= kMaxSafeSecondsToMicros &&
+                                       val >= kMinSafeSecondsToMicros)) {
+                    val *= 1000000;
+                  }
+
+                  break;
+                case NANOARROW_TIME_UNIT_MILLI:
+                  if ((overflow_safe = val <= kMaxSafeMillisToMicros &&
+                                       val >= kMinSafeMillisToMicros)) {
+                    val *= 1000;
+                  }
+                  break;
+                case NANOARROW_TIME_UNIT_MICRO:
+                  break;
+                case NANOARROW_TIME_UNIT_NANO:
+                  val /= 1000;
+                  break;
+              }
+
+              if (!overflow_safe) {
+                SetError(error,
+                         "[libpq] Field #%" PRId64 " ('%s') Row #%" PRId64
+                         " has value '%" PRIi64 "' which exceeds %s timestamp limits",
+                         col + 1, bind_schema->children[col]->name, row + 1,
+                         array_view->children[col]->buffer_views[1].data.as_int64[row],
+                         Dialect::CopyDialect::kName);
+                return ADBC_STATUS_INVALID_ARGUMENT;
+              }
+
+              if (val < std::numeric_limits<int64_t>::min() + kTimestampEpoch) {
+                SetError(error,
+                         "[libpq] Field #%" PRId64 " ('%s') Row #%" PRId64
+                         " has value '%" PRIi64 "' which would underflow",
+                         col + 1, bind_schema->children[col]->name, row + 1,
+                         array_view->children[col]->buffer_views[1].data.as_int64[row]);
+                return ADBC_STATUS_INVALID_ARGUMENT;
+              }
+
+              if (bind_schema_fields[col].type == ArrowType::NANOARROW_TYPE_TIMESTAMP) {
+                const uint64_t value = ToNetworkInt64(val - kTimestampEpoch);
+                std::memcpy(param_values[col], &value, sizeof(int64_t));
+              } else if (bind_schema_fields[col].type ==
+                         ArrowType::NANOARROW_TYPE_DURATION) {
+                // the backend stores an interval as a 64 bit offset in microsecond
+                // resolution alongside a 32 bit day and 32 bit month
+                // for now we just send 0 for the day / month values
+                const uint64_t value = ToNetworkInt64(val);
+                std::memcpy(param_values[col], &value, sizeof(int64_t));
+                std::memset(param_values[col] + sizeof(int64_t), 0, sizeof(int64_t));
+              }
+              break;
+            }
+            case ArrowType::NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO: {
+              struct ArrowInterval interval;
+              ArrowIntervalInit(&interval, NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO);
+              ArrowArrayViewGetIntervalUnsafe(array_view->children[col], row, &interval);
+
+              const uint32_t months = ToNetworkInt32(interval.months);
+              const uint32_t days = ToNetworkInt32(interval.days);
+              const uint64_t ms = ToNetworkInt64(interval.ns / 1000);
+
+              std::memcpy(param_values[col], &ms, sizeof(uint64_t));
+              std::memcpy(param_values[col] + sizeof(uint64_t), &days, sizeof(uint32_t));
+              std::memcpy(param_values[col] + sizeof(uint64_t) + sizeof(uint32_t),
+                          &months, sizeof(uint32_t));
+              break;
+            }
+            default:
+              SetError(error, "%s%" PRId64 "%s%s%s%s", "[libpq] Field #", col + 1, " ('",
+                       bind_schema->children[col]->name,
+                       "') has unsupported type for ingestion ",
+                       ArrowTypeString(bind_schema_fields[col].type));
+              return ADBC_STATUS_NOT_IMPLEMENTED;
+          }
+        }
+
+        result = Dialect::ExecPrepared(conn, /*nParams=*/bind_schema->n_children,
+                                       param_values.data(), param_lengths.data(),
+                                       param_formats.data());
+
+        ExecStatusType pg_status = PQresultStatus(result);
+        if (pg_status != PGRES_COMMAND_OK) {
+          AdbcStatusCode code = SetError(
+              error, result, "[libpq] Failed to execute prepared statement: %s %s",
+              PQresStatus(pg_status), PQerrorMessage(conn));
+          PQclear(result);
+          return code;
+        }
+
+        PQclear(result);
+      }
+      if (rows_affected) *rows_affected += array->length;
+
+      if (has_tz_field) {
+        std::string reset_query = "SET TIME ZONE '" + tz_setting + "'";
+        PGresult* reset_tz_result = PQexec(conn, reset_query.c_str());
+        if (PQresultStatus(reset_tz_result) != PGRES_COMMAND_OK) {
+          AdbcStatusCode code =
+              SetError(error, reset_tz_result, "[libpq] Failed to reset time zone: %s",
+                       PQerrorMessage(conn));
+          PQclear(reset_tz_result);
+          return code;
+        }
+        PQclear(reset_tz_result);
+
+        PGresult* commit_result = PQexec(conn, "COMMIT");
+        if (PQresultStatus(commit_result) != PGRES_COMMAND_OK) {
+          AdbcStatusCode code =
+              SetError(error, commit_result, "[libpq] Failed to commit transaction: %s",
+                       PQerrorMessage(conn));
+          PQclear(commit_result);
+          return code;
+        }
+        PQclear(commit_result);
+      }
+    }
+    return ADBC_STATUS_OK;
+  }
+
+  AdbcStatusCode ExecuteCopy(PGconn* conn, int64_t* rows_affected,
+                             struct AdbcError* error) {
+    if (rows_affected) *rows_affected = 0;
+
+    PqCopyStreamWriter<typename Dialect::CopyDialect> writer;
+    CHECK_NA(INTERNAL, writer.Init(&bind_schema.value), error);
+    CHECK_NA(INTERNAL, writer.InitFieldWriters(nullptr), error);
+
+    CHECK_NA(INTERNAL, writer.WriteHeader(nullptr), error);
+
+    while (true) {
+      Handle<struct ArrowArray> array;
+      int res = bind->get_next(&bind.value, &array.value);
+      if (res != 0) {
+        SetError(error,
+                 "[libpq] Failed to read next batch from stream of bind parameters: "
+                 "(%d) %s %s",
+                 res, std::strerror(res), bind->get_last_error(&bind.value));
+        return ADBC_STATUS_IO;
+      }
+      if (!array->release) break;
+
+      CHECK_NA(INTERNAL, writer.SetArray(&array.value), error);
+
+      // build writer buffer
+      int write_result;
+      do {
+        write_result = writer.WriteRecord(nullptr);
+      } while (write_result == NANOARROW_OK);
+
+      // check if not ENODATA at exit
+      if (write_result != ENODATA) {
+        SetError(error, "Error occurred writing COPY data: %s", PQerrorMessage(conn));
+        return ADBC_STATUS_IO;
+      }
+
+      ArrowBuffer buffer = writer.WriteBuffer();
+      if (Dialect::PutCopyData(conn, reinterpret_cast<char*>(buffer.data),
+                               static_cast<int>(buffer.size_bytes)) <= 0) {
+        SetError(error, "Error writing tuple field data: %s", PQerrorMessage(conn));
+        return ADBC_STATUS_IO;
+      }
+
+      if (rows_affected) *rows_affected += array->length;
+      writer.Rewind();
+    }
+
+    if (Dialect::PutCopyEnd(conn) <= 0) {
+      SetError(error, "Error message returned by PQputCopyEnd: %s", PQerrorMessage(conn));
+      return ADBC_STATUS_IO;
+    }
+
+    PGresult* result = PQgetResult(conn);
+    ExecStatusType pg_status = PQresultStatus(result);
+    if (pg_status != PGRES_COMMAND_OK) {
+      AdbcStatusCode code =
+          SetError(error, result, "[libpq] Failed to execute COPY statement: %s %s",
+                   PQresStatus(pg_status), PQerrorMessage(conn));
+      PQclear(result);
+      return code;
+    }
+
+    PQclear(result);
+    return ADBC_STATUS_OK;
+  }
+};
+
+}  // namespace adbcpq
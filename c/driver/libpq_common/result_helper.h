@@ -71,6 +71,10 @@ class PqResultRow {
 // will be evaluated as part of the constructor, with the desctructor handling cleanup
 // Caller must call Prepare then Execute, checking both for an OK AdbcStatusCode
 // prior to iterating
+//
+// Prepare() and Execute() are defined by each driver (result_helper.cc), since
+// the backends differ in which status a successful prepare reports and in
+// whether unnamed prepared statements can be executed.
 class PqResultHelper {
  public:
   explicit PqResultHelper(PGconn* conn, std::string query, struct AdbcError* error)
@@ -92,6 +96,8 @@ class PqResultHelper {
 
   int NumColumns() const { return PQnfields(result_); }
 
+  PqResultRow Row(int row_num) const { return PqResultRow(result_, row_num); }
+
   class iterator {
     const PqResultHelper& outer_;
     int curr_row_ = 0;
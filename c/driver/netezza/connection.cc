@@ -22,7 +22,6 @@
 #include <cmath>
 #include <cstring>
 #include <memory>
-#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -33,8 +32,8 @@
 
 #include "common/utils.h"
 #include "database.h"
-#include "error.h"
-#include "result_helper.h"
+#include "libpq_common/error.h"
+#include "libpq_common/result_helper.h"
 
 namespace adbcpq {
 namespace {
@@ -45,10 +44,25 @@ static const uint32_t kSupportedInfoCodes[] = {
     ADBC_INFO_DRIVER_ARROW_VERSION, ADBC_INFO_DRIVER_ADBC_VERSION,
 };
 
-static const std::unordered_map<std::string, std::string> kPgTableTypes = {
-    {"table", "r"},       {"view", "v"},          {"materialized_view", "m"},
-    {"toast_table", "t"}, {"foreign_table", "f"}, {"partitioned_table", "p"}};
+/// Table types reported by GetTableTypes, with the system view listing each
+/// and the view's column holding the object name
+struct NzTableType {
+  std::string table_type;
+  std::string view;
+  std::string name_column;
+};
+
+static const std::vector<NzTableType> kNzTableTypes = {
+    {"table", "_V_TABLE", "TABLENAME"},
+    {"view", "_V_VIEW", "VIEWNAME"},
+};
 
+/// \brief Build the GetObjects result from the _V_ system views.
+///
+/// Rather than issuing a query per schema and per table, each level of the
+/// hierarchy is fetched for the whole database with a single query ordered by
+/// its parent, and the rows are then indexed by parent so that the nested
+/// lists can be assembled in one pass.
 class NzGetObjectsHelper {
  public:
   NzGetObjectsHelper(PGconn* conn, int depth, const char* catalog, const char* db_schema,
@@ -107,90 +121,63 @@ class NzGetObjectsHelper {
   }
 
  private:
-  AdbcStatusCode InitArrowArray() {
-    RAISE_ADBC(AdbcInitConnectionObjectsSchema(schema_, error_));
+  /// Half-open range of rows in a result set that share the same parent
+  using RowRange = std::pair<int, int>;
+  using RowIndex = std::unordered_map<std::string, RowRange>;
 
-    CHECK_NA_DETAIL(INTERNAL, ArrowArrayInitFromSchema(array_, schema_, &na_error_),
-                    &na_error_, error_);
-
-    CHECK_NA(INTERNAL, ArrowArrayStartAppending(array_), error_);
-    return ADBC_STATUS_OK;
+  static std::string IndexKey(const PqRecord& schema_name) {
+    return std::string(schema_name.data, schema_name.len);
   }
 
-  AdbcStatusCode AppendSchemas(std::string db_name) {
-    // postgres only allows you to list schemas for the currently connected db
-    if (!strcmp(db_name.c_str(), PQdb(conn_))) {
-      struct StringBuilder query;
-      std::memset(&query, 0, sizeof(query));
-      if (StringBuilderInit(&query, /*initial_size*/ 256)) {
-        return ADBC_STATUS_INTERNAL;
-      }
-
-      const char* stmt =
-          "SELECT nspname FROM pg_catalog.pg_namespace WHERE "
-          "nspname !~ '^pg_' AND nspname <> 'information_schema'";
-
-      if (StringBuilderAppend(&query, "%s", stmt)) {
-        StringBuilderReset(&query);
-        return ADBC_STATUS_INTERNAL;
-      }
+  static std::string IndexKey(const PqRecord& schema_name, const PqRecord& table_name) {
+    std::string key(schema_name.data, schema_name.len);
+    key.push_back('\0');
+    key.append(table_name.data, table_name.len);
+    return key;
+  }
 
-      std::vector<std::string> params;
-      if (db_schema_ != NULL) {
-        if (StringBuilderAppend(&query, "%s", " AND nspname = $1")) {
-          StringBuilderReset(&query);
-          return ADBC_STATUS_INTERNAL;
-        }
-        params.push_back(db_schema_);
+  /// Index a result set ordered by its parent key(s) in the leading column(s)
+  static RowIndex IndexRows(PqResultHelper& result, int key_columns) {
+    RowIndex index;
+    std::string prev_key;
+    for (int i = 0; i < result.NumRows(); i++) {
+      PqResultRow row = result.Row(i);
+      std::string key = key_columns == 1 ? IndexKey(row[0]) : IndexKey(row[0], row[1]);
+      if (i == 0 || key != prev_key) {
+        index[key] = RowRange(i, i + 1);
+        prev_key = std::move(key);
+      } else {
+        index[prev_key].second = i + 1;
       }
+    }
+    return index;
+  }
 
-      auto result_helper =
-          PqResultHelper{conn_, std::string(query.buffer), params, error_};
-      StringBuilderReset(&query);
+  static RowRange FindRows(const RowIndex& index, const std::string& key) {
+    auto it = index.find(key);
+    if (it == index.end()) return RowRange(0, 0);
+    return it->second;
+  }
 
-      RAISE_ADBC(result_helper.Prepare());
-      RAISE_ADBC(result_helper.Execute());
+  AdbcStatusCode InitArrowArray() {
+    RAISE_ADBC(AdbcInitConnectionObjectsSchema(schema_, error_));
 
-      for (PqResultRow row : result_helper) {
-        const char* schema_name = row[0].data;
-        CHECK_NA(INTERNAL,
-                 ArrowArrayAppendString(db_schema_name_col_, ArrowCharView(schema_name)),
-                 error_);
-        if (depth_ == ADBC_OBJECT_DEPTH_DB_SCHEMAS) {
-          CHECK_NA(INTERNAL, ArrowArrayAppendNull(db_schema_tables_col_, 1), error_);
-        } else {
-          RAISE_ADBC(AppendTables(std::string(schema_name)));
-        }
-        CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_items_), error_);
-      }
-    }
+    CHECK_NA_DETAIL(INTERNAL, ArrowArrayInitFromSchema(array_, schema_, &na_error_),
+                    &na_error_, error_);
 
-    CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_col_), error_);
+    CHECK_NA(INTERNAL, ArrowArrayStartAppending(array_), error_);
     return ADBC_STATUS_OK;
   }
 
   AdbcStatusCode AppendCatalogs() {
-    struct StringBuilder query;
-    std::memset(&query, 0, sizeof(query));
-    if (StringBuilderInit(&query, /*initial_size=*/256) != 0) return ADBC_STATUS_INTERNAL;
-
-    if (StringBuilderAppend(&query, "%s", "SELECT datname FROM pg_catalog.pg_database")) {
-      return ADBC_STATUS_INTERNAL;
-    }
-
+    std::string query = "SELECT DATABASE FROM _V_DATABASE";
     std::vector<std::string> params;
     if (catalog_ != NULL) {
-      if (StringBuilderAppend(&query, "%s", " WHERE datname = $1")) {
-        StringBuilderReset(&query);
-        return ADBC_STATUS_INTERNAL;
-      }
+      query += " WHERE DATABASE = $1";
       params.push_back(catalog_);
     }
 
-    PqResultHelper result_helper =
-        PqResultHelper{conn_, std::string(query.buffer), params, error_};
-    StringBuilderReset(&query);
-
+    PqResultHelper result_helper = PqResultHelper{conn_, query, params, error_};
     RAISE_ADBC(result_helper.Prepare());
     RAISE_ADBC(result_helper.Execute());
 
@@ -200,8 +187,11 @@ class NzGetObjectsHelper {
                ArrowArrayAppendString(catalog_name_col_, ArrowCharView(db_name)), error_);
       if (depth_ == ADBC_OBJECT_DEPTH_CATALOGS) {
         CHECK_NA(INTERNAL, ArrowArrayAppendNull(catalog_db_schemas_col_, 1), error_);
+      } else if (std::strcmp(db_name, PQdb(conn_)) == 0) {
+        // The _V_ views only describe the currently connected database
+        RAISE_ADBC(AppendSchemas());
       } else {
-        RAISE_ADBC(AppendSchemas(std::string(db_name)));
+        CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_col_), error_);
       }
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(array_), error_);
     }
@@ -209,98 +199,144 @@ class NzGetObjectsHelper {
     return ADBC_STATUS_OK;
   }
 
-  AdbcStatusCode AppendTables(std::string schema_name) {
-    struct StringBuilder query;
-    std::memset(&query, 0, sizeof(query));
-    if (StringBuilderInit(&query, /*initial_size*/ 512)) {
-      return ADBC_STATUS_INTERNAL;
+  AdbcStatusCode AppendSchemas() {
+    std::string query = "SELECT SCHEMA FROM _V_SCHEMA";
+    std::vector<std::string> params;
+    if (db_schema_ != NULL) {
+      query += " WHERE SCHEMA = $1";
+      params.push_back(db_schema_);
     }
 
-    std::vector<std::string> params = {schema_name};
-    const char* stmt =
-        "SELECT c.relname, CASE c.relkind WHEN 'r' THEN 'table' WHEN 'v' THEN 'view' "
-        "WHEN 'm' THEN 'materialized view' WHEN 't' THEN 'TOAST table' "
-        "WHEN 'f' THEN 'foreign table' WHEN 'p' THEN 'partitioned table' END "
-        "AS reltype FROM pg_catalog.pg_class c "
-        "LEFT JOIN pg_catalog.pg_namespace n ON n.oid = c.relnamespace "
-        "WHERE c.relkind IN ('r','v','m','t','f','p') "
-        "AND pg_catalog.pg_table_is_visible(c.oid) AND n.nspname = $1";
-
-    if (StringBuilderAppend(&query, "%s", stmt)) {
-      StringBuilderReset(&query);
-      return ADBC_STATUS_INTERNAL;
+    PqResultHelper schemas{conn_, query, params, error_};
+    RAISE_ADBC(schemas.Prepare());
+    RAISE_ADBC(schemas.Execute());
+
+    if (depth_ != ADBC_OBJECT_DEPTH_DB_SCHEMAS) {
+      RAISE_ADBC(LoadTables());
     }
 
-    if (table_name_ != nullptr) {
-      if (StringBuilderAppend(&query, "%s", " AND c.relname LIKE $2")) {
-        StringBuilderReset(&query);
-        return ADBC_STATUS_INTERNAL;
+    for (PqResultRow row : schemas) {
+      CHECK_NA(INTERNAL,
+               ArrowArrayAppendString(db_schema_name_col_,
+                                      ArrowStringView{row[0].data, row[0].len}),
+               error_);
+      if (depth_ == ADBC_OBJECT_DEPTH_DB_SCHEMAS) {
+        CHECK_NA(INTERNAL, ArrowArrayAppendNull(db_schema_tables_col_, 1), error_);
+      } else {
+        RAISE_ADBC(AppendTables(FindRows(tables_index_, IndexKey(row[0]))));
       }
-
-      params.push_back(std::string(table_name_));
+      CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_items_), error_);
     }
 
-    if (table_types_ != nullptr) {
-      std::vector<std::string> table_type_filter;
-      const char** table_types = table_types_;
-      while (*table_types != NULL) {
-        auto table_type_str = std::string(*table_types);
-        auto search = kPgTableTypes.find(table_type_str);
-        if (search != kPgTableTypes.end()) {
-          table_type_filter.push_back(search->second);
-        }
-        table_types++;
-      }
+    CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_col_), error_);
+    return ADBC_STATUS_OK;
+  }
 
-      if (!table_type_filter.empty()) {
-        std::ostringstream oss;
-        bool first = true;
-        oss << "(";
-        for (const auto& str : table_type_filter) {
-          if (!first) {
-            oss << ", ";
-          }
-          oss << "'" << str << "'";
-          first = false;
-        }
-        oss << ")";
+  /// Append the filters shared by all queries over schema objects, numbering
+  /// parameters after those already in params
+  void AppendObjectFilters(const char* schema_col, const char* name_col,
+                           std::string* query, std::vector<std::string>* params) {
+    if (db_schema_ != NULL) {
+      params->push_back(db_schema_);
+      *query += std::string(" AND ") + schema_col + " = $" +
+                std::to_string(params->size());
+    }
+    if (table_name_ != NULL) {
+      params->push_back(table_name_);
+      *query += std::string(" AND ") + name_col + " LIKE $" +
+                std::to_string(params->size());
+    }
+  }
 
-        if (StringBuilderAppend(&query, "%s%s", " AND c.relkind IN ",
-                                oss.str().c_str())) {
-          StringBuilderReset(&query);
-          return ADBC_STATUS_INTERNAL;
-        }
-      } else {
-        // no matching table type means no records should come back
-        if (StringBuilderAppend(&query, "%s", " AND false")) {
-          StringBuilderReset(&query);
-          return ADBC_STATUS_INTERNAL;
+  AdbcStatusCode LoadTables() {
+    std::vector<std::string> params;
+    std::string query;
+    for (const auto& table_type : kNzTableTypes) {
+      if (table_types_ != nullptr) {
+        bool requested = false;
+        for (const char** it = table_types_; *it != NULL; it++) {
+          if (table_type.table_type == *it) requested = true;
         }
+        if (!requested) continue;
       }
+      if (!query.empty()) query += " UNION ALL ";
+      query += "SELECT SCHEMA, " + table_type.name_column + ", '" +
+               table_type.table_type + "' FROM " + table_type.view + " WHERE 1 = 1";
+      AppendObjectFilters("SCHEMA", table_type.name_column.c_str(), &query, &params);
+    }
+    if (query.empty()) {
+      // no matching table type means no records should come back
+      query = "SELECT NULL, NULL, NULL WHERE 1 = 0";
     }
+    query += " ORDER BY 1, 2";
 
-    auto result_helper = PqResultHelper{conn_, query.buffer, params, error_};
-    StringBuilderReset(&query);
+    tables_.reset(new PqResultHelper(conn_, query, params, error_));
+    RAISE_ADBC(tables_->Prepare());
+    RAISE_ADBC(tables_->Execute());
+    tables_index_ = IndexRows(*tables_, 1);
 
-    RAISE_ADBC(result_helper.Prepare());
-    RAISE_ADBC(result_helper.Execute());
-    for (PqResultRow row : result_helper) {
-      const char* table_name = row[0].data;
-      const char* table_type = row[1].data;
+    if (depth_ == ADBC_OBJECT_DEPTH_TABLES) return ADBC_STATUS_OK;
 
+    params.clear();
+    query =
+        "SELECT SCHEMA, NAME, ATTNAME, ATTNUM, DESCRIPTION FROM _V_RELATION_COLUMN "
+        "WHERE TYPE IN ('TABLE', 'VIEW')";
+    AppendObjectFilters("SCHEMA", "NAME", &query, &params);
+    if (column_name_ != NULL) {
+      params.push_back(column_name_);
+      query += " AND ATTNAME LIKE $" + std::to_string(params.size());
+    }
+    query += " ORDER BY SCHEMA, NAME, ATTNUM";
+
+    columns_.reset(new PqResultHelper(conn_, query, params, error_));
+    RAISE_ADBC(columns_->Prepare());
+    RAISE_ADBC(columns_->Execute());
+    columns_index_ = IndexRows(*columns_, 2);
+
+    params.clear();
+    query =
+        "SELECT SCHEMA, RELATION, CONSTRAINTNAME, CASE CONTYPE "
+        "WHEN 'p' THEN 'PRIMARY KEY' WHEN 'u' THEN 'UNIQUE' "
+        "WHEN 'f' THEN 'FOREIGN KEY' END, ATTNAME, PKSCHEMA, PKRELATION, PKATTNAME "
+        "FROM _V_RELATION_KEYDATA AS k WHERE CONTYPE IN ('p', 'u', 'f')";
+    AppendObjectFilters("SCHEMA", "RELATION", &query, &params);
+    if (column_name_ != NULL) {
+      // Keep the constraints on at least one matching column, with all of
+      // their columns
+      params.push_back(column_name_);
+      query +=
+          " AND EXISTS (SELECT 1 FROM _V_RELATION_KEYDATA AS kc "
+          "WHERE kc.SCHEMA = k.SCHEMA AND kc.RELATION = k.RELATION "
+          "AND kc.CONSTRAINTNAME = k.CONSTRAINTNAME AND kc.ATTNAME LIKE $" +
+          std::to_string(params.size()) + ")";
+    }
+    query += " ORDER BY SCHEMA, RELATION, CONSTRAINTNAME, CONSEQ";
+
+    constraints_.reset(new PqResultHelper(conn_, query, params, error_));
+    RAISE_ADBC(constraints_->Prepare());
+    RAISE_ADBC(constraints_->Execute());
+    constraints_index_ = IndexRows(*constraints_, 2);
+    return ADBC_STATUS_OK;
+  }
+
+  AdbcStatusCode AppendTables(RowRange rows) {
+    for (int i = rows.first; i < rows.second; i++) {
+      PqResultRow row = tables_->Row(i);
       CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(table_name_col_, ArrowCharView(table_name)),
+               ArrowArrayAppendString(table_name_col_,
+                                      ArrowStringView{row[1].data, row[1].len}),
                error_);
       CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(table_type_col_, ArrowCharView(table_type)),
+               ArrowArrayAppendString(table_type_col_,
+                                      ArrowStringView{row[2].data, row[2].len}),
                error_);
       if (depth_ == ADBC_OBJECT_DEPTH_TABLES) {
         CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_columns_col_, 1), error_);
         CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_constraints_col_, 1), error_);
       } else {
-        auto table_name_s = std::string(table_name);
-        RAISE_ADBC(AppendColumns(schema_name, table_name_s));
-        RAISE_ADBC(AppendConstraints(schema_name, table_name_s));
+        std::string key = IndexKey(row[0], row[1]);
+        RAISE_ADBC(AppendColumns(FindRows(columns_index_, key)));
+        RAISE_ADBC(AppendConstraints(FindRows(constraints_index_, key)));
       }
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(schema_table_items_), error_);
     }
@@ -309,66 +345,29 @@ class NzGetObjectsHelper {
     return ADBC_STATUS_OK;
   }
 
-  AdbcStatusCode AppendColumns(std::string schema_name, std::string table_name) {
-    struct StringBuilder query;
-    std::memset(&query, 0, sizeof(query));
-    if (StringBuilderInit(&query, /*initial_size*/ 512)) {
-      return ADBC_STATUS_INTERNAL;
-    }
-
-    std::vector<std::string> params = {schema_name, table_name};
-    const char* stmt =
-        "SELECT attr.attname, attr.attnum, "
-        "pg_catalog.col_description(cls.oid, attr.attnum) "
-        "FROM pg_catalog.pg_attribute AS attr "
-        "INNER JOIN pg_catalog.pg_class AS cls ON attr.attrelid = cls.oid "
-        "INNER JOIN pg_catalog.pg_namespace AS nsp ON nsp.oid = cls.relnamespace "
-        "WHERE attr.attnum > 0 AND NOT attr.attisdropped "
-        "AND nsp.nspname LIKE $1 AND cls.relname LIKE $2";
-
-    if (StringBuilderAppend(&query, "%s", stmt)) {
-      StringBuilderReset(&query);
-      return ADBC_STATUS_INTERNAL;
-    }
-
-    if (column_name_ != NULL) {
-      if (StringBuilderAppend(&query, "%s", " AND attr.attname LIKE $3")) {
-        StringBuilderReset(&query);
-        return ADBC_STATUS_INTERNAL;
-      }
-
-      params.push_back(std::string(column_name_));
-    }
-
-    auto result_helper = PqResultHelper{conn_, query.buffer, params, error_};
-    StringBuilderReset(&query);
-
-    RAISE_ADBC(result_helper.Prepare());
-    RAISE_ADBC(result_helper.Execute());
-
-    for (PqResultRow row : result_helper) {
-      const char* column_name = row[0].data;
-      const char* position = row[1].data;
-
+  AdbcStatusCode AppendColumns(RowRange rows) {
+    for (int i = rows.first; i < rows.second; i++) {
+      PqResultRow row = columns_->Row(i);
       CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(column_name_col_, ArrowCharView(column_name)),
+               ArrowArrayAppendString(column_name_col_,
+                                      ArrowStringView{row[2].data, row[2].len}),
                error_);
-      int ival = atol(position);
       CHECK_NA(INTERNAL,
-               ArrowArrayAppendInt(column_position_col_, static_cast<int64_t>(ival)),
+               ArrowArrayAppendInt(column_position_col_,
+                                   static_cast<int64_t>(std::atol(row[3].data))),
                error_);
-      if (row[2].is_null) {
+      if (row[4].is_null || row[4].len == 0) {
         CHECK_NA(INTERNAL, ArrowArrayAppendNull(column_remarks_col_, 1), error_);
       } else {
-        const char* remarks = row[2].data;
         CHECK_NA(INTERNAL,
-                 ArrowArrayAppendString(column_remarks_col_, ArrowCharView(remarks)),
+                 ArrowArrayAppendString(column_remarks_col_,
+                                        ArrowStringView{row[4].data, row[4].len}),
                  error_);
       }
 
       // no xdbc_ values for now
-      for (auto i = 3; i < 19; i++) {
-        CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_columns_items_->children[i], 1),
+      for (auto j = 3; j < 19; j++) {
+        CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_columns_items_->children[j], 1),
                  error_);
       }
 
@@ -379,177 +378,54 @@ class NzGetObjectsHelper {
     return ADBC_STATUS_OK;
   }
 
-  // libpq PQexecParams can use either text or binary transfers
-  // For now we are using text transfer internally, so arrays are sent
-  // back like {element1, element2} within a const char*
-  std::vector<std::string> PqTextArrayToVector(std::string text_array) {
-    text_array.erase(0, 1);
-    text_array.erase(text_array.size() - 1);
-
-    std::vector<std::string> elements;
-    std::stringstream ss(std::move(text_array));
-    std::string tmp;
-
-    while (getline(ss, tmp, ',')) {
-      elements.push_back(std::move(tmp));
-    }
-
-    return elements;
-  }
-
-  AdbcStatusCode AppendConstraints(std::string schema_name, std::string table_name) {
-    struct StringBuilder query;
-    std::memset(&query, 0, sizeof(query));
-    if (StringBuilderInit(&query, /*initial_size*/ 4096)) {
-      return ADBC_STATUS_INTERNAL;
-    }
-
-    std::vector<std::string> params = {schema_name, table_name};
-    const char* stmt =
-        "WITH fk_unnest AS ( "
-        "    SELECT "
-        "        con.conname, "
-        "        'FOREIGN KEY' AS contype, "
-        "        conrelid, "
-        "        UNNEST(con.conkey) AS conkey, "
-        "        confrelid, "
-        "        UNNEST(con.confkey) AS confkey "
-        "    FROM pg_catalog.pg_constraint AS con "
-        "    INNER JOIN pg_catalog.pg_class AS cls ON cls.oid = conrelid "
-        "    INNER JOIN pg_catalog.pg_namespace AS nsp ON nsp.oid = cls.relnamespace "
-        "    WHERE con.contype = 'f' AND nsp.nspname LIKE $1 "
-        "    AND cls.relname LIKE $2 "
-        "), "
-        "fk_names AS ( "
-        "    SELECT "
-        "        fk_unnest.conname, "
-        "        fk_unnest.contype, "
-        "        fk_unnest.conkey, "
-        "        fk_unnest.confkey, "
-        "        attr.attname, "
-        "        fnsp.nspname AS fschema, "
-        "        fcls.relname AS ftable, "
-        "        fattr.attname AS fattname "
-        "    FROM fk_unnest "
-        "    INNER JOIN pg_catalog.pg_class AS cls ON cls.oid = fk_unnest.conrelid "
-        "    INNER JOIN pg_catalog.pg_class AS fcls ON fcls.oid = fk_unnest.confrelid "
-        "    INNER JOIN pg_catalog.pg_namespace AS fnsp ON fnsp.oid = fcls.relnamespace"
-        "    INNER JOIN pg_catalog.pg_attribute AS attr ON attr.attnum = "
-        "fk_unnest.conkey "
-        "        AND attr.attrelid = fk_unnest.conrelid "
-        "    LEFT JOIN pg_catalog.pg_attribute AS fattr ON fattr.attnum =  "
-        "fk_unnest.confkey "
-        "        AND fattr.attrelid = fk_unnest.confrelid "
-        "), "
-        "fkeys AS ( "
-        "    SELECT "
-        "        conname, "
-        "        contype, "
-        "        ARRAY_AGG(attname ORDER BY conkey) AS colnames, "
-        "        fschema, "
-        "        ftable, "
-        "        ARRAY_AGG(fattname ORDER BY confkey) AS fcolnames "
-        "    FROM fk_names "
-        "    GROUP BY "
-        "        conname, "
-        "        contype, "
-        "        fschema, "
-        "        ftable "
-        "), "
-        "other_constraints AS ( "
-        "    SELECT con.conname, CASE con.contype WHEN 'c' THEN 'CHECK' WHEN 'u' THEN  "
-        "    'UNIQUE' WHEN 'p' THEN 'PRIMARY KEY' END AS contype, "
-        "    ARRAY_AGG(attr.attname) AS colnames "
-        "    FROM pg_catalog.pg_constraint AS con  "
-        "    CROSS JOIN UNNEST(conkey) AS conkeys  "
-        "    INNER JOIN pg_catalog.pg_class AS cls ON cls.oid = con.conrelid  "
-        "    INNER JOIN pg_catalog.pg_namespace AS nsp ON nsp.oid = cls.relnamespace  "
-        "    INNER JOIN pg_catalog.pg_attribute AS attr ON attr.attnum = conkeys  "
-        "    AND cls.oid = attr.attrelid  "
-        "    WHERE con.contype IN ('c', 'u', 'p') AND nsp.nspname LIKE $1 "
-        "    AND cls.relname LIKE $2 "
-        "    GROUP BY conname, contype "
-        ") "
-        "SELECT "
-        "    conname, contype, colnames, fschema, ftable, fcolnames "
-        "FROM fkeys "
-        "UNION ALL "
-        "SELECT "
-        "    conname, contype, colnames, NULL, NULL, NULL "
-        "FROM other_constraints";
-
-    if (StringBuilderAppend(&query, "%s", stmt)) {
-      StringBuilderReset(&query);
-      return ADBC_STATUS_INTERNAL;
-    }
-
-    if (column_name_ != NULL) {
-      if (StringBuilderAppend(&query, "%s", " WHERE conname LIKE $3")) {
-        StringBuilderReset(&query);
-        return ADBC_STATUS_INTERNAL;
-      }
-
-      params.push_back(std::string(column_name_));
-    }
-
-    auto result_helper = PqResultHelper{conn_, query.buffer, params, error_};
-    StringBuilderReset(&query);
-
-    RAISE_ADBC(result_helper.Prepare());
-    RAISE_ADBC(result_helper.Execute());
-
-    for (PqResultRow row : result_helper) {
-      const char* constraint_name = row[0].data;
-      const char* constraint_type = row[1].data;
-
-      CHECK_NA(
-          INTERNAL,
-          ArrowArrayAppendString(constraint_name_col_, ArrowCharView(constraint_name)),
-          error_);
+  /// Constraints come back with one row per key column, ordered by key
+  /// position, so consecutive rows with the same name form one constraint
+  AdbcStatusCode AppendConstraints(RowRange rows) {
+    int i = rows.first;
+    while (i < rows.second) {
+      PqResultRow first = constraints_->Row(i);
+      const std::string constraint_name(first[2].data, first[2].len);
+      const bool is_foreign_key = std::strcmp(first[3].data, "FOREIGN KEY") == 0;
 
-      CHECK_NA(
-          INTERNAL,
-          ArrowArrayAppendString(constraint_type_col_, ArrowCharView(constraint_type)),
-          error_);
+      CHECK_NA(INTERNAL,
+               ArrowArrayAppendString(constraint_name_col_,
+                                      ArrowCharView(constraint_name.c_str())),
+               error_);
+      CHECK_NA(INTERNAL,
+               ArrowArrayAppendString(constraint_type_col_,
+                                      ArrowStringView{first[3].data, first[3].len}),
+               error_);
 
-      auto constraint_column_names = PqTextArrayToVector(std::string(row[2].data));
-      for (const auto& constraint_column_name : constraint_column_names) {
+      for (; i < rows.second; i++) {
+        PqResultRow row = constraints_->Row(i);
+        if (constraint_name.compare(0, std::string::npos, row[2].data, row[2].len) != 0) {
+          break;
+        }
         CHECK_NA(INTERNAL,
                  ArrowArrayAppendString(constraint_column_name_col_,
-                                        ArrowCharView(constraint_column_name.c_str())),
+                                        ArrowStringView{row[4].data, row[4].len}),
                  error_);
-      }
-      CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_names_col_), error_);
-
-      if (!strcmp(constraint_type, "FOREIGN KEY")) {
-        assert(!row[3].is_null);
-        assert(!row[4].is_null);
-        assert(!row[5].is_null);
-
-        const char* constraint_ftable_schema = row[3].data;
-        const char* constraint_ftable_name = row[4].data;
-        auto constraint_fcolumn_names = PqTextArrayToVector(std::string(row[5].data));
-        for (const auto& constraint_fcolumn_name : constraint_fcolumn_names) {
+        if (is_foreign_key) {
           CHECK_NA(INTERNAL,
                    ArrowArrayAppendString(fk_catalog_col_, ArrowCharView(PQdb(conn_))),
                    error_);
           CHECK_NA(INTERNAL,
                    ArrowArrayAppendString(fk_db_schema_col_,
-                                          ArrowCharView(constraint_ftable_schema)),
+                                          ArrowStringView{row[5].data, row[5].len}),
                    error_);
           CHECK_NA(INTERNAL,
                    ArrowArrayAppendString(fk_table_col_,
-                                          ArrowCharView(constraint_ftable_name)),
+                                          ArrowStringView{row[6].data, row[6].len}),
                    error_);
           CHECK_NA(INTERNAL,
                    ArrowArrayAppendString(fk_column_name_col_,
-                                          ArrowCharView(constraint_fcolumn_name.c_str())),
+                                          ArrowStringView{row[7].data, row[7].len}),
                    error_);
-
           CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_usage_items_),
                    error_);
         }
       }
+      CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_names_col_), error_);
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_usages_col_), error_);
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_constraints_items_), error_);
     }
@@ -576,6 +452,12 @@ class NzGetObjectsHelper {
   struct ArrowArray* array_;
   struct AdbcError* error_;
   struct ArrowError na_error_;
+  std::unique_ptr<PqResultHelper> tables_;
+  std::unique_ptr<PqResultHelper> columns_;
+  std::unique_ptr<PqResultHelper> constraints_;
+  RowIndex tables_index_;
+  RowIndex columns_index_;
+  RowIndex constraints_index_;
   struct ArrowArray* catalog_name_col_;
   struct ArrowArray* catalog_db_schemas_col_;
   struct ArrowArray* catalog_db_schemas_items_;
@@ -897,19 +779,14 @@ AdbcStatusCode NetezzaConnectionGetStatisticsImpl(PGconn* conn, const char* db_s
   struct ArrowArray* value_float64_col = statistics_value_col->children[2];
   // struct ArrowArray* value_binary_col = statistics_value_col->children[3];
 
-  // Query (could probably be massively improved)
+  // A single query over the whole schema, ordered so that each table's
+  // columns are contiguous
   std::string query = R"(
-    WITH
-      class AS (
-        SELECT nspname, relname, reltuples
-        FROM pg_namespace
-        INNER JOIN pg_class ON pg_class.relnamespace = pg_namespace.oid
-      )
-    SELECT tablename, attname, null_frac, avg_width, n_distinct, reltuples
-    FROM pg_stats
-    INNER JOIN class ON pg_stats.schemaname = class.nspname AND pg_stats.tablename = class.relname
-    WHERE pg_stats.schemaname = $1 AND tablename LIKE $2
-    ORDER BY tablename
+    SELECT s.TABLENAME, s.ATTNAME, s.STANULLFRAC, s.ATTDISPERSION, t.RELTUPLES
+    FROM _V_STATISTIC s
+    INNER JOIN _V_TABLE t ON t.OBJID = s.OBJID
+    WHERE t.SCHEMA = $1 AND s.TABLENAME LIKE $2
+    ORDER BY s.TABLENAME, s.ATTNUM
 )";
 
   CHECK_NA(INTERNAL, ArrowArrayAppendString(catalog_name_col, ArrowCharView(PQdb(conn))),
@@ -928,9 +805,9 @@ AdbcStatusCode NetezzaConnectionGetStatisticsImpl(PGconn* conn, const char* db_s
     RAISE_ADBC(result_helper.Execute());
 
     for (PqResultRow row : result_helper) {
-      auto reltuples = row[5].ParseDouble();
+      auto reltuples = row[4].ParseDouble();
       if (!reltuples.first) {
-        SetError(error, "[libpq] Invalid double value in reltuples: '%s'", row[5].data);
+        SetError(error, "[libpq] Invalid double value in reltuples: '%s'", row[4].data);
         return ADBC_STATUS_INTERNAL;
       }
 
@@ -955,7 +832,7 @@ AdbcStatusCode NetezzaConnectionGetStatisticsImpl(PGconn* conn, const char* db_s
 
       auto null_frac = row[2].ParseDouble();
       if (!null_frac.first) {
-        SetError(error, "[libpq] Invalid double value in null_frac: '%s'", row[2].data);
+        SetError(error, "[libpq] Invalid double value in stanullfrac: '%s'", row[2].data);
         return ADBC_STATUS_INTERNAL;
       }
 
@@ -980,11 +857,15 @@ AdbcStatusCode NetezzaConnectionGetStatisticsImpl(PGconn* conn, const char* db_s
       CHECK_NA(INTERNAL, ArrowArrayAppendInt(statistics_is_approximate_col, 1), error);
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_statistics_items), error);
 
-      auto average_byte_width = row[3].ParseDouble();
-      if (!average_byte_width.first) {
-        SetError(error, "[libpq] Invalid double value in avg_width: '%s'", row[3].data);
+      // Netezza reports the dispersion (the inverse of the number of distinct
+      // values); zero means it has not been computed
+      auto dispersion = row[3].ParseDouble();
+      if (!dispersion.first) {
+        SetError(error, "[libpq] Invalid double value in attdispersion: '%s'",
+                 row[3].data);
         return ADBC_STATUS_INTERNAL;
       }
+      if (dispersion.second <= 0) continue;
 
       CHECK_NA(INTERNAL,
                ArrowArrayAppendString(statistics_table_name_col,
@@ -994,46 +875,12 @@ AdbcStatusCode NetezzaConnectionGetStatisticsImpl(PGconn* conn, const char* db_s
                ArrowArrayAppendString(statistics_column_name_col,
                                       ArrowStringView{row[1].data, row[1].len}),
                error);
-      CHECK_NA(
-          INTERNAL,
-          ArrowArrayAppendInt(statistics_key_col, ADBC_STATISTIC_AVERAGE_BYTE_WIDTH_KEY),
-          error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendDouble(value_float64_col, average_byte_width.second),
-               error);
       CHECK_NA(INTERNAL,
-               ArrowArrayFinishUnionElement(statistics_value_col, kStatsVariantFloat64),
-               error);
-      CHECK_NA(INTERNAL, ArrowArrayAppendInt(statistics_is_approximate_col, 1), error);
-      CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_statistics_items), error);
-
-      auto n_distinct = row[4].ParseDouble();
-      if (!n_distinct.first) {
-        SetError(error, "[libpq] Invalid double value in avg_width: '%s'", row[4].data);
-        return ADBC_STATUS_INTERNAL;
-      }
-
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(statistics_table_name_col,
-                                      ArrowStringView{row[0].data, row[0].len}),
-               error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(statistics_column_name_col,
-                                      ArrowStringView{row[1].data, row[1].len}),
+               ArrowArrayAppendInt(statistics_key_col, ADBC_STATISTIC_DISTINCT_COUNT_KEY),
                error);
       CHECK_NA(INTERNAL,
-               ArrowArrayAppendInt(statistics_key_col, ADBC_STATISTIC_DISTINCT_COUNT_KEY),
+               ArrowArrayAppendDouble(value_float64_col, 1.0 / dispersion.second),
                error);
-      // > If greater than zero, the estimated number of distinct values in
-      // > the column. If less than zero, the negative of the number of
-      // > distinct values divided by the number of rows.
-      CHECK_NA(
-          INTERNAL,
-          ArrowArrayAppendDouble(value_float64_col,
-                                 n_distinct.second > 0
-                                     ? n_distinct.second
-                                     : (std::fabs(n_distinct.second) * reltuples.second)),
-          error);
       CHECK_NA(INTERNAL,
                ArrowArrayFinishUnionElement(statistics_value_col, kStatsVariantFloat64),
                error);
@@ -1233,10 +1080,10 @@ AdbcStatusCode NetezzaConnectionGetTableTypesImpl(struct ArrowSchema* schema,
   CHECK_NA(INTERNAL, ArrowArrayInitFromSchema(array, uschema.get(), NULL), error);
   CHECK_NA(INTERNAL, ArrowArrayStartAppending(array), error);
 
-  for (auto const& table_type : kPgTableTypes) {
+  for (auto const& table_type : kNzTableTypes) {
     CHECK_NA(INTERNAL,
              ArrowArrayAppendString(array->children[0],
-                                    ArrowCharView(table_type.first.c_str())),
+                                    ArrowCharView(table_type.table_type.c_str())),
              error);
     CHECK_NA(INTERNAL, ArrowArrayFinishElement(array), error);
   }
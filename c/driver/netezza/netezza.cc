@@ -366,7 +366,8 @@ AdbcStatusCode NetezzaConnectionReadPartition(struct AdbcConnection* connection,
                                                struct ArrowArrayStream* out,
                                                struct AdbcError* error) {
   if (!connection->private_data) return ADBC_STATUS_INVALID_STATE;
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+  return NetezzaStatement::ReadPartition(connection, serialized_partition,
+                                         serialized_length, out, error);
 }
 
 AdbcStatusCode NetezzaConnectionRelease(struct AdbcConnection* connection,
@@ -598,7 +599,9 @@ AdbcStatusCode NetezzaStatementExecutePartitions(struct AdbcStatement* statement
                                                   int64_t* rows_affected,
                                                   struct AdbcError* error) {
   if (!statement->private_data) return ADBC_STATUS_INVALID_STATE;
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+  auto* ptr =
+      reinterpret_cast<std::shared_ptr<NetezzaStatement>*>(statement->private_data);
+  return (*ptr)->ExecutePartitions(schema, partitions, rows_affected, error);
 }
 
 AdbcStatusCode NetezzaStatementExecuteQuery(struct AdbcStatement* statement,
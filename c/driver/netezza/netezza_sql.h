@@ -0,0 +1,555 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Lightweight scanning of SQL text, used to rewrite queries (e.g., to split
+// a query across data slices or to batch INSERTs) without a full parser.
+
+#pragma once
+
+#include <cctype>
+#include <cerrno>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nanoarrow/nanoarrow.hpp>
+
+#include "libpq_common/pq_copy_reader.h"
+
+namespace adbcpq {
+
+/// \brief Skip the literal, quoted identifier or comment starting at offset i.
+///
+/// Returns i if nothing is to be skipped there, and the offset just past it
+/// otherwise (or the end of the query if it is unterminated).
+inline size_t SkipQuotedOrComment(const std::string& query, size_t i) {
+  const char c = query[i];
+  size_t end = i;
+  if (c == '\'' || c == '"') {
+    end = query.find(c, i + 1);
+    while (end != std::string::npos && end + 1 < query.size() && query[end + 1] == c) {
+      end = query.find(c, end + 2);
+    }
+    if (end != std::string::npos) end += 1;
+  } else if (c == '-' && i + 1 < query.size() && query[i + 1] == '-') {
+    end = query.find('\n', i);
+  } else if (c == '/' && i + 1 < query.size() && query[i + 1] == '*') {
+    end = query.find("*/", i + 2);
+    if (end != std::string::npos) end += 2;
+  }
+  return end == std::string::npos ? query.size() : end;
+}
+
+/// A keyword outside of any literal, comment or parentheses (upper-cased),
+/// and its offset in the query
+using SqlKeyword = std::pair<std::string, size_t>;
+
+inline std::vector<SqlKeyword> FindTopLevelKeywords(const std::string& query) {
+  std::vector<SqlKeyword> keywords;
+  int depth = 0;
+  size_t i = 0;
+  while (i < query.size()) {
+    const char c = query[i];
+    size_t skipped = SkipQuotedOrComment(query, i);
+    if (skipped != i) {
+      i = skipped;
+    } else if (c == '(') {
+      depth++;
+      i++;
+    } else if (c == ')') {
+      depth--;
+      i++;
+    } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      size_t start = i;
+      while (i < query.size() && (std::isalnum(static_cast<unsigned char>(query[i])) ||
+                                  query[i] == '_' || query[i] == '$')) {
+        i++;
+      }
+      if (depth == 0) {
+        std::string word = query.substr(start, i - start);
+        for (char& ch : word) ch = static_cast<char>(std::toupper(ch));
+        keywords.emplace_back(std::move(word), start);
+      }
+    } else {
+      i++;
+    }
+  }
+  return keywords;
+}
+
+/// The offset of the parenthesis closing the one at offset open, or npos
+inline size_t FindClosingParen(const std::string& query, size_t open) {
+  int depth = 0;
+  size_t i = open;
+  while (i < query.size()) {
+    size_t skipped = SkipQuotedOrComment(query, i);
+    if (skipped != i) {
+      i = skipped;
+      continue;
+    }
+    if (query[i] == '(') {
+      depth++;
+    } else if (query[i] == ')' && --depth == 0) {
+      return i;
+    }
+    i++;
+  }
+  return std::string::npos;
+}
+
+/// Whether the top level of query[begin, end) (outside of any literal,
+/// comment or parentheses) contains the character c
+inline bool HasTopLevelChar(const std::string& query, size_t begin, size_t end, char c) {
+  int depth = 0;
+  size_t i = begin;
+  while (i < end) {
+    size_t skipped = SkipQuotedOrComment(query, i);
+    if (skipped != i) {
+      i = skipped;
+      continue;
+    }
+    if (query[i] == '(') {
+      depth++;
+    } else if (query[i] == ')') {
+      depth--;
+    } else if (depth == 0 && query[i] == c) {
+      return true;
+    }
+    i++;
+  }
+  return false;
+}
+
+/// Whether query[begin, end) calls an aggregate function, at any depth
+inline bool HasAggregateCall(const std::string& query, size_t begin, size_t end) {
+  static const char* kAggregates[] = {
+      "AVG", "BIT_AND", "BIT_OR", "BOOL_AND", "BOOL_OR", "COUNT", "EVERY", "GROUPING",
+      "MAX", "MIN", "STDDEV", "STDDEV_POP", "STDDEV_SAMP", "SUM", "VARIANCE", "VAR_POP",
+      "VAR_SAMP"};
+  size_t i = begin;
+  while (i < end) {
+    size_t skipped = SkipQuotedOrComment(query, i);
+    if (skipped != i) {
+      i = skipped;
+    } else if (std::isalpha(static_cast<unsigned char>(query[i])) || query[i] == '_') {
+      size_t start = i;
+      while (i < end && (std::isalnum(static_cast<unsigned char>(query[i])) ||
+                         query[i] == '_' || query[i] == '$')) {
+        i++;
+      }
+      std::string word = query.substr(start, i - start);
+      for (char& ch : word) ch = static_cast<char>(std::toupper(ch));
+      size_t next = query.find_first_not_of(" \t\r\n", i);
+      if (next == std::string::npos || next >= end || query[next] != '(') continue;
+      for (const char* name : kAggregates) {
+        if (word == name) return true;
+      }
+    } else {
+      i++;
+    }
+  }
+  return false;
+}
+
+/// \brief Restrict a query to the rows stored on one data slice.
+///
+/// DATASLICEID is a pseudo-column of base tables, so it can't be applied to
+/// the query as a derived table; instead, the predicate is AND-ed onto the
+/// query's own top-level WHERE clause. The predicate goes on a new line so
+/// that a trailing -- comment can't swallow it.
+///
+/// Only a SELECT from a single base table can be split this way: queries
+/// whose result would change if evaluated per slice (aggregates, grouping,
+/// ordering, limits, joins, window functions, set operations, DISTINCT) and
+/// queries reading from a derived table are not. For those, returns false and
+/// the query must be read as a single partition.
+inline bool RestrictToDataSlice(const std::string& query, int64_t slice_id,
+                                std::string* out) {
+  std::vector<SqlKeyword> keywords = FindTopLevelKeywords(query);
+  if (keywords.empty() || keywords.front().first != "SELECT") return false;
+
+  static const char* kUnpartitionable[] = {
+      "DISTINCT", "GROUP",     "HAVING", "ORDER", "LIMIT", "OFFSET", "FETCH",
+      "UNION",    "INTERSECT", "EXCEPT", "MINUS", "JOIN",  "OVER",   "INTO"};
+  size_t from_offset = std::string::npos;
+  size_t where_offset = std::string::npos;
+  for (const auto& keyword : keywords) {
+    for (const char* name : kUnpartitionable) {
+      if (keyword.first == name) return false;
+    }
+    if (keyword.first == "FROM" && from_offset == std::string::npos) {
+      from_offset = keyword.second;
+    } else if (keyword.first == "WHERE" && where_offset == std::string::npos) {
+      where_offset = keyword.second;
+    }
+  }
+  if (from_offset == std::string::npos) return false;
+
+  const size_t select_list = keywords.front().second + std::strlen("SELECT");
+  if (HasAggregateCall(query, select_list, from_offset)) return false;
+
+  // A single base table: no derived table, and no comma-separated join
+  const size_t from_list = from_offset + std::strlen("FROM");
+  const size_t from_end = where_offset == std::string::npos ? query.size() : where_offset;
+  const size_t table = query.find_first_not_of(" \t\r\n", from_list);
+  if (table == std::string::npos || table >= from_end || query[table] == '(') {
+    return false;
+  }
+  if (HasTopLevelChar(query, from_list, from_end, ',')) return false;
+
+  const std::string predicate = "DATASLICEID = " + std::to_string(slice_id);
+  if (where_offset == std::string::npos) {
+    *out = query + "\n WHERE " + predicate;
+  } else {
+    const size_t condition = where_offset + std::strlen("WHERE");
+    *out = query.substr(0, condition) + " (" + query.substr(condition) + "\n)\n AND " +
+           predicate;
+  }
+  return true;
+}
+
+/// A piece of a row template: literal SQL text followed by the (1-based)
+/// parameter to substitute after it, if param > 0
+struct RowTemplatePart {
+  std::string text;
+  int param;
+};
+
+/// \brief Split a prepared INSERT ... VALUES (...) into the INSERT prefix and
+///   a template for one row.
+///
+/// Returns false if the query does not have that shape, in which case the
+/// statement must be executed row by row.
+inline bool ParseInsertValues(const std::string& query, int64_t n_params,
+                              std::string* prefix,
+                              std::vector<RowTemplatePart>* row_template) {
+  std::vector<SqlKeyword> keywords = FindTopLevelKeywords(query);
+  if (keywords.empty() || keywords.front().first != "INSERT") return false;
+
+  size_t values_offset = std::string::npos;
+  for (const auto& keyword : keywords) {
+    if (keyword.first == "VALUES") {
+      values_offset = keyword.second;
+      break;
+    }
+  }
+  if (values_offset == std::string::npos) return false;
+
+  size_t open = query.find_first_not_of(" \t\r\n", values_offset + std::strlen("VALUES"));
+  if (open == std::string::npos || query[open] != '(') return false;
+  size_t close = FindClosingParen(query, open);
+  if (close == std::string::npos) return false;
+  if (query.find_first_not_of(" \t\r\n;", close + 1) != std::string::npos) return false;
+
+  *prefix = query.substr(0, values_offset);
+  row_template->clear();
+  RowTemplatePart part{"", 0};
+  size_t i = open + 1;
+  while (i < close) {
+    size_t skipped = SkipQuotedOrComment(query, i);
+    if (skipped != i) {
+      part.text.append(query, i, skipped - i);
+      i = skipped;
+    } else if (query[i] == '$' && i + 1 < close &&
+               std::isdigit(static_cast<unsigned char>(query[i + 1]))) {
+      i++;
+      int64_t param = 0;
+      while (i < close && std::isdigit(static_cast<unsigned char>(query[i]))) {
+        param = param * 10 + (query[i] - '0');
+        if (param > n_params) return false;
+        i++;
+      }
+      if (param == 0) return false;
+      part.param = static_cast<int>(param);
+      row_template->push_back(std::move(part));
+      part = RowTemplatePart{"", 0};
+    } else {
+      part.text.push_back(query[i]);
+      i++;
+    }
+  }
+  row_template->push_back(std::move(part));
+  return true;
+}
+
+/// \brief Write the proleptic Gregorian date for a day count since the UNIX
+///   epoch as YYYY-MM-DD.
+///
+/// See https://howardhinnant.github.io/date_algorithms.html#civil_from_days
+inline void AppendCivilDate(int64_t days, std::string* out) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const int64_t doe = days - era * 146097;
+  const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int64_t mp = (5 * doy + 2) / 153;
+  const int64_t day = doy - (153 * mp + 2) / 5 + 1;
+  const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+  const int64_t year = yoe + era * 400 + (month <= 2);
+
+  char buf[32];
+  int n = std::snprintf(buf, sizeof(buf), "%04" PRId64 "-%02" PRId64 "-%02" PRId64, year,
+                        month, day);
+  out->append(buf, n);
+}
+
+/// \brief Append one value of a bound column as a SQL literal.
+///
+/// Values other than strings and binary are written as CAST(... AS type), so
+/// that every SELECT in a UNION ALL resolves to the same column types. (A
+/// postfix cast would bind tighter than a minus sign: -32768::INT2 casts
+/// 32768 and overflows.)
+///
+/// Returns EINVAL for a string containing a NUL byte, ERANGE for a timestamp
+/// outside of Netezza's range, and ENOTSUP for a type that has no literal.
+inline ArrowErrorCode AppendLiteral(struct ArrowArrayView* column,
+                                    const struct ArrowSchemaView& field, int64_t row,
+                                    std::string* out, struct ArrowError* error) {
+  const bool is_null = ArrowArrayViewIsNull(column, row);
+  char buf[64];
+  int n = 0;
+
+  switch (field.type) {
+    case NANOARROW_TYPE_BOOL:
+      out->append("CAST(");
+      if (is_null) {
+        out->append("NULL");
+      } else {
+        out->append(ArrowArrayViewGetIntUnsafe(column, row) ? "TRUE" : "FALSE");
+      }
+      out->append(" AS BOOLEAN)");
+      return NANOARROW_OK;
+    case NANOARROW_TYPE_INT8:
+    case NANOARROW_TYPE_INT16:
+    case NANOARROW_TYPE_INT32:
+    case NANOARROW_TYPE_INT64:
+      out->append("CAST(");
+      if (is_null) {
+        out->append("NULL");
+      } else {
+        n = std::snprintf(buf, sizeof(buf), "%" PRId64,
+                          ArrowArrayViewGetIntUnsafe(column, row));
+        out->append(buf, n);
+      }
+      out->append(field.type == NANOARROW_TYPE_INT64   ? " AS INT8)"
+                  : field.type == NANOARROW_TYPE_INT32 ? " AS INT4)"
+                                                       : " AS INT2)");
+      return NANOARROW_OK;
+    case NANOARROW_TYPE_FLOAT:
+    case NANOARROW_TYPE_DOUBLE: {
+      const double value = ArrowArrayViewGetDoubleUnsafe(column, row);
+      out->append("CAST(");
+      if (is_null) {
+        out->append("NULL");
+      } else if (std::isnan(value)) {
+        out->append("'NaN'");
+      } else if (std::isinf(value)) {
+        out->append(value > 0 ? "'Infinity'" : "'-Infinity'");
+      } else {
+        n = std::snprintf(buf, sizeof(buf),
+                          field.type == NANOARROW_TYPE_FLOAT ? "%.9g" : "%.17g", value);
+        out->append(buf, n);
+      }
+      out->append(field.type == NANOARROW_TYPE_FLOAT ? " AS FLOAT4)" : " AS FLOAT8)");
+      return NANOARROW_OK;
+    }
+    case NANOARROW_TYPE_STRING:
+    case NANOARROW_TYPE_LARGE_STRING: {
+      if (is_null) {
+        out->append("NULL");
+        return NANOARROW_OK;
+      }
+      const ArrowStringView view = ArrowArrayViewGetStringUnsafe(column, row);
+      out->push_back('\'');
+      for (int64_t i = 0; i < view.size_bytes; i++) {
+        const char c = view.data[i];
+        if (c == '\0') {
+          ArrowErrorSet(error, "contains a NUL byte, which can't be sent as a literal");
+          return EINVAL;
+        }
+        if (c == '\'') out->push_back('\'');
+        out->push_back(c);
+      }
+      out->push_back('\'');
+      return NANOARROW_OK;
+    }
+    case NANOARROW_TYPE_BINARY: {
+      if (is_null) {
+        out->append("NULL");
+        return NANOARROW_OK;
+      }
+      static const char kHexDigits[] = "0123456789ABCDEF";
+      const ArrowBufferView view = ArrowArrayViewGetBytesUnsafe(column, row);
+      out->append("X'");
+      for (int64_t i = 0; i < view.size_bytes; i++) {
+        out->push_back(kHexDigits[view.data.as_uint8[i] >> 4]);
+        out->push_back(kHexDigits[view.data.as_uint8[i] & 0x0F]);
+      }
+      out->push_back('\'');
+      return NANOARROW_OK;
+    }
+    case NANOARROW_TYPE_DATE32:
+      out->append("CAST(");
+      if (is_null) {
+        out->append("NULL");
+      } else {
+        out->push_back('\'');
+        AppendCivilDate(ArrowArrayViewGetIntUnsafe(column, row), out);
+        out->push_back('\'');
+      }
+      out->append(" AS DATE)");
+      return NANOARROW_OK;
+    case NANOARROW_TYPE_TIMESTAMP: {
+      if (is_null) {
+        out->append("CAST(NULL AS TIMESTAMP)");
+        return NANOARROW_OK;
+      }
+      // Values are UTC; Netezza's TIMESTAMP has microsecond resolution
+      const int64_t raw_value = ArrowArrayViewGetIntUnsafe(column, row);
+      int64_t micros = raw_value;
+      bool overflow_safe = true;
+      switch (field.time_unit) {
+        case NANOARROW_TIME_UNIT_SECOND:
+          overflow_safe =
+              micros <= kMaxSafeSecondsToMicros && micros >= kMinSafeSecondsToMicros;
+          micros *= overflow_safe ? 1000000 : 1;
+          break;
+        case NANOARROW_TIME_UNIT_MILLI:
+          overflow_safe =
+              micros <= kMaxSafeMillisToMicros && micros >= kMinSafeMillisToMicros;
+          micros *= overflow_safe ? 1000 : 1;
+          break;
+        case NANOARROW_TIME_UNIT_MICRO:
+          break;
+        case NANOARROW_TIME_UNIT_NANO:
+          micros /= 1000;
+          break;
+      }
+      if (!overflow_safe) {
+        ArrowErrorSet(error,
+                      "has value '%" PRIi64 "' which exceeds Netezza timestamp limits",
+                      raw_value);
+        return ERANGE;
+      }
+
+      constexpr int64_t kMicrosPerSecond = 1000000;
+      constexpr int64_t kMicrosPerDay = 86400 * kMicrosPerSecond;
+      int64_t days = micros / kMicrosPerDay;
+      int64_t time_of_day = micros % kMicrosPerDay;
+      if (time_of_day < 0) {
+        time_of_day += kMicrosPerDay;
+        days -= 1;
+      }
+      out->append("CAST('");
+      AppendCivilDate(days, out);
+      n = std::snprintf(buf, sizeof(buf),
+                        " %02" PRId64 ":%02" PRId64 ":%02" PRId64 ".%06" PRId64
+                        "' AS TIMESTAMP)",
+                        time_of_day / (3600 * kMicrosPerSecond),
+                        time_of_day / (60 * kMicrosPerSecond) % 60,
+                        time_of_day / kMicrosPerSecond % 60,
+                        time_of_day % kMicrosPerSecond);
+      out->append(buf, n);
+      return NANOARROW_OK;
+    }
+    default:
+      ArrowErrorSet(error, "has unsupported type for a literal %s",
+                    ArrowTypeString(field.type));
+      return ENOTSUP;
+  }
+}
+
+/// \brief Render a stream of bound parameters as INSERTs of many rows each.
+///
+/// Netezza only accepts a single row in INSERT ... VALUES, so each chunk of
+/// rows is rendered as INSERT ... SELECT <row> UNION ALL SELECT <row> ...,
+/// with the parameters written by AppendLiteral. A chunk is passed to
+/// execute(sql, num_rows) once its SQL reaches batch_size_hint_bytes, and
+/// what is left at the end of the stream. The SQL is built in a single
+/// buffer reserved up front and reused across chunks.
+///
+/// Returns EIO if the stream fails, and otherwise the first error returned
+/// by AppendLiteral or execute.
+template <typename Execute>
+ArrowErrorCode RenderInsertBatches(struct ArrowArrayStream* stream,
+                                   struct ArrowSchema* schema,
+                                   const std::vector<struct ArrowSchemaView>& fields,
+                                   const std::string& insert_prefix,
+                                   const std::vector<RowTemplatePart>& row_template,
+                                   int64_t batch_size_hint_bytes, Execute&& execute,
+                                   struct ArrowError* error) {
+  std::string sql;
+  sql.reserve(static_cast<size_t>(batch_size_hint_bytes) + 4096);
+  int64_t chunk_rows = 0;
+
+  while (true) {
+    nanoarrow::UniqueArray array;
+    int res = stream->get_next(stream, array.get());
+    if (res != 0) {
+      ArrowErrorSet(error,
+                    "Failed to read next batch from stream of bind parameters: "
+                    "(%d) %s %s",
+                    res, std::strerror(res), stream->get_last_error(stream));
+      return EIO;
+    }
+    if (!array->release) break;
+
+    nanoarrow::UniqueArrayView array_view;
+    NANOARROW_RETURN_NOT_OK(
+        ArrowArrayViewInitFromSchema(array_view.get(), schema, error));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayViewSetArray(array_view.get(), array.get(), error));
+
+    for (int64_t row = 0; row < array->length; row++) {
+      if (chunk_rows == 0) {
+        sql.append(insert_prefix);
+        sql.append("SELECT ");
+      } else {
+        sql.append(" UNION ALL SELECT ");
+      }
+      for (const auto& part : row_template) {
+        sql.append(part.text);
+        if (part.param > 0) {
+          const int64_t col = part.param - 1;
+          int status = AppendLiteral(array_view->children[col], fields[col], row, &sql,
+                                     error);
+          if (status != NANOARROW_OK) {
+            const std::string detail = error->message;
+            ArrowErrorSet(error, "Field #%" PRId64 " ('%s') Row #%" PRId64 " %s", col + 1,
+                          schema->children[col]->name, row + 1, detail.c_str());
+            return status;
+          }
+        }
+      }
+      chunk_rows++;
+
+      if (static_cast<int64_t>(sql.size()) >= batch_size_hint_bytes) {
+        NANOARROW_RETURN_NOT_OK(execute(sql, chunk_rows));
+        chunk_rows = 0;
+        sql.clear();
+      }
+    }
+  }
+  if (chunk_rows > 0) NANOARROW_RETURN_NOT_OK(execute(sql, chunk_rows));
+  return NANOARROW_OK;
+}
+
+}  // namespace adbcpq
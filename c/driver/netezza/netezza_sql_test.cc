@@ -0,0 +1,421 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nanoarrow/nanoarrow.hpp>
+
+#include "netezza_sql.h"
+#include "validation/adbc_validation_util.h"
+
+namespace adbcpq {
+
+TEST(NetezzaSqlTest, RestrictToDataSliceNoWhere) {
+  std::string out;
+  ASSERT_TRUE(RestrictToDataSlice("SELECT a, b FROM t", 3, &out));
+  EXPECT_EQ("SELECT a, b FROM t\n WHERE DATASLICEID = 3", out);
+}
+
+TEST(NetezzaSqlTest, RestrictToDataSliceWhere) {
+  std::string out;
+  ASSERT_TRUE(RestrictToDataSlice("SELECT a FROM t WHERE a > 1 OR b < 2", 7, &out));
+  EXPECT_EQ("SELECT a FROM t WHERE ( a > 1 OR b < 2\n)\n AND DATASLICEID = 7", out);
+
+  // WHERE inside a subquery is not the query's own WHERE
+  ASSERT_TRUE(RestrictToDataSlice("SELECT a, (SELECT 1 WHERE TRUE) FROM t", 1, &out));
+  EXPECT_EQ("SELECT a, (SELECT 1 WHERE TRUE) FROM t\n WHERE DATASLICEID = 1", out);
+}
+
+TEST(NetezzaSqlTest, RestrictToDataSliceTrailingComment) {
+  std::string out;
+  ASSERT_TRUE(RestrictToDataSlice("SELECT a FROM t -- all rows", 0, &out));
+  EXPECT_EQ("SELECT a FROM t -- all rows\n WHERE DATASLICEID = 0", out);
+
+  ASSERT_TRUE(RestrictToDataSlice("SELECT a FROM t WHERE a = 1 -- one row", 0, &out));
+  EXPECT_EQ("SELECT a FROM t WHERE ( a = 1 -- one row\n)\n AND DATASLICEID = 0", out);
+
+  // Keywords in comments and literals are ignored
+  ASSERT_TRUE(RestrictToDataSlice("SELECT 'GROUP BY' FROM t /* LIMIT 1 */", 0, &out));
+  EXPECT_EQ("SELECT 'GROUP BY' FROM t /* LIMIT 1 */\n WHERE DATASLICEID = 0", out);
+}
+
+TEST(NetezzaSqlTest, RestrictToDataSliceAggregates) {
+  std::string out;
+  EXPECT_FALSE(RestrictToDataSlice("SELECT COUNT(*) FROM t", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("select sum (a) from t where b = 1", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT 1 + (MAX(a)) FROM t", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT a, ROW_NUMBER() OVER () FROM t", 0, &out));
+  // A column that happens to be named like an aggregate is fine
+  EXPECT_TRUE(RestrictToDataSlice("SELECT count, max FROM t", 0, &out));
+}
+
+TEST(NetezzaSqlTest, RestrictToDataSliceClauses) {
+  std::string out;
+  EXPECT_FALSE(RestrictToDataSlice("SELECT a FROM t GROUP BY a", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT a FROM t ORDER BY a", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT a FROM t LIMIT 10", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT DISTINCT a FROM t", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT a FROM t UNION ALL SELECT a FROM u", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT a INTO u FROM t", 0, &out));
+}
+
+TEST(NetezzaSqlTest, RestrictToDataSliceJoins) {
+  std::string out;
+  EXPECT_FALSE(RestrictToDataSlice("SELECT * FROM t JOIN u ON t.a = u.a", 0, &out));
+  EXPECT_FALSE(
+      RestrictToDataSlice("SELECT * FROM t LEFT OUTER JOIN u USING (a)", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT * FROM t, u WHERE t.a = u.a", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT * FROM (SELECT a FROM t) s", 0, &out));
+}
+
+TEST(NetezzaSqlTest, RestrictToDataSliceNotSelect) {
+  std::string out;
+  EXPECT_FALSE(
+      RestrictToDataSlice("WITH s AS (SELECT a FROM t) SELECT a FROM s", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("DELETE FROM t", 0, &out));
+  EXPECT_FALSE(RestrictToDataSlice("SELECT 1", 0, &out));
+}
+
+TEST(NetezzaSqlTest, ParseInsertValues) {
+  std::string prefix;
+  std::vector<RowTemplatePart> row_template;
+  ASSERT_TRUE(ParseInsertValues("INSERT INTO t (a, b) VALUES ($1, $2)", 2, &prefix,
+                                &row_template));
+  EXPECT_EQ("INSERT INTO t (a, b) ", prefix);
+  ASSERT_EQ(3, row_template.size());
+  EXPECT_EQ("", row_template[0].text);
+  EXPECT_EQ(1, row_template[0].param);
+  EXPECT_EQ(", ", row_template[1].text);
+  EXPECT_EQ(2, row_template[1].param);
+  EXPECT_EQ("", row_template[2].text);
+  EXPECT_EQ(0, row_template[2].param);
+
+  // Expressions, literals and comments are kept as text; parameters may
+  // repeat and appear in any order
+  ASSERT_TRUE(ParseInsertValues(
+      "insert into t values ($2 + 1, '$1 '' $2', /* $1 */ $1, $2);", 2, &prefix,
+      &row_template));
+  EXPECT_EQ("insert into t ", prefix);
+  ASSERT_EQ(4, row_template.size());
+  EXPECT_EQ(2, row_template[0].param);
+  EXPECT_EQ(" + 1, '$1 '' $2', /* $1 */ ", row_template[1].text);
+  EXPECT_EQ(1, row_template[1].param);
+  EXPECT_EQ(", ", row_template[2].text);
+  EXPECT_EQ(2, row_template[2].param);
+}
+
+TEST(NetezzaSqlTest, ParseInsertValuesRejected) {
+  std::string prefix;
+  std::vector<RowTemplatePart> row_template;
+  // Not an INSERT ... VALUES
+  EXPECT_FALSE(ParseInsertValues("SELECT $1", 1, &prefix, &row_template));
+  EXPECT_FALSE(
+      ParseInsertValues("INSERT INTO t SELECT a FROM u", 0, &prefix, &row_template));
+  // More than one row, or trailing clauses
+  EXPECT_FALSE(
+      ParseInsertValues("INSERT INTO t VALUES ($1), ($1)", 1, &prefix, &row_template));
+  EXPECT_FALSE(ParseInsertValues("INSERT INTO t VALUES ($1) RETURNING a", 1, &prefix,
+                                 &row_template));
+  // Unterminated
+  EXPECT_FALSE(ParseInsertValues("INSERT INTO t VALUES ($1", 1, &prefix, &row_template));
+  // Parameters that aren't bound
+  EXPECT_FALSE(ParseInsertValues("INSERT INTO t VALUES ($0)", 1, &prefix, &row_template));
+  EXPECT_FALSE(
+      ParseInsertValues("INSERT INTO t VALUES ($1, $3)", 2, &prefix, &row_template));
+}
+
+TEST(NetezzaSqlTest, AppendCivilDate) {
+  auto civil = [](int64_t days) {
+    std::string out;
+    AppendCivilDate(days, &out);
+    return out;
+  };
+  EXPECT_EQ("1970-01-01", civil(0));
+  EXPECT_EQ("1970-01-02", civil(1));
+  EXPECT_EQ("1969-12-31", civil(-1));
+  EXPECT_EQ("2000-02-29", civil(11016));
+  EXPECT_EQ("2000-03-01", civil(11017));
+  EXPECT_EQ("1900-03-01", civil(-25508));
+  EXPECT_EQ("1900-01-01", civil(-25567));
+  EXPECT_EQ("0001-01-01", civil(-719162));
+  EXPECT_EQ("9999-12-31", civil(2932896));
+}
+
+/// Render every row of a single-column batch with AppendLiteral
+class NetezzaLiteralTest : public ::testing::Test {
+ protected:
+  template <typename T>
+  void Render(ArrowType type, const std::vector<std::optional<T>>& values) {
+    schema_.reset();
+    array_.reset();
+    ASSERT_EQ(adbc_validation::MakeSchema(schema_.get(), {{"col", type}}), 0);
+    ASSERT_EQ(adbc_validation::MakeBatch<T>(schema_.get(), array_.get(), &error_, values),
+              0);
+    ASSERT_NO_FATAL_FAILURE(RenderAll());
+  }
+
+  void RenderAll() {
+    view_.reset();
+    ASSERT_EQ(ArrowSchemaViewInit(&field_, schema_->children[0], &error_), 0);
+    ASSERT_EQ(ArrowArrayViewInitFromSchema(view_.get(), schema_.get(), &error_), 0);
+    ASSERT_EQ(ArrowArrayViewSetArray(view_.get(), array_.get(), &error_), 0);
+    literals_.clear();
+    statuses_.clear();
+    for (int64_t row = 0; row < array_->length; row++) {
+      std::string out;
+      statuses_.push_back(AppendLiteral(view_->children[0], field_, row, &out, &error_));
+      literals_.push_back(out);
+    }
+  }
+
+  nanoarrow::UniqueSchema schema_;
+  nanoarrow::UniqueArray array_;
+  nanoarrow::UniqueArrayView view_;
+  struct ArrowSchemaView field_;
+  struct ArrowError error_ = {};
+  std::vector<std::string> literals_;
+  std::vector<int> statuses_;
+};
+
+TEST_F(NetezzaLiteralTest, Integers) {
+  ASSERT_NO_FATAL_FAILURE(Render<int64_t>(
+      NANOARROW_TYPE_INT16, {std::numeric_limits<int16_t>::min(),
+                             std::numeric_limits<int16_t>::max(), -1, std::nullopt}));
+  EXPECT_EQ(std::vector<std::string>({"CAST(-32768 AS INT2)", "CAST(32767 AS INT2)",
+                                      "CAST(-1 AS INT2)", "CAST(NULL AS INT2)"}),
+            literals_);
+
+  ASSERT_NO_FATAL_FAILURE(Render<int64_t>(
+      NANOARROW_TYPE_INT32,
+      {std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()}));
+  EXPECT_EQ(std::vector<std::string>(
+                {"CAST(-2147483648 AS INT4)", "CAST(2147483647 AS INT4)"}),
+            literals_);
+
+  ASSERT_NO_FATAL_FAILURE(Render<int64_t>(
+      NANOARROW_TYPE_INT64,
+      {std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), 0,
+       std::nullopt}));
+  EXPECT_EQ(std::vector<std::string>({"CAST(-9223372036854775808 AS INT8)",
+                                      "CAST(9223372036854775807 AS INT8)",
+                                      "CAST(0 AS INT8)", "CAST(NULL AS INT8)"}),
+            literals_);
+
+  ASSERT_NO_FATAL_FAILURE(Render<int64_t>(NANOARROW_TYPE_INT8, {-128, 127}));
+  EXPECT_EQ(std::vector<std::string>({"CAST(-128 AS INT2)", "CAST(127 AS INT2)"}),
+            literals_);
+}
+
+TEST_F(NetezzaLiteralTest, BooleansAndFloats) {
+  ASSERT_NO_FATAL_FAILURE(
+      Render<bool>(NANOARROW_TYPE_BOOL, {true, false, std::nullopt}));
+  EXPECT_EQ(std::vector<std::string>({"CAST(TRUE AS BOOLEAN)", "CAST(FALSE AS BOOLEAN)",
+                                      "CAST(NULL AS BOOLEAN)"}),
+            literals_);
+
+  ASSERT_NO_FATAL_FAILURE(Render<double>(
+      NANOARROW_TYPE_DOUBLE,
+      {-1.5, 0.1, std::numeric_limits<double>::quiet_NaN(),
+       -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+       std::nullopt}));
+  EXPECT_EQ(std::vector<std::string>(
+                {"CAST(-1.5 AS FLOAT8)", "CAST(0.10000000000000001 AS FLOAT8)",
+                 "CAST('NaN' AS FLOAT8)", "CAST('-Infinity' AS FLOAT8)",
+                 "CAST('Infinity' AS FLOAT8)", "CAST(NULL AS FLOAT8)"}),
+            literals_);
+
+  ASSERT_NO_FATAL_FAILURE(Render<float>(NANOARROW_TYPE_FLOAT, {-2.25f}));
+  EXPECT_EQ(std::vector<std::string>({"CAST(-2.25 AS FLOAT4)"}), literals_);
+}
+
+TEST_F(NetezzaLiteralTest, StringsAndBinary) {
+  ASSERT_NO_FATAL_FAILURE(Render<std::string>(
+      NANOARROW_TYPE_STRING, {"plain", "it's", "''", "", std::nullopt}));
+  EXPECT_EQ(std::vector<std::string>({"'plain'", "'it''s'", "''''''", "''", "NULL"}),
+            literals_);
+
+  ASSERT_NO_FATAL_FAILURE(
+      Render<std::string>(NANOARROW_TYPE_STRING, {std::string("a\0b", 3)}));
+  EXPECT_EQ(EINVAL, statuses_[0]);
+  EXPECT_NE(nullptr, std::strstr(error_.message, "NUL byte"));
+
+  ASSERT_NO_FATAL_FAILURE(Render<std::vector<std::byte>>(
+      NANOARROW_TYPE_BINARY,
+      {std::vector<std::byte>{std::byte{0x00}, std::byte{0xAB}, std::byte{0xFF}},
+       std::nullopt}));
+  EXPECT_EQ(std::vector<std::string>({"X'00ABFF'", "NULL"}), literals_);
+}
+
+TEST_F(NetezzaLiteralTest, Dates) {
+  ASSERT_NO_FATAL_FAILURE(
+      Render<int32_t>(NANOARROW_TYPE_DATE32, {0, -1, -25567, 11016, std::nullopt}));
+  EXPECT_EQ(std::vector<std::string>(
+                {"CAST('1970-01-01' AS DATE)", "CAST('1969-12-31' AS DATE)",
+                 "CAST('1900-01-01' AS DATE)", "CAST('2000-02-29' AS DATE)",
+                 "CAST(NULL AS DATE)"}),
+            literals_);
+}
+
+TEST_F(NetezzaLiteralTest, Timestamps) {
+  ASSERT_EQ(ArrowSchemaInitFromType(schema_.get(), NANOARROW_TYPE_STRUCT), 0);
+  ASSERT_EQ(ArrowSchemaAllocateChildren(schema_.get(), 1), 0);
+  ArrowSchemaInit(schema_->children[0]);
+  ASSERT_EQ(ArrowSchemaSetTypeDateTime(schema_->children[0], NANOARROW_TYPE_TIMESTAMP,
+                                       NANOARROW_TIME_UNIT_MICRO, nullptr),
+            0);
+  ASSERT_EQ(ArrowSchemaSetName(schema_->children[0], "ts"), 0);
+  ASSERT_EQ(adbc_validation::MakeBatch<int64_t>(
+                schema_.get(), array_.get(), &error_,
+                {0, -1, 951782400123456, -2208988800000000, std::nullopt}),
+            0);
+  ASSERT_NO_FATAL_FAILURE(RenderAll());
+  EXPECT_EQ(std::vector<std::string>(
+                {"CAST('1970-01-01 00:00:00.000000' AS TIMESTAMP)",
+                 "CAST('1969-12-31 23:59:59.999999' AS TIMESTAMP)",
+                 "CAST('2000-02-29 00:00:00.123456' AS TIMESTAMP)",
+                 "CAST('1900-01-01 00:00:00.000000' AS TIMESTAMP)",
+                 "CAST(NULL AS TIMESTAMP)"}),
+            literals_);
+
+  // Seconds that don't fit in microseconds
+  schema_.reset();
+  array_.reset();
+  ASSERT_EQ(ArrowSchemaInitFromType(schema_.get(), NANOARROW_TYPE_STRUCT), 0);
+  ASSERT_EQ(ArrowSchemaAllocateChildren(schema_.get(), 1), 0);
+  ArrowSchemaInit(schema_->children[0]);
+  ASSERT_EQ(ArrowSchemaSetTypeDateTime(schema_->children[0], NANOARROW_TYPE_TIMESTAMP,
+                                       NANOARROW_TIME_UNIT_SECOND, nullptr),
+            0);
+  ASSERT_EQ(ArrowSchemaSetName(schema_->children[0], "ts"), 0);
+  ASSERT_EQ(
+      adbc_validation::MakeBatch<int64_t>(schema_.get(), array_.get(), &error_,
+                                          {-1, std::numeric_limits<int64_t>::min()}),
+      0);
+  ASSERT_NO_FATAL_FAILURE(RenderAll());
+  EXPECT_EQ("CAST('1969-12-31 23:59:59.000000' AS TIMESTAMP)", literals_[0]);
+  EXPECT_EQ(ERANGE, statuses_[1]);
+  EXPECT_NE(nullptr, std::strstr(error_.message, "exceeds Netezza timestamp limits"));
+}
+
+class NetezzaInsertBatchesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(adbc_validation::MakeSchema(schema_.get(), {{"a", NANOARROW_TYPE_INT32},
+                                                          {"b", NANOARROW_TYPE_STRING}}),
+              0);
+    fields_.resize(2);
+    for (int i = 0; i < 2; i++) {
+      ASSERT_EQ(ArrowSchemaViewInit(&fields_[i], schema_->children[i], &error_), 0);
+    }
+    ASSERT_TRUE(ParseInsertValues("INSERT INTO t VALUES ($1, upper($2))", 2, &prefix_,
+                                  &row_template_));
+  }
+
+  void MakeStream(std::vector<std::vector<std::optional<int32_t>>> a,
+                  std::vector<std::vector<std::optional<std::string>>> b) {
+    std::vector<struct ArrowArray> batches(a.size());
+    for (size_t i = 0; i < a.size(); i++) {
+      int status = adbc_validation::MakeBatch<int32_t, std::string>(
+          schema_.get(), &batches[i], &error_, a[i], b[i]);
+      ASSERT_EQ(status, 0);
+    }
+    nanoarrow::UniqueSchema schema;
+    ASSERT_EQ(ArrowSchemaDeepCopy(schema_.get(), schema.get()), 0);
+    stream_.reset();
+    adbc_validation::MakeStream(stream_.get(), schema.get(), std::move(batches));
+  }
+
+  int Render(int64_t batch_size_hint_bytes) {
+    statements_.clear();
+    rows_.clear();
+    return RenderInsertBatches(
+        stream_.get(), schema_.get(), fields_, prefix_, row_template_,
+        batch_size_hint_bytes,
+        [&](const std::string& sql, int64_t num_rows) {
+          statements_.push_back(sql);
+          rows_.push_back(num_rows);
+          return fail_execute_ ? EIO : NANOARROW_OK;
+        },
+        &error_);
+  }
+
+  nanoarrow::UniqueSchema schema_;
+  nanoarrow::UniqueArrayStream stream_;
+  std::vector<struct ArrowSchemaView> fields_;
+  std::string prefix_;
+  std::vector<RowTemplatePart> row_template_;
+  struct ArrowError error_ = {};
+  bool fail_execute_ = false;
+  std::vector<std::string> statements_;
+  std::vector<int64_t> rows_;
+};
+
+TEST_F(NetezzaInsertBatchesTest, SingleChunk) {
+  ASSERT_NO_FATAL_FAILURE(
+      MakeStream({{1, std::nullopt}, {std::numeric_limits<int32_t>::min()}},
+                 {{"x", "y'z"}, {std::nullopt}}));
+  ASSERT_EQ(Render(/*batch_size_hint_bytes=*/1 << 20), 0) << error_.message;
+  ASSERT_EQ(1, statements_.size());
+  EXPECT_EQ(
+      "INSERT INTO t SELECT CAST(1 AS INT4), upper('x') UNION ALL SELECT CAST(NULL AS "
+      "INT4), upper('y''z') UNION ALL SELECT CAST(-2147483648 AS INT4), upper(NULL)",
+      statements_[0]);
+  EXPECT_EQ(std::vector<int64_t>({3}), rows_);
+}
+
+TEST_F(NetezzaInsertBatchesTest, ChunksAtHint) {
+  ASSERT_NO_FATAL_FAILURE(MakeStream({{1, 2, 3}, {4, 5}}, {{"a", "b", "c"}, {"d", "e"}}));
+  // Each chunk is sent once it reaches the hint, including across batches
+  const std::string one_row = "INSERT INTO t SELECT CAST(1 AS INT4), upper('a')";
+  ASSERT_EQ(Render(/*batch_size_hint_bytes=*/one_row.size() + 1), 0) << error_.message;
+  ASSERT_EQ(3, statements_.size());
+  EXPECT_EQ(one_row + " UNION ALL SELECT CAST(2 AS INT4), upper('b')", statements_[0]);
+  EXPECT_EQ(
+      "INSERT INTO t SELECT CAST(3 AS INT4), upper('c') UNION ALL SELECT CAST(4 AS "
+      "INT4), upper('d')",
+      statements_[1]);
+  EXPECT_EQ("INSERT INTO t SELECT CAST(5 AS INT4), upper('e')", statements_[2]);
+  EXPECT_EQ(std::vector<int64_t>({2, 2, 1}), rows_);
+}
+
+TEST_F(NetezzaInsertBatchesTest, EmptyStream) {
+  ASSERT_NO_FATAL_FAILURE(MakeStream({}, {}));
+  ASSERT_EQ(Render(/*batch_size_hint_bytes=*/1024), 0) << error_.message;
+  EXPECT_TRUE(statements_.empty());
+}
+
+TEST_F(NetezzaInsertBatchesTest, Errors) {
+  ASSERT_NO_FATAL_FAILURE(MakeStream({{1, 2}}, {{"a", std::string("b\0", 2)}}));
+  ASSERT_EQ(EINVAL, Render(/*batch_size_hint_bytes=*/1024));
+  EXPECT_NE(nullptr, std::strstr(error_.message, "Field #2 ('b') Row #2 contains a NUL"))
+      << error_.message;
+  EXPECT_TRUE(statements_.empty());
+
+  ASSERT_NO_FATAL_FAILURE(MakeStream({{1}}, {{"a"}}));
+  fail_execute_ = true;
+  ASSERT_EQ(EIO, Render(/*batch_size_hint_bytes=*/1024));
+  EXPECT_EQ(1, statements_.size());
+}
+
+}  // namespace adbcpq
@@ -536,6 +536,74 @@ TEST_F(PostgresConnectionTest, GetObjectsGetAllFindsForeignKey) {
   }
 }
 
+TEST_F(PostgresConnectionTest, GetObjectsColumnFilterConstraints) {
+  ASSERT_THAT(AdbcConnectionNew(&connection, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error), IsOkStatus(&error));
+
+  ASSERT_THAT(quirks()->DropTable(&connection, "adbc_constraint_filter_test", &error),
+              IsOkStatus(&error));
+
+  {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement.value,
+                    "CREATE TABLE adbc_constraint_filter_test (a INT, b INT, c INT, "
+                    "CONSTRAINT adbc_cf_pkey PRIMARY KEY (a, b), "
+                    "CONSTRAINT adbc_cf_unique UNIQUE (c))",
+                    &error),
+                IsOkStatus(&error));
+    int64_t rows_affected = 0;
+    ASSERT_THAT(
+        AdbcStatementExecuteQuery(&statement.value, nullptr, &rows_affected, &error),
+        IsOkStatus(&error));
+  }
+
+  struct FilterCase {
+    const char* column_name;
+    int64_t n_columns;
+    const char* constraint_name;
+    int64_t n_constraint_columns;
+  };
+  // The filter selects constraints by the columns they apply to (not by
+  // constraint name), and a matching constraint lists all of its columns
+  for (const auto& filter : std::vector<FilterCase>{{"b", 1, "adbc_cf_pkey", 2},
+                                                    {"c", 1, "adbc_cf_unique", 1},
+                                                    {"adbc_cf%", 0, nullptr, 0}}) {
+    SCOPED_TRACE(filter.column_name);
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcConnectionGetObjects(&connection, ADBC_OBJECT_DEPTH_ALL, nullptr,
+                                         nullptr, "adbc_constraint_filter_test", nullptr,
+                                         filter.column_name, &reader.stream.value,
+                                         &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_NE(nullptr, reader.array->release);
+
+    auto get_objects_data = adbc_validation::GetObjectsReader{&reader.array_view.value};
+    ASSERT_NE(*get_objects_data, nullptr)
+        << "could not initialize the AdbcGetObjectsData object";
+
+    struct AdbcGetObjectsTable* table = AdbcGetObjectsDataGetTableByName(
+        *get_objects_data, "postgres", "public", "adbc_constraint_filter_test");
+    ASSERT_NE(table, nullptr) << "could not find adbc_constraint_filter_test table";
+    ASSERT_EQ(table->n_table_columns, filter.n_columns);
+
+    if (filter.constraint_name == nullptr) {
+      ASSERT_EQ(table->n_table_constraints, 0);
+      continue;
+    }
+    ASSERT_EQ(table->n_table_constraints, 1);
+    struct AdbcGetObjectsConstraint* constraint = AdbcGetObjectsDataGetConstraintByName(
+        *get_objects_data, "postgres", "public", "adbc_constraint_filter_test",
+        filter.constraint_name);
+    ASSERT_NE(constraint, nullptr) << "could not find " << filter.constraint_name;
+    ASSERT_EQ(constraint->n_column_names, filter.n_constraint_columns);
+  }
+}
+
 TEST_F(PostgresConnectionTest, GetObjectsTableTypesFilter) {
   ASSERT_THAT(AdbcConnectionNew(&connection, &error), IsOkStatus(&error));
   ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error), IsOkStatus(&error));
@@ -1096,7 +1164,7 @@ TEST_F(PostgresStatementTest, SqlIngestTimestampOverflow) {
                 IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
     ASSERT_THAT(error.message,
                 ::testing::HasSubstr("Row #1 has value '9223372036854775807' which "
-                                     "exceeds PostgreSQL timestamp limits"));
+                                     "exceeds Netezza timestamp limits"));
   }
 
   {
@@ -1126,7 +1194,7 @@ TEST_F(PostgresStatementTest, SqlIngestTimestampOverflow) {
                 IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
     ASSERT_THAT(error.message,
                 ::testing::HasSubstr("Row #1 has value '-9223372036854775808' which "
-                                     "exceeds PostgreSQL timestamp limits"));
+                                     "exceeds Netezza timestamp limits"));
   }
 }
 
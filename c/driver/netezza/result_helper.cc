@@ -15,10 +15,10 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#include "result_helper.h"
+#include "libpq_common/result_helper.h"
 
 #include "common/utils.h"
-#include "error.h"
+#include "libpq_common/error.h"
 
 namespace adbcpq {
 
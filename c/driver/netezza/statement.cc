@@ -20,10 +20,13 @@
 
 #include "statement.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cctype>
 #include <cerrno>
 #include <cinttypes>
+#include <cmath>
 #include <cstring>
 #include <iostream>
 #include <limits>
@@ -38,20 +41,19 @@
 #include "common/options.h"
 #include "common/utils.h"
 #include "connection.h"
-#include "error.h"
+#include "libpq_common/error.h"
+#include "libpq_common/pq_bind_stream.h"
+#include "libpq_common/pq_util.h"
+#include "libpq_common/result_helper.h"
 #include "netezza_copy_reader.h"
+#include "netezza_sql.h"
 #include "netezza_type.h"
-#include "netezza_util.h"
-#include "result_helper.h"
 #include <string>
 #include <bits/stdc++.h>
 
 namespace adbcpq {
 
 namespace {
-/// The flag indicating to PostgreSQL that we want binary-format values.
-constexpr int kPgBinaryFormat = 1;
-
 /// One-value ArrowArrayStream used to unify the implementations of Bind
 struct OneValueStream {
   struct ArrowSchema schema;
@@ -107,529 +109,138 @@ AdbcStatusCode ResolveNetezzaType(const NetezzaTypeResolver& type_resolver,
   return ADBC_STATUS_OK;
 }
 
-/// Helper to manage bind parameters with a prepared statement
-struct BindStream {
-  Handle<struct ArrowArrayStream> bind;
-  Handle<struct ArrowSchema> bind_schema;
-  struct ArrowSchemaView bind_schema_view;
-  std::vector<struct ArrowSchemaView> bind_schema_fields;
-
-  // OIDs for parameter types
-  std::vector<uint32_t> param_types;
-  std::vector<char*> param_values;
-  std::vector<int> param_lengths;
-  std::vector<int> param_formats;
-  std::vector<size_t> param_values_offsets;
-  std::vector<char> param_values_buffer;
-  // XXX: this assumes fixed-length fields only - will need more
-  // consideration to deal with variable-length fields
-
-  bool has_tz_field = false;
-  std::string tz_setting;
-
-  struct ArrowError na_error;
-
-  explicit BindStream(struct ArrowArrayStream&& bind) {
-    this->bind.value = std::move(bind);
-    std::memset(&na_error, 0, sizeof(na_error));
+/// Hooks that specialize the shared bind parameter helper for Netezza.
+///
+/// Netezza reports PGRES_TUPLES_OK for a successful PQprepare, and executes
+/// the unnamed statement through PQexecParams with no parameter types.
+struct NetezzaBindDialect {
+  using CopyDialect = NetezzaCopyDialect;
+  using TypeResolver = NetezzaTypeResolver;
+  using TypeId = NetezzaTypeId;
+
+  static constexpr ExecStatusType kPrepareStatus = PGRES_TUPLES_OK;
+
+  static PGresult* ExecPrepared(PGconn* conn, int n_params, const char* const* values,
+                                const int* lengths, const int* formats) {
+    return PQexecParams(conn, /*query=*/"", n_params, /*paramTypes=*/nullptr, values,
+                        lengths, formats, /*resultFormat=*/0 /*text*/);
   }
 
-  template <typename Callback>
-  AdbcStatusCode Begin(Callback&& callback, struct AdbcError* error) {
-    CHECK_NA(INTERNAL, bind->get_schema(&bind.value, &bind_schema.value), error);
-    CHECK_NA(
-        INTERNAL,
-        ArrowSchemaViewInit(&bind_schema_view, &bind_schema.value, /*error*/ nullptr),
-        error);
-
-    if (bind_schema_view.type != ArrowType::NANOARROW_TYPE_STRUCT) {
-      SetError(error, "%s", "[libpq] Bind parameters must have type STRUCT");
-      return ADBC_STATUS_INVALID_STATE;
-    }
-
-    bind_schema_fields.resize(bind_schema->n_children);
-    for (size_t i = 0; i < bind_schema_fields.size(); i++) {
-      CHECK_NA(INTERNAL,
-               ArrowSchemaViewInit(&bind_schema_fields[i], bind_schema->children[i],
-                                   /*error*/ nullptr),
-               error);
-    }
-
-    return std::move(callback)();
+  // COPY data is framed by hand with PQputnbytes
+  static int PutCopyData(PGconn* conn, const char* data, int size) {
+    return PQputnbytes(conn, data, size);
   }
 
-  AdbcStatusCode SetParamTypes(const NetezzaTypeResolver& type_resolver,
-                               struct AdbcError* error) {
-    param_types.resize(bind_schema->n_children);
-    param_values.resize(bind_schema->n_children);
-    param_lengths.resize(bind_schema->n_children);
-    param_formats.resize(bind_schema->n_children, kPgBinaryFormat);
-    param_values_offsets.reserve(bind_schema->n_children);
+  static int PutCopyEnd(PGconn* conn) { return PQputnbytes(conn, NULL, 0); }
+};
+
+/// Helper to manage bind parameters with a prepared statement, plus the
+/// multi-row INSERT path that renders parameters as literals
+struct BindStream : public PqBindStream<NetezzaBindDialect> {
+  using PqBindStream<NetezzaBindDialect>::PqBindStream;
 
-    for (size_t i = 0; i < bind_schema_fields.size(); i++) {
-      NetezzaTypeId type_id;
-      switch (bind_schema_fields[i].type) {
+  /// Whether every bound column can be rendered as a SQL literal
+  bool CanRenderLiterals() const {
+    for (const auto& field : bind_schema_fields) {
+      switch (field.type) {
         case ArrowType::NANOARROW_TYPE_BOOL:
-          type_id = NetezzaTypeId::kBool;
-          param_lengths[i] = 1;
-          break;
         case ArrowType::NANOARROW_TYPE_INT8:
         case ArrowType::NANOARROW_TYPE_INT16:
-          type_id = NetezzaTypeId::kInt2;
-          param_lengths[i] = 2;
-          break;
         case ArrowType::NANOARROW_TYPE_INT32:
-          type_id = NetezzaTypeId::kInt4;
-          param_lengths[i] = 4;
-          break;
         case ArrowType::NANOARROW_TYPE_INT64:
-          type_id = NetezzaTypeId::kInt8;
-          param_lengths[i] = 8;
-          break;
         case ArrowType::NANOARROW_TYPE_FLOAT:
-          type_id = NetezzaTypeId::kFloat4;
-          param_lengths[i] = 4;
-          break;
         case ArrowType::NANOARROW_TYPE_DOUBLE:
-          type_id = NetezzaTypeId::kFloat8;
-          param_lengths[i] = 8;
-          break;
         case ArrowType::NANOARROW_TYPE_STRING:
         case ArrowType::NANOARROW_TYPE_LARGE_STRING:
-          type_id = NetezzaTypeId::kText;
-          param_lengths[i] = 0;
-          break;
         case ArrowType::NANOARROW_TYPE_BINARY:
-          type_id = NetezzaTypeId::kBytea;
-          param_lengths[i] = 0;
-          break;
         case ArrowType::NANOARROW_TYPE_DATE32:
-          type_id = NetezzaTypeId::kDate;
-          param_lengths[i] = 4;
-          break;
         case ArrowType::NANOARROW_TYPE_TIMESTAMP:
-          type_id = NetezzaTypeId::kTimestamp;
-          param_lengths[i] = 8;
-          break;
-        case ArrowType::NANOARROW_TYPE_DURATION:
-        case ArrowType::NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO:
-          type_id = NetezzaTypeId::kInterval;
-          param_lengths[i] = 16;
           break;
-        case ArrowType::NANOARROW_TYPE_DICTIONARY: {
-          struct ArrowSchemaView value_view;
-          CHECK_NA(INTERNAL,
-                   ArrowSchemaViewInit(&value_view, bind_schema->children[i]->dictionary,
-                                       nullptr),
-                   error);
-          switch (value_view.type) {
-            case NANOARROW_TYPE_BINARY:
-            case NANOARROW_TYPE_LARGE_BINARY:
-              type_id = NetezzaTypeId::kBytea;
-              param_lengths[i] = 0;
-              break;
-            case NANOARROW_TYPE_STRING:
-            case NANOARROW_TYPE_LARGE_STRING:
-              type_id = NetezzaTypeId::kText;
-              param_lengths[i] = 0;
-              break;
-            default:
-              SetError(error, "%s%" PRIu64 "%s%s%s%s", "[libpq] Field #",
-                       static_cast<uint64_t>(i + 1), " ('",
-                       bind_schema->children[i]->name,
-                       "') has unsupported dictionary value parameter type ",
-                       ArrowTypeString(value_view.type));
-              return ADBC_STATUS_NOT_IMPLEMENTED;
-          }
-          break;
-        }
         default:
-          SetError(error, "%s%" PRIu64 "%s%s%s%s", "[libpq] Field #",
-                   static_cast<uint64_t>(i + 1), " ('", bind_schema->children[i]->name,
-                   "') has unsupported parameter type ",
-                   ArrowTypeString(bind_schema_fields[i].type));
-          return ADBC_STATUS_NOT_IMPLEMENTED;
-      }
-
-      param_types[i] = type_resolver.GetOID(type_id);
-      if (param_types[i] == 0) {
-        SetError(error, "%s%" PRIu64 "%s%s%s%s", "[libpq] Field #",
-                 static_cast<uint64_t>(i + 1), " ('", bind_schema->children[i]->name,
-                 "') has type with no corresponding PostgreSQL type ",
-                 ArrowTypeString(bind_schema_fields[i].type));
-        return ADBC_STATUS_NOT_IMPLEMENTED;
+          return false;
       }
     }
-
-    size_t param_values_length = 0;
-    for (int length : param_lengths) {
-      param_values_offsets.push_back(param_values_length);
-      param_values_length += length;
-    }
-    param_values_buffer.resize(param_values_length);
-    return ADBC_STATUS_OK;
+    return true;
   }
 
-  AdbcStatusCode Prepare(PGconn* conn, const std::string& query, struct AdbcError* error,
-                         const bool autocommit) {
-    // tz-aware timestamps require special handling to set the timezone to UTC
-    // prior to sending over the binary protocol; must be reset after execute
-    for (int64_t col = 0; col < bind_schema->n_children; col++) {
-      if ((bind_schema_fields[col].type == ArrowType::NANOARROW_TYPE_TIMESTAMP) &&
-          (strcmp("", bind_schema_fields[col].timezone))) {
-        has_tz_field = true;
-
-        if (autocommit) {
-          PGresult* begin_result = PQexec(conn, "BEGIN");
-          if (PQresultStatus(begin_result) != PGRES_COMMAND_OK) {
-            AdbcStatusCode code =
-                SetError(error, begin_result,
-                         "[libpq] Failed to begin transaction for timezone data: %s",
-                         PQerrorMessage(conn));
-            PQclear(begin_result);
-            return code;
-          }
-          PQclear(begin_result);
-        }
-
-        PGresult* get_tz_result = PQexec(conn, "SELECT current_setting('TIMEZONE')");
-        if (PQresultStatus(get_tz_result) != PGRES_TUPLES_OK) {
-          AdbcStatusCode code = SetError(error, get_tz_result,
-                                         "[libpq] Could not query current timezone: %s",
-                                         PQerrorMessage(conn));
-          PQclear(get_tz_result);
-          return code;
-        }
-
-        tz_setting = std::string(PQgetvalue(get_tz_result, 0, 0));
-        PQclear(get_tz_result);
-
-        PGresult* set_utc_result = PQexec(conn, "SET TIME ZONE 'UTC'");
-        if (PQresultStatus(set_utc_result) != PGRES_COMMAND_OK) {
-          AdbcStatusCode code = SetError(error, set_utc_result,
-                                         "[libpq] Failed to set time zone to UTC: %s",
-                                         PQerrorMessage(conn));
-          PQclear(set_utc_result);
-          return code;
-        }
-        PQclear(set_utc_result);
-        break;
-      }
-    }
-
-    PGresult* result = PQprepare(conn, /*stmtName=*/"", query.c_str(),
-                                 /*nParams=*/bind_schema->n_children, param_types.data());
-    if (PQresultStatus(result) != PGRES_TUPLES_OK) {
-      AdbcStatusCode code =
-          SetError(error, result, "[libpq] Failed to prepare query: %s\nQuery was:%s",
-                   PQerrorMessage(conn), query.c_str());
-      PQclear(result);
-      return code;
-    }
-    PQclear(result);
-    return ADBC_STATUS_OK;
-  }
-
-  AdbcStatusCode Execute(PGconn* conn, int64_t* rows_affected, struct AdbcError* error) {
+  /// \brief Execute an INSERT for all bound rows, many rows per statement.
+  ///
+  /// See RenderInsertBatches.
+  AdbcStatusCode ExecuteInsertBatches(PGconn* conn, const std::string& insert_prefix,
+                                      const std::vector<RowTemplatePart>& row_template,
+                                      int64_t batch_size_hint_bytes,
+                                      int64_t* rows_affected, struct AdbcError* error) {
     if (rows_affected) *rows_affected = 0;
-    PGresult* result = nullptr;
-
-    while (true) {
-      Handle<struct ArrowArray> array;
-      int res = bind->get_next(&bind.value, &array.value);
-      if (res != 0) {
-        SetError(error,
-                 "[libpq] Failed to read next batch from stream of bind parameters: "
-                 "(%d) %s %s",
-                 res, std::strerror(res), bind->get_last_error(&bind.value));
-        return ADBC_STATUS_IO;
-      }
-      if (!array->release) break;
-
-      Handle<struct ArrowArrayView> array_view;
-      // TODO: include error messages
-      CHECK_NA(
-          INTERNAL,
-          ArrowArrayViewInitFromSchema(&array_view.value, &bind_schema.value, nullptr),
-          error);
-      CHECK_NA(INTERNAL, ArrowArrayViewSetArray(&array_view.value, &array.value, nullptr),
-               error);
-
-      for (int64_t row = 0; row < array->length; row++) {
-        for (int64_t col = 0; col < array_view->n_children; col++) {
-          if (ArrowArrayViewIsNull(array_view->children[col], row)) {
-            param_values[col] = nullptr;
-            continue;
-          } else {
-            param_values[col] = param_values_buffer.data() + param_values_offsets[col];
-          }
-          switch (bind_schema_fields[col].type) {
-            case ArrowType::NANOARROW_TYPE_BOOL: {
-              const int8_t val = ArrowBitGet(
-                  array_view->children[col]->buffer_views[1].data.as_uint8, row);
-              std::memcpy(param_values[col], &val, sizeof(int8_t));
-              break;
-            }
-
-            case ArrowType::NANOARROW_TYPE_INT8: {
-              const int16_t val =
-                  array_view->children[col]->buffer_views[1].data.as_int8[row];
-              const uint16_t value = ToNetworkInt16(val);
-              std::memcpy(param_values[col], &value, sizeof(int16_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_INT16: {
-              const uint16_t value = ToNetworkInt16(
-                  array_view->children[col]->buffer_views[1].data.as_int16[row]);
-              std::memcpy(param_values[col], &value, sizeof(int16_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_INT32: {
-              const uint32_t value = ToNetworkInt32(
-                  array_view->children[col]->buffer_views[1].data.as_int32[row]);
-              std::memcpy(param_values[col], &value, sizeof(int32_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_INT64: {
-              const int64_t value = ToNetworkInt64(
-                  array_view->children[col]->buffer_views[1].data.as_int64[row]);
-              std::memcpy(param_values[col], &value, sizeof(int64_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_FLOAT: {
-              const uint32_t value = ToNetworkFloat4(
-                  array_view->children[col]->buffer_views[1].data.as_float[row]);
-              std::memcpy(param_values[col], &value, sizeof(uint32_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_DOUBLE: {
-              const uint64_t value = ToNetworkFloat8(
-                  array_view->children[col]->buffer_views[1].data.as_double[row]);
-              std::memcpy(param_values[col], &value, sizeof(uint64_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_STRING:
-            case ArrowType::NANOARROW_TYPE_LARGE_STRING:
-            case ArrowType::NANOARROW_TYPE_BINARY: {
-              const ArrowBufferView view =
-                  ArrowArrayViewGetBytesUnsafe(array_view->children[col], row);
-              // TODO: overflow check?
-              param_lengths[col] = static_cast<int>(view.size_bytes);
-              param_values[col] = const_cast<char*>(view.data.as_char);
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_DATE32: {
-              // 2000-01-01
-              constexpr int32_t kNetezzaDateEpoch = 10957;
-              const int32_t raw_value =
-                  array_view->children[col]->buffer_views[1].data.as_int32[row];
-              if (raw_value < INT32_MIN + kNetezzaDateEpoch) {
-                SetError(error, "[libpq] Field #%" PRId64 "%s%s%s%" PRId64 "%s", col + 1,
-                         "('", bind_schema->children[col]->name, "') Row #", row + 1,
-                         "has value which exceeds netezza date limits");
-                return ADBC_STATUS_INVALID_ARGUMENT;
-              }
-
-              const uint32_t value = ToNetworkInt32(raw_value - kNetezzaDateEpoch);
-              std::memcpy(param_values[col], &value, sizeof(int32_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_DURATION:
-            case ArrowType::NANOARROW_TYPE_TIMESTAMP: {
-              int64_t val = array_view->children[col]->buffer_views[1].data.as_int64[row];
-
-              bool overflow_safe = true;
-
-              auto unit = bind_schema_fields[col].time_unit;
-
-              switch (unit) {
-                case NANOARROW_TIME_UNIT_SECOND:
-                  if ((overflow_safe = val <= kMaxSafeSecondsToMicros &&
-                                       val >= kMinSafeSecondsToMicros)) {
-                    val *= 1000000;
-                  }
-
-                  break;
-                case NANOARROW_TIME_UNIT_MILLI:
-                  if ((overflow_safe = val <= kMaxSafeMillisToMicros &&
-                                       val >= kMinSafeMillisToMicros)) {
-                    val *= 1000;
-                  }
-                  break;
-                case NANOARROW_TIME_UNIT_MICRO:
-                  break;
-                case NANOARROW_TIME_UNIT_NANO:
-                  val /= 1000;
-                  break;
-              }
-
-              if (!overflow_safe) {
-                SetError(error,
-                         "[libpq] Field #%" PRId64 " ('%s') Row #%" PRId64
-                         " has value '%" PRIi64
-                         "' which exceeds PostgreSQL timestamp limits",
-                         col + 1, bind_schema->children[col]->name, row + 1,
-                         array_view->children[col]->buffer_views[1].data.as_int64[row]);
-                return ADBC_STATUS_INVALID_ARGUMENT;
-              }
-
-              if (val < std::numeric_limits<int64_t>::min() + kNetezzaTimestampEpoch) {
-                SetError(error,
-                         "[libpq] Field #%" PRId64 " ('%s') Row #%" PRId64
-                         " has value '%" PRIi64 "' which would underflow",
-                         col + 1, bind_schema->children[col]->name, row + 1,
-                         array_view->children[col]->buffer_views[1].data.as_int64[row]);
-                return ADBC_STATUS_INVALID_ARGUMENT;
-              }
-
-              if (bind_schema_fields[col].type == ArrowType::NANOARROW_TYPE_TIMESTAMP) {
-                const uint64_t value = ToNetworkInt64(val - kNetezzaTimestampEpoch);
-                std::memcpy(param_values[col], &value, sizeof(int64_t));
-              } else if (bind_schema_fields[col].type ==
-                         ArrowType::NANOARROW_TYPE_DURATION) {
-                // netezza stores an interval as a 64 bit offset in microsecond
-                // resolution alongside a 32 bit day and 32 bit month
-                // for now we just send 0 for the day / month values
-                const uint64_t value = ToNetworkInt64(val);
-                std::memcpy(param_values[col], &value, sizeof(int64_t));
-                std::memset(param_values[col] + sizeof(int64_t), 0, sizeof(int64_t));
-              }
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO: {
-              struct ArrowInterval interval;
-              ArrowIntervalInit(&interval, NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO);
-              ArrowArrayViewGetIntervalUnsafe(array_view->children[col], row, &interval);
-
-              const uint32_t months = ToNetworkInt32(interval.months);
-              const uint32_t days = ToNetworkInt32(interval.days);
-              const uint64_t ms = ToNetworkInt64(interval.ns / 1000);
-
-              std::memcpy(param_values[col], &ms, sizeof(uint64_t));
-              std::memcpy(param_values[col] + sizeof(uint64_t), &days, sizeof(uint32_t));
-              std::memcpy(param_values[col] + sizeof(uint64_t) + sizeof(uint32_t),
-                          &months, sizeof(uint32_t));
-              break;
-            }
-            default:
-              SetError(error, "%s%" PRId64 "%s%s%s%s", "[libpq] Field #", col + 1, " ('",
-                       bind_schema->children[col]->name,
-                       "') has unsupported type for ingestion ",
-                       ArrowTypeString(bind_schema_fields[col].type));
-              return ADBC_STATUS_NOT_IMPLEMENTED;
-          }
-        }
-
-        result = PQexecParams(conn, /*query=*/"",
-                                /*nParams=*/bind_schema->n_children, nullptr, param_values.data(),
-                                param_lengths.data(), param_formats.data(),
-                                /*resultFormat=*/0 /*text*/);
-
-        ExecStatusType pg_status = PQresultStatus(result);
-        if (pg_status != PGRES_COMMAND_OK) {
-          AdbcStatusCode code = SetError(
-              error, result, "[libpq] Failed to execute prepared statement: %s %s",
-              PQresStatus(pg_status), PQerrorMessage(conn));
-          PQclear(result);
-          return code;
-        }
 
+    AdbcStatusCode exec_status = ADBC_STATUS_OK;
+    auto execute = [&](const std::string& sql, int64_t num_rows) -> ArrowErrorCode {
+      PGresult* result = PQexec(conn, sql.c_str());
+      ExecStatusType pg_status = PQresultStatus(result);
+      if (pg_status != PGRES_COMMAND_OK) {
+        exec_status =
+            SetError(error, result, "[libpq] Failed to execute batched insert: %s %s",
+                     PQresStatus(pg_status), PQerrorMessage(conn));
         PQclear(result);
+        return EIO;
       }
-      if (rows_affected) *rows_affected += array->length;
-
-      if (has_tz_field) {
-        std::string reset_query = "SET TIME ZONE '" + tz_setting + "'";
-        PGresult* reset_tz_result = PQexec(conn, reset_query.c_str());
-        if (PQresultStatus(reset_tz_result) != PGRES_COMMAND_OK) {
-          AdbcStatusCode code =
-              SetError(error, reset_tz_result, "[libpq] Failed to reset time zone: %s",
-                       PQerrorMessage(conn));
-          PQclear(reset_tz_result);
-          return code;
-        }
-        PQclear(reset_tz_result);
-
-        PGresult* commit_result = PQexec(conn, "COMMIT");
-        if (PQresultStatus(commit_result) != PGRES_COMMAND_OK) {
-          AdbcStatusCode code =
-              SetError(error, commit_result, "[libpq] Failed to commit transaction: %s",
-                       PQerrorMessage(conn));
-          PQclear(commit_result);
-          return code;
-        }
-        PQclear(commit_result);
+      PQclear(result);
+      if (rows_affected) *rows_affected += num_rows;
+      return NANOARROW_OK;
+    };
+
+    struct ArrowError na_error;
+    std::memset(&na_error, 0, sizeof(na_error));
+    int status = RenderInsertBatches(&bind.value, &bind_schema.value, bind_schema_fields,
+                                     insert_prefix, row_template, batch_size_hint_bytes,
+                                     execute, &na_error);
+    if (exec_status != ADBC_STATUS_OK) return exec_status;
+    if (status != NANOARROW_OK) {
+      SetError(error, "[libpq] %s", na_error.message);
+      switch (status) {
+        case ENOTSUP:
+          return ADBC_STATUS_NOT_IMPLEMENTED;
+        case EINVAL:
+        case ERANGE:
+          return ADBC_STATUS_INVALID_ARGUMENT;
+        default:
+          return ADBC_STATUS_IO;
       }
     }
     return ADBC_STATUS_OK;
   }
+};
 
-  AdbcStatusCode ExecuteCopy(PGconn* conn, int64_t* rows_affected,
-                             struct AdbcError* error) {
-    if (rows_affected) *rows_affected = 0;
-
-    NetezzaCopyStreamWriter writer;
-    CHECK_NA(INTERNAL, writer.Init(&bind_schema.value), error);
-    CHECK_NA(INTERNAL, writer.InitFieldWriters(nullptr), error);
-
-    CHECK_NA(INTERNAL, writer.WriteHeader(nullptr), error);
-
-    while (true) {
-      Handle<struct ArrowArray> array;
-      int res = bind->get_next(&bind.value, &array.value);
-      if (res != 0) {
-        SetError(error,
-                 "[libpq] Failed to read next batch from stream of bind parameters: "
-                 "(%d) %s %s",
-                 res, std::strerror(res), bind->get_last_error(&bind.value));
-        return ADBC_STATUS_IO;
-      }
-      if (!array->release) break;
-
-      CHECK_NA(INTERNAL, writer.SetArray(&array.value), error);
-
-      // build writer buffer
-      int write_result;
-      do {
-        write_result = writer.WriteRecord(nullptr);
-      } while (write_result == NANOARROW_OK);
-
-      // check if not ENODATA at exit
-      if (write_result != ENODATA) {
-        SetError(error, "Error occurred writing COPY data: %s", PQerrorMessage(conn));
-        return ADBC_STATUS_IO;
-      }
-
-      ArrowBuffer buffer = writer.WriteBuffer();
-      if (PQputnbytes(conn, reinterpret_cast<char*>(buffer.data), buffer.size_bytes) <=
-          0) {
-        SetError(error, "Error writing tuple field data: %s", PQerrorMessage(conn));
-        return ADBC_STATUS_IO;
-      }
-
-      if (rows_affected) *rows_affected += array->length;
-      writer.Rewind();
-    }
-
-    if (PQputnbytes(conn, NULL, 0) <= 0) {
-      SetError(error, "Error message returned by PQputCopyEnd: %s", PQerrorMessage(conn));
-      return ADBC_STATUS_IO;
-    }
-
-    PGresult* result = PQgetResult(conn);
-    ExecStatusType pg_status = PQresultStatus(result);
-    if (pg_status != PGRES_COMMAND_OK) {
-      AdbcStatusCode code =
-          SetError(error, result, "[libpq] Failed to execute COPY statement: %s %s",
-                   PQresStatus(pg_status), PQerrorMessage(conn));
-      PQclear(result);
-      return code;
-    }
-
-    PQclear(result);
-    return ADBC_STATUS_OK;
+/// Header of a serialized partition descriptor. The remainder of the
+/// descriptor is the query restricted to a single data slice.
+constexpr char kPartitionDescriptorPrefix[] = "adbc.netezza.partition.v1\n";
+
+/// Owns the descriptors handed out through AdbcPartitions.
+struct PartitionsData {
+  std::vector<std::string> descriptors;
+  std::vector<const uint8_t*> pointers;
+  std::vector<size_t> lengths;
+
+  static void Release(struct AdbcPartitions* partitions) {
+    delete reinterpret_cast<PartitionsData*>(partitions->private_data);
+    partitions->num_partitions = 0;
+    partitions->partitions = nullptr;
+    partitions->partition_lengths = nullptr;
+    partitions->private_data = nullptr;
+    partitions->release = nullptr;
   }
 };
+
+/// \brief The bytes currently allocated for an array's buffers and children.
+int64_t ArrowArrayAllocatedBytes(struct ArrowArray* array) {
+  int64_t total = 0;
+  for (int64_t i = 0; i < array->n_buffers; i++) {
+    total += ArrowArrayBuffer(array, i)->capacity_bytes;
+  }
+  for (int64_t i = 0; i < array->n_children; i++) {
+    total += ArrowArrayAllocatedBytes(array->children[i]);
+  }
+  return total;
+}
 }  // namespace
 
 int TupleReader::GetSchema(struct ArrowSchema* out) {
@@ -842,17 +453,28 @@ int TupleReader::NZAppendRowAndFetchNext(struct  ArrowError* error) {
 
   InitResultArray(error);
 
-  // Move these vars to a safer place.
-  int batch_size = 1677721;
   int numRows = PQntuples(result_);
   int numCols = PQnfields(result_);
 
+  // Size the batch from the byte budget using the average width of the rows
+  // seen so far, so that wide rows don't produce huge batches and narrow ones
+  // don't over-allocate. The width is measured on the text values, like the
+  // PostgreSQL driver measures the COPY data it consumes.
+  if (rows_read_ > 0 && bytes_read_ > 0) {
+    double average_row_bytes = static_cast<double>(bytes_read_) / rows_read_;
+    int64_t expected_rows = static_cast<int64_t>(std::min<double>(
+        numRows - row_id_, std::ceil(batch_size_hint_bytes_ / average_row_bytes)));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayReserve(&result_array, expected_rows));
+  }
+
+  int64_t batch_bytes = 0;
   char* cell_value;
 
   while (true) {
     if (numRows > 0 && numCols > 0) {
       for (int j = 0; j < numCols; j++) {
         cell_value = PQgetvalue(result_, row_id_, j);
+        batch_bytes += PQgetlength(result_, row_id_, j);
         Oid cell_format = PQftype(result_, j);
         AppendToChildArrayForColumnType(result_array.children[j], cell_value, cell_format);
       }
@@ -865,7 +487,7 @@ int TupleReader::NZAppendRowAndFetchNext(struct  ArrowError* error) {
       break;
     }
 
-    if (result_array.length == batch_size) {
+    if (batch_bytes >= batch_size_hint_bytes_) {
       /* checking if there's anything left, to come back for. */
       if (row_id_ < numRows) {
         is_finished_ = false;
@@ -876,6 +498,10 @@ int TupleReader::NZAppendRowAndFetchNext(struct  ArrowError* error) {
     }
   }
 
+  rows_read_ += result_array.length;
+  bytes_read_ += batch_bytes;
+  peak_batch_bytes_ =
+      std::max(peak_batch_bytes_, ArrowArrayAllocatedBytes(&result_array));
   return NANOARROW_OK;
 }
 
@@ -897,6 +523,9 @@ int TupleReader::GetNext(struct ArrowArray* out) {
   if (row_id_ == -1) {
     NANOARROW_RETURN_NOT_OK(NZInitQueryAndFetchFirst(&error));
     row_id_++;
+    rows_read_ = 0;
+    bytes_read_ = 0;
+    peak_batch_bytes_ = 0;
   }
   
   NZAppendRowAndFetchNext(&error);
@@ -978,6 +607,8 @@ void TupleReader::ReleaseTrampoline(struct ArrowArrayStream* self) {
   if (!self || !self->private_data) return;
 
   TupleReader* reader = static_cast<TupleReader*>(self->private_data);
+  // Destroy the owning statement (if any) only once the reader is unused
+  std::shared_ptr<NetezzaStatement> owner = std::move(reader->owner_);
   reader->Release();
   self->private_data = nullptr;
   self->release = nullptr;
@@ -1256,6 +887,19 @@ AdbcStatusCode NetezzaStatement::ExecutePreparedStatement(
 
   RAISE_ADBC(bind_stream.Begin([&]() { return ADBC_STATUS_OK; }, error));
   RAISE_ADBC(bind_stream.SetParamTypes(*type_resolver_, error));
+
+  // Executing the prepared statement once per row is bound by the round trip
+  // time, so send INSERTs many rows at a time where possible
+  std::string insert_prefix;
+  std::vector<RowTemplatePart> row_template;
+  if (bind_stream.CanRenderLiterals() &&
+      ParseInsertValues(query_, bind_stream.bind_schema->n_children, &insert_prefix,
+                        &row_template)) {
+    return bind_stream.ExecuteInsertBatches(connection_->conn(), insert_prefix,
+                                            row_template, insert_batch_size_hint_bytes_,
+                                            rows_affected, error);
+  }
+
   RAISE_ADBC(
       bind_stream.Prepare(connection_->conn(), query_, error, connection_->autocommit()));
   RAISE_ADBC(bind_stream.Execute(connection_->conn(), rows_affected, error));
@@ -1363,6 +1007,101 @@ AdbcStatusCode NetezzaStatement::ExecuteSchema(struct ArrowSchema* schema,
   return ADBC_STATUS_OK;
 }
 
+AdbcStatusCode NetezzaStatement::ExecutePartitions(struct ArrowSchema* schema,
+                                                    struct AdbcPartitions* partitions,
+                                                    int64_t* rows_affected,
+                                                    struct AdbcError* error) {
+  ClearResult();
+  while (!query_.empty() && query_.back() == ';') {
+    query_.pop_back();
+  }
+  if (query_.empty()) {
+    SetError(error, "%s", "[libpq] Must SetSqlQuery before ExecutePartitions");
+    return ADBC_STATUS_INVALID_STATE;
+  } else if (bind_.release) {
+    SetError(error, "%s", "[libpq] ExecutePartitions with parameters is not implemented");
+    return ADBC_STATUS_NOT_IMPLEMENTED;
+  }
+
+  std::vector<SqlKeyword> keywords = FindTopLevelKeywords(query_);
+  if (keywords.empty() ||
+      (keywords.front().first != "SELECT" && keywords.front().first != "WITH")) {
+    SetError(error, "[libpq] ExecutePartitions requires a SELECT query\nQuery was: %s",
+             query_.c_str());
+    return ADBC_STATUS_NOT_IMPLEMENTED;
+  }
+
+  // Rows are distributed across data slices, so each slice is an independent
+  // partition that can be fetched in parallel over its own connection
+  std::vector<int64_t> slice_ids;
+  {
+    PqResultHelper result_helper{connection_->conn(),
+                                 "SELECT DS_ID FROM _V_DSLICE ORDER BY DS_ID", error};
+    RAISE_ADBC(result_helper.Prepare());
+    RAISE_ADBC(result_helper.Execute());
+    for (PqResultRow row : result_helper) {
+      slice_ids.push_back(std::strtoll(row[0].data, nullptr, 10));
+    }
+  }
+
+  std::unique_ptr<PartitionsData> data(new PartitionsData());
+  data->descriptors.reserve(slice_ids.size());
+  for (int64_t slice_id : slice_ids) {
+    std::string slice_query;
+    if (!RestrictToDataSlice(query_, slice_id, &slice_query)) {
+      // The query can't be evaluated per slice, so read it as a whole
+      data->descriptors.clear();
+      break;
+    }
+    data->descriptors.push_back(kPartitionDescriptorPrefix + slice_query);
+  }
+  if (data->descriptors.empty()) {
+    data->descriptors.push_back(kPartitionDescriptorPrefix + query_);
+  }
+  for (const std::string& descriptor : data->descriptors) {
+    data->pointers.push_back(reinterpret_cast<const uint8_t*>(descriptor.data()));
+    data->lengths.push_back(descriptor.size());
+  }
+
+  RAISE_ADBC(SetupReader(error));
+  CHECK_NA(INTERNAL, reader_.copy_reader_->GetSchema(schema), error);
+  ClearResult();
+
+  partitions->num_partitions = data->descriptors.size();
+  partitions->partitions = data->pointers.data();
+  partitions->partition_lengths = data->lengths.data();
+  partitions->private_data = data.release();
+  partitions->release = &PartitionsData::Release;
+  if (rows_affected) *rows_affected = -1;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NetezzaStatement::ReadPartition(struct AdbcConnection* connection,
+                                                const uint8_t* serialized_partition,
+                                                size_t serialized_length,
+                                                struct ArrowArrayStream* out,
+                                                struct AdbcError* error) {
+  const size_t prefix_length = std::strlen(kPartitionDescriptorPrefix);
+  if (serialized_length < prefix_length ||
+      std::memcmp(serialized_partition, kPartitionDescriptorPrefix, prefix_length) !=
+          0) {
+    SetError(error, "%s", "[libpq] Invalid partition descriptor");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  std::string query(reinterpret_cast<const char*>(serialized_partition) + prefix_length,
+                    serialized_length - prefix_length);
+
+  auto statement = std::make_shared<NetezzaStatement>();
+  RAISE_ADBC(statement->New(connection, error));
+  RAISE_ADBC(statement->SetSqlQuery(query.c_str(), error));
+  RAISE_ADBC(statement->ExecuteQuery(out, nullptr, error));
+  // The stream outlives any statement handle, so it keeps its statement alive
+  if (out->private_data == &statement->reader_) {
+    statement->reader_.owner_ = statement;
+  }
+  return ADBC_STATUS_OK;
+}
+
 AdbcStatusCode NetezzaStatement::ExecuteUpdateBulk(int64_t* rows_affected,
                                                     struct AdbcError* error) {
   if (!bind_.release) {
@@ -1472,6 +1211,12 @@ AdbcStatusCode NetezzaStatement::GetOption(const char* key, char* value, size_t*
     }
   } else if (std::strcmp(key, ADBC_NETEZZA_OPTION_BATCH_SIZE_HINT_BYTES) == 0) {
     result = std::to_string(reader_.batch_size_hint_bytes_);
+  } else if (std::strcmp(key, ADBC_NETEZZA_OPTION_INSERT_BATCH_SIZE_HINT_BYTES) == 0) {
+    result = std::to_string(insert_batch_size_hint_bytes_);
+  } else if (std::strcmp(key, ADBC_NETEZZA_OPTION_AVERAGE_ROW_BYTES) == 0) {
+    result = std::to_string(reader_.average_row_bytes());
+  } else if (std::strcmp(key, ADBC_NETEZZA_OPTION_PEAK_BATCH_BYTES) == 0) {
+    result = std::to_string(reader_.peak_batch_bytes_);
   } else {
     SetError(error, "[libpq] Unknown statement option '%s'", key);
     return ADBC_STATUS_NOT_FOUND;
@@ -1503,6 +1248,15 @@ AdbcStatusCode NetezzaStatement::GetOptionInt(const char* key, int64_t* value,
   if (std::strcmp(key, ADBC_NETEZZA_OPTION_BATCH_SIZE_HINT_BYTES) == 0) {
     *value = reader_.batch_size_hint_bytes_;
     return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_NETEZZA_OPTION_INSERT_BATCH_SIZE_HINT_BYTES) == 0) {
+    *value = insert_batch_size_hint_bytes_;
+    return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_NETEZZA_OPTION_AVERAGE_ROW_BYTES) == 0) {
+    *value = reader_.average_row_bytes();
+    return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_NETEZZA_OPTION_PEAK_BATCH_BYTES) == 0) {
+    *value = reader_.peak_batch_bytes_;
+    return ADBC_STATUS_OK;
   }
   SetError(error, "[libpq] Unknown statement option '%s'", key);
   return ADBC_STATUS_NOT_FOUND;
@@ -1591,6 +1345,14 @@ AdbcStatusCode NetezzaStatement::SetOption(const char* key, const char* value,
     }
 
     this->reader_.batch_size_hint_bytes_ = int_value;
+  } else if (std::strcmp(key, ADBC_NETEZZA_OPTION_INSERT_BATCH_SIZE_HINT_BYTES) == 0) {
+    int64_t int_value = std::atol(value);
+    if (int_value <= 0) {
+      SetError(error, "[libpq] Invalid value '%s' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+
+    insert_batch_size_hint_bytes_ = int_value;
   } else {
     SetError(error, "[libpq] Unknown statement option '%s'", key);
     return ADBC_STATUS_NOT_IMPLEMENTED;
@@ -1620,6 +1382,14 @@ AdbcStatusCode NetezzaStatement::SetOptionInt(const char* key, int64_t value,
 
     this->reader_.batch_size_hint_bytes_ = value;
     return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_NETEZZA_OPTION_INSERT_BATCH_SIZE_HINT_BYTES) == 0) {
+    if (value <= 0) {
+      SetError(error, "[libpq] Invalid value '%" PRIi64 "' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+
+    insert_batch_size_hint_bytes_ = value;
+    return ADBC_STATUS_OK;
   }
   SetError(error, "[libpq] Unknown statement option '%s'", key);
   return ADBC_STATUS_NOT_IMPLEMENTED;
@@ -33,6 +33,19 @@
 #define ADBC_NETEZZA_OPTION_BATCH_SIZE_HINT_BYTES \
   "adbc.netezza.batch_size_hint_bytes"
 
+/// \brief The approximate size in bytes of the multi-row INSERT statements
+///   that bound parameters to a prepared INSERT ... VALUES are sent in.
+#define ADBC_NETEZZA_OPTION_INSERT_BATCH_SIZE_HINT_BYTES \
+  "adbc.netezza.insert_batch_size_hint_bytes"
+
+/// \brief Read-only: the average width in bytes of the rows read by the
+///   last result set, as used to size its batches.
+#define ADBC_NETEZZA_OPTION_AVERAGE_ROW_BYTES "adbc.netezza.average_row_bytes"
+
+/// \brief Read-only: the largest amount of memory in bytes allocated for a
+///   single batch of the last result set.
+#define ADBC_NETEZZA_OPTION_PEAK_BATCH_BYTES "adbc.netezza.peak_batch_bytes"
+
 namespace adbcpq {
 class NetezzaConnection;
 class NetezzaStatement;
@@ -49,6 +62,9 @@ class TupleReader final {
         copy_reader_(nullptr),
         row_id_(-1),
         batch_size_hint_bytes_(16777216),
+        rows_read_(0),
+        bytes_read_(0),
+        peak_batch_bytes_(0),
         is_finished_(false) {
     // buffer_view_.data.as_char = nullptr;
     // buffer_view_.size_bytes = 0;
@@ -57,6 +73,9 @@ class TupleReader final {
   int GetSchema(struct ArrowSchema* out);
   int GetNext(struct ArrowArray* out);
   const char* last_error() const { return error_.message; }
+  int64_t average_row_bytes() const {
+    return rows_read_ > 0 ? bytes_read_ / rows_read_ : 0;
+  }
   void Release();
   void ExportTo(struct ArrowArrayStream* stream);
 
@@ -86,15 +105,25 @@ class TupleReader final {
   struct ArrowArray result_array;
   struct ArrowSchema result_schema;
   std::unique_ptr<NetezzaCopyStreamReader> copy_reader_;
+  // Set for streams from ReadPartition, which have no user-visible statement
+  std::shared_ptr<NetezzaStatement> owner_;
   int64_t row_id_;
   int64_t batch_size_hint_bytes_;
+  // Statistics for the current result set
+  int64_t rows_read_;
+  int64_t bytes_read_;
+  int64_t peak_batch_bytes_;
   bool is_finished_;
 };
 
 class NetezzaStatement {
  public:
   NetezzaStatement()
-      : connection_(nullptr), query_(), prepared_(false), reader_(nullptr) {
+      : connection_(nullptr),
+        query_(),
+        prepared_(false),
+        insert_batch_size_hint_bytes_(1048576),
+        reader_(nullptr) {
     std::memset(&bind_, 0, sizeof(bind_));
   }
 
@@ -105,6 +134,9 @@ class NetezzaStatement {
                       struct AdbcError* error);
   AdbcStatusCode Bind(struct ArrowArrayStream* stream, struct AdbcError* error);
   AdbcStatusCode Cancel(struct AdbcError* error);
+  AdbcStatusCode ExecutePartitions(struct ArrowSchema* schema,
+                                   struct AdbcPartitions* partitions,
+                                   int64_t* rows_affected, struct AdbcError* error);
   AdbcStatusCode ExecuteQuery(struct ArrowArrayStream* stream, int64_t* rows_affected,
                               struct AdbcError* error);
   AdbcStatusCode ExecuteSchema(struct ArrowSchema* schema, struct AdbcError* error);
@@ -125,6 +157,13 @@ class NetezzaStatement {
   AdbcStatusCode SetOptionInt(const char* key, int64_t value, struct AdbcError* error);
   AdbcStatusCode SetSqlQuery(const char* query, struct AdbcError* error);
 
+  /// \brief Execute a partition descriptor from ExecutePartitions.
+  static AdbcStatusCode ReadPartition(struct AdbcConnection* connection,
+                                      const uint8_t* serialized_partition,
+                                      size_t serialized_length,
+                                      struct ArrowArrayStream* out,
+                                      struct AdbcError* error);
+
   // ---------------------------------------------------------------------
   // Helper methods
 
@@ -149,6 +188,7 @@ class NetezzaStatement {
   std::string query_;
   bool prepared_;
   struct ArrowArrayStream bind_;
+  int64_t insert_batch_size_hint_bytes_;
 
   // Bulk ingest state
   enum class IngestMode {
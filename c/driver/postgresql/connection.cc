@@ -33,8 +33,8 @@
 
 #include "common/utils.h"
 #include "database.h"
-#include "error.h"
-#include "result_helper.h"
+#include "libpq_common/error.h"
+#include "libpq_common/result_helper.h"
 
 namespace adbcpq {
 namespace {
@@ -15,7 +15,7 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#include "error.h"
+#include "libpq_common/error.h"
 
 #include <postgres_ext.h>
 #include <stdarg.h>
@@ -1096,7 +1096,7 @@ TEST_F(PostgresStatementTest, SqlIngestTimestampOverflow) {
                 IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
     ASSERT_THAT(error.message,
                 ::testing::HasSubstr("Row #1 has value '9223372036854775807' which "
-                                     "exceeds PostgreSQL timestamp limits"));
+                                     "exceeds Postgres timestamp limits"));
   }
 
   {
@@ -1126,7 +1126,7 @@ TEST_F(PostgresStatementTest, SqlIngestTimestampOverflow) {
                 IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
     ASSERT_THAT(error.message,
                 ::testing::HasSubstr("Row #1 has value '-9223372036854775808' which "
-                                     "exceeds PostgreSQL timestamp limits"));
+                                     "exceeds Postgres timestamp limits"));
   }
 }
 
@@ -18,6 +18,7 @@
 #include "adbc.h"
 
 #include <assert.h>
+#include <ctype.h>
 #include <errno.h>
 #include <inttypes.h>
 #include <stdarg.h>
@@ -35,14 +36,43 @@
 #include "types.h"
 
 static const char kDefaultUri[] = "file:adbc_driver_sqlite?mode=memory&cache=shared";
+// PRAGMAs applied to every connection opened for the database
+static const char kDatabaseOptionJournalMode[] = "adbc.sqlite.pragma.journal_mode";
+static const char kDatabaseOptionCacheSize[] = "adbc.sqlite.pragma.cache_size";
+static const char kDatabaseOptionMmapSize[] = "adbc.sqlite.pragma.mmap_size";
+// The number of idle read-only connections kept for reading partitions
+static const char kDatabaseOptionPoolSize[] = "adbc.sqlite.pool.max_idle";
+static const int kDefaultPoolSize = 4;
 static const char kConnectionOptionEnableLoadExtension[] =
     "adbc.sqlite.load_extension.enabled";
 static const char kConnectionOptionLoadExtensionPath[] =
     "adbc.sqlite.load_extension.path";
 static const char kConnectionOptionLoadExtensionEntrypoint[] =
     "adbc.sqlite.load_extension.entrypoint";
+// The number of prepared statements kept for reuse, and statistics
+static const char kConnectionOptionStatementCacheCapacity[] =
+    "adbc.sqlite.statement_cache.capacity";
+static const char kConnectionOptionStatementCacheHits[] =
+    "adbc.sqlite.statement_cache.hits";
+static const char kConnectionOptionStatementCacheMisses[] =
+    "adbc.sqlite.statement_cache.misses";
+static const int kDefaultStatementCacheCapacity = 16;
+static const char kConnectionOptionGetObjectsBatchTables[] =
+    "adbc.sqlite.get_objects.batch_tables";
+static const int kDefaultGetObjectsBatchTables = 1024;
 // The batch size for query results (and for initial type inference)
 static const char kStatementOptionBatchRows[] = "adbc.sqlite.query.batch_rows";
+static const char kStatementOptionPartitionCount[] = "adbc.sqlite.query.partition_count";
+static const char kStatementOptionUseDeclaredTypes[] =
+    "adbc.sqlite.query.use_declared_types";
+static const char kStatementOptionDictionaryThreshold[] =
+    "adbc.sqlite.query.dictionary_threshold";
+// How bound date/timestamp values are stored (see AdbcSqliteTemporalMode)
+static const char kStatementOptionTemporalMode[] = "adbc.sqlite.bind.temporal_mode";
+// "default" or "bulk" (see SqliteBulkIngestBegin)
+static const char kStatementOptionIngestProfile[] = "adbc.sqlite.ingest.profile";
+// The page cache used for bulk ingestion (negative: in KiB, i.e. 256 MiB)
+static const char kBulkIngestCacheSize[] = "-262144";
 static const uint32_t kSupportedInfoCodes[] = {
     ADBC_INFO_VENDOR_NAME,    ADBC_INFO_VENDOR_VERSION,       ADBC_INFO_DRIVER_NAME,
     ADBC_INFO_DRIVER_VERSION, ADBC_INFO_DRIVER_ARROW_VERSION,
@@ -74,6 +104,7 @@ AdbcStatusCode SqliteDatabaseNew(struct AdbcDatabase* database, struct AdbcError
 
   database->private_data = malloc(sizeof(struct SqliteDatabase));
   memset(database->private_data, 0, sizeof(struct SqliteDatabase));
+  ((struct SqliteDatabase*)database->private_data)->pool_size = kDefaultPoolSize;
   return ADBC_STATUS_OK;
 }
 
@@ -88,6 +119,65 @@ AdbcStatusCode SqliteDatabaseSetOption(struct AdbcDatabase* database, const char
     db->uri = malloc(len);
     strncpy(db->uri, value, len);
     return ADBC_STATUS_OK;
+  } else if (strcmp(key, kDatabaseOptionJournalMode) == 0) {
+    static const char* kJournalModes[] = {"delete", "truncate", "persist",
+                                          "memory", "wal",      "off"};
+    int valid = 0;
+    for (size_t i = 0; value && i < sizeof(kJournalModes) / sizeof(kJournalModes[0]);
+         i++) {
+      if (sqlite3_stricmp(value, kJournalModes[i]) == 0) {
+        valid = 1;
+        break;
+      }
+    }
+    if (!valid) {
+      SetError(error, "[SQLite] Invalid journal mode '%s'", value ? value : "(NULL)");
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    if (db->journal_mode) free(db->journal_mode);
+    size_t len = strlen(value) + 1;
+    db->journal_mode = malloc(len);
+    strncpy(db->journal_mode, value, len);
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kDatabaseOptionCacheSize) == 0 ||
+             strcmp(key, kDatabaseOptionMmapSize) == 0) {
+    char* end = NULL;
+    errno = 0;
+    long long parsed = strtoll(value, &end, /*base=*/10);  // NOLINT(runtime/int)
+    if (errno != 0 || end == value || *end != '\0') {
+      SetError(error, "[SQLite] Invalid integer value '%s' for %s", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    if (strcmp(key, kDatabaseOptionCacheSize) == 0) {
+      // Negative values are a size in KiB rather than a number of pages
+      db->has_cache_size = 1;
+      db->cache_size = parsed;
+    } else {
+      if (parsed < 0) {
+        SetError(error, "[SQLite] Invalid mmap size %lld, must be non-negative",
+                 parsed);
+        return ADBC_STATUS_INVALID_ARGUMENT;
+      }
+      db->has_mmap_size = 1;
+      db->mmap_size = parsed;
+    }
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kDatabaseOptionPoolSize) == 0) {
+    if (db->db) {
+      SetError(error, "[SQLite] Cannot set %s after AdbcDatabaseInit", key);
+      return ADBC_STATUS_INVALID_STATE;
+    }
+    char* end = NULL;
+    errno = 0;
+    long parsed = strtol(value, &end, /*base=*/10);  // NOLINT(runtime/int)
+    if (errno != 0 || end == value || *end != '\0' || parsed < 0 ||
+        parsed > (long)INT_MAX) {  // NOLINT(runtime/int)
+      SetError(error, "[SQLite] Invalid pool size '%s', must be a non-negative integer",
+               value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    db->pool_size = (int)parsed;
+    return ADBC_STATUS_OK;
   }
   SetError(error, "[SQLite] Unknown database option %s=%s", key,
            value ? value : "(NULL)");
@@ -114,6 +204,45 @@ AdbcStatusCode SqliteDatabaseSetOptionInt(struct AdbcDatabase* database, const c
   return ADBC_STATUS_NOT_IMPLEMENTED;
 }
 
+// Apply the PRAGMAs configured on the database to a new connection.
+// The journal mode is persistent and can only be changed by a writer,
+// so it is not set on read-only connections.
+static AdbcStatusCode SqliteApplyPragmas(const struct SqliteDatabase* database,
+                                         sqlite3* db, char read_only,
+                                         struct AdbcError* error) {
+  char* pragmas[3] = {NULL, NULL, NULL};
+  int num_pragmas = 0;
+  if (database->has_cache_size) {
+    pragmas[num_pragmas++] =
+        sqlite3_mprintf("PRAGMA cache_size = %lld", (sqlite3_int64)database->cache_size);
+  }
+  if (database->has_mmap_size) {
+    pragmas[num_pragmas++] =
+        sqlite3_mprintf("PRAGMA mmap_size = %lld", (sqlite3_int64)database->mmap_size);
+  }
+  if (database->journal_mode && !read_only) {
+    pragmas[num_pragmas++] =
+        sqlite3_mprintf("PRAGMA journal_mode = %s", database->journal_mode);
+  }
+
+  AdbcStatusCode status = ADBC_STATUS_OK;
+  for (int i = 0; i < num_pragmas; i++) {
+    if (status != ADBC_STATUS_OK) {
+      // Fall through to free the remaining statements
+    } else if (!pragmas[i]) {
+      SetError(error, "[SQLite] Failed to allocate PRAGMA statement");
+      status = ADBC_STATUS_INTERNAL;
+    } else if (sqlite3_exec(db, pragmas[i], /*callback=*/NULL, /*arg=*/NULL,
+                            /*errmsg=*/NULL) != SQLITE_OK) {
+      SetError(error, "[SQLite] Failed to execute \"%s\": %s", pragmas[i],
+               sqlite3_errmsg(db));
+      status = ADBC_STATUS_IO;
+    }
+    sqlite3_free(pragmas[i]);
+  }
+  return status;
+}
+
 int OpenDatabase(const struct SqliteDatabase* database, sqlite3** db,
                  struct AdbcError* error) {
   const char* uri = database->uri ? database->uri : kDefaultUri;
@@ -130,7 +259,235 @@ int OpenDatabase(const struct SqliteDatabase* database, sqlite3** db,
     *db = NULL;
     return ADBC_STATUS_IO;
   }
-  return ADBC_STATUS_OK;
+  AdbcStatusCode status = SqliteApplyPragmas(database, *db, /*read_only=*/0, error);
+  if (status != ADBC_STATUS_OK) {
+    (void)sqlite3_close(*db);
+    *db = NULL;
+  }
+  return status;
+}
+
+// -- Connection pool ---------------------------------------------------
+//
+// Partitions of a file database are read on read-only connections of
+// their own, so that several threads can read at once without
+// contending for the mutex of the connection that executed the query.
+// Opening a connection (and warming up its page cache) is not free, so
+// idle connections are kept by the database and handed out again.
+
+static AdbcStatusCode SqliteDatabaseAcquireReader(struct SqliteDatabase* database,
+                                                  const char* filename, sqlite3** out,
+                                                  struct AdbcError* error) {
+  *out = NULL;
+  sqlite3_mutex_enter(database->pool_mutex);
+  if (database->num_idle_readers > 0) {
+    *out = database->idle_readers[--database->num_idle_readers];
+  }
+  database->num_active_readers++;
+  sqlite3_mutex_leave(database->pool_mutex);
+  if (*out) return ADBC_STATUS_OK;
+
+  // The connection is only ever used by one reader at a time
+  int rc = sqlite3_open_v2(filename, out, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX,
+                           /*zVfs=*/NULL);
+  AdbcStatusCode status = ADBC_STATUS_OK;
+  if (rc != SQLITE_OK) {
+    SetError(error, "[SQLite] Failed to open %s: %s", filename,
+             *out ? sqlite3_errmsg(*out) : "failed to allocate memory");
+    status = ADBC_STATUS_IO;
+  } else {
+    status = SqliteApplyPragmas(database, *out, /*read_only=*/1, error);
+  }
+
+  if (status != ADBC_STATUS_OK) {
+    (void)sqlite3_close(*out);
+    *out = NULL;
+    sqlite3_mutex_enter(database->pool_mutex);
+    database->num_active_readers--;
+    sqlite3_mutex_leave(database->pool_mutex);
+  }
+  return status;
+}
+
+static void SqliteDatabaseReleaseReader(struct SqliteDatabase* database, sqlite3* db) {
+  sqlite3_mutex_enter(database->pool_mutex);
+  database->num_active_readers--;
+  if (database->num_idle_readers < database->pool_size) {
+    database->idle_readers[database->num_idle_readers++] = db;
+    db = NULL;
+  }
+  sqlite3_mutex_leave(database->pool_mutex);
+  if (db) (void)sqlite3_close(db);
+}
+
+// -- Prepared statement cache ------------------------------------------
+//
+// Each connection keeps its most recently used prepared statements, so
+// that running the same SQL again (including the catalog queries behind
+// GetObjects) skips sqlite3_prepare_v2. A statement is taken out of the
+// cache while it is in use and reset when it is returned, so it is never
+// shared. The cache is small and scanned linearly, comparing hashes.
+//
+// SQLite only re-prepares a statement after a schema change when it is
+// next stepped, so until then its column names and declared types are
+// stale. Each statement remembers the schema version it was prepared
+// against, and is prepared again if the schema has changed since.
+
+static uint64_t SqliteStatementCacheHash(const char* sql, size_t len) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= (uint8_t)sql[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static void SqliteStatementCacheEvict(struct SqliteStatementCache* cache, int index) {
+  (void)sqlite3_finalize(cache->entries[index].stmt);
+  cache->entries[index] = cache->entries[--cache->size];
+}
+
+// Get the current schema version of the connection, or -1 on error.
+static int64_t SqliteStatementCacheSchemaVersion(struct SqliteStatementCache* cache,
+                                                 sqlite3* db) {
+  if (!cache->version_stmt &&
+      sqlite3_prepare_v2(db, "PRAGMA schema_version", -1, &cache->version_stmt,
+                         /*pzTail=*/NULL) != SQLITE_OK) {
+    (void)sqlite3_finalize(cache->version_stmt);
+    cache->version_stmt = NULL;
+    return -1;
+  }
+  int64_t version = -1;
+  if (sqlite3_step(cache->version_stmt) == SQLITE_ROW) {
+    version = sqlite3_column_int64(cache->version_stmt, 0);
+  }
+  (void)sqlite3_reset(cache->version_stmt);
+  return version;
+}
+
+// Remember a statement handed out by SqliteStatementCacheAcquire. If
+// this fails, the statement is simply not cached when returned.
+static void SqliteStatementCacheCheckOut(struct SqliteStatementCache* cache,
+                                         const struct SqliteStatementCacheEntry* entry) {
+  if (cache->num_checked_out == cache->checked_out_capacity) {
+    int capacity = cache->checked_out_capacity ? 2 * cache->checked_out_capacity : 4;
+    struct SqliteStatementCacheEntry* checked_out =
+        (struct SqliteStatementCacheEntry*)realloc(
+            cache->checked_out, sizeof(struct SqliteStatementCacheEntry) * capacity);
+    if (!checked_out) return;
+    cache->checked_out = checked_out;
+    cache->checked_out_capacity = capacity;
+  }
+  cache->checked_out[cache->num_checked_out++] = *entry;
+}
+
+// Get a prepared statement for the given SQL (of len bytes, or
+// NUL-terminated if negative), from the cache if possible. Returns an
+// SQLite result code. The statement must be given back with
+// SqliteStatementCacheRelease.
+static int SqliteStatementCacheAcquire(struct SqliteStatementCache* cache, sqlite3* db,
+                                       const char* sql, int len, sqlite3_stmt** out) {
+  const size_t sql_len = len < 0 ? strlen(sql) : (size_t)len;
+  struct SqliteStatementCacheEntry entry;
+  entry.hash = SqliteStatementCacheHash(sql, sql_len);
+  entry.schema_version = -1;
+  if (cache->capacity > 0) {
+    entry.schema_version = SqliteStatementCacheSchemaVersion(cache, db);
+  }
+  for (int i = 0; i < cache->size; i++) {
+    if (cache->entries[i].hash != entry.hash) continue;
+    const char* cached = sqlite3_sql(cache->entries[i].stmt);
+    if (strlen(cached) == sql_len && memcmp(cached, sql, sql_len) == 0) {
+      if (cache->entries[i].schema_version != entry.schema_version ||
+          entry.schema_version < 0) {
+        SqliteStatementCacheEvict(cache, i);
+        break;
+      }
+      *out = cache->entries[i].stmt;
+      cache->entries[i] = cache->entries[--cache->size];
+      cache->hits++;
+      entry.stmt = *out;
+      SqliteStatementCacheCheckOut(cache, &entry);
+      return SQLITE_OK;
+    }
+  }
+  cache->misses++;
+  int rc = sqlite3_prepare_v2(db, sql, (int)sql_len, out, /*pzTail=*/NULL);
+  if (rc == SQLITE_OK && *out && entry.schema_version >= 0) {
+    entry.stmt = *out;
+    SqliteStatementCacheCheckOut(cache, &entry);
+  }
+  return rc;
+}
+
+// Return a statement from SqliteStatementCacheAcquire, evicting the
+// least recently used statement if the cache is full. Statements are
+// keyed by sqlite3_sql(), i.e. the text up to the end of the first
+// statement, so SQL with trailing text won't be found again. Statements
+// prepared against an older schema are finalized instead.
+static void SqliteStatementCacheRelease(struct SqliteStatementCache* cache,
+                                        sqlite3_stmt* stmt) {
+  if (!stmt) return;
+  int64_t schema_version = -1;
+  for (int i = 0; i < cache->num_checked_out; i++) {
+    if (cache->checked_out[i].stmt == stmt) {
+      schema_version = cache->checked_out[i].schema_version;
+      cache->checked_out[i] = cache->checked_out[--cache->num_checked_out];
+      break;
+    }
+  }
+  if (cache->capacity <= 0 || schema_version < 0 ||
+      schema_version !=
+          SqliteStatementCacheSchemaVersion(cache, sqlite3_db_handle(stmt))) {
+    (void)sqlite3_finalize(stmt);
+    return;
+  }
+  if (!cache->entries) {
+    cache->entries = (struct SqliteStatementCacheEntry*)malloc(
+        sizeof(struct SqliteStatementCacheEntry) * (size_t)cache->capacity);
+    if (!cache->entries) {
+      (void)sqlite3_finalize(stmt);
+      return;
+    }
+  }
+
+  (void)sqlite3_reset(stmt);
+  (void)sqlite3_clear_bindings(stmt);
+  const char* sql = sqlite3_sql(stmt);
+  const uint64_t hash = SqliteStatementCacheHash(sql, strlen(sql));
+  int lru = 0;
+  for (int i = 0; i < cache->size; i++) {
+    // Two copies were in use at once; keep one
+    if (cache->entries[i].hash == hash &&
+        strcmp(sqlite3_sql(cache->entries[i].stmt), sql) == 0) {
+      SqliteStatementCacheEvict(cache, i);
+      break;
+    }
+    if (cache->entries[i].last_used < cache->entries[lru].last_used) lru = i;
+  }
+  if (cache->size >= cache->capacity) SqliteStatementCacheEvict(cache, lru);
+
+  struct SqliteStatementCacheEntry* entry = &cache->entries[cache->size++];
+  entry->hash = hash;
+  entry->last_used = ++cache->clock;
+  entry->schema_version = schema_version;
+  entry->stmt = stmt;
+}
+
+// Finalize all cached statements. Statements still in use stay checked
+// out, and are cached or finalized when returned.
+static void SqliteStatementCacheClear(struct SqliteStatementCache* cache) {
+  while (cache->size > 0) SqliteStatementCacheEvict(cache, cache->size - 1);
+  free(cache->entries);
+  cache->entries = NULL;
+  (void)sqlite3_finalize(cache->version_stmt);
+  cache->version_stmt = NULL;
+  if (cache->num_checked_out == 0) {
+    free(cache->checked_out);
+    cache->checked_out = NULL;
+    cache->checked_out_capacity = 0;
+  }
 }
 
 AdbcStatusCode ExecuteQuery(struct SqliteConnection* conn, const char* query,
@@ -186,6 +543,16 @@ AdbcStatusCode SqliteDatabaseInit(struct AdbcDatabase* database,
     return ADBC_STATUS_INVALID_STATE;
   }
 
+  if (db->pool_size > 0) {
+    db->idle_readers = (sqlite3**)malloc(sizeof(sqlite3*) * (size_t)db->pool_size);
+    if (!db->idle_readers) {
+      SetError(error, "[SQLite] AdbcDatabaseInit: failed to allocate connection pool");
+      return ADBC_STATUS_INTERNAL;
+    }
+  }
+  // NULL if SQLite was built without mutexes, in which case the
+  // mutex functions are no-ops
+  db->pool_mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_FAST);
   return OpenDatabase(db, &db->db, error);
 }
 
@@ -194,8 +561,25 @@ AdbcStatusCode SqliteDatabaseRelease(struct AdbcDatabase* database,
   CHECK_DB_INIT(database, error);
   struct SqliteDatabase* db = (struct SqliteDatabase*)database->private_data;
 
+  if (db->num_active_readers > 0) {
+    SetError(error,
+             "[SQLite] AdbcDatabaseRelease: %d partition readers still open, release "
+             "them first",
+             db->num_active_readers);
+    return ADBC_STATUS_INVALID_STATE;
+  }
+  for (int i = 0; i < db->num_idle_readers; i++) {
+    (void)sqlite3_close(db->idle_readers[i]);
+  }
+  db->num_idle_readers = 0;
+  if (db->idle_readers) free(db->idle_readers);
+  db->idle_readers = NULL;
+  if (db->pool_mutex) sqlite3_mutex_free(db->pool_mutex);
+  db->pool_mutex = NULL;
+
   size_t connection_count = db->connection_count;
   if (db->uri) free(db->uri);
+  if (db->journal_mode) free(db->journal_mode);
   if (db->db) {
     if (sqlite3_close(db->db) == SQLITE_BUSY) {
       SetError(error, "[SQLite] AdbcDatabaseRelease: connection is busy");
@@ -223,6 +607,9 @@ AdbcStatusCode SqliteConnectionNew(struct AdbcConnection* connection,
 
   connection->private_data = malloc(sizeof(struct SqliteConnection));
   memset(connection->private_data, 0, sizeof(struct SqliteConnection));
+  struct SqliteConnection* conn = (struct SqliteConnection*)connection->private_data;
+  conn->statement_cache.capacity = kDefaultStatementCacheCapacity;
+  conn->get_objects_batch_tables = kDefaultGetObjectsBatchTables;
   return ADBC_STATUS_OK;
 }
 
@@ -327,6 +714,36 @@ AdbcStatusCode SqliteConnectionSetOption(struct AdbcConnection* connection,
              "loading");
     return ADBC_STATUS_NOT_IMPLEMENTED;
 #endif
+  } else if (strcmp(key, kConnectionOptionStatementCacheCapacity) == 0) {
+    char* end = NULL;
+    errno = 0;
+    long capacity = strtol(value, &end, /*base=*/10);  // NOLINT(runtime/int)
+    if (errno != 0 || end == value || *end != '\0' || capacity < 0 ||
+        capacity > (long)INT_MAX) {  // NOLINT(runtime/int)
+      SetError(error,
+               "[SQLite] Invalid connection option value %s=%s (expected a "
+               "non-negative integer)",
+               key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    // Statements in use are returned to the resized cache
+    SqliteStatementCacheClear(&conn->statement_cache);
+    conn->statement_cache.capacity = (int)capacity;
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kConnectionOptionGetObjectsBatchTables) == 0) {
+    char* end = NULL;
+    errno = 0;
+    long batch_tables = strtol(value, &end, /*base=*/10);  // NOLINT(runtime/int)
+    if (errno != 0 || end == value || *end != '\0' || batch_tables <= 0 ||
+        batch_tables > (long)INT_MAX) {  // NOLINT(runtime/int)
+      SetError(error,
+               "[SQLite] Invalid connection option value %s=%s (expected a "
+               "positive integer)",
+               key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    conn->get_objects_batch_tables = (int)batch_tables;
+    return ADBC_STATUS_OK;
   }
   SetError(error, "[SQLite] Unknown connection option %s=%s", key,
            value ? value : "(NULL)");
@@ -366,6 +783,7 @@ AdbcStatusCode SqliteConnectionInit(struct AdbcConnection* connection,
     SetError(error, "[SQLite] AdbcConnectionInit: connection already initialized");
     return ADBC_STATUS_INVALID_STATE;
   }
+  conn->database = db;
   return OpenDatabase(db, &conn->conn, error);
 }
 
@@ -374,6 +792,11 @@ AdbcStatusCode SqliteConnectionRelease(struct AdbcConnection* connection,
   CHECK_CONN_INIT(connection, error);
   struct SqliteConnection* conn = (struct SqliteConnection*)connection->private_data;
 
+  if (conn->num_get_objects_streams > 0) {
+    SetError(error, "[SQLite] AdbcConnectionRelease: GetObjects stream still open");
+    return ADBC_STATUS_INVALID_STATE;
+  }
+  SqliteStatementCacheClear(&conn->statement_cache);
   if (conn->conn) {
     int rc = sqlite3_close(conn->conn);
     if (rc == SQLITE_BUSY) {
@@ -469,25 +892,97 @@ static const char kTableQuery[] =
     "FROM sqlite_master "
     "WHERE name LIKE ? AND type <> 'index'"
     "ORDER BY name ASC";
+// The columns of the tables in a range of names. Primary key columns are
+// read from here as well, so the column name filter is applied in C.
 static const char kColumnQuery[] =
-    "SELECT cid, name, type, \"notnull\", dflt_value "
-    "FROM pragma_table_info(?) "
-    "WHERE name LIKE ? "
-    "ORDER BY cid ASC";
-static const char kPrimaryKeyQuery[] =
-    "SELECT name "
-    "FROM pragma_table_info(?) "
-    "WHERE pk > 0 "
-    "ORDER BY pk ASC";
+    "SELECT m.name, c.cid, c.name, c.type, c.\"notnull\", c.dflt_value, c.pk, "
+    "c.name LIKE ?3 "
+    "FROM sqlite_master AS m JOIN pragma_table_info(m.name) AS c "
+    "WHERE m.type IN ('table', 'view') AND m.name BETWEEN ?1 AND ?2 "
+    "ORDER BY m.name ASC, c.cid ASC";
+// The foreign keys of the tables in a range of names
 static const char kForeignKeyQuery[] =
-    "SELECT id, seq, \"table\", \"from\", \"to\" "
-    "FROM pragma_foreign_key_list(?) "
-    "ORDER BY id, seq ASC";
-
-AdbcStatusCode SqliteConnectionGetColumnsImpl(
-    struct SqliteConnection* conn, const char* table_name, const char* column_name,
-    struct ArrowArray* table_columns_col, sqlite3_stmt* stmt, struct AdbcError* error) {
-  struct ArrowArray* table_columns_items = table_columns_col->children[0];
+    "SELECT m.name, f.id, f.seq, f.\"table\", f.\"from\", f.\"to\" "
+    "FROM sqlite_master AS m JOIN pragma_foreign_key_list(m.name) AS f "
+    "WHERE m.type = 'table' AND m.name BETWEEN ?1 AND ?2 "
+    "ORDER BY m.name ASC, f.id ASC, f.seq ASC";
+
+// -- GetObjects --------------------------------------------------------
+//
+// GetObjects is returned as a stream that reads the tables of "main" a
+// chunk at a time. Each chunk becomes a batch with a single catalog and
+// schema row, so the whole result is never held in memory. The columns
+// and constraints of a chunk are read with one query each, joining
+// sqlite_master with the table-valued PRAGMA functions over the range of
+// table names in the chunk (rather than querying once per table). The
+// stream reads through the connection, so AdbcConnectionRelease fails
+// while it is open.
+
+struct SqliteGetObjectsReader {
+  struct SqliteConnection* conn;
+  int depth;
+  // Whether the catalog and schema filters match "main" and its
+  // (unnamed) schema
+  char match_catalog;
+  char match_db_schema;
+  // NULL-terminated, or NULL to not filter
+  char** table_types;
+  char* column_name;
+  int batch_tables;
+
+  // Positioned on the next table (if has_table)
+  sqlite3_stmt* tables_stmt;
+  char has_table;
+  sqlite3_stmt* columns_stmt;
+  sqlite3_stmt* fk_stmt;
+
+  // Names and types of the tables in the current chunk
+  char** chunk_names;
+  char** chunk_types;
+  int chunk_size;
+  // Primary key columns of the current table, by position in the key
+  char** pk_columns;
+  int pk_capacity;
+
+  struct ArrowSchema schema;
+  struct AdbcError error;
+  char done;
+};
+
+// Advance to the next table that passes the table type filter.
+static AdbcStatusCode SqliteGetObjectsReaderStepTable(
+    struct SqliteGetObjectsReader* reader, struct AdbcError* error) {
+  int rc = SQLITE_OK;
+  while ((rc = sqlite3_step(reader->tables_stmt)) == SQLITE_ROW) {
+    if (!reader->table_types) break;
+    const char* table_type = (const char*)sqlite3_column_text(reader->tables_stmt, 1);
+    char found = 0;
+    for (char** current = reader->table_types; *current; current++) {
+      if (strcmp(*current, table_type) == 0) {
+        found = 1;
+        break;
+      }
+    }
+    if (found) break;
+  }
+
+  reader->has_table = rc == SQLITE_ROW;
+  if (rc == SQLITE_ROW) return ADBC_STATUS_OK;
+  if (rc != SQLITE_DONE) {
+    SetError(error, "[SQLite] Failed to query for tables: %s",
+             sqlite3_errmsg(reader->conn->conn));
+    return ADBC_STATUS_INTERNAL;
+  }
+  // Don't hold a read on the schema once all tables were read
+  SqliteStatementCacheRelease(&reader->conn->statement_cache, reader->tables_stmt);
+  reader->tables_stmt = NULL;
+  return ADBC_STATUS_OK;
+}
+
+// Append a column from the current row of kColumnQuery.
+static AdbcStatusCode SqliteGetObjectsAppendColumn(struct ArrowArray* table_columns_items,
+                                                   sqlite3_stmt* stmt,
+                                                   struct AdbcError* error) {
   struct ArrowArray* column_name_col = table_columns_items->children[0];
   struct ArrowArray* ordinal_position_col = table_columns_items->children[1];
   struct ArrowArray* remarks_col = table_columns_items->children[2];
@@ -508,94 +1003,167 @@ AdbcStatusCode SqliteConnectionGetColumnsImpl(
   struct ArrowArray* xdbc_is_autoincrement_col = table_columns_items->children[17];
   struct ArrowArray* xdbc_is_generatedcolumn_col = table_columns_items->children[18];
 
-  int rc = sqlite3_reset(stmt);
-  RAISE(INTERNAL, rc == SQLITE_OK, sqlite3_errmsg(conn->conn), error);
+  const char* col_name = (const char*)sqlite3_column_text(stmt, 2);
+  struct ArrowStringView str = {.data = col_name,
+                                .size_bytes = sqlite3_column_bytes(stmt, 2)};
+  CHECK_NA(INTERNAL, ArrowArrayAppendString(column_name_col, str), error);
 
-  rc = sqlite3_bind_text64(stmt, 1, table_name, strlen(table_name), SQLITE_STATIC,
-                           SQLITE_UTF8);
-  RAISE(INTERNAL, rc == SQLITE_OK, sqlite3_errmsg(conn->conn), error);
+  const int32_t col_cid = sqlite3_column_int(stmt, 1);
+  CHECK_NA(INTERNAL, ArrowArrayAppendInt(ordinal_position_col, col_cid + 1), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(remarks_col, 1), error);
 
-  if (column_name) {
-    rc = sqlite3_bind_text64(stmt, 2, column_name, strlen(column_name), SQLITE_STATIC,
-                             SQLITE_UTF8);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_data_type_col, 1), error);
+
+  const char* col_type = (const char*)sqlite3_column_text(stmt, 3);
+  if (col_type) {
+    str.data = col_type;
+    str.size_bytes = sqlite3_column_bytes(stmt, 3);
+    CHECK_NA(INTERNAL, ArrowArrayAppendString(xdbc_type_name_col, str), error);
   } else {
-    rc = sqlite3_bind_text64(stmt, 2, "%", 1, SQLITE_STATIC, SQLITE_UTF8);
+    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_type_name_col, 1), error);
   }
-  RAISE(INTERNAL, rc == SQLITE_OK, sqlite3_errmsg(conn->conn), error);
 
-  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-    const char* col_name = (const char*)sqlite3_column_text(stmt, 1);
-    struct ArrowStringView str = {.data = col_name,
-                                  .size_bytes = sqlite3_column_bytes(stmt, 1)};
-    CHECK_NA(INTERNAL, ArrowArrayAppendString(column_name_col, str), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_column_size_col, 1), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_decimal_digits_col, 1), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_num_prec_radix_col, 1), error);
 
-    const int32_t col_cid = sqlite3_column_int(stmt, 0);
-    CHECK_NA(INTERNAL, ArrowArrayAppendInt(ordinal_position_col, col_cid + 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(remarks_col, 1), error);
+  const int32_t col_notnull = sqlite3_column_int(stmt, 4);
+  if (col_notnull == 0) {
+    // JDBC columnNullable == 1
+    CHECK_NA(INTERNAL, ArrowArrayAppendInt(xdbc_nullable_col, 1), error);
+  } else {
+    // JDBC columnNoNulls == 0
+    CHECK_NA(INTERNAL, ArrowArrayAppendInt(xdbc_nullable_col, 0), error);
+  }
 
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_data_type_col, 1), error);
+  const char* col_def = (const char*)sqlite3_column_text(stmt, 5);
+  if (col_def) {
+    str.data = col_def;
+    str.size_bytes = sqlite3_column_bytes(stmt, 5);
+    CHECK_NA(INTERNAL, ArrowArrayAppendString(xdbc_column_def_col, str), error);
+  } else {
+    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_column_def_col, 1), error);
+  }
 
-    const char* col_type = (const char*)sqlite3_column_text(stmt, 2);
-    if (col_type) {
-      str.data = col_type;
-      str.size_bytes = sqlite3_column_bytes(stmt, 2);
-      CHECK_NA(INTERNAL, ArrowArrayAppendString(xdbc_type_name_col, str), error);
-    } else {
-      CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_type_name_col, 1), error);
-    }
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_sql_data_type_col, 1), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_datetime_sub_col, 1), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_char_octet_length_col, 1), error);
 
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_column_size_col, 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_decimal_digits_col, 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_num_prec_radix_col, 1), error);
+  if (col_notnull == 0) {
+    str.data = "YES";
+    str.size_bytes = 3;
+  } else {
+    str.data = "NO";
+    str.size_bytes = 2;
+  }
+  CHECK_NA(INTERNAL, ArrowArrayAppendString(xdbc_is_nullable_col, str), error);
 
-    const int32_t col_notnull = sqlite3_column_int(stmt, 3);
-    if (col_notnull == 0) {
-      // JDBC columnNullable == 1
-      CHECK_NA(INTERNAL, ArrowArrayAppendInt(xdbc_nullable_col, 1), error);
-    } else {
-      // JDBC columnNoNulls == 0
-      CHECK_NA(INTERNAL, ArrowArrayAppendInt(xdbc_nullable_col, 0), error);
-    }
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_scope_catalog_col, 1), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_scope_schema_col, 1), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_scope_table_col, 1), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_is_autoincrement_col, 1), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_is_generatedcolumn_col, 1), error);
 
-    const char* col_def = (const char*)sqlite3_column_text(stmt, 4);
-    if (col_def) {
-      str.data = col_def;
-      str.size_bytes = sqlite3_column_bytes(stmt, 4);
-      CHECK_NA(INTERNAL, ArrowArrayAppendString(xdbc_column_def_col, str), error);
-    } else {
-      CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_column_def_col, 1), error);
-    }
+  CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_columns_items), error);
+  return ADBC_STATUS_OK;
+}
 
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_sql_data_type_col, 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_datetime_sub_col, 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_char_octet_length_col, 1), error);
+// Advance a chunk query (kColumnQuery or kForeignKeyQuery) to the rows
+// of the given table. Returns SQLITE_ROW if the table has rows, else
+// SQLITE_DONE (or an error). *rc is the result of the last step.
+static int SqliteGetObjectsSeekTable(sqlite3_stmt* stmt, int* rc, const char* table) {
+  while (*rc == SQLITE_ROW) {
+    // Matches the BINARY collation used to sort by name
+    const int cmp = strcmp((const char*)sqlite3_column_text(stmt, 0), table);
+    if (cmp == 0) return SQLITE_ROW;
+    if (cmp > 0) return SQLITE_DONE;
+    // A table in the range that was filtered out
+    *rc = sqlite3_step(stmt);
+  }
+  return *rc;
+}
 
-    if (col_notnull == 0) {
-      str.data = "YES";
-      str.size_bytes = 3;
-    } else {
-      str.data = "NO";
-      str.size_bytes = 2;
+// Append the columns of a table from kColumnQuery, and its primary key
+// (if any) as a constraint.
+static AdbcStatusCode SqliteGetObjectsAppendColumns(
+    struct SqliteGetObjectsReader* reader, const char* table, int* rc,
+    struct ArrowArray* table_columns_col, struct ArrowArray* table_constraints_col,
+    struct AdbcError* error) {
+  sqlite3_stmt* stmt = reader->columns_stmt;
+  int num_pk = 0;
+  AdbcStatusCode status = ADBC_STATUS_OK;
+  while (SqliteGetObjectsSeekTable(stmt, rc, table) == SQLITE_ROW) {
+    if (sqlite3_column_int(stmt, 7)) {
+      status = SqliteGetObjectsAppendColumn(table_columns_col->children[0], stmt, error);
+      if (status != ADBC_STATUS_OK) break;
     }
-    CHECK_NA(INTERNAL, ArrowArrayAppendString(xdbc_is_nullable_col, str), error);
-
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_scope_catalog_col, 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_scope_schema_col, 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_scope_table_col, 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_is_autoincrement_col, 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(xdbc_is_generatedcolumn_col, 1), error);
 
-    CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_columns_items), error);
+    // Primary key columns are numbered from 1 in key order
+    const int pk = sqlite3_column_int(stmt, 6);
+    if (pk > 0) {
+      if (pk > reader->pk_capacity) {
+        char** resized =
+            (char**)realloc(reader->pk_columns, sizeof(char*) * (size_t)pk * 2);
+        if (!resized) {
+          SetError(error, "[SQLite] Failed to allocate primary key columns");
+          status = ADBC_STATUS_INTERNAL;
+          break;
+        }
+        memset(resized + reader->pk_capacity, 0,
+               sizeof(char*) * (size_t)(pk * 2 - reader->pk_capacity));
+        reader->pk_columns = resized;
+        reader->pk_capacity = pk * 2;
+      }
+      sqlite3_free(reader->pk_columns[pk - 1]);
+      reader->pk_columns[pk - 1] =
+          sqlite3_mprintf("%s", (const char*)sqlite3_column_text(stmt, 2));
+      if (pk > num_pk) num_pk = pk;
+    }
+    *rc = sqlite3_step(stmt);
+  }
+  if (status == ADBC_STATUS_OK && *rc != SQLITE_ROW && *rc != SQLITE_DONE) {
+    SetError(error, "[SQLite] Failed to query for columns: %s",
+             sqlite3_errmsg(reader->conn->conn));
+    status = ADBC_STATUS_INTERNAL;
   }
-  RAISE(INTERNAL, rc == SQLITE_DONE, sqlite3_errmsg(conn->conn), error);
 
-  return ADBC_STATUS_OK;
+  // We can get primary keys and foreign keys, but not unique
+  // constraints (unless we parse the SQL table definition)
+  struct ArrowArray* table_constraints_items = table_constraints_col->children[0];
+  struct ArrowArray* constraint_column_names_col = table_constraints_items->children[2];
+  for (int i = 0; status == ADBC_STATUS_OK && i < num_pk; i++) {
+    if (i == 0) {
+      CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_constraints_items->children[0], 1),
+               error);
+      CHECK_NA(INTERNAL,
+               ArrowArrayAppendString(table_constraints_items->children[1],
+                                      ArrowCharView("PRIMARY KEY")),
+               error);
+    }
+    CHECK_NA(INTERNAL,
+             ArrowArrayAppendString(constraint_column_names_col->children[0],
+                                    ArrowCharView(reader->pk_columns[i]
+                                                      ? reader->pk_columns[i]
+                                                      : "")),
+             error);
+  }
+  if (status == ADBC_STATUS_OK && num_pk > 0) {
+    CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_names_col), error);
+    CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_constraints_items->children[3], 1),
+             error);
+    CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_constraints_items), error);
+  }
+  for (int i = 0; i < num_pk; i++) {
+    sqlite3_free(reader->pk_columns[i]);
+    reader->pk_columns[i] = NULL;
+  }
+  return status;
 }
 
-AdbcStatusCode SqliteConnectionGetConstraintsImpl(
-    struct SqliteConnection* conn, const char* table_name, const char* column_name,
-    struct ArrowArray* table_constraints_col, sqlite3_stmt* pk_stmt,
-    sqlite3_stmt* fk_stmt, struct AdbcError* error) {
+// Append the foreign keys of a table from kForeignKeyQuery.
+static AdbcStatusCode SqliteGetObjectsAppendForeignKeys(
+    struct SqliteGetObjectsReader* reader, const char* table, int* rc,
+    struct ArrowArray* table_constraints_col, struct AdbcError* error) {
   struct ArrowArray* table_constraints_items = table_constraints_col->children[0];
   struct ArrowArray* constraint_name_col = table_constraints_items->children[0];
   struct ArrowArray* constraint_type_col = table_constraints_items->children[1];
@@ -610,54 +1178,14 @@ AdbcStatusCode SqliteConnectionGetConstraintsImpl(
   struct ArrowArray* fk_table_col = constraint_column_usage_items->children[2];
   struct ArrowArray* fk_column_name_col = constraint_column_usage_items->children[3];
 
-  // We can get primary keys and foreign keys, but not unique
-  // constraints (unless we parse the SQL table definition)
-
-  int rc = sqlite3_reset(pk_stmt);
-  RAISE(INTERNAL, rc == SQLITE_OK, sqlite3_errmsg(conn->conn), error);
-
-  rc = sqlite3_bind_text64(pk_stmt, 1, table_name, strlen(table_name), SQLITE_STATIC,
-                           SQLITE_UTF8);
-  RAISE(INTERNAL, rc == SQLITE_OK, sqlite3_errmsg(conn->conn), error);
-
-  char has_primary_key = 0;
-  while ((rc = sqlite3_step(pk_stmt)) == SQLITE_ROW) {
-    if (!has_primary_key) {
-      has_primary_key = 1;
-      CHECK_NA(INTERNAL, ArrowArrayAppendNull(constraint_name_col, 1), error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(constraint_type_col, ArrowCharView("PRIMARY KEY")),
-               error);
-    }
-    CHECK_NA(
-        INTERNAL,
-        ArrowArrayAppendString(
-            constraint_column_names_items,
-            (struct ArrowStringView){.data = (const char*)sqlite3_column_text(pk_stmt, 0),
-                                     .size_bytes = sqlite3_column_bytes(pk_stmt, 0)}),
-        error);
-  }
-  RAISE(INTERNAL, rc == SQLITE_DONE, sqlite3_errmsg(conn->conn), error);
-  if (has_primary_key) {
-    CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_names_col), error);
-    CHECK_NA(INTERNAL, ArrowArrayAppendNull(constraint_column_usage_col, 1), error);
-    CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_constraints_items), error);
-  }
-
-  rc = sqlite3_reset(fk_stmt);
-  RAISE(INTERNAL, rc == SQLITE_OK, sqlite3_errmsg(conn->conn), error);
-
-  rc = sqlite3_bind_text64(fk_stmt, 1, table_name, strlen(table_name), SQLITE_STATIC,
-                           SQLITE_UTF8);
-  RAISE(INTERNAL, rc == SQLITE_OK, sqlite3_errmsg(conn->conn), error);
-
+  sqlite3_stmt* fk_stmt = reader->fk_stmt;
   int prev_fk_id = -1;
-  while ((rc = sqlite3_step(fk_stmt)) == SQLITE_ROW) {
-    const int fk_id = sqlite3_column_int(fk_stmt, 0);
-    // Foreign key seq is sqlite3_column_int(fk_stmt, 1);
-    const char* to_table = (const char*)sqlite3_column_text(fk_stmt, 2);
-    const char* from_col = (const char*)sqlite3_column_text(fk_stmt, 3);
-    const char* to_col = (const char*)sqlite3_column_text(fk_stmt, 4);
+  while (SqliteGetObjectsSeekTable(fk_stmt, rc, table) == SQLITE_ROW) {
+    const int fk_id = sqlite3_column_int(fk_stmt, 1);
+    // Foreign key seq is sqlite3_column_int(fk_stmt, 2);
+    const char* to_table = (const char*)sqlite3_column_text(fk_stmt, 3);
+    const char* from_col = (const char*)sqlite3_column_text(fk_stmt, 4);
+    const char* to_col = (const char*)sqlite3_column_text(fk_stmt, 5);
 
     // New foreign key constraint or -constraint sets
     if (fk_id != prev_fk_id) {
@@ -678,7 +1206,7 @@ AdbcStatusCode SqliteConnectionGetConstraintsImpl(
              ArrowArrayAppendString(
                  constraint_column_names_items,
                  (struct ArrowStringView){
-                     .data = from_col, .size_bytes = sqlite3_column_bytes(fk_stmt, 3)}),
+                     .data = from_col, .size_bytes = sqlite3_column_bytes(fk_stmt, 4)}),
              error);
     CHECK_NA(INTERNAL, ArrowArrayAppendString(fk_catalog_col, ArrowCharView("main")),
              error);
@@ -687,160 +1215,131 @@ AdbcStatusCode SqliteConnectionGetConstraintsImpl(
              ArrowArrayAppendString(
                  fk_table_col,
                  (struct ArrowStringView){
-                     .data = to_table, .size_bytes = sqlite3_column_bytes(fk_stmt, 2)}),
+                     .data = to_table, .size_bytes = sqlite3_column_bytes(fk_stmt, 3)}),
              error);
     CHECK_NA(INTERNAL,
              ArrowArrayAppendString(
                  fk_column_name_col,
                  (struct ArrowStringView){
-                     .data = to_col, .size_bytes = sqlite3_column_bytes(fk_stmt, 4)}),
+                     .data = to_col, .size_bytes = sqlite3_column_bytes(fk_stmt, 5)}),
              error);
 
     CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_usage_items), error);
+    *rc = sqlite3_step(fk_stmt);
+  }
+  if (*rc != SQLITE_ROW && *rc != SQLITE_DONE) {
+    SetError(error, "[SQLite] Failed to query for foreign keys: %s",
+             sqlite3_errmsg(reader->conn->conn));
+    return ADBC_STATUS_INTERNAL;
   }
-  RAISE(INTERNAL, rc == SQLITE_DONE, sqlite3_errmsg(conn->conn), error);
   if (prev_fk_id != -1) {
     CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_names_col), error);
     CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_usage_col), error);
     CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_constraints_items), error);
   }
-
   return ADBC_STATUS_OK;
-}  // NOLINT(whitespace/indent)
+}
 
-AdbcStatusCode SqliteConnectionGetTablesInner(
-    struct SqliteConnection* conn, sqlite3_stmt* tables_stmt, sqlite3_stmt* columns_stmt,
-    sqlite3_stmt* pk_stmt, sqlite3_stmt* fk_stmt, const char** table_type,
-    const char* column_name, struct ArrowArray* db_schema_tables_col,
-    struct AdbcError* error) {
+// Append the tables of the next chunk (with their columns and
+// constraints, if requested) to the list of tables of the schema.
+static AdbcStatusCode SqliteGetObjectsAppendChunk(struct SqliteGetObjectsReader* reader,
+                                                  struct ArrowArray* db_schema_tables_col,
+                                                  struct AdbcError* error) {
   struct ArrowArray* db_schema_tables_items = db_schema_tables_col->children[0];
   struct ArrowArray* table_name_col = db_schema_tables_items->children[0];
   struct ArrowArray* table_type_col = db_schema_tables_items->children[1];
   struct ArrowArray* table_columns_col = db_schema_tables_items->children[2];
   struct ArrowArray* table_constraints_col = db_schema_tables_items->children[3];
 
-  int rc = SQLITE_OK;
-  while ((rc = sqlite3_step(tables_stmt)) == SQLITE_ROW) {
-    const char* cur_table_type = (const char*)sqlite3_column_text(tables_stmt, 1);
-
-    if (table_type) {
-      const char** current = table_type;
-      char found = 0;
-      while (*current) {
-        if (strcmp(*current, cur_table_type) == 0) {
-          found = 1;
-          break;
-        }
-        current++;
-      }
-      if (!found) continue;
+  while (reader->has_table && reader->chunk_size < reader->batch_tables) {
+    const int i = reader->chunk_size;
+    reader->chunk_names[i] = sqlite3_mprintf(
+        "%s", (const char*)sqlite3_column_text(reader->tables_stmt, 0));
+    reader->chunk_types[i] = sqlite3_mprintf(
+        "%s", (const char*)sqlite3_column_text(reader->tables_stmt, 1));
+    reader->chunk_size++;
+    if (!reader->chunk_names[i] || !reader->chunk_types[i]) {
+      SetError(error, "[SQLite] Failed to allocate table name");
+      return ADBC_STATUS_INTERNAL;
     }
+    RAISE_ADBC(SqliteGetObjectsReaderStepTable(reader, error));
+  }
+
+  int columns_rc = SQLITE_DONE;
+  int fk_rc = SQLITE_DONE;
+  if (reader->depth == ADBC_OBJECT_DEPTH_COLUMNS && reader->chunk_size > 0) {
+    const char* first = reader->chunk_names[0];
+    const char* last = reader->chunk_names[reader->chunk_size - 1];
+    const char* column_name = reader->column_name ? reader->column_name : "%";
+    columns_rc = sqlite3_bind_text(reader->columns_stmt, 1, first, -1, SQLITE_STATIC);
+    if (columns_rc == SQLITE_OK) {
+      columns_rc = sqlite3_bind_text(reader->columns_stmt, 2, last, -1, SQLITE_STATIC);
+    }
+    if (columns_rc == SQLITE_OK) {
+      columns_rc =
+          sqlite3_bind_text(reader->columns_stmt, 3, column_name, -1, SQLITE_STATIC);
+    }
+    if (columns_rc == SQLITE_OK) columns_rc = sqlite3_step(reader->columns_stmt);
 
-    struct ArrowStringView str = {.data = cur_table_type,
-                                  .size_bytes = sqlite3_column_bytes(tables_stmt, 1)};
-    CHECK_NA(INTERNAL, ArrowArrayAppendString(table_type_col, str), error);
+    fk_rc = sqlite3_bind_text(reader->fk_stmt, 1, first, -1, SQLITE_STATIC);
+    if (fk_rc == SQLITE_OK) {
+      fk_rc = sqlite3_bind_text(reader->fk_stmt, 2, last, -1, SQLITE_STATIC);
+    }
+    if (fk_rc == SQLITE_OK) fk_rc = sqlite3_step(reader->fk_stmt);
+  }
 
-    const char* cur_table = (const char*)sqlite3_column_text(tables_stmt, 0);
-    str.data = cur_table;
-    str.size_bytes = sqlite3_column_bytes(tables_stmt, 0);
-    CHECK_NA(INTERNAL, ArrowArrayAppendString(table_name_col, str), error);
+  AdbcStatusCode status = ADBC_STATUS_OK;
+  for (int i = 0; status == ADBC_STATUS_OK && i < reader->chunk_size; i++) {
+    CHECK_NA(INTERNAL,
+             ArrowArrayAppendString(table_name_col,
+                                    ArrowCharView(reader->chunk_names[i])),
+             error);
+    CHECK_NA(INTERNAL,
+             ArrowArrayAppendString(table_type_col,
+                                    ArrowCharView(reader->chunk_types[i])),
+             error);
 
-    if (columns_stmt == NULL) {
+    if (reader->depth != ADBC_OBJECT_DEPTH_COLUMNS) {
       CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_columns_col, 1), error);
       CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_constraints_col, 1), error);
     } else {
-      // XXX: n + 1 query pattern. You can join on a pragma so we
-      // could avoid this in principle but it complicates the
-      // unpacking code here quite a bit, so ignore for now.
-      RAISE_ADBC(SqliteConnectionGetColumnsImpl(conn, cur_table, column_name,
-                                                table_columns_col, columns_stmt, error));
-      // Not strictly necessary, but we passed SQLITE_STATIC when
-      // binding so don't let the reference leak
-      (void)sqlite3_clear_bindings(columns_stmt);
-      CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_columns_col), error);
-
-      RAISE_ADBC(SqliteConnectionGetConstraintsImpl(
-          conn, cur_table, column_name, table_constraints_col, pk_stmt, fk_stmt, error));
-      (void)sqlite3_clear_bindings(pk_stmt);
-      (void)sqlite3_clear_bindings(fk_stmt);
-      CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_constraints_col), error);
+      status = SqliteGetObjectsAppendColumns(reader, reader->chunk_names[i], &columns_rc,
+                                             table_columns_col, table_constraints_col,
+                                             error);
+      if (status == ADBC_STATUS_OK) {
+        status = SqliteGetObjectsAppendForeignKeys(reader, reader->chunk_names[i], &fk_rc,
+                                                   table_constraints_col, error);
+      }
+      if (status == ADBC_STATUS_OK) {
+        CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_columns_col), error);
+        CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_constraints_col), error);
+      }
+    }
+    if (status == ADBC_STATUS_OK) {
+      CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_tables_items), error);
     }
-    CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_tables_items), error);
   }
 
-  if (rc != SQLITE_DONE) {
-    SetError(error, "[SQLite] Failed to query for tables: %s",
-             sqlite3_errmsg(conn->conn));
-    return ADBC_STATUS_INTERNAL;
+  // The chunk names were bound with SQLITE_STATIC
+  if (reader->columns_stmt) {
+    (void)sqlite3_reset(reader->columns_stmt);
+    (void)sqlite3_clear_bindings(reader->columns_stmt);
   }
+  if (reader->fk_stmt) {
+    (void)sqlite3_reset(reader->fk_stmt);
+    (void)sqlite3_clear_bindings(reader->fk_stmt);
+  }
+  if (status != ADBC_STATUS_OK) return status;
   CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_tables_col), error);
   return ADBC_STATUS_OK;
 }
 
-AdbcStatusCode SqliteConnectionGetTablesImpl(struct SqliteConnection* conn, int depth,
-                                             const char* table_name,
-                                             const char** table_type,
-                                             const char* column_name,
-                                             struct ArrowArray* db_schema_tables_col,
-                                             struct AdbcError* error) {
-  sqlite3_stmt* tables_stmt = NULL;
-  sqlite3_stmt* columns_stmt = NULL;
-  sqlite3_stmt* pk_stmt = NULL;
-  sqlite3_stmt* fk_stmt = NULL;
-  int rc = SQLITE_OK;
-
-  if (rc == SQLITE_OK) {
-    rc = sqlite3_prepare_v2(conn->conn, kTableQuery, sizeof(kTableQuery), &tables_stmt,
-                            /*pzTail=*/NULL);
-  }
-  if (rc == SQLITE_OK && depth == ADBC_OBJECT_DEPTH_COLUMNS) {
-    rc = sqlite3_prepare_v2(conn->conn, kColumnQuery, sizeof(kColumnQuery), &columns_stmt,
-                            /*pzTail=*/NULL);
-  }
-  if (rc == SQLITE_OK && depth == ADBC_OBJECT_DEPTH_COLUMNS) {
-    rc = sqlite3_prepare_v2(conn->conn, kPrimaryKeyQuery, sizeof(kPrimaryKeyQuery),
-                            &pk_stmt, /*pzTail=*/NULL);
-  }
-  if (rc == SQLITE_OK && depth == ADBC_OBJECT_DEPTH_COLUMNS) {
-    rc = sqlite3_prepare_v2(conn->conn, kForeignKeyQuery, sizeof(kForeignKeyQuery),
-                            &fk_stmt, /*pzTail=*/NULL);
-  }
-  if (rc == SQLITE_OK) {
-    if (table_name) {
-      rc = sqlite3_bind_text64(tables_stmt, 1, table_name, strlen(table_name),
-                               SQLITE_STATIC, SQLITE_UTF8);
-    } else {
-      rc = sqlite3_bind_text64(tables_stmt, 1, "%", 1, SQLITE_STATIC, SQLITE_UTF8);
-    }
-  }
-
-  AdbcStatusCode status = ADBC_STATUS_OK;
-  if (rc == SQLITE_OK) {
-    status = SqliteConnectionGetTablesInner(conn, tables_stmt, columns_stmt, pk_stmt,
-                                            fk_stmt, table_type, column_name,
-                                            db_schema_tables_col, error);
-  } else {
-    SetError(error, "[SQLite] Failed to query for tables: %s",
-             sqlite3_errmsg(conn->conn));
-    status = ADBC_STATUS_INTERNAL;
-  }
-
-  sqlite3_finalize(tables_stmt);
-  sqlite3_finalize(columns_stmt);
-  sqlite3_finalize(pk_stmt);
-  sqlite3_finalize(fk_stmt);
-  return status;
-}
-
-AdbcStatusCode SqliteConnectionGetObjectsImpl(
-    struct SqliteConnection* conn, int depth, const char* catalog, const char* db_schema,
-    const char* table_name, const char** table_type, const char* column_name,
-    struct ArrowSchema* schema, struct ArrowArray* array, struct AdbcError* error) {
-  RAISE_ADBC(AdbcInitConnectionObjectsSchema(schema, error));
-
+static AdbcStatusCode SqliteGetObjectsReaderNext(struct SqliteGetObjectsReader* reader,
+                                                 struct ArrowArray* array,
+                                                 struct AdbcError* error) {
   struct ArrowError na_error = {0};
-  CHECK_NA_DETAIL(INTERNAL, ArrowArrayInitFromSchema(array, schema, &na_error), &na_error,
-                  error);
+  CHECK_NA_DETAIL(INTERNAL, ArrowArrayInitFromSchema(array, &reader->schema, &na_error),
+                  &na_error, error);
   CHECK_NA(INTERNAL, ArrowArrayStartAppending(array), error);
 
   struct ArrowArray* catalog_name_col = array->children[0];
@@ -850,8 +1349,11 @@ AdbcStatusCode SqliteConnectionGetObjectsImpl(
   struct ArrowArray* db_schema_name_col = catalog_db_schemas_items->children[0];
   struct ArrowArray* db_schema_tables_col = catalog_db_schemas_items->children[1];
 
+  // Unless there are more tables to read, this is the only batch
+  reader->done = 1;
+
   // TODO: support proper filters
-  if (!catalog || strcmp(catalog, "main") == 0) {
+  if (reader->match_catalog) {
     // Default the primary catalog to "main"
     // https://www.sqlite.org/cli.html
     // > The ".databases" command shows a list of all databases open
@@ -861,18 +1363,17 @@ AdbcStatusCode SqliteConnectionGetObjectsImpl(
     CHECK_NA(INTERNAL, ArrowArrayAppendString(catalog_name_col, ArrowCharView("main")),
              error);
 
-    if (depth == ADBC_OBJECT_DEPTH_CATALOGS) {
+    if (reader->depth == ADBC_OBJECT_DEPTH_CATALOGS) {
       CHECK_NA(INTERNAL, ArrowArrayAppendNull(catalog_db_schemas_col, 1), error);
-    } else if (!db_schema || db_schema == NULL) {
+    } else if (reader->match_db_schema) {
       // For our purposes, we'll consider SQLite to always have a
       // single, unnamed schema within each catalog.
       CHECK_NA(INTERNAL, ArrowArrayAppendNull(db_schema_name_col, 1), error);
-      if (depth == ADBC_OBJECT_DEPTH_DB_SCHEMAS) {
+      if (reader->depth == ADBC_OBJECT_DEPTH_DB_SCHEMAS) {
         CHECK_NA(INTERNAL, ArrowArrayAppendNull(db_schema_tables_col, 1), error);
       } else {
-        RAISE_ADBC(SqliteConnectionGetTablesImpl(conn, depth, table_name, table_type,
-                                                 column_name, db_schema_tables_col,
-                                                 error));
+        RAISE_ADBC(SqliteGetObjectsAppendChunk(reader, db_schema_tables_col, error));
+        reader->done = !reader->has_table;
       }
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_items), error);
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_col), error);
@@ -889,6 +1390,134 @@ AdbcStatusCode SqliteConnectionGetObjectsImpl(
   return ADBC_STATUS_OK;
 }
 
+static int SqliteGetObjectsReaderGetSchema(struct ArrowArrayStream* self,
+                                           struct ArrowSchema* out) {
+  struct SqliteGetObjectsReader* reader =
+      (struct SqliteGetObjectsReader*)self->private_data;
+  return ArrowSchemaDeepCopy(&reader->schema, out);
+}
+
+static int SqliteGetObjectsReaderGetNext(struct ArrowArrayStream* self,
+                                         struct ArrowArray* out) {
+  struct SqliteGetObjectsReader* reader =
+      (struct SqliteGetObjectsReader*)self->private_data;
+  memset(out, 0, sizeof(*out));
+  if (reader->done) return 0;
+
+  AdbcStatusCode status = SqliteGetObjectsReaderNext(reader, out, &reader->error);
+  for (int i = 0; i < reader->chunk_size; i++) {
+    sqlite3_free(reader->chunk_names[i]);
+    sqlite3_free(reader->chunk_types[i]);
+  }
+  reader->chunk_size = 0;
+  if (status != ADBC_STATUS_OK) {
+    if (out->release) out->release(out);
+    reader->done = 1;
+    return EIO;
+  }
+  return 0;
+}
+
+static const char* SqliteGetObjectsReaderGetLastError(struct ArrowArrayStream* self) {
+  struct SqliteGetObjectsReader* reader =
+      (struct SqliteGetObjectsReader*)self->private_data;
+  return reader->error.message;
+}
+
+static void SqliteGetObjectsReaderFree(struct SqliteGetObjectsReader* reader) {
+  struct SqliteStatementCache* cache = &reader->conn->statement_cache;
+  SqliteStatementCacheRelease(cache, reader->tables_stmt);
+  SqliteStatementCacheRelease(cache, reader->columns_stmt);
+  SqliteStatementCacheRelease(cache, reader->fk_stmt);
+  if (reader->table_types) {
+    for (char** current = reader->table_types; *current; current++) free(*current);
+    free(reader->table_types);
+  }
+  free(reader->column_name);
+  for (int i = 0; i < reader->chunk_size; i++) {
+    sqlite3_free(reader->chunk_names[i]);
+    sqlite3_free(reader->chunk_types[i]);
+  }
+  free(reader->chunk_names);
+  free(reader->chunk_types);
+  for (int i = 0; i < reader->pk_capacity; i++) sqlite3_free(reader->pk_columns[i]);
+  free(reader->pk_columns);
+  if (reader->schema.release) reader->schema.release(&reader->schema);
+  if (reader->error.release) reader->error.release(&reader->error);
+  free(reader);
+}
+
+static void SqliteGetObjectsReaderRelease(struct ArrowArrayStream* self) {
+  if (self->private_data) {
+    struct SqliteGetObjectsReader* reader =
+        (struct SqliteGetObjectsReader*)self->private_data;
+    reader->conn->num_get_objects_streams--;
+    SqliteGetObjectsReaderFree(reader);
+  }
+  self->private_data = NULL;
+  self->release = NULL;
+}
+
+static AdbcStatusCode SqliteGetObjectsReaderInit(
+    struct SqliteGetObjectsReader* reader, const char* table_name,
+    const char** table_type, const char* column_name, struct AdbcError* error) {
+  RAISE_ADBC(AdbcInitConnectionObjectsSchema(&reader->schema, error));
+  if (!reader->match_catalog || !reader->match_db_schema ||
+      reader->depth == ADBC_OBJECT_DEPTH_CATALOGS ||
+      reader->depth == ADBC_OBJECT_DEPTH_DB_SCHEMAS) {
+    return ADBC_STATUS_OK;
+  }
+
+  if (table_type) {
+    size_t num_types = 0;
+    while (table_type[num_types]) num_types++;
+    reader->table_types = (char**)calloc(num_types + 1, sizeof(char*));
+    if (!reader->table_types) {
+      SetError(error, "[SQLite] Failed to allocate table types");
+      return ADBC_STATUS_INTERNAL;
+    }
+    for (size_t i = 0; i < num_types; i++) {
+      reader->table_types[i] = strdup(table_type[i]);
+      if (!reader->table_types[i]) {
+        SetError(error, "[SQLite] Failed to allocate table types");
+        return ADBC_STATUS_INTERNAL;
+      }
+    }
+  }
+  if (column_name) {
+    reader->column_name = strdup(column_name);
+    if (!reader->column_name) {
+      SetError(error, "[SQLite] Failed to allocate column name");
+      return ADBC_STATUS_INTERNAL;
+    }
+  }
+  reader->chunk_names = (char**)calloc((size_t)reader->batch_tables, sizeof(char*));
+  reader->chunk_types = (char**)calloc((size_t)reader->batch_tables, sizeof(char*));
+  if (!reader->chunk_names || !reader->chunk_types) {
+    SetError(error, "[SQLite] Failed to allocate table names");
+    return ADBC_STATUS_INTERNAL;
+  }
+
+  struct SqliteStatementCache* cache = &reader->conn->statement_cache;
+  sqlite3* db = reader->conn->conn;
+  int rc = SqliteStatementCacheAcquire(cache, db, kTableQuery, -1, &reader->tables_stmt);
+  if (rc == SQLITE_OK && reader->depth == ADBC_OBJECT_DEPTH_COLUMNS) {
+    rc = SqliteStatementCacheAcquire(cache, db, kColumnQuery, -1, &reader->columns_stmt);
+  }
+  if (rc == SQLITE_OK && reader->depth == ADBC_OBJECT_DEPTH_COLUMNS) {
+    rc = SqliteStatementCacheAcquire(cache, db, kForeignKeyQuery, -1, &reader->fk_stmt);
+  }
+  if (rc == SQLITE_OK) {
+    rc = sqlite3_bind_text(reader->tables_stmt, 1, table_name ? table_name : "%", -1,
+                           SQLITE_TRANSIENT);
+  }
+  if (rc != SQLITE_OK) {
+    SetError(error, "[SQLite] Failed to query for tables: %s", sqlite3_errmsg(db));
+    return ADBC_STATUS_INTERNAL;
+  }
+  return SqliteGetObjectsReaderStepTable(reader, error);
+}
+
 AdbcStatusCode SqliteConnectionGetObjects(struct AdbcConnection* connection, int depth,
                                           const char* catalog, const char* db_schema,
                                           const char* table_name, const char** table_type,
@@ -898,19 +1527,32 @@ AdbcStatusCode SqliteConnectionGetObjects(struct AdbcConnection* connection, int
   CHECK_CONN_INIT(connection, error);
   struct SqliteConnection* conn = (struct SqliteConnection*)connection->private_data;
 
-  struct ArrowSchema schema = {0};
-  struct ArrowArray array = {0};
+  struct SqliteGetObjectsReader* reader =
+      (struct SqliteGetObjectsReader*)calloc(1, sizeof(struct SqliteGetObjectsReader));
+  if (!reader) {
+    SetError(error, "[SQLite] Failed to allocate GetObjects reader");
+    return ADBC_STATUS_INTERNAL;
+  }
+  reader->conn = conn;
+  reader->depth = depth;
+  reader->match_catalog = !catalog || strcmp(catalog, "main") == 0;
+  reader->match_db_schema = db_schema == NULL;
+  reader->batch_tables = conn->get_objects_batch_tables;
 
   AdbcStatusCode status =
-      SqliteConnectionGetObjectsImpl(conn, depth, catalog, db_schema, table_name,
-                                     table_type, column_name, &schema, &array, error);
+      SqliteGetObjectsReaderInit(reader, table_name, table_type, column_name, error);
   if (status != ADBC_STATUS_OK) {
-    if (schema.release) schema.release(&schema);
-    if (array.release) array.release(&array);
+    SqliteGetObjectsReaderFree(reader);
     return status;
   }
 
-  return BatchToArrayStream(&array, &schema, out, error);
+  out->get_schema = SqliteGetObjectsReaderGetSchema;
+  out->get_next = SqliteGetObjectsReaderGetNext;
+  out->get_last_error = SqliteGetObjectsReaderGetLastError;
+  out->release = SqliteGetObjectsReaderRelease;
+  out->private_data = reader;
+  conn->num_get_objects_streams++;
+  return ADBC_STATUS_OK;
 }
 
 AdbcStatusCode SqliteConnectionGetOption(struct AdbcConnection* connection,
@@ -938,6 +1580,20 @@ AdbcStatusCode SqliteConnectionGetOptionInt(struct AdbcConnection* connection,
                                             const char* key, int64_t* value,
                                             struct AdbcError* error) {
   CHECK_DB_INIT(connection, error);
+  struct SqliteConnection* conn = (struct SqliteConnection*)connection->private_data;
+  if (strcmp(key, kConnectionOptionStatementCacheCapacity) == 0) {
+    *value = conn->statement_cache.capacity;
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kConnectionOptionStatementCacheHits) == 0) {
+    *value = conn->statement_cache.hits;
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kConnectionOptionStatementCacheMisses) == 0) {
+    *value = conn->statement_cache.misses;
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kConnectionOptionGetObjectsBatchTables) == 0) {
+    *value = conn->get_objects_batch_tables;
+    return ADBC_STATUS_OK;
+  }
   return ADBC_STATUS_NOT_FOUND;
 }
 
@@ -1012,35 +1668,422 @@ AdbcStatusCode SqliteConnectionGetTableTypesImpl(struct ArrowSchema* schema,
   CHECK_NA(INTERNAL, ArrowSchemaSetName(schema->children[0], "table_type"), error);
   schema->children[0]->flags &= ~ARROW_FLAG_NULLABLE;
 
-  CHECK_NA(INTERNAL, ArrowArrayInitFromSchema(array, schema, NULL), error);
-  CHECK_NA(INTERNAL, ArrowArrayStartAppending(array), error);
+  CHECK_NA(INTERNAL, ArrowArrayInitFromSchema(array, schema, NULL), error);
+  CHECK_NA(INTERNAL, ArrowArrayStartAppending(array), error);
+
+  CHECK_NA(INTERNAL, ArrowArrayAppendString(array->children[0], ArrowCharView("table")),
+           error);
+  CHECK_NA(INTERNAL, ArrowArrayFinishElement(array), error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendString(array->children[0], ArrowCharView("view")),
+           error);
+  CHECK_NA(INTERNAL, ArrowArrayFinishElement(array), error);
+
+  CHECK_NA(INTERNAL, ArrowArrayFinishBuildingDefault(array, NULL), error);
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode SqliteConnectionGetTableTypes(struct AdbcConnection* connection,
+                                             struct ArrowArrayStream* out,
+                                             struct AdbcError* error) {
+  CHECK_CONN_INIT(connection, error);
+
+  struct ArrowSchema schema = {0};
+  struct ArrowArray array = {0};
+
+  AdbcStatusCode status = SqliteConnectionGetTableTypesImpl(&schema, &array, error);
+  if (status != ADBC_STATUS_OK) {
+    if (schema.release) schema.release(&schema);
+    if (array.release) array.release(&array);
+    return status;
+  }
+  return BatchToArrayStream(&array, &schema, out, error);
+}
+
+// -- Partitioned execution ------------------------------------------
+//
+// A query over a single rowid table is split into partitions covering
+// disjoint rowid ranges. Each partition descriptor holds the rewritten
+// query, which ReadPartition executes on a separate read-only
+// connection to the same database file, so that partitions can be
+// read in parallel. Queries that can't be split this way (joins,
+// aggregates, ordering, ...) become a single partition, as do queries
+// that must be read on the original connection (reading TEMP tables or
+// attached databases, or with uncommitted changes). The result schema is
+// computed once, when planning, and every partition is read with it.
+
+static const char kPartitionDescriptorPrefix[] = "adbc.sqlite.partition.v2\n";
+
+// Return the offset just past the literal, quoted identifier or comment
+// starting at offset i, or i if there is none.
+static size_t SqliteSkipQuotedOrComment(const char* query, size_t len, size_t i) {
+  const char c = query[i];
+  if (c == '\'' || c == '"' || c == '`') {
+    size_t j = i + 1;
+    while (j < len) {
+      if (query[j] == c) {
+        // A doubled quote is an escaped quote
+        if (j + 1 < len && query[j + 1] == c) {
+          j += 2;
+          continue;
+        }
+        return j + 1;
+      }
+      j++;
+    }
+    return len;
+  } else if (c == '[') {
+    const char* end = memchr(query + i, ']', len - i);
+    return end ? (size_t)(end - query) + 1 : len;
+  } else if (c == '-' && i + 1 < len && query[i + 1] == '-') {
+    const char* end = memchr(query + i, '\n', len - i);
+    return end ? (size_t)(end - query) : len;
+  } else if (c == '/' && i + 1 < len && query[i + 1] == '*') {
+    for (size_t j = i + 2; j + 1 < len; j++) {
+      if (query[j] == '*' && query[j + 1] == '/') return j + 2;
+    }
+    return len;
+  }
+  return i;
+}
+
+// Find the first occurrence of one of the given keywords (NULL-terminated
+// list) outside of literals, comments and parentheses, starting at offset
+// start. Returns the offset, or -1 if none is found.
+static int64_t SqliteFindTopLevelKeyword(const char* query, size_t len, size_t start,
+                                         const char* const* keywords) {
+  int depth = 0;
+  size_t i = start;
+  while (i < len) {
+    const char c = query[i];
+    size_t skipped = SqliteSkipQuotedOrComment(query, len, i);
+    if (skipped != i) {
+      i = skipped;
+    } else if (c == '(') {
+      depth++;
+      i++;
+    } else if (c == ')') {
+      depth--;
+      i++;
+    } else if (isalpha((unsigned char)c) || c == '_') {
+      size_t word_start = i;
+      while (i < len && (isalnum((unsigned char)query[i]) || query[i] == '_' ||
+                         query[i] == '$')) {
+        i++;
+      }
+      if (depth != 0) continue;
+      for (const char* const* keyword = keywords; *keyword; keyword++) {
+        if (strlen(*keyword) == i - word_start &&
+            sqlite3_strnicmp(*keyword, query + word_start, (int)(i - word_start)) == 0) {
+          return (int64_t)word_start;
+        }
+      }
+    } else {
+      i++;
+    }
+  }
+  return -1;
+}
+
+// Check whether query[start, len) calls one of the given functions
+// (NULL-terminated list) outside of literals and comments, at any depth.
+static char SqliteCallsFunction(const char* query, size_t len, size_t start,
+                                const char* const* names) {
+  size_t i = start;
+  while (i < len) {
+    const char c = query[i];
+    size_t skipped = SqliteSkipQuotedOrComment(query, len, i);
+    if (skipped != i) {
+      i = skipped;
+    } else if (isalpha((unsigned char)c) || c == '_') {
+      size_t word_start = i;
+      while (i < len && (isalnum((unsigned char)query[i]) || query[i] == '_' ||
+                         query[i] == '$')) {
+        i++;
+      }
+      size_t next = i;
+      while (next < len && isspace((unsigned char)query[next])) next++;
+      if (next >= len || query[next] != '(') continue;
+      for (const char* const* name = names; *name; name++) {
+        if (strlen(*name) == i - word_start &&
+            sqlite3_strnicmp(*name, query + word_start, (int)(i - word_start)) == 0) {
+          return 1;
+        }
+      }
+    } else {
+      i++;
+    }
+  }
+  return 0;
+}
+
+// Check whether a query can be split by rowid, and if so, find its
+// top-level FROM and WHERE (-1 if absent) clauses.
+static char SqliteIsRowidPartitionable(const char* query, size_t len,
+                                       int64_t* from_offset, int64_t* where_offset) {
+  static const char* const kSelect[] = {"SELECT", NULL};
+  static const char* const kFrom[] = {"FROM", NULL};
+  static const char* const kWhere[] = {"WHERE", NULL};
+  // Clauses whose result would change if evaluated per partition, or
+  // which make rowid ambiguous
+  static const char* const kUnpartitionable[] = {
+      "DISTINCT", "GROUP", "HAVING", "ORDER", "LIMIT",  "OFFSET", "UNION", "INTERSECT",
+      "EXCEPT",   "WINDOW", "OVER",  "JOIN",  "VALUES", "WITH",   NULL};
+  // Aggregates anywhere in the select list, e.g. abs(max(x)) (user-defined
+  // ones can't be detected)
+  static const char* const kAggregates[] = {
+      "COUNT",      "SUM",       "TOTAL",           "AVG",
+      "MIN",        "MAX",       "GROUP_CONCAT",    "STRING_AGG",
+      "JSON_GROUP_ARRAY", "JSON_GROUP_OBJECT", NULL};
+
+  size_t first = 0;
+  while (first < len && isspace((unsigned char)query[first])) first++;
+  if (SqliteFindTopLevelKeyword(query, len, 0, kSelect) != (int64_t)first) return 0;
+  if (SqliteFindTopLevelKeyword(query, len, 0, kUnpartitionable) >= 0) return 0;
+
+  *from_offset = SqliteFindTopLevelKeyword(query, len, 0, kFrom);
+  if (*from_offset < 0) return 0;
+  if (SqliteCallsFunction(query, (size_t)*from_offset, 0, kAggregates)) return 0;
+  *where_offset = SqliteFindTopLevelKeyword(query, len, (size_t)*from_offset, kWhere);
+
+  // The FROM clause must name a single table: no lists or subqueries
+  size_t from_end = *where_offset >= 0 ? (size_t)*where_offset : len;
+  size_t i = (size_t)*from_offset;
+  while (i < from_end) {
+    size_t skipped = SqliteSkipQuotedOrComment(query, from_end, i);
+    if (skipped != i) {
+      i = skipped;
+      continue;
+    }
+    if (query[i] == ',' || query[i] == '(') return 0;
+    i++;
+  }
+  return 1;
+}
+
+// Partitions are read on other connections, which see only the
+// committed contents of the main database. To check that a query reads
+// nothing else, it is prepared once more with an authorizer that
+// records which databases (and views, which may be TEMP views) it
+// reads.
+struct SqliteReadScope {
+  char other_database;
+  char view;
+};
+
+static int SqliteReadScopeAuthorizer(void* user_data, int action, const char* table,
+                                     const char* column, const char* database,
+                                     const char* view) {
+  struct SqliteReadScope* scope = (struct SqliteReadScope*)user_data;
+  if (action == SQLITE_READ) {
+    if (database && strcmp(database, "main") != 0) scope->other_database = 1;
+    if (view) scope->view = 1;
+  }
+  return SQLITE_OK;
+}
+
+/// Check whether a query can be read on another connection to the same
+/// database: it reads only the main database, and there are no
+/// uncommitted changes.
+static char SqliteIsShareable(sqlite3* conn, const char* query, size_t query_len) {
+  if (!sqlite3_get_autocommit(conn)) return 0;
+
+  struct SqliteReadScope scope = {0, 0};
+  sqlite3_stmt* probe = NULL;
+  (void)sqlite3_set_authorizer(conn, SqliteReadScopeAuthorizer, &scope);
+  int rc = sqlite3_prepare_v2(conn, query, (int)query_len, &probe, /*pzTail=*/NULL);
+  (void)sqlite3_set_authorizer(conn, NULL, NULL);
+  (void)sqlite3_finalize(probe);
+  if (rc != SQLITE_OK || scope.other_database) return 0;
+  if (!scope.view) return 1;
+
+  char has_temp_views = 1;
+  sqlite3_stmt* check = NULL;
+  if (sqlite3_prepare_v2(conn, "SELECT 1 FROM temp.sqlite_master WHERE type = 'view'",
+                         -1, &check, /*pzTail=*/NULL) == SQLITE_OK) {
+    has_temp_views = sqlite3_step(check) == SQLITE_ROW;
+  }
+  (void)sqlite3_finalize(check);
+  return !has_temp_views;
+}
+
+// The descriptor header is "<batch_size> <shared> <dictionary
+// threshold>\n<column types>\n", where shared is 1 if the partition may
+// be read on a separate connection, and the column types are the Arrow
+// format strings of the result schema computed when planning (a
+// dictionary-encoded column is written as "<index format>=<value
+// format>"), so that every partition produces that same schema.
+static char* SqlitePartitionHeader(const struct SqliteStatement* stmt, char shared,
+                                   const struct ArrowSchema* schema) {
+  sqlite3_str* str = sqlite3_str_new(NULL);
+  sqlite3_str_appendf(str, "%s%d %d %d\n", kPartitionDescriptorPrefix,
+                      stmt->batch_size, shared ? 1 : 0, stmt->dictionary_threshold);
+  for (int64_t i = 0; i < schema->n_children; i++) {
+    const struct ArrowSchema* child = schema->children[i];
+    if (i > 0) sqlite3_str_appendchar(str, 1, ' ');
+    sqlite3_str_appendall(str, child->format);
+    if (child->dictionary) sqlite3_str_appendf(str, "=%s", child->dictionary->format);
+  }
+  sqlite3_str_appendall(str, "\n");
+  if (sqlite3_str_errcode(str)) {
+    sqlite3_free(sqlite3_str_finish(str));
+    return NULL;
+  }
+  return sqlite3_str_finish(str);
+}
+
+static char SqliteParsePartitionHeader(const char* header, size_t len,
+                                       struct AdbcSqliteReaderOptions* options,
+                                       char* shared) {
+  char buf[64];
+  if (len >= sizeof(buf)) return 0;
+  memcpy(buf, header, len);
+  buf[len] = '\0';
+
+  char* end = NULL;
+  errno = 0;
+  long value = strtol(buf, &end, /*base=*/10);  // NOLINT(runtime/int)
+  if (errno != 0 || end == buf || *end != ' ' || value <= 0 ||
+      value > (long)INT_MAX) {  // NOLINT(runtime/int)
+    return 0;
+  }
+  const char* flag = end + 1;
+  if ((flag[0] != '0' && flag[0] != '1') || flag[1] != ' ') return 0;
+  const char* threshold_start = flag + 2;
+  long threshold = strtol(threshold_start, &end, /*base=*/10);  // NOLINT(runtime/int)
+  if (errno != 0 || end == threshold_start || *end != '\0' || threshold < 0 ||
+      threshold > (long)INT_MAX) {  // NOLINT(runtime/int)
+    return 0;
+  }
+  memset(options, 0, sizeof(*options));
+  options->batch_size = (size_t)value;
+  options->dictionary_threshold = (size_t)threshold;
+  *shared = flag[0] == '1';
+  return 1;
+}
+
+// Build the result schema of a partition from the column types in its
+// descriptor, taking the column names from the prepared statement.
+static AdbcStatusCode SqliteParsePartitionSchema(const char* types, size_t len,
+                                                 sqlite3_stmt* stmt,
+                                                 struct ArrowSchema* schema,
+                                                 struct AdbcError* error) {
+  const int num_columns = sqlite3_column_count(stmt);
+  ArrowSchemaInit(schema);
+  int na_res = ArrowSchemaSetTypeStruct(schema, num_columns);
+  char format[32];
+  size_t pos = 0;
+  for (int col = 0; na_res == 0 && col < num_columns; col++) {
+    const char* start = types + pos;
+    const char* space = memchr(start, ' ', len - pos);
+    size_t token_len = space ? (size_t)(space - start) : len - pos;
+    if (token_len == 0 || token_len >= sizeof(format) ||
+        (col + 1 < num_columns) != (space != NULL)) {
+      na_res = EINVAL;
+      break;
+    }
+    memcpy(format, start, token_len);
+    format[token_len] = '\0';
+    pos += token_len + (space ? 1 : 0);
+
+    struct ArrowSchema* child = schema->children[col];
+    char* value_format = strchr(format, '=');
+    if (value_format) *value_format++ = '\0';
+    na_res = ArrowSchemaSetFormat(child, format);
+    if (na_res == 0) na_res = ArrowSchemaSetName(child, sqlite3_column_name(stmt, col));
+    if (na_res == 0 && value_format) {
+      na_res = ArrowSchemaAllocateDictionary(child);
+      if (na_res == 0) {
+        ArrowSchemaInit(child->dictionary);
+        na_res = ArrowSchemaSetFormat(child->dictionary, value_format);
+      }
+    }
+  }
+  if (na_res == 0 && pos != len) na_res = EINVAL;
+  if (na_res != 0) {
+    schema->release(schema);
+    SetError(error,
+             "[SQLite] AdbcConnectionReadPartition: invalid partition schema for "
+             "a query with %d columns",
+             num_columns);
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  return ADBC_STATUS_OK;
+}
+
+static void SqliteStatementReaderOptions(const struct SqliteStatement* stmt,
+                                         struct AdbcSqliteReaderOptions* options) {
+  memset(options, 0, sizeof(*options));
+  options->batch_size = (size_t)stmt->batch_size;
+  options->use_declared_types = stmt->use_declared_types;
+  options->dictionary_threshold = (size_t)stmt->dictionary_threshold;
+}
 
-  CHECK_NA(INTERNAL, ArrowArrayAppendString(array->children[0], ArrowCharView("table")),
-           error);
-  CHECK_NA(INTERNAL, ArrowArrayFinishElement(array), error);
-  CHECK_NA(INTERNAL, ArrowArrayAppendString(array->children[0], ArrowCharView("view")),
-           error);
-  CHECK_NA(INTERNAL, ArrowArrayFinishElement(array), error);
+struct SqlitePartitions {
+  size_t num_partitions;
+  char** descriptors;
+  const uint8_t** pointers;
+  size_t* lengths;
+};
 
-  CHECK_NA(INTERNAL, ArrowArrayFinishBuildingDefault(array, NULL), error);
-  return ADBC_STATUS_OK;
+static void SqlitePartitionsRelease(struct AdbcPartitions* partitions) {
+  struct SqlitePartitions* private_data =
+      (struct SqlitePartitions*)partitions->private_data;
+  if (private_data) {
+    for (size_t i = 0; i < private_data->num_partitions; i++) {
+      sqlite3_free(private_data->descriptors[i]);
+    }
+    free(private_data->descriptors);
+    free(private_data->pointers);
+    free(private_data->lengths);
+    free(private_data);
+  }
+  partitions->num_partitions = 0;
+  partitions->partitions = NULL;
+  partitions->partition_lengths = NULL;
+  partitions->private_data = NULL;
+  partitions->release = NULL;
+}
+
+// Wraps the reader for a partition, owning its statement and (if the
+// partition is read on a separate connection) its pooled connection.
+struct SqlitePartitionReader {
+  struct SqliteDatabase* database;
+  sqlite3* db;
+  sqlite3_stmt* stmt;
+  struct ArrowArrayStream inner;
+};
+
+static int SqlitePartitionReaderGetSchema(struct ArrowArrayStream* self,
+                                          struct ArrowSchema* out) {
+  struct SqlitePartitionReader* reader =
+      (struct SqlitePartitionReader*)self->private_data;
+  return reader->inner.get_schema(&reader->inner, out);
 }
 
-AdbcStatusCode SqliteConnectionGetTableTypes(struct AdbcConnection* connection,
-                                             struct ArrowArrayStream* out,
-                                             struct AdbcError* error) {
-  CHECK_CONN_INIT(connection, error);
+static int SqlitePartitionReaderGetNext(struct ArrowArrayStream* self,
+                                        struct ArrowArray* out) {
+  struct SqlitePartitionReader* reader =
+      (struct SqlitePartitionReader*)self->private_data;
+  return reader->inner.get_next(&reader->inner, out);
+}
 
-  struct ArrowSchema schema = {0};
-  struct ArrowArray array = {0};
+static const char* SqlitePartitionReaderGetLastError(struct ArrowArrayStream* self) {
+  struct SqlitePartitionReader* reader =
+      (struct SqlitePartitionReader*)self->private_data;
+  return reader->inner.get_last_error(&reader->inner);
+}
 
-  AdbcStatusCode status = SqliteConnectionGetTableTypesImpl(&schema, &array, error);
-  if (status != ADBC_STATUS_OK) {
-    if (schema.release) schema.release(&schema);
-    if (array.release) array.release(&array);
-    return status;
+static void SqlitePartitionReaderRelease(struct ArrowArrayStream* self) {
+  struct SqlitePartitionReader* reader =
+      (struct SqlitePartitionReader*)self->private_data;
+  if (reader) {
+    if (reader->inner.release) reader->inner.release(&reader->inner);
+    if (reader->stmt) (void)sqlite3_finalize(reader->stmt);
+    if (reader->db) SqliteDatabaseReleaseReader(reader->database, reader->db);
+    free(reader);
   }
-  return BatchToArrayStream(&array, &schema, out, error);
+  self->private_data = NULL;
+  self->release = NULL;
 }
 
 AdbcStatusCode SqliteConnectionReadPartition(struct AdbcConnection* connection,
@@ -1049,7 +2092,90 @@ AdbcStatusCode SqliteConnectionReadPartition(struct AdbcConnection* connection,
                                              struct ArrowArrayStream* out,
                                              struct AdbcError* error) {
   CHECK_CONN_INIT(connection, error);
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+  struct SqliteConnection* conn = (struct SqliteConnection*)connection->private_data;
+  if (!conn->conn) {
+    SetError(error, "[SQLite] AdbcConnectionReadPartition: connection not initialized");
+    return ADBC_STATUS_INVALID_STATE;
+  }
+
+  const size_t prefix_len = sizeof(kPartitionDescriptorPrefix) - 1;
+  const char* descriptor = (const char*)serialized_partition;
+  if (serialized_length <= prefix_len ||
+      memcmp(descriptor, kPartitionDescriptorPrefix, prefix_len) != 0) {
+    SetError(error, "[SQLite] AdbcConnectionReadPartition: invalid partition descriptor");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  const char* end = descriptor + serialized_length;
+  const char* header = descriptor + prefix_len;
+  const char* types = memchr(header, '\n', (size_t)(end - header));
+  const char* query = types ? memchr(types + 1, '\n', (size_t)(end - types - 1)) : NULL;
+  struct AdbcSqliteReaderOptions options;
+  char shared = 0;
+  if (!query ||
+      !SqliteParsePartitionHeader(header, (size_t)(types - header), &options, &shared)) {
+    SetError(error, "[SQLite] AdbcConnectionReadPartition: invalid partition descriptor");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  types++;
+  const size_t types_len = (size_t)(query - types);
+  query++;
+  const size_t query_len = (size_t)(end - query);
+
+  struct SqlitePartitionReader* reader =
+      (struct SqlitePartitionReader*)malloc(sizeof(struct SqlitePartitionReader));
+  memset(reader, 0, sizeof(*reader));
+
+  // Read file databases on a separate read-only connection from the
+  // database's pool so partitions can be consumed concurrently.
+  // In-memory databases have no file, and TEMP tables, attached
+  // databases, and uncommitted changes are only visible to this
+  // connection, so read those on this connection.
+  const char* filename = sqlite3_db_filename(conn->conn, "main");
+  sqlite3* db = conn->conn;
+  if (shared && filename && filename[0] != '\0' && !conn->active_transaction) {
+    AdbcStatusCode status =
+        SqliteDatabaseAcquireReader(conn->database, filename, &reader->db, error);
+    if (status != ADBC_STATUS_OK) {
+      free(reader);
+      return status;
+    }
+    reader->database = conn->database;
+    db = reader->db;
+  }
+
+  int rc = sqlite3_prepare_v2(db, query, (int)query_len, &reader->stmt,
+                              /*pzTail=*/NULL);
+  if (rc != SQLITE_OK) {
+    SetError(error, "[SQLite] Failed to prepare query: %s\nQuery:%.*s",
+             sqlite3_errmsg(db), (int)query_len, query);
+    (void)sqlite3_finalize(reader->stmt);
+    if (reader->db) SqliteDatabaseReleaseReader(reader->database, reader->db);
+    free(reader);
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+
+  struct ArrowSchema schema;
+  AdbcStatusCode status =
+      SqliteParsePartitionSchema(types, types_len, reader->stmt, &schema, error);
+  if (status == ADBC_STATUS_OK) {
+    options.schema = &schema;
+    status = AdbcSqliteExportReaderWithOptions(db, reader->stmt, /*binder=*/NULL,
+                                               &options, &reader->inner, error);
+    schema.release(&schema);
+  }
+  if (status != ADBC_STATUS_OK) {
+    (void)sqlite3_finalize(reader->stmt);
+    if (reader->db) SqliteDatabaseReleaseReader(reader->database, reader->db);
+    free(reader);
+    return status;
+  }
+
+  out->get_schema = SqlitePartitionReaderGetSchema;
+  out->get_next = SqlitePartitionReaderGetNext;
+  out->get_last_error = SqlitePartitionReaderGetLastError;
+  out->release = SqlitePartitionReaderRelease;
+  out->private_data = reader;
+  return ADBC_STATUS_OK;
 }
 
 AdbcStatusCode SqliteConnectionCommit(struct AdbcConnection* connection,
@@ -1097,9 +2223,11 @@ AdbcStatusCode SqliteStatementNew(struct AdbcConnection* connection,
   memset(statement->private_data, 0, sizeof(struct SqliteStatement));
   struct SqliteStatement* stmt = (struct SqliteStatement*)statement->private_data;
   stmt->conn = conn->conn;
+  stmt->statement_cache = &conn->statement_cache;
 
   // Default options
   stmt->batch_size = 1024;
+  stmt->partition_count = 4;
 
   return ADBC_STATUS_OK;
 }
@@ -1109,23 +2237,15 @@ AdbcStatusCode SqliteStatementRelease(struct AdbcStatement* statement,
   CHECK_STMT_INIT(statement, error);
   struct SqliteStatement* stmt = (struct SqliteStatement*)statement->private_data;
 
-  int rc = SQLITE_OK;
-  if (stmt->stmt) {
-    rc = sqlite3_finalize(stmt->stmt);
-  }
+  SqliteStatementCacheRelease(stmt->statement_cache, stmt->stmt);
   if (stmt->query) free(stmt->query);
   AdbcSqliteBinderRelease(&stmt->binder);
   if (stmt->target_catalog) free(stmt->target_catalog);
   if (stmt->target_table) free(stmt->target_table);
-  if (rc != SQLITE_OK) {
-    SetError(error,
-             "[SQLite] AdbcStatementRelease: statement failed to finalize: (%d) %s", rc,
-             sqlite3_errmsg(stmt->conn));
-  }
   free(statement->private_data);
   statement->private_data = NULL;
 
-  return rc == SQLITE_OK ? ADBC_STATUS_OK : ADBC_STATUS_IO;
+  return ADBC_STATUS_OK;
 }
 
 AdbcStatusCode SqliteStatementPrepare(struct AdbcStatement* statement,
@@ -1138,19 +2258,11 @@ AdbcStatusCode SqliteStatementPrepare(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   if (stmt->prepared == 0) {
-    if (stmt->stmt) {
-      int rc = sqlite3_finalize(stmt->stmt);
-      stmt->stmt = NULL;
-      if (rc != SQLITE_OK) {
-        SetError(error, "[SQLite] Failed to finalize previous statement: (%d) %s", rc,
-                 sqlite3_errmsg(stmt->conn));
-        return ADBC_STATUS_IO;
-      }
-    }
+    SqliteStatementCacheRelease(stmt->statement_cache, stmt->stmt);
+    stmt->stmt = NULL;
 
-    int rc =
-        sqlite3_prepare_v2(stmt->conn, stmt->query, (int)stmt->query_len, &stmt->stmt,
-                           /*pzTail=*/NULL);
+    int rc = SqliteStatementCacheAcquire(stmt->statement_cache, stmt->conn, stmt->query,
+                                         /*len=*/-1, &stmt->stmt);
     if (rc != SQLITE_OK) {
       SetError(error, "[SQLite] Failed to prepare query: %s\nQuery:%s",
                sqlite3_errmsg(stmt->conn), stmt->query);
@@ -1164,8 +2276,11 @@ AdbcStatusCode SqliteStatementPrepare(struct AdbcStatement* statement,
   return ADBC_STATUS_OK;
 }
 
+// Create the target table if needed, and build the INSERT up to the
+// VALUES clause (which the caller sizes to the number of rows per
+// statement). insert_prefix must be freed with sqlite3_free.
 AdbcStatusCode SqliteStatementInitIngest(struct SqliteStatement* stmt,
-                                         sqlite3_stmt** insert_statement,
+                                         char** insert_prefix,
                                          struct AdbcError* error) {
   AdbcStatusCode code = ADBC_STATUS_OK;
 
@@ -1291,9 +2406,43 @@ AdbcStatusCode SqliteStatementInitIngest(struct SqliteStatement* stmt,
         break;
       case NANOARROW_TYPE_STRING:
       case NANOARROW_TYPE_LARGE_STRING:
-      case NANOARROW_TYPE_DATE32:
         sqlite3_str_appendf(create_query, " TEXT");
         break;
+      case NANOARROW_TYPE_DATE32:
+      case NANOARROW_TYPE_TIMESTAMP: {
+        if (!stmt->temporal_mode_set) {
+          if (view.type == NANOARROW_TYPE_DATE32) {
+            sqlite3_str_appendf(create_query, " TEXT");
+          }
+          break;
+        }
+        // Declare a type that the reader maps back (see use_declared_types),
+        // prefixed so that the column gets the affinity of the stored values
+        // (else e.g. whole Julian days would be stored as integers). The
+        // precision gives the unit of stored integers, or of the timestamp.
+        static const int kPrecision[] = {0, 3, 6, 9};
+        const int epoch_unit = AdbcSqliteTemporalModeUnit(stmt->temporal_mode);
+        const char* name = "TIMESTAMP";
+        int unit = view.time_unit;
+        if (view.type == NANOARROW_TYPE_DATE32) {
+          name = "DATE";
+          unit = NANOARROW_TIME_UNIT_SECOND;
+        }
+        const char* affinity = "TEXT";
+        if (epoch_unit >= 0) {
+          affinity = "INTEGER";
+          unit = epoch_unit;
+        } else if (stmt->temporal_mode == ADBC_SQLITE_TEMPORAL_JULIANDAY) {
+          affinity = "REAL";
+        }
+        if (kPrecision[unit] == 0) {
+          sqlite3_str_appendf(create_query, " %s %s", affinity, name);
+        } else {
+          sqlite3_str_appendf(create_query, " %s %s(%d)", affinity, name,
+                              kPrecision[unit]);
+        }
+        break;
+      }
       case NANOARROW_TYPE_BINARY:
         sqlite3_str_appendf(create_query, " BLOB");
         break;
@@ -1309,23 +2458,7 @@ AdbcStatusCode SqliteStatementInitIngest(struct SqliteStatement* stmt,
     goto cleanup;
   }
 
-  sqlite3_str_appendall(insert_query, ") VALUES (");
-  if (sqlite3_str_errcode(insert_query)) {
-    SetError(error, "[SQLite] Failed to build INSERT: %s", sqlite3_errmsg(stmt->conn));
-    code = ADBC_STATUS_INTERNAL;
-    goto cleanup;
-  }
-
-  for (int i = 0; i < stmt->binder.schema.n_children; i++) {
-    sqlite3_str_appendf(insert_query, "%s?", (i > 0 ? ", " : ""));
-    if (sqlite3_str_errcode(insert_query)) {
-      SetError(error, "[SQLite] Failed to build INSERT: %s", sqlite3_errmsg(stmt->conn));
-      code = ADBC_STATUS_INTERNAL;
-      goto cleanup;
-    }
-  }
-
-  sqlite3_str_appendchar(insert_query, 1, ')');
+  sqlite3_str_appendall(insert_query, ") VALUES ");
   if (sqlite3_str_errcode(insert_query)) {
     SetError(error, "[SQLite] Failed to build INSERT: %s", sqlite3_errmsg(stmt->conn));
     code = ADBC_STATUS_INTERNAL;
@@ -1351,15 +2484,8 @@ AdbcStatusCode SqliteStatementInitIngest(struct SqliteStatement* stmt,
   }
 
   if (code == ADBC_STATUS_OK) {
-    int rc = sqlite3_prepare_v2(stmt->conn, sqlite3_str_value(insert_query),
-                                sqlite3_str_length(insert_query), insert_statement,
-                                /*pzTail=*/NULL);
-    if (rc != SQLITE_OK) {
-      SetError(error, "[SQLite] Failed to prepare statement: %s (executed '%.*s')",
-               sqlite3_errmsg(stmt->conn), sqlite3_str_length(insert_query),
-               sqlite3_str_value(insert_query));
-      code = ADBC_STATUS_INTERNAL;
-    }
+    *insert_prefix = sqlite3_str_finish(insert_query);
+    insert_query = NULL;
   }
 
   sqlite3_finalize(create);
@@ -1371,6 +2497,244 @@ cleanup:
   return code;
 }
 
+// Prepare an INSERT of num_rows rows from the prefix built by
+// SqliteStatementInitIngest.
+static AdbcStatusCode SqliteStatementPrepareIngestInsert(struct SqliteStatement* stmt,
+                                                         const char* insert_prefix,
+                                                         int64_t num_rows,
+                                                         sqlite3_stmt** insert,
+                                                         struct AdbcError* error) {
+  sqlite3_str* query = sqlite3_str_new(stmt->conn);
+  sqlite3_str_appendall(query, insert_prefix);
+  for (int64_t row = 0; row < num_rows; row++) {
+    sqlite3_str_appendall(query, row > 0 ? ", (" : "(");
+    for (int i = 0; i < stmt->binder.schema.n_children; i++) {
+      sqlite3_str_appendall(query, i > 0 ? ", ?" : "?");
+    }
+    sqlite3_str_appendchar(query, 1, ')');
+  }
+  if (sqlite3_str_errcode(query)) {
+    SetError(error, "[SQLite] Failed to build INSERT: %s", sqlite3_errmsg(stmt->conn));
+    sqlite3_free(sqlite3_str_finish(query));
+    return ADBC_STATUS_INTERNAL;
+  }
+
+  AdbcStatusCode code = ADBC_STATUS_OK;
+  int rc = sqlite3_prepare_v2(stmt->conn, sqlite3_str_value(query),
+                              sqlite3_str_length(query), insert, /*pzTail=*/NULL);
+  if (rc != SQLITE_OK) {
+    SetError(error, "[SQLite] Failed to prepare statement: %s (executed '%.*s')",
+             sqlite3_errmsg(stmt->conn), sqlite3_str_length(query),
+             sqlite3_str_value(query));
+    code = ADBC_STATUS_INTERNAL;
+  }
+  sqlite3_free(sqlite3_str_finish(query));
+  return code;
+}
+
+static AdbcStatusCode SqliteStatementStepIngestInsert(struct SqliteStatement* stmt,
+                                                      sqlite3_stmt* insert,
+                                                      struct AdbcError* error) {
+  int rc = 0;
+  do {
+    rc = sqlite3_step(insert);
+  } while (rc == SQLITE_ROW);
+  if (rc != SQLITE_DONE) {
+    SetError(error, "[SQLite] Failed to execute statement: %s",
+             sqlite3_errmsg(stmt->conn));
+    return ADBC_STATUS_INTERNAL;
+  }
+  return ADBC_STATUS_OK;
+}
+
+// -- Bulk ingest profile -----------------------------------------------
+//
+// With adbc.sqlite.ingest.profile=bulk, durability and memory settings
+// are relaxed for the duration of the load, and secondary indexes of the
+// target table are dropped and rebuilt once at the end rather than
+// updated row by row.
+
+// Settings changed for the duration of a bulk ingest, and their
+// previous values.
+struct SqliteBulkIngest {
+  // The schema (main, temp, or an attached catalog) of the target table
+  const char* schema;
+  char* synchronous;
+  char* journal_mode;
+  char* cache_size;
+  // CREATE INDEX statements for the indexes dropped during the load
+  char** indexes;
+  int num_indexes;
+};
+
+static AdbcStatusCode SqliteGetPragma(sqlite3* db, const char* schema, const char* name,
+                                      char** out, struct AdbcError* error) {
+  char* query = sqlite3_mprintf("PRAGMA \"%w\".%s", schema, name);
+  sqlite3_stmt* stmt = NULL;
+  int rc = query ? sqlite3_prepare_v2(db, query, -1, &stmt, /*pzTail=*/NULL)
+                 : SQLITE_NOMEM;
+  if (rc == SQLITE_OK) rc = sqlite3_step(stmt);
+  if (rc == SQLITE_ROW) {
+    *out = sqlite3_mprintf("%s", (const char*)sqlite3_column_text(stmt, 0));
+    rc = *out ? SQLITE_OK : SQLITE_NOMEM;
+  }
+  if (rc != SQLITE_OK) {
+    SetError(error, "[SQLite] Failed to read PRAGMA %s: %s", name, sqlite3_errmsg(db));
+  }
+  sqlite3_finalize(stmt);
+  sqlite3_free(query);
+  return rc == SQLITE_OK ? ADBC_STATUS_OK : ADBC_STATUS_IO;
+}
+
+static AdbcStatusCode SqliteSetPragma(sqlite3* db, const char* schema, const char* name,
+                                      const char* value, struct AdbcError* error) {
+  char* query = sqlite3_mprintf("PRAGMA \"%w\".%s = %s", schema, name, value);
+  int rc = query ? sqlite3_exec(db, query, /*callback=*/NULL, /*arg=*/NULL,
+                                /*errmsg=*/NULL)
+                 : SQLITE_NOMEM;
+  sqlite3_free(query);
+  if (rc != SQLITE_OK) {
+    SetError(error, "[SQLite] Failed to set PRAGMA %s: %s", name, sqlite3_errmsg(db));
+    return ADBC_STATUS_IO;
+  }
+  return ADBC_STATUS_OK;
+}
+
+// Relax the settings of the target schema. Must be called outside of the
+// ingest transaction, since the journal mode can't change within one.
+static AdbcStatusCode SqliteBulkIngestBegin(struct SqliteStatement* stmt,
+                                            struct SqliteBulkIngest* bulk,
+                                            struct AdbcError* error) {
+  sqlite3* db = stmt->conn;
+  RAISE_ADBC(SqliteGetPragma(db, bulk->schema, "synchronous", &bulk->synchronous, error));
+  RAISE_ADBC(SqliteSetPragma(db, bulk->schema, "synchronous", "OFF", error));
+  RAISE_ADBC(SqliteGetPragma(db, bulk->schema, "cache_size", &bulk->cache_size, error));
+  RAISE_ADBC(
+      SqliteSetPragma(db, bulk->schema, "cache_size", kBulkIngestCacheSize, error));
+
+  if (!sqlite3_get_autocommit(db)) return ADBC_STATUS_OK;
+  // Keep the rollback journal in memory. WAL is left alone: leaving it
+  // would checkpoint and requires that no other connection is open, and
+  // with synchronous=OFF it is about as fast anyways.
+  char* journal_mode = NULL;
+  RAISE_ADBC(SqliteGetPragma(db, bulk->schema, "journal_mode", &journal_mode, error));
+  if (sqlite3_stricmp(journal_mode, "wal") == 0 ||
+      sqlite3_stricmp(journal_mode, "memory") == 0 ||
+      sqlite3_stricmp(journal_mode, "off") == 0) {
+    sqlite3_free(journal_mode);
+    return ADBC_STATUS_OK;
+  }
+  bulk->journal_mode = journal_mode;
+  return SqliteSetPragma(db, bulk->schema, "journal_mode", "MEMORY", error);
+}
+
+// Drop the secondary indexes of the target table, remembering how to
+// recreate them. UNIQUE indexes (and those backing constraints, which
+// have no SQL) are kept, since they must be enforced during the load.
+static AdbcStatusCode SqliteBulkIngestDropIndexes(struct SqliteStatement* stmt,
+                                                  struct SqliteBulkIngest* bulk,
+                                                  struct AdbcError* error) {
+  sqlite3* db = stmt->conn;
+  // SQLite normalizes the stored SQL to "CREATE INDEX <name> ON ..."
+  static const char kCreateIndex[] = "CREATE INDEX ";
+  char* query = sqlite3_mprintf(
+      "SELECT name, sql FROM \"%w\".sqlite_master WHERE type = 'index' AND "
+      "tbl_name = ?1 AND sql IS NOT NULL",
+      bulk->schema);
+  sqlite3_stmt* indexes = NULL;
+  int rc = query ? sqlite3_prepare_v2(db, query, -1, &indexes, /*pzTail=*/NULL)
+                 : SQLITE_NOMEM;
+  sqlite3_free(query);
+  if (rc == SQLITE_OK) {
+    rc = sqlite3_bind_text(indexes, 1, stmt->target_table, -1, SQLITE_STATIC);
+  }
+
+  // Indexes can't be dropped while sqlite_master is being read, so
+  // collect the DROP statements first
+  sqlite3_str* drops = sqlite3_str_new(db);
+  while (rc == SQLITE_OK && (rc = sqlite3_step(indexes)) == SQLITE_ROW) {
+    rc = SQLITE_OK;
+    const char* name = (const char*)sqlite3_column_text(indexes, 0);
+    const char* sql = (const char*)sqlite3_column_text(indexes, 1);
+    if (strncmp(sql, kCreateIndex, sizeof(kCreateIndex) - 1) != 0) continue;
+
+    char** resized = (char**)realloc(bulk->indexes,
+                                     sizeof(char*) * (size_t)(bulk->num_indexes + 1));
+    if (!resized) {
+      rc = SQLITE_NOMEM;
+      break;
+    }
+    bulk->indexes = resized;
+    // Qualify the index name, since it's created in the table's schema
+    char* create = sqlite3_mprintf("CREATE INDEX IF NOT EXISTS \"%w\".%s", bulk->schema,
+                                   sql + sizeof(kCreateIndex) - 1);
+    if (!create) {
+      rc = SQLITE_NOMEM;
+      break;
+    }
+    bulk->indexes[bulk->num_indexes++] = create;
+    sqlite3_str_appendf(drops, "DROP INDEX \"%w\".\"%w\";", bulk->schema, name);
+  }
+  sqlite3_finalize(indexes);
+  if (rc == SQLITE_DONE && sqlite3_str_errcode(drops) != SQLITE_OK) {
+    rc = sqlite3_str_errcode(drops);
+  }
+  char* drop = sqlite3_str_finish(drops);
+  if (rc == SQLITE_DONE && drop) {
+    rc = sqlite3_exec(db, drop, /*callback=*/NULL, /*arg=*/NULL, /*errmsg=*/NULL);
+  }
+  sqlite3_free(drop);
+
+  if (rc != SQLITE_DONE && rc != SQLITE_OK) {
+    // Some indexes may have been dropped, which are still recreated
+    SetError(error, "[SQLite] Failed to drop indexes for bulk ingestion: %s",
+             sqlite3_errstr(rc));
+    return ADBC_STATUS_IO;
+  }
+  return ADBC_STATUS_OK;
+}
+
+// Recreate the dropped indexes. This is done even if the load failed, and
+// reports the first error.
+static AdbcStatusCode SqliteBulkIngestRebuildIndexes(struct SqliteStatement* stmt,
+                                                     struct SqliteBulkIngest* bulk,
+                                                     struct AdbcError* error) {
+  AdbcStatusCode status = ADBC_STATUS_OK;
+  for (int i = 0; i < bulk->num_indexes; i++) {
+    if (sqlite3_exec(stmt->conn, bulk->indexes[i], /*callback=*/NULL, /*arg=*/NULL,
+                     /*errmsg=*/NULL) != SQLITE_OK &&
+        status == ADBC_STATUS_OK) {
+      SetError(error, "[SQLite] Failed to rebuild index after bulk ingestion: %s (%s)",
+               sqlite3_errmsg(stmt->conn), bulk->indexes[i]);
+      status = ADBC_STATUS_IO;
+    }
+  }
+  return status;
+}
+
+// Restore the settings changed by SqliteBulkIngestBegin (after the
+// ingest transaction has committed) and release the state.
+static AdbcStatusCode SqliteBulkIngestEnd(struct SqliteStatement* stmt,
+                                          struct SqliteBulkIngest* bulk,
+                                          struct AdbcError* error) {
+  AdbcStatusCode status = ADBC_STATUS_OK;
+  const char* names[] = {"journal_mode", "cache_size", "synchronous"};
+  char** values[] = {&bulk->journal_mode, &bulk->cache_size, &bulk->synchronous};
+  for (int i = 0; i < 3; i++) {
+    if (!*values[i]) continue;
+    if (status == ADBC_STATUS_OK) {
+      status = SqliteSetPragma(stmt->conn, bulk->schema, names[i], *values[i], error);
+    }
+    sqlite3_free(*values[i]);
+    *values[i] = NULL;
+  }
+  for (int i = 0; i < bulk->num_indexes; i++) sqlite3_free(bulk->indexes[i]);
+  free(bulk->indexes);
+  bulk->indexes = NULL;
+  bulk->num_indexes = 0;
+  return status;
+}
+
 AdbcStatusCode SqliteStatementExecuteIngest(struct SqliteStatement* stmt,
                                             int64_t* rows_affected,
                                             struct AdbcError* error) {
@@ -1379,38 +2743,97 @@ AdbcStatusCode SqliteStatementExecuteIngest(struct SqliteStatement* stmt,
     return ADBC_STATUS_INVALID_STATE;
   }
 
+  char* insert_prefix = NULL;
+  AdbcStatusCode status = SqliteStatementInitIngest(stmt, &insert_prefix, error);
+
+  // Insert as many rows per statement as the parameter limit allows. Rows
+  // aren't bound across parameter batches, so the tail of each batch uses
+  // a second statement (kept while consecutive tails are the same size).
+  const int64_t num_columns = stmt->binder.schema.n_children;
+  int64_t rows_per_insert = 1;
+  if (num_columns > 0) {
+    rows_per_insert =
+        sqlite3_limit(stmt->conn, SQLITE_LIMIT_VARIABLE_NUMBER, -1) / num_columns;
+    if (rows_per_insert < 1) rows_per_insert = 1;
+  }
   sqlite3_stmt* insert = NULL;
-  AdbcStatusCode status = SqliteStatementInitIngest(stmt, &insert, error);
+  sqlite3_stmt* remainder = NULL;
+  int64_t remainder_rows = 0;
+
+  struct SqliteBulkIngest bulk;
+  memset(&bulk, 0, sizeof(bulk));
+  bulk.schema = stmt->temporary      ? "temp"
+                : stmt->target_catalog ? stmt->target_catalog
+                                       : "main";
+  if (status == ADBC_STATUS_OK && stmt->bulk_ingest) {
+    status = SqliteBulkIngestBegin(stmt, &bulk, error);
+  }
 
   int64_t row_count = 0;
   int is_autocommit = sqlite3_get_autocommit(stmt->conn);
   if (status == ADBC_STATUS_OK) {
     if (is_autocommit) sqlite3_exec(stmt->conn, "BEGIN TRANSACTION", 0, 0, 0);
+    // A newly created table has no indexes
+    if (stmt->bulk_ingest && stmt->append) {
+      status = SqliteBulkIngestDropIndexes(stmt, &bulk, error);
+    }
 
-    while (1) {
+    while (status == ADBC_STATUS_OK) {
       char finished = 0;
+      int64_t available = 0;
       status =
-          AdbcSqliteBinderBindNext(&stmt->binder, stmt->conn, insert, &finished, error);
+          AdbcSqliteBinderRowsAvailable(&stmt->binder, &available, &finished, error);
       if (status != ADBC_STATUS_OK || finished) break;
 
-      int rc = 0;
-      do {
-        rc = sqlite3_step(insert);
-      } while (rc == SQLITE_ROW);
-      if (rc != SQLITE_DONE) {
-        SetError(error, "[SQLite] Failed to execute statement: %s",
-                 sqlite3_errmsg(stmt->conn));
-        status = ADBC_STATUS_INTERNAL;
-        break;
+      sqlite3_stmt* target = NULL;
+      int64_t num_rows = available;
+      if (available >= rows_per_insert) {
+        if (!insert) {
+          status = SqliteStatementPrepareIngestInsert(stmt, insert_prefix,
+                                                      rows_per_insert, &insert, error);
+          if (status != ADBC_STATUS_OK) break;
+        }
+        target = insert;
+        num_rows = rows_per_insert;
+      } else {
+        if (remainder && remainder_rows != available) {
+          sqlite3_finalize(remainder);
+          remainder = NULL;
+        }
+        if (!remainder) {
+          status = SqliteStatementPrepareIngestInsert(stmt, insert_prefix, available,
+                                                      &remainder, error);
+          if (status != ADBC_STATUS_OK) break;
+          remainder_rows = available;
+        }
+        target = remainder;
       }
-      row_count++;
+
+      status =
+          AdbcSqliteBinderBindRows(&stmt->binder, stmt->conn, target, num_rows, error);
+      if (status != ADBC_STATUS_OK) break;
+      status = SqliteStatementStepIngestInsert(stmt, target, error);
+      if (status != ADBC_STATUS_OK) break;
+      row_count += num_rows;
     }
 
+    if (bulk.num_indexes > 0) {
+      AdbcStatusCode rebuild_status = SqliteBulkIngestRebuildIndexes(
+          stmt, &bulk, status == ADBC_STATUS_OK ? error : NULL);
+      if (status == ADBC_STATUS_OK) status = rebuild_status;
+    }
     if (is_autocommit) sqlite3_exec(stmt->conn, "COMMIT", 0, 0, 0);
   }
+  if (stmt->bulk_ingest) {
+    AdbcStatusCode end_status =
+        SqliteBulkIngestEnd(stmt, &bulk, status == ADBC_STATUS_OK ? error : NULL);
+    if (status == ADBC_STATUS_OK) status = end_status;
+  }
 
   if (rows_affected) *rows_affected = row_count;
   if (insert) sqlite3_finalize(insert);
+  if (remainder) sqlite3_finalize(remainder);
+  if (insert_prefix) sqlite3_free(insert_prefix);
   AdbcSqliteBinderRelease(&stmt->binder);
   return status;
 }
@@ -1422,6 +2845,7 @@ AdbcStatusCode SqliteStatementExecuteQuery(struct AdbcStatement* statement,
   CHECK_STMT_INIT(statement, error);
   struct SqliteStatement* stmt = (struct SqliteStatement*)statement->private_data;
 
+  stmt->binder.temporal_mode = stmt->temporal_mode;
   if (stmt->target_table) {
     return SqliteStatementExecuteIngest(stmt, rows_affected, error);
   }
@@ -1487,8 +2911,10 @@ AdbcStatusCode SqliteStatementExecuteQuery(struct AdbcStatement* statement,
   // Query
   if (rows_affected) *rows_affected = -1;
   struct AdbcSqliteBinder* binder = stmt->binder.schema.release ? &stmt->binder : NULL;
-  return AdbcSqliteExportReader(stmt->conn, stmt->stmt, binder, stmt->batch_size, out,
-                                error);
+  struct AdbcSqliteReaderOptions options;
+  SqliteStatementReaderOptions(stmt, &options);
+  return AdbcSqliteExportReaderWithOptions(stmt->conn, stmt->stmt, binder, &options, out,
+                                           error);
 }
 
 AdbcStatusCode SqliteStatementSetSqlQuery(struct AdbcStatement* statement,
@@ -1675,6 +3101,97 @@ AdbcStatusCode SqliteStatementSetOption(struct AdbcStatement* statement, const c
     }
     stmt->batch_size = (int)batch_size;
     return ADBC_STATUS_OK;
+  } else if (strcmp(key, kStatementOptionPartitionCount) == 0) {
+    char* end = NULL;
+    errno = 0;
+    long partition_count = strtol(value, &end, /*base=*/10);  // NOLINT(runtime/int)
+    if (errno == ERANGE) {
+      SetError(error, "[SQLite] Invalid statement option value %s=%s (out of range)", key,
+               value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    } else if (partition_count <= 0 || *end != '\0') {
+      SetError(error,
+               "[SQLite] Invalid statement option value %s=%s (value is non-positive or "
+               "invalid)",
+               key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    } else if (partition_count > (long)INT_MAX) {  // NOLINT(runtime/int)
+      SetError(
+          error,
+          "[SQLite] Invalid statement option value %s=%s (value is out of range of int)",
+          key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    stmt->partition_count = (int)partition_count;
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kStatementOptionUseDeclaredTypes) == 0) {
+    if (strcmp(value, ADBC_OPTION_VALUE_ENABLED) == 0) {
+      stmt->use_declared_types = 1;
+    } else if (strcmp(value, ADBC_OPTION_VALUE_DISABLED) == 0) {
+      stmt->use_declared_types = 0;
+    } else {
+      SetError(error, "[SQLite] Invalid statement option value %s=%s", key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kStatementOptionDictionaryThreshold) == 0) {
+    char* end = NULL;
+    errno = 0;
+    long threshold = strtol(value, &end, /*base=*/10);  // NOLINT(runtime/int)
+    if (errno == ERANGE) {
+      SetError(error, "[SQLite] Invalid statement option value %s=%s (out of range)", key,
+               value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    } else if (threshold < 0 || end == value || *end != '\0') {
+      SetError(error,
+               "[SQLite] Invalid statement option value %s=%s (value is negative or "
+               "invalid)",
+               key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    } else if (threshold > (long)INT_MAX) {  // NOLINT(runtime/int)
+      SetError(
+          error,
+          "[SQLite] Invalid statement option value %s=%s (value is out of range of int)",
+          key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    stmt->dictionary_threshold = (int)threshold;
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kStatementOptionTemporalMode) == 0) {
+    if (strcmp(value, "iso8601") == 0) {
+      stmt->temporal_mode = ADBC_SQLITE_TEMPORAL_ISO8601;
+    } else if (strcmp(value, "unixepoch") == 0) {
+      stmt->temporal_mode = ADBC_SQLITE_TEMPORAL_UNIXEPOCH;
+    } else if (strcmp(value, "unixepoch_ms") == 0) {
+      stmt->temporal_mode = ADBC_SQLITE_TEMPORAL_UNIXEPOCH_MS;
+    } else if (strcmp(value, "unixepoch_us") == 0) {
+      stmt->temporal_mode = ADBC_SQLITE_TEMPORAL_UNIXEPOCH_US;
+    } else if (strcmp(value, "unixepoch_ns") == 0) {
+      stmt->temporal_mode = ADBC_SQLITE_TEMPORAL_UNIXEPOCH_NS;
+    } else if (strcmp(value, "julianday") == 0) {
+      stmt->temporal_mode = ADBC_SQLITE_TEMPORAL_JULIANDAY;
+    } else {
+      SetError(error,
+               "[SQLite] Invalid statement option value %s=%s (expected iso8601, "
+               "unixepoch, unixepoch_ms, unixepoch_us, unixepoch_ns, or julianday)",
+               key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    stmt->temporal_mode_set = 1;
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, kStatementOptionIngestProfile) == 0) {
+    if (strcmp(value, "default") == 0) {
+      stmt->bulk_ingest = 0;
+    } else if (strcmp(value, "bulk") == 0) {
+      stmt->bulk_ingest = 1;
+    } else {
+      SetError(error,
+               "[SQLite] Invalid statement option value %s=%s (expected default or "
+               "bulk)",
+               key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return ADBC_STATUS_OK;
   }
   SetError(error, "[SQLite] Unknown statement option %s=%s", key,
            value ? value : "(NULL)");
@@ -1708,8 +3225,141 @@ AdbcStatusCode SqliteStatementExecutePartitions(struct AdbcStatement* statement,
                                                 int64_t* rows_affected,
                                                 struct AdbcError* error) {
   CHECK_STMT_INIT(statement, error);
-  SetError(error, "[SQLite] Partitioned result sets are not supported");
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+  struct SqliteStatement* stmt = (struct SqliteStatement*)statement->private_data;
+
+  if (stmt->target_table) {
+    SetError(error, "[SQLite] Cannot execute bulk ingestion as partitions");
+    return ADBC_STATUS_INVALID_STATE;
+  } else if (stmt->binder.schema.release) {
+    SetError(error,
+             "[SQLite] Cannot execute a query with bound parameters as partitions");
+    return ADBC_STATUS_NOT_IMPLEMENTED;
+  }
+
+  AdbcStatusCode status = SqliteStatementPrepare(statement, error);
+  if (status != ADBC_STATUS_OK) return status;
+
+  // Get the schema by reading the first batch of the whole query
+  struct ArrowArrayStream stream;
+  memset(&stream, 0, sizeof(stream));
+  struct AdbcSqliteReaderOptions options;
+  SqliteStatementReaderOptions(stmt, &options);
+  status = AdbcSqliteExportReaderWithOptions(stmt->conn, stmt->stmt, /*binder=*/NULL,
+                                             &options, &stream, error);
+  if (status != ADBC_STATUS_OK) return status;
+  int na_res = stream.get_schema(&stream, schema);
+  stream.release(&stream);
+  (void)sqlite3_reset(stmt->stmt);
+  if (na_res != 0) {
+    SetError(error, "[SQLite] Failed to get result schema: (%d) %s", na_res,
+             strerror(na_res));
+    return ADBC_STATUS_INTERNAL;
+  }
+
+  size_t query_len = strlen(stmt->query);
+  while (query_len > 0 && (isspace((unsigned char)stmt->query[query_len - 1]) ||
+                           stmt->query[query_len - 1] == ';')) {
+    query_len--;
+  }
+
+  // A query that must be read on this connection becomes one partition
+  const char shared = SqliteIsShareable(stmt->conn, stmt->query, query_len);
+
+  // Find the range of rowids, if the query can be split by rowid
+  int64_t from_offset = -1;
+  int64_t where_offset = -1;
+  char have_range = 0;
+  sqlite3_int64 min_rowid = 0;
+  sqlite3_int64 max_rowid = 0;
+  if (shared && stmt->partition_count > 1 &&
+      SqliteIsRowidPartitionable(stmt->query, query_len, &from_offset, &where_offset)) {
+    size_t from_end = where_offset >= 0 ? (size_t)where_offset : query_len;
+    char* range_query = sqlite3_mprintf("SELECT min(rowid), max(rowid) %.*s",
+                                        (int)(from_end - (size_t)from_offset),
+                                        stmt->query + from_offset);
+    sqlite3_stmt* range_stmt = NULL;
+    if (range_query &&
+        sqlite3_prepare_v2(stmt->conn, range_query, -1, &range_stmt, NULL) == SQLITE_OK &&
+        sqlite3_step(range_stmt) == SQLITE_ROW &&
+        sqlite3_column_type(range_stmt, 0) == SQLITE_INTEGER &&
+        sqlite3_column_type(range_stmt, 1) == SQLITE_INTEGER) {
+      min_rowid = sqlite3_column_int64(range_stmt, 0);
+      max_rowid = sqlite3_column_int64(range_stmt, 1);
+      have_range = 1;
+    }
+    (void)sqlite3_finalize(range_stmt);
+    sqlite3_free(range_query);
+  }
+
+  // Queries that can't be split (or an empty table) become one partition
+  size_t num_partitions = 1;
+  uint64_t span = 0;
+  if (have_range) {
+    span = (uint64_t)max_rowid - (uint64_t)min_rowid;
+    num_partitions = (size_t)stmt->partition_count;
+    if (span < (uint64_t)num_partitions) num_partitions = (size_t)span + 1;
+  }
+
+  struct SqlitePartitions* private_data =
+      (struct SqlitePartitions*)malloc(sizeof(struct SqlitePartitions));
+  private_data->num_partitions = 0;
+  private_data->descriptors = (char**)calloc(num_partitions, sizeof(char*));
+  private_data->pointers = (const uint8_t**)calloc(num_partitions, sizeof(uint8_t*));
+  private_data->lengths = (size_t*)calloc(num_partitions, sizeof(size_t));
+  partitions->private_data = private_data;
+  partitions->release = SqlitePartitionsRelease;
+
+  char* header = SqlitePartitionHeader(stmt, shared, schema);
+
+  for (size_t i = 0; i < num_partitions; i++) {
+    char* descriptor = NULL;
+    if (!header) {
+      // Allocation failure
+    } else if (!have_range) {
+      descriptor = sqlite3_mprintf("%s%.*s", header, (int)query_len, stmt->query);
+    } else {
+      // Split the span + 1 rowids in [min, max] into evenly sized ranges
+      // (without computing span + 1, which may overflow)
+      uint64_t base = span / num_partitions;
+      uint64_t extra = span % num_partitions + 1;
+      if (extra == num_partitions) {
+        base++;
+        extra = 0;
+      }
+      uint64_t offset = base * i + (i < extra ? i : extra);
+      uint64_t size = base + (i < extra ? 1 : 0);
+      sqlite3_int64 lo = (sqlite3_int64)((uint64_t)min_rowid + offset);
+      sqlite3_int64 hi = (sqlite3_int64)((uint64_t)lo + size - 1);
+      if (where_offset >= 0) {
+        size_t where_end = (size_t)where_offset + 5;
+        descriptor = sqlite3_mprintf("%s%.*s (%.*s\n) AND rowid BETWEEN %lld AND %lld",
+                                     header, (int)where_end, stmt->query,
+                                     (int)(query_len - where_end),
+                                     stmt->query + where_end, lo, hi);
+      } else {
+        descriptor = sqlite3_mprintf("%s%.*s\nWHERE rowid BETWEEN %lld AND %lld", header,
+                                     (int)query_len, stmt->query, lo, hi);
+      }
+    }
+    if (!descriptor) {
+      sqlite3_free(header);
+      SqlitePartitionsRelease(partitions);
+      schema->release(schema);
+      SetError(error, "[SQLite] Failed to allocate partition descriptor");
+      return ADBC_STATUS_INTERNAL;
+    }
+    private_data->descriptors[i] = descriptor;
+    private_data->pointers[i] = (const uint8_t*)descriptor;
+    private_data->lengths[i] = strlen(descriptor);
+    private_data->num_partitions++;
+  }
+  sqlite3_free(header);
+
+  partitions->num_partitions = num_partitions;
+  partitions->partitions = private_data->pointers;
+  partitions->partition_lengths = private_data->lengths;
+  if (rows_affected) *rows_affected = -1;
+  return ADBC_STATUS_OK;
 }  // NOLINT(whitespace/indent)
 
 AdbcStatusCode SqliteDriverInit(int version, void* raw_driver, struct AdbcError* error) {
@@ -1740,6 +3390,7 @@ AdbcStatusCode SqliteDriverInit(int version, void* raw_driver, struct AdbcError*
 
   driver->StatementBind = SqliteStatementBind;
   driver->StatementBindStream = SqliteStatementBindStream;
+  driver->StatementExecutePartitions = SqliteStatementExecutePartitions;
   driver->StatementExecuteQuery = SqliteStatementExecuteQuery;
   driver->StatementGetParameterSchema = SqliteStatementGetParameterSchema;
   driver->StatementNew = SqliteStatementNew;
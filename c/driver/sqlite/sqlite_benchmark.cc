@@ -0,0 +1,329 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstring>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <nanoarrow/nanoarrow.hpp>
+
+#include "adbc.h"
+#include "validation/adbc_validation_util.h"
+
+#define _ADBC_BENCHMARK_RETURN_NOT_OK_IMPL(NAME, EXPR) \
+  do {                                                 \
+    const int NAME = (EXPR);                           \
+    if (NAME) {                                        \
+      state.SkipWithError(error.message);              \
+      error.release(&error);                           \
+      return;                                          \
+    }                                                  \
+  } while (0)
+
+#define ADBC_BENCHMARK_RETURN_NOT_OK(EXPR) \
+  _ADBC_BENCHMARK_RETURN_NOT_OK_IMPL(_NANOARROW_MAKE_NAME(errno_status_, __COUNTER__), \
+                                     EXPR)
+
+namespace {
+/// An in-memory database with a table of state.range(0) rows of int64,
+/// double, and text columns (every tenth value NULL).
+class SqliteBenchmarkTable {
+ public:
+  AdbcStatusCode Init(int64_t num_rows, struct AdbcError* error) {
+    std::memset(error, 0, sizeof(*error));
+    AdbcStatusCode status = AdbcDatabaseNew(&database.value, error);
+    if (status != ADBC_STATUS_OK) return status;
+    status = AdbcDatabaseSetOption(&database.value, "uri", ":memory:", error);
+    if (status != ADBC_STATUS_OK) return status;
+    status = AdbcDatabaseInit(&database.value, error);
+    if (status != ADBC_STATUS_OK) return status;
+    status = AdbcConnectionNew(&connection.value, error);
+    if (status != ADBC_STATUS_OK) return status;
+    status = AdbcConnectionInit(&connection.value, &database.value, error);
+    if (status != ADBC_STATUS_OK) return status;
+
+    std::string query =
+        "CREATE TABLE bench AS WITH RECURSIVE ints(x) AS (SELECT 0 UNION ALL SELECT x "
+        "+ 1 FROM ints WHERE x + 1 < " +
+        std::to_string(num_rows) +
+        ") SELECT CASE WHEN x % 10 = 1 THEN NULL ELSE x END AS ints, CASE WHEN x % 10 "
+        "= 2 THEN NULL ELSE x * 0.5 END AS doubles, CASE WHEN x % 10 = 3 THEN NULL "
+        "ELSE 'value ' || x END AS strs FROM ints";
+    return Execute(query.c_str(), error);
+  }
+
+  AdbcStatusCode Execute(const char* query, struct AdbcError* error) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    AdbcStatusCode status = AdbcStatementNew(&connection.value, &statement.value, error);
+    if (status != ADBC_STATUS_OK) return status;
+    status = AdbcStatementSetSqlQuery(&statement.value, query, error);
+    if (status != ADBC_STATUS_OK) return status;
+    return AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, error);
+  }
+
+  /// Read the whole table into schema and array as one batch.
+  AdbcStatusCode ReadAll(int64_t num_rows, struct AdbcError* error) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    AdbcStatusCode status = AdbcStatementNew(&connection.value, &statement.value, error);
+    if (status != ADBC_STATUS_OK) return status;
+    status = AdbcStatementSetOption(&statement.value, "adbc.sqlite.query.batch_rows",
+                                    std::to_string(num_rows).c_str(), error);
+    if (status != ADBC_STATUS_OK) return status;
+    status = AdbcStatementSetSqlQuery(&statement.value,
+                                      "SELECT ints, doubles, strs FROM bench", error);
+    if (status != ADBC_STATUS_OK) return status;
+
+    nanoarrow::UniqueArrayStream stream;
+    status = AdbcStatementExecuteQuery(&statement.value, stream.get(), nullptr, error);
+    if (status != ADBC_STATUS_OK) return status;
+    schema.reset();
+    array.reset();
+    if (stream->get_schema(stream.get(), schema.get()) != 0 ||
+        stream->get_next(stream.get(), array.get()) != 0 || !array->release) {
+      return ADBC_STATUS_INTERNAL;
+    }
+    return ADBC_STATUS_OK;
+  }
+
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  adbc_validation::Handle<struct AdbcConnection> connection;
+  nanoarrow::UniqueSchema schema;
+  nanoarrow::UniqueArray array;
+};
+}  // namespace
+
+static void BM_SqliteRead(benchmark::State& state, const char* query) {
+  const int64_t num_rows = state.range(0);
+  struct AdbcError error;
+  SqliteBenchmarkTable table;
+  ADBC_BENCHMARK_RETURN_NOT_OK(table.Init(num_rows, &error));
+
+  for (auto _ : state) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementNew(&table.connection.value, &statement.value, &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementSetSqlQuery(&statement.value, query, &error));
+
+    adbc_validation::Handle<struct ArrowArrayStream> stream;
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementExecuteQuery(&statement.value, &stream.value, nullptr, &error));
+    int64_t rows_read = 0;
+    while (true) {
+      nanoarrow::UniqueArray batch;
+      if (stream->get_next(&stream.value, batch.get()) != 0) {
+        state.SkipWithError(stream->get_last_error(&stream.value));
+        return;
+      }
+      if (!batch->release) break;
+      rows_read += batch->length;
+    }
+    benchmark::DoNotOptimize(rows_read);
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+static void BM_SqliteIngest(benchmark::State& state) {
+  const int64_t num_rows = state.range(0);
+  struct AdbcError error;
+  SqliteBenchmarkTable table;
+  ADBC_BENCHMARK_RETURN_NOT_OK(table.Init(num_rows, &error));
+
+  for (auto _ : state) {
+    // Bind consumes the batch, so read the source table back each time
+    state.PauseTiming();
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        table.Execute("DROP TABLE IF EXISTS bench_ingest", &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(table.ReadAll(num_rows, &error));
+    state.ResumeTiming();
+
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementNew(&table.connection.value, &statement.value, &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(AdbcStatementSetOption(
+        &statement.value, ADBC_INGEST_OPTION_TARGET_TABLE, "bench_ingest", &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(AdbcStatementBind(
+        &statement.value, table.array.get(), table.schema.get(), &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error));
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+static void BM_SqliteIngestTimestamps(benchmark::State& state, const char* mode) {
+  const int64_t num_rows = state.range(0);
+  struct AdbcError error;
+  SqliteBenchmarkTable table;
+  ADBC_BENCHMARK_RETURN_NOT_OK(table.Init(/*num_rows=*/0, &error));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        table.Execute("DROP TABLE IF EXISTS bench_ingest", &error));
+    // A timestamp[us] column of consecutive seconds
+    nanoarrow::UniqueSchema schema;
+    nanoarrow::UniqueArray array;
+    ArrowSchemaInit(schema.get());
+    ADBC_BENCHMARK_RETURN_NOT_OK(ArrowSchemaSetTypeStruct(schema.get(), 1));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        ArrowSchemaSetTypeDateTime(schema->children[0], NANOARROW_TYPE_TIMESTAMP,
+                                   NANOARROW_TIME_UNIT_MICRO, nullptr));
+    ADBC_BENCHMARK_RETURN_NOT_OK(ArrowSchemaSetName(schema->children[0], "ts"));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        ArrowArrayInitFromSchema(array.get(), schema.get(), nullptr));
+    ADBC_BENCHMARK_RETURN_NOT_OK(ArrowArrayStartAppending(array.get()));
+    for (int64_t i = 0; i < num_rows; i++) {
+      ADBC_BENCHMARK_RETURN_NOT_OK(
+          ArrowArrayAppendInt(array->children[0], 1700000000000000 + i * 1000001));
+      ADBC_BENCHMARK_RETURN_NOT_OK(ArrowArrayFinishElement(array.get()));
+    }
+    ADBC_BENCHMARK_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(array.get(), nullptr));
+    state.ResumeTiming();
+
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementNew(&table.connection.value, &statement.value, &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(AdbcStatementSetOption(
+        &statement.value, ADBC_INGEST_OPTION_TARGET_TABLE, "bench_ingest", &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(AdbcStatementSetOption(
+        &statement.value, "adbc.sqlite.bind.temporal_mode", mode, &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementBind(&statement.value, array.get(), schema.get(), &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error));
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+// Look up single rows by rowid, each on a new statement, with the given
+// prepared statement cache capacity
+static void BM_SqlitePointLookup(benchmark::State& state, const char* capacity) {
+  const int64_t num_rows = state.range(0);
+  struct AdbcError error;
+  SqliteBenchmarkTable table;
+  ADBC_BENCHMARK_RETURN_NOT_OK(table.Init(num_rows, &error));
+  ADBC_BENCHMARK_RETURN_NOT_OK(AdbcConnectionSetOption(
+      &table.connection.value, "adbc.sqlite.statement_cache.capacity", capacity,
+      &error));
+
+  int64_t rowid = 0;
+  for (auto _ : state) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementNew(&table.connection.value, &statement.value, &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(AdbcStatementSetSqlQuery(
+        &statement.value, "SELECT ints, doubles, strs FROM bench WHERE rowid = ?",
+        &error));
+
+    nanoarrow::UniqueSchema schema;
+    nanoarrow::UniqueArray array;
+    ArrowSchemaInit(schema.get());
+    ADBC_BENCHMARK_RETURN_NOT_OK(ArrowSchemaSetTypeStruct(schema.get(), 1));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_INT64));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        ArrowArrayInitFromSchema(array.get(), schema.get(), nullptr));
+    ADBC_BENCHMARK_RETURN_NOT_OK(ArrowArrayStartAppending(array.get()));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        ArrowArrayAppendInt(array->children[0], 1 + rowid++ % num_rows));
+    ADBC_BENCHMARK_RETURN_NOT_OK(ArrowArrayFinishElement(array.get()));
+    ADBC_BENCHMARK_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(array.get(), nullptr));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementBind(&statement.value, array.get(), schema.get(), &error));
+
+    adbc_validation::Handle<struct ArrowArrayStream> stream;
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementExecuteQuery(&statement.value, &stream.value, nullptr, &error));
+    nanoarrow::UniqueArray batch;
+    if (stream->get_next(&stream.value, batch.get()) != 0) {
+      state.SkipWithError(stream->get_last_error(&stream.value));
+      return;
+    }
+    benchmark::DoNotOptimize(batch->length);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Append to a table with secondary indexes under the given ingest profile
+static void BM_SqliteIngestIndexed(benchmark::State& state, const char* profile) {
+  const int64_t num_rows = state.range(0);
+  struct AdbcError error;
+  SqliteBenchmarkTable table;
+  ADBC_BENCHMARK_RETURN_NOT_OK(table.Init(num_rows, &error));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        table.Execute("DROP TABLE IF EXISTS bench_ingest", &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(table.Execute(
+        "CREATE TABLE bench_ingest (ints INTEGER, doubles REAL, strs TEXT)", &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        table.Execute("CREATE INDEX bench_ingest_ints ON bench_ingest (ints)", &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        table.Execute("CREATE INDEX bench_ingest_strs ON bench_ingest (strs)", &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(table.ReadAll(num_rows, &error));
+    state.ResumeTiming();
+
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementNew(&table.connection.value, &statement.value, &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(AdbcStatementSetOption(
+        &statement.value, ADBC_INGEST_OPTION_TARGET_TABLE, "bench_ingest", &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(AdbcStatementSetOption(
+        &statement.value, ADBC_INGEST_OPTION_MODE, ADBC_INGEST_OPTION_MODE_APPEND,
+        &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(AdbcStatementSetOption(
+        &statement.value, "adbc.sqlite.ingest.profile", profile, &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(AdbcStatementBind(
+        &statement.value, table.array.get(), table.schema.get(), &error));
+    ADBC_BENCHMARK_RETURN_NOT_OK(
+        AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error));
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+BENCHMARK_CAPTURE(BM_SqliteRead, Mixed, "SELECT ints, doubles, strs FROM bench")
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SqliteRead, Ints,
+                  "SELECT ints, ints, ints, ints, ints, ints, ints, ints FROM bench")
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SqliteRead, Doubles,
+                  "SELECT doubles, doubles, doubles, doubles, doubles, doubles, doubles, "
+                  "doubles FROM bench")
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SqliteIngest)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SqliteIngestTimestamps, Iso8601, "iso8601")
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SqliteIngestTimestamps, UnixEpoch, "unixepoch")
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SqliteIngestTimestamps, JulianDay, "julianday")
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SqliteIngestIndexed, Default, "default")
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SqliteIngestIndexed, Bulk, "bulk")
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SqlitePointLookup, Uncached, "0")->Arg(1000);
+BENCHMARK_CAPTURE(BM_SqlitePointLookup, Cached, "16")->Arg(1000);
+BENCHMARK_MAIN();
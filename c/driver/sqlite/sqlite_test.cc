@@ -15,11 +15,15 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <adbc.h>
 #include <gmock/gmock-matchers.h>
@@ -67,6 +71,8 @@ class SqliteQuirks : public adbc_validation::DriverQuirks {
 
   std::string BindParameter(int index) const override { return "?"; }
 
+  bool supports_partitioned_data() const override { return true; }
+
   ArrowType IngestSelectRoundTripType(ArrowType ingest_type) const override {
     switch (ingest_type) {
       case NANOARROW_TYPE_BOOL:
@@ -171,6 +177,229 @@ class SqliteDatabaseTest : public ::testing::Test, public adbc_validation::Datab
 };
 ADBCV_TEST_DATABASE(SqliteDatabaseTest)
 
+TEST_F(SqliteDatabaseTest, PragmasAndConnectionPool) {
+  const std::string path = ::testing::TempDir() + "adbc_sqlite_pool.db";
+  for (const char* suffix : {"", "-wal", "-shm"}) std::remove((path + suffix).c_str());
+
+  ASSERT_THAT(AdbcDatabaseNew(&database, &error), adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, "uri", path.c_str(), &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, "adbc.sqlite.pragma.journal_mode",
+                                    "bogus", &error),
+              adbc_validation::IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, "adbc.sqlite.pragma.mmap_size", "-1",
+                                    &error),
+              adbc_validation::IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database, "adbc.sqlite.pragma.journal_mode", "wal", &error),
+      adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, "adbc.sqlite.pragma.cache_size", "-4096",
+                                    &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, "adbc.sqlite.pragma.mmap_size",
+                                    "1048576", &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database, "adbc.sqlite.pool.max_idle", "1", &error),
+      adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database, &error), adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database, "adbc.sqlite.pool.max_idle", "2", &error),
+      adbc_validation::IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+
+  adbc_validation::Handle<struct AdbcConnection> connection;
+  ASSERT_THAT(AdbcConnectionNew(&connection.value, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection.value, &database, &error),
+              adbc_validation::IsOkStatus(&error));
+  adbc_validation::Handle<struct AdbcStatement> statement;
+  ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+              adbc_validation::IsOkStatus(&error));
+
+  // The PRAGMAs are applied to the connection
+  for (const auto& [pragma, expected] : std::vector<std::pair<std::string, std::string>>{
+           {"journal_mode", "wal"}, {"cache_size", "-4096"}, {"mmap_size", "1048576"}}) {
+    SCOPED_TRACE(pragma);
+    std::string query = "PRAGMA " + pragma;
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query.c_str(), &error),
+                adbc_validation::IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(1, reader.array->length);
+    if (reader.fields[0].type == NANOARROW_TYPE_STRING) {
+      struct ArrowStringView value =
+          ArrowArrayViewGetStringUnsafe(reader.array_view->children[0], 0);
+      ASSERT_EQ(expected, std::string(value.data, value.size_bytes));
+    } else {
+      ASSERT_EQ(expected, std::to_string(ArrowArrayViewGetIntUnsafe(
+                              reader.array_view->children[0], 0)));
+    }
+  }
+
+  ASSERT_THAT(AdbcStatementSetSqlQuery(
+                  &statement.value,
+                  "CREATE TABLE pooled AS WITH RECURSIVE ints(x) AS (SELECT 1 UNION "
+                  "ALL SELECT x + 1 FROM ints WHERE x < 100) SELECT x FROM ints",
+                  &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                     "adbc.sqlite.query.partition_count", "3", &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcStatementSetSqlQuery(&statement.value, "SELECT x FROM pooled", &error),
+      adbc_validation::IsOkStatus(&error));
+  adbc_validation::Handle<struct ArrowSchema> schema;
+  adbc_validation::Handle<struct AdbcPartitions> partitions;
+  ASSERT_THAT(AdbcStatementExecutePartitions(&statement.value, &schema.value,
+                                             &partitions.value, nullptr, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_EQ(3, partitions->num_partitions);
+
+  // Read all partitions at once (each on its own connection) and then
+  // again (reusing the pooled connection)
+  for (int round = 0; round < 2; round++) {
+    SCOPED_TRACE("round " + std::to_string(round));
+    std::vector<adbc_validation::StreamReader> readers(partitions->num_partitions);
+    for (size_t i = 0; i < partitions->num_partitions; i++) {
+      ASSERT_THAT(AdbcConnectionReadPartition(
+                      &connection.value, partitions->partitions[i],
+                      partitions->partition_lengths[i], &readers[i].stream.value, &error),
+                  adbc_validation::IsOkStatus(&error));
+      ASSERT_NO_FATAL_FAILURE(readers[i].GetSchema());
+    }
+
+    // The database can't be released while partitions are being read
+    if (round == 0) {
+      ASSERT_THAT(AdbcDatabaseRelease(&database, &error),
+                  adbc_validation::IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+    }
+
+    int64_t sum = 0;
+    for (auto& reader : readers) {
+      while (true) {
+        ASSERT_NO_FATAL_FAILURE(reader.Next());
+        if (!reader.array->release) break;
+        for (int64_t row = 0; row < reader.array->length; row++) {
+          sum += ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], row);
+        }
+      }
+    }
+    ASSERT_EQ(5050, sum);
+  }
+}
+
+TEST_F(SqliteDatabaseTest, PartitionsOnFileDatabase) {
+  const std::string path = ::testing::TempDir() + "adbc_sqlite_partitions.db";
+  std::remove(path.c_str());
+  ASSERT_THAT(AdbcDatabaseNew(&database, &error), adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, "uri", path.c_str(), &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database, &error), adbc_validation::IsOkStatus(&error));
+
+  adbc_validation::Handle<struct AdbcConnection> connection;
+  adbc_validation::Handle<struct AdbcConnection> other;
+  for (auto* conn : {&connection.value, &other.value}) {
+    ASSERT_THAT(AdbcConnectionNew(conn, &error), adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionInit(conn, &database, &error),
+                adbc_validation::IsOkStatus(&error));
+  }
+  adbc_validation::Handle<struct AdbcStatement> statement;
+  ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+              adbc_validation::IsOkStatus(&error));
+  auto execute = [&](const char* query) {
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+  };
+  // The first rowids only have NULLs, so inferring the schema of the
+  // first partition on its own would give int64
+  ASSERT_NO_FATAL_FAILURE(
+      execute("CREATE TABLE mixed AS WITH RECURSIVE ints(x) AS (SELECT 1 UNION ALL "
+              "SELECT x + 1 FROM ints WHERE x < 100) SELECT x, CASE WHEN x > 50 "
+              "THEN 'v' || x END AS v FROM ints"));
+  ASSERT_NO_FATAL_FAILURE(
+      execute("CREATE TEMP TABLE scratch AS SELECT x, v FROM mixed WHERE x > 90"));
+  ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                     "adbc.sqlite.query.partition_count", "3", &error),
+              adbc_validation::IsOkStatus(&error));
+
+  // Plan the query, then read every partition on the given connection,
+  // checking that each one has the planned schema. Returns the sum of x.
+  auto read_partitions = [&](const char* query, struct AdbcConnection* reader_conn,
+                             size_t expected_partitions, int64_t* sum) {
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query, &error),
+                adbc_validation::IsOkStatus(&error));
+    adbc_validation::Handle<struct ArrowSchema> schema;
+    adbc_validation::Handle<struct AdbcPartitions> partitions;
+    ASSERT_THAT(AdbcStatementExecutePartitions(&statement.value, &schema.value,
+                                               &partitions.value, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_EQ(expected_partitions, partitions->num_partitions);
+    ASSERT_EQ(2, schema->n_children);
+    ASSERT_STREQ("l", schema->children[0]->format);
+    ASSERT_STREQ("u", schema->children[1]->format);
+
+    *sum = 0;
+    for (size_t i = 0; i < partitions->num_partitions; i++) {
+      SCOPED_TRACE("partition " + std::to_string(i));
+      adbc_validation::StreamReader reader;
+      ASSERT_THAT(AdbcConnectionReadPartition(reader_conn, partitions->partitions[i],
+                                              partitions->partition_lengths[i],
+                                              &reader.stream.value, &error),
+                  adbc_validation::IsOkStatus(&error));
+      ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+      ASSERT_EQ(2, reader.schema->n_children);
+      ASSERT_STREQ("x", reader.schema->children[0]->name);
+      ASSERT_STREQ("l", reader.schema->children[0]->format);
+      ASSERT_STREQ("v", reader.schema->children[1]->name);
+      ASSERT_STREQ("u", reader.schema->children[1]->format);
+      while (true) {
+        ASSERT_NO_FATAL_FAILURE(reader.Next());
+        if (!reader.array->release) break;
+        for (int64_t row = 0; row < reader.array->length; row++) {
+          *sum += ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], row);
+        }
+      }
+    }
+  };
+
+  // Partitions of a main database table are read on pooled read-only
+  // connections, from this connection or any other one
+  int64_t sum = 0;
+  for (auto* conn : {&connection.value, &other.value}) {
+    ASSERT_NO_FATAL_FAILURE(read_partitions("SELECT x, v FROM mixed", conn, 3, &sum));
+    ASSERT_EQ(5050, sum);
+  }
+
+  // TEMP tables are only visible to this connection
+  ASSERT_NO_FATAL_FAILURE(
+      read_partitions("SELECT x, v FROM scratch", &connection.value, 1, &sum));
+  ASSERT_EQ(955, sum);
+  ASSERT_NO_FATAL_FAILURE(read_partitions(
+      "SELECT x, v FROM mixed WHERE x IN (SELECT x FROM temp.scratch)",
+      &connection.value, 1, &sum));
+  ASSERT_EQ(955, sum);
+
+  // Uncommitted changes are only visible to this connection
+  ASSERT_THAT(AdbcConnectionSetOption(&connection.value,
+                                      ADBC_CONNECTION_OPTION_AUTOCOMMIT,
+                                      ADBC_OPTION_VALUE_DISABLED, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(execute("INSERT INTO mixed VALUES (1000, 'new')"));
+  ASSERT_NO_FATAL_FAILURE(
+      read_partitions("SELECT x, v FROM mixed", &connection.value, 1, &sum));
+  ASSERT_EQ(6050, sum);
+  ASSERT_THAT(AdbcConnectionRollback(&connection.value, &error),
+              adbc_validation::IsOkStatus(&error));
+}
+
 class SqliteConnectionTest : public ::testing::Test,
                              public adbc_validation::ConnectionTest {
  public:
@@ -307,6 +536,290 @@ TEST_F(SqliteConnectionTest, GetInfoMetadata) {
   ASSERT_THAT(seen, ::testing::UnorderedElementsAreArray(info));
 }
 
+TEST_F(SqliteConnectionTest, StatementCache) {
+  ASSERT_THAT(AdbcConnectionNew(&connection, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error),
+              adbc_validation::IsOkStatus(&error));
+
+  auto get_stats = [&](int64_t* hits, int64_t* misses) {
+    ASSERT_THAT(AdbcConnectionGetOptionInt(&connection,
+                                           "adbc.sqlite.statement_cache.hits", hits,
+                                           &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionGetOptionInt(&connection,
+                                           "adbc.sqlite.statement_cache.misses", misses,
+                                           &error),
+                adbc_validation::IsOkStatus(&error));
+  };
+  // Execute a query on a new statement, and check the result
+  auto execute = [&](const char* query, int64_t expected) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query, &error),
+                adbc_validation::IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(1, reader.array->length);
+    ASSERT_EQ(expected, ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], 0));
+  };
+
+  int64_t hits = -1, misses = -1;
+  ASSERT_NO_FATAL_FAILURE(get_stats(&hits, &misses));
+  ASSERT_EQ(0, hits);
+  ASSERT_EQ(0, misses);
+
+  ASSERT_NO_FATAL_FAILURE(execute("SELECT 1", 1));
+  ASSERT_NO_FATAL_FAILURE(execute("SELECT 2", 2));
+  ASSERT_NO_FATAL_FAILURE(execute("SELECT 1", 1));
+  ASSERT_NO_FATAL_FAILURE(execute("SELECT 1", 1));
+  ASSERT_NO_FATAL_FAILURE(get_stats(&hits, &misses));
+  ASSERT_EQ(2, hits);
+  ASSERT_EQ(2, misses);
+
+  // The least recently used statement is evicted
+  ASSERT_THAT(AdbcConnectionSetOption(&connection, "adbc.sqlite.statement_cache.capacity",
+                                      "1", &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(execute("SELECT 1", 1));
+  ASSERT_NO_FATAL_FAILURE(execute("SELECT 2", 2));
+  ASSERT_NO_FATAL_FAILURE(execute("SELECT 2", 2));
+  ASSERT_NO_FATAL_FAILURE(execute("SELECT 1", 1));
+  ASSERT_NO_FATAL_FAILURE(get_stats(&hits, &misses));
+  ASSERT_EQ(3, hits);
+  ASSERT_EQ(5, misses);
+
+  // GetObjects reuses its catalog queries
+  ASSERT_THAT(AdbcConnectionSetOption(&connection, "adbc.sqlite.statement_cache.capacity",
+                                      "16", &error),
+              adbc_validation::IsOkStatus(&error));
+  for (int i = 0; i < 2; i++) {
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcConnectionGetObjects(&connection, ADBC_OBJECT_DEPTH_ALL, nullptr,
+                                         nullptr, nullptr, nullptr, nullptr,
+                                         &reader.stream.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  }
+  int64_t objects_hits = 0;
+  ASSERT_NO_FATAL_FAILURE(get_stats(&objects_hits, &misses));
+  ASSERT_EQ(hits + 3, objects_hits);
+
+  ASSERT_THAT(AdbcConnectionSetOption(&connection, "adbc.sqlite.statement_cache.capacity",
+                                      "-1", &error),
+              adbc_validation::IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+}
+
+TEST_F(SqliteConnectionTest, StatementCacheSchemaChange) {
+  ASSERT_THAT(AdbcConnectionNew(&connection, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error),
+              adbc_validation::IsOkStatus(&error));
+
+  auto execute = [&](const char* query) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+  };
+  // Check the columns of SELECT * FROM t, before any rows are read
+  auto check_columns = [&](std::vector<std::string> expected) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, "SELECT * FROM t", &error),
+                adbc_validation::IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    std::vector<std::string> names;
+    for (int64_t i = 0; i < reader.schema->n_children; i++) {
+      names.push_back(reader.schema->children[i]->name);
+    }
+    ASSERT_EQ(expected, names);
+  };
+
+  ASSERT_NO_FATAL_FAILURE(execute("CREATE TABLE t (a INTEGER)"));
+  ASSERT_NO_FATAL_FAILURE(check_columns({"a"}));
+  ASSERT_NO_FATAL_FAILURE(execute("DROP TABLE t"));
+  ASSERT_NO_FATAL_FAILURE(execute("CREATE TABLE t (b TEXT, c INTEGER)"));
+  ASSERT_NO_FATAL_FAILURE(check_columns({"b", "c"}));
+
+  // The schema changes while the statement is in use
+  {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, "SELECT * FROM t", &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementPrepare(&statement.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(execute("ALTER TABLE t ADD COLUMN d REAL"));
+    ASSERT_NO_FATAL_FAILURE(check_columns({"b", "c", "d"}));
+  }
+  ASSERT_NO_FATAL_FAILURE(check_columns({"b", "c", "d"}));
+}
+
+TEST_F(SqliteConnectionTest, GetObjectsBatches) {
+  ASSERT_THAT(AdbcConnectionNew(&connection, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error),
+              adbc_validation::IsOkStatus(&error));
+
+  for (const char* query : {
+           "CREATE TABLE a (id INTEGER PRIMARY KEY, x TEXT)",
+           "CREATE TABLE b (id INTEGER, a_id INTEGER REFERENCES a(id), "
+           "PRIMARY KEY (a_id, id))",
+           "CREATE TABLE c (v REAL NOT NULL)",
+           "CREATE TABLE d (b_id INTEGER, b_a_id INTEGER, "
+           "FOREIGN KEY (b_a_id, b_id) REFERENCES b(a_id, id))",
+           "CREATE VIEW v AS SELECT x FROM a",
+       }) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+  }
+
+  ASSERT_THAT(AdbcConnectionSetOption(&connection, "adbc.sqlite.get_objects.batch_tables",
+                                      "2", &error),
+              adbc_validation::IsOkStatus(&error));
+
+  // Read each table as "name: columns; constraints", with the tables of
+  // each batch on one line
+  auto get_objects = [&](const char* column_name, std::vector<std::string>* out) {
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcConnectionGetObjects(&connection, ADBC_OBJECT_DEPTH_ALL, nullptr,
+                                         nullptr, nullptr, nullptr, column_name,
+                                         &reader.stream.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    auto get_string = [](struct ArrowArrayView* view, int64_t i) {
+      ArrowStringView value = ArrowArrayViewGetStringUnsafe(view, i);
+      return std::string(value.data, value.size_bytes);
+    };
+    while (true) {
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      if (!reader.array->release) break;
+      ASSERT_EQ(1, reader.array->length);
+      ASSERT_EQ("main", get_string(reader.array_view->children[0], 0));
+
+      struct ArrowArrayView* tables =
+          reader.array_view->children[1]->children[0]->children[1]->children[0];
+      struct ArrowArrayView* columns = tables->children[2];
+      struct ArrowArrayView* constraints = tables->children[3];
+      struct ArrowArrayView* constraint_columns =
+          constraints->children[0]->children[2];
+      std::string batch;
+      for (int64_t i = 0; i < tables->length; i++) {
+        batch += get_string(tables->children[0], i) + ":";
+        for (int64_t j = ArrowArrayViewListChildOffset(columns, i);
+             j < ArrowArrayViewListChildOffset(columns, i + 1); j++) {
+          batch += " " + get_string(columns->children[0]->children[0], j);
+        }
+        batch += ";";
+        for (int64_t j = ArrowArrayViewListChildOffset(constraints, i);
+             j < ArrowArrayViewListChildOffset(constraints, i + 1); j++) {
+          batch += " " + get_string(constraints->children[0]->children[1], j) + "(";
+          for (int64_t k = ArrowArrayViewListChildOffset(constraint_columns, j);
+               k < ArrowArrayViewListChildOffset(constraint_columns, j + 1); k++) {
+            batch += " " + get_string(constraint_columns->children[0], k);
+          }
+          batch += ")";
+        }
+        batch += "\n";
+      }
+      out->push_back(std::move(batch));
+    }
+  };
+
+  std::vector<std::string> batches;
+  ASSERT_NO_FATAL_FAILURE(get_objects(nullptr, &batches));
+  ASSERT_THAT(batches, ::testing::ElementsAre(
+                           "a: id x; PRIMARY KEY( id)\n"
+                           "b: id a_id; PRIMARY KEY( a_id id) FOREIGN KEY( a_id)\n",
+                           "c: v;\n"
+                           "d: b_id b_a_id; FOREIGN KEY( b_a_id b_id)\n",
+                           "v: x;\n"));
+
+  // Constraints don't depend on the column filter
+  batches.clear();
+  ASSERT_NO_FATAL_FAILURE(get_objects("a%", &batches));
+  ASSERT_THAT(batches, ::testing::ElementsAre(
+                           "a:; PRIMARY KEY( id)\n"
+                           "b: a_id; PRIMARY KEY( a_id id) FOREIGN KEY( a_id)\n",
+                           "c:;\n"
+                           "d:; FOREIGN KEY( b_a_id b_id)\n",
+                           "v:;\n"));
+
+  ASSERT_THAT(AdbcConnectionSetOption(&connection, "adbc.sqlite.get_objects.batch_tables",
+                                      "0", &error),
+              adbc_validation::IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+}
+
+TEST_F(SqliteConnectionTest, GetObjectsAfterRelease) {
+  ASSERT_THAT(AdbcConnectionNew(&connection, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error),
+              adbc_validation::IsOkStatus(&error));
+  for (const char* query : {"CREATE TABLE a (x INTEGER)", "CREATE TABLE b (y TEXT)"}) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+  }
+  ASSERT_THAT(AdbcConnectionSetOption(&connection, "adbc.sqlite.get_objects.batch_tables",
+                                      "1", &error),
+              adbc_validation::IsOkStatus(&error));
+
+  // The stream reads through the connection, which can't be released
+  // until the stream is
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcConnectionGetObjects(&connection, ADBC_OBJECT_DEPTH_ALL, nullptr,
+                                       nullptr, nullptr, nullptr, nullptr,
+                                       &reader.stream.value, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionRelease(&connection, &error),
+              adbc_validation::IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+  if (error.release) error.release(&error);
+
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  std::vector<std::string> tables;
+  while (true) {
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    if (!reader.array->release) break;
+    struct ArrowArrayView* table_names = reader.array_view->children[1]
+                                             ->children[0]
+                                             ->children[1]
+                                             ->children[0]
+                                             ->children[0];
+    ASSERT_EQ(1, table_names->length);
+    ArrowStringView name = ArrowArrayViewGetStringUnsafe(table_names, 0);
+    tables.emplace_back(name.data, name.size_bytes);
+  }
+  ASSERT_THAT(tables, ::testing::ElementsAre("a", "b"));
+
+  reader.stream->release(&reader.stream.value);
+  ASSERT_THAT(AdbcConnectionRelease(&connection, &error),
+              adbc_validation::IsOkStatus(&error));
+}
+
 class SqliteStatementTest : public ::testing::Test,
                             public adbc_validation::StatementTest {
  public:
@@ -400,6 +913,464 @@ TEST_F(SqliteStatementTest, SqlIngestNameEscaping) {
   ASSERT_EQ(3, rows_affected);
 }
 
+TEST_F(SqliteStatementTest, SqlIngestTemporalModes) {
+  const std::vector<std::optional<int32_t>> dates = {std::nullopt, -42, 0, 19000};
+  const std::vector<std::optional<int64_t>> timestamps = {std::nullopt, -42, 0,
+                                                          1700000000123};
+
+  struct Case {
+    std::string mode;
+    std::string storage;
+    std::string declared_types;
+    ArrowTimeUnit unit;
+  };
+  for (const auto& [mode, storage, declared_types, unit] : std::vector<Case>{
+           {"iso8601", "text", "TEXT DATE,TEXT TIMESTAMP(3)", NANOARROW_TIME_UNIT_MILLI},
+           {"unixepoch_ms", "integer", "INTEGER DATE(3),INTEGER TIMESTAMP(3)",
+            NANOARROW_TIME_UNIT_MILLI},
+           {"unixepoch_us", "integer", "INTEGER DATE(6),INTEGER TIMESTAMP(6)",
+            NANOARROW_TIME_UNIT_MICRO},
+           {"julianday", "real", "REAL DATE,REAL TIMESTAMP(3)",
+            NANOARROW_TIME_UNIT_MILLI}}) {
+    SCOPED_TRACE(mode);
+    ASSERT_THAT(quirks()->DropTable(&connection, "bulk_ingest", &error),
+                adbc_validation::IsOkStatus(&error));
+
+    adbc_validation::Handle<struct ArrowSchema> schema;
+    adbc_validation::Handle<struct ArrowArray> batch;
+    struct ArrowError na_error;
+    ArrowSchemaInit(&schema.value);
+    ASSERT_EQ(0, ArrowSchemaSetTypeStruct(&schema.value, 2));
+    ASSERT_EQ(0, ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_DATE32));
+    ASSERT_EQ(0, ArrowSchemaSetName(schema->children[0], "d"));
+    ASSERT_EQ(0, ArrowSchemaSetTypeDateTime(schema->children[1], NANOARROW_TYPE_TIMESTAMP,
+                                            NANOARROW_TIME_UNIT_MILLI, nullptr));
+    ASSERT_EQ(0, ArrowSchemaSetName(schema->children[1], "ts"));
+    ASSERT_THAT((adbc_validation::MakeBatch<int32_t, int64_t>(
+                    &schema.value, &batch.value, &na_error, dates, timestamps)),
+                adbc_validation::IsOkErrno(&na_error));
+
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                       "bulk_ingest", &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.sqlite.bind.temporal_mode",
+                                       mode.c_str(), &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementBind(&statement, &batch.value, &schema.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement,
+                    "SELECT DISTINCT typeof(d) || ' ' || typeof(ts) FROM bulk_ingest "
+                    "WHERE d IS NOT NULL",
+                    &error),
+                adbc_validation::IsOkStatus(&error));
+    {
+      adbc_validation::StreamReader reader;
+      ASSERT_THAT(
+          AdbcStatementExecuteQuery(&statement, &reader.stream.value, nullptr, &error),
+          adbc_validation::IsOkStatus(&error));
+      ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      ASSERT_NO_FATAL_FAILURE(adbc_validation::CompareArray<std::string>(
+          reader.array_view->children[0], {storage + " " + storage}));
+    }
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement,
+                    "SELECT group_concat(type) FROM pragma_table_info('bulk_ingest')",
+                    &error),
+                adbc_validation::IsOkStatus(&error));
+    {
+      adbc_validation::StreamReader reader;
+      ASSERT_THAT(
+          AdbcStatementExecuteQuery(&statement, &reader.stream.value, nullptr, &error),
+          adbc_validation::IsOkStatus(&error));
+      ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      ASSERT_NO_FATAL_FAILURE(adbc_validation::CompareArray<std::string>(
+          reader.array_view->children[0], {declared_types}));
+    }
+
+    // The declared types map the columns back to date32/timestamp
+    ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.sqlite.query.use_declared_types",
+                                       ADBC_OPTION_VALUE_ENABLED, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcStatementSetSqlQuery(&statement, "SELECT * FROM bulk_ingest", &error),
+        adbc_validation::IsOkStatus(&error));
+    {
+      adbc_validation::StreamReader reader;
+      ASSERT_THAT(
+          AdbcStatementExecuteQuery(&statement, &reader.stream.value, nullptr, &error),
+          adbc_validation::IsOkStatus(&error));
+      ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+      ASSERT_EQ(NANOARROW_TYPE_DATE32, reader.fields[0].type);
+      ASSERT_EQ(NANOARROW_TYPE_TIMESTAMP, reader.fields[1].type);
+      ASSERT_EQ(unit, reader.fields[1].time_unit);
+      std::vector<std::optional<int64_t>> expected = timestamps;
+      for (auto& value : expected) {
+        if (value && unit == NANOARROW_TIME_UNIT_MICRO) *value *= 1000;
+      }
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      ASSERT_NO_FATAL_FAILURE(
+          adbc_validation::CompareArray<int32_t>(reader.array_view->children[0], dates));
+      ASSERT_NO_FATAL_FAILURE(adbc_validation::CompareArray<int64_t>(
+          reader.array_view->children[1], expected));
+    }
+    ASSERT_THAT(AdbcStatementRelease(&statement, &error),
+                adbc_validation::IsOkStatus(&error));
+  }
+}
+
+TEST_F(SqliteStatementTest, SqlIngestTemporalUnixEpoch) {
+  ASSERT_THAT(quirks()->DropTable(&connection, "bulk_ingest", &error),
+              adbc_validation::IsOkStatus(&error));
+  struct ArrowError na_error;
+  // Bind a batch of millisecond timestamps
+  auto bind = [&](std::vector<std::optional<int64_t>> values) {
+    adbc_validation::Handle<struct ArrowSchema> schema;
+    adbc_validation::Handle<struct ArrowArray> batch;
+    ArrowSchemaInit(&schema.value);
+    ASSERT_EQ(0, ArrowSchemaSetTypeStruct(&schema.value, 1));
+    ASSERT_EQ(0, ArrowSchemaSetTypeDateTime(schema->children[0], NANOARROW_TYPE_TIMESTAMP,
+                                            NANOARROW_TIME_UNIT_MILLI, nullptr));
+    ASSERT_EQ(0, ArrowSchemaSetName(schema->children[0], "ts"));
+    ASSERT_THAT((adbc_validation::MakeBatch<int64_t>(&schema.value, &batch.value,
+                                                     &na_error, values)),
+                adbc_validation::IsOkErrno(&na_error));
+    ASSERT_THAT(AdbcStatementBind(&statement, &batch.value, &schema.value, &error),
+                adbc_validation::IsOkStatus(&error));
+  };
+
+  // Without the option, ingestion declares no type for timestamps
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                     "bulk_ingest", &error),
+              adbc_validation::IsOkStatus(&error));
+  {
+    ASSERT_NO_FATAL_FAILURE(bind({1000}));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+  }
+  ASSERT_THAT(AdbcStatementSetSqlQuery(
+                  &statement,
+                  "SELECT type, (SELECT typeof(ts) FROM bulk_ingest) "
+                  "FROM pragma_table_info('bulk_ingest')",
+                  &error),
+              adbc_validation::IsOkStatus(&error));
+  {
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(
+        AdbcStatementExecuteQuery(&statement, &reader.stream.value, nullptr, &error),
+        adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_NO_FATAL_FAILURE(
+        adbc_validation::CompareArray<std::string>(reader.array_view->children[0], {""}));
+    ASSERT_NO_FATAL_FAILURE(adbc_validation::CompareArray<std::string>(
+        reader.array_view->children[1], {"text"}));
+  }
+  ASSERT_THAT(AdbcStatementRelease(&statement, &error),
+              adbc_validation::IsOkStatus(&error));
+
+  // unixepoch stores whole seconds, and rejects anything more precise
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetSqlQuery(&statement,
+                                       "INSERT INTO bulk_ingest VALUES (?)", &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.sqlite.bind.temporal_mode",
+                                     "unixepoch", &error),
+              adbc_validation::IsOkStatus(&error));
+  {
+    ASSERT_NO_FATAL_FAILURE(bind({-2000, 1700000000000}));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+  }
+  {
+    ASSERT_NO_FATAL_FAILURE(bind({1500}));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+                adbc_validation::IsStatus(ADBC_STATUS_INVALID_DATA, &error));
+  }
+  ASSERT_THAT(AdbcStatementSetSqlQuery(
+                  &statement,
+                  "SELECT ts FROM bulk_ingest WHERE typeof(ts) = 'integer' ORDER BY ts",
+                  &error),
+              adbc_validation::IsOkStatus(&error));
+  {
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(
+        AdbcStatementExecuteQuery(&statement, &reader.stream.value, nullptr, &error),
+        adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_NO_FATAL_FAILURE(adbc_validation::CompareArray<int64_t>(
+        reader.array_view->children[0], {-2, 1700000000}));
+  }
+}
+
+TEST_F(SqliteStatementTest, SqlIngestMultiRowInserts) {
+  // Enough rows that each batch needs several multi-row INSERTs plus a
+  // remainder statement, and batches of differing sizes
+  ASSERT_THAT(quirks()->DropTable(&connection, "bulk_ingest", &error),
+              adbc_validation::IsOkStatus(&error));
+
+  adbc_validation::Handle<struct ArrowSchema> schema;
+  struct ArrowError na_error;
+  ASSERT_THAT(
+      adbc_validation::MakeSchema(&schema.value, {{"ints", NANOARROW_TYPE_INT64},
+                                                  {"strs", NANOARROW_TYPE_STRING}}),
+      adbc_validation::IsOkErrno());
+
+  std::vector<struct ArrowArray> batches;
+  int64_t expected_sum = 0;
+  int64_t expected_rows = 0;
+  int64_t expected_strs = 0;
+  for (int64_t batch_rows : {40000, 3, 0, 20000}) {
+    std::vector<std::optional<int64_t>> ints;
+    std::vector<std::optional<std::string>> strs;
+    for (int64_t i = 0; i < batch_rows; i++) {
+      ints.push_back(expected_rows + i);
+      expected_sum += expected_rows + i;
+      if (i % 7 == 0) {
+        strs.push_back(std::nullopt);
+      } else {
+        strs.push_back(std::to_string(i));
+        expected_strs++;
+      }
+    }
+    expected_rows += batch_rows;
+    struct ArrowArray batch;
+    ASSERT_THAT((adbc_validation::MakeBatch<int64_t, std::string>(
+                    &schema.value, &batch, &na_error, ints, strs)),
+                adbc_validation::IsOkErrno(&na_error));
+    batches.push_back(batch);
+  }
+  adbc_validation::Handle<struct ArrowArrayStream> stream;
+  adbc_validation::MakeStream(&stream.value, &schema.value, std::move(batches));
+
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                     "bulk_ingest", &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementBindStream(&statement, &stream.value, &error),
+              adbc_validation::IsOkStatus(&error));
+  int64_t rows_affected = 0;
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, &rows_affected, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_EQ(expected_rows, rows_affected);
+
+  // Columns stay aligned: ints - strs is the offset of the row's batch
+  ASSERT_THAT(AdbcStatementSetSqlQuery(
+                  &statement,
+                  "SELECT count(*), sum(ints), count(strs), "
+                  "count(DISTINCT ints - CAST(strs AS INTEGER)) FROM bulk_ingest",
+                  &error),
+              adbc_validation::IsOkStatus(&error));
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(
+      AdbcStatementExecuteQuery(&statement, &reader.stream.value, nullptr, &error),
+      adbc_validation::IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_EQ(1, reader.array->length);
+  ASSERT_EQ(expected_rows, ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], 0));
+  ASSERT_EQ(expected_sum, ArrowArrayViewGetIntUnsafe(reader.array_view->children[1], 0));
+  ASSERT_EQ(expected_strs, ArrowArrayViewGetIntUnsafe(reader.array_view->children[2], 0));
+  ASSERT_EQ(3, ArrowArrayViewGetIntUnsafe(reader.array_view->children[3], 0));
+}
+
+TEST_F(SqliteStatementTest, SqlIngestBulkProfile) {
+  ASSERT_THAT(quirks()->DropTable(&connection, "indexed_ingest", &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error),
+              adbc_validation::IsOkStatus(&error));
+  for (const char* query : {
+           "CREATE TABLE indexed_ingest (ints INTEGER, strs TEXT)",
+           "CREATE INDEX indexed_ingest_ints ON indexed_ingest (ints)",
+           "CREATE UNIQUE INDEX indexed_ingest_strs ON indexed_ingest (strs)",
+       }) {
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement, query, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+  }
+
+  // The indexes, whether they are consistent with the table, and the
+  // settings the bulk profile changes
+  auto get_state = [&](std::vector<std::string>* out) {
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement,
+                    "SELECT (SELECT group_concat(name) FROM (SELECT name FROM "
+                    "sqlite_master WHERE tbl_name = 'indexed_ingest' AND type = 'index' "
+                    "ORDER BY name)), (SELECT integrity_check FROM "
+                    "pragma_integrity_check), (SELECT CAST(synchronous AS TEXT) FROM "
+                    "pragma_synchronous), (SELECT CAST(cache_size AS TEXT) FROM "
+                    "pragma_cache_size)",
+                    &error),
+                adbc_validation::IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(
+        AdbcStatementExecuteQuery(&statement, &reader.stream.value, nullptr, &error),
+        adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(1, reader.array->length);
+    out->clear();
+    for (int64_t i = 0; i < reader.array->n_children; i++) {
+      struct ArrowStringView value =
+          ArrowArrayViewGetStringUnsafe(reader.array_view->children[i], 0);
+      out->emplace_back(value.data, value.size_bytes);
+    }
+  };
+  std::vector<std::string> before;
+  ASSERT_NO_FATAL_FAILURE(get_state(&before));
+  ASSERT_EQ("indexed_ingest_ints,indexed_ingest_strs", before[0]);
+  ASSERT_EQ("ok", before[1]);
+
+  ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.sqlite.ingest.profile", "fast",
+                                     &error),
+              adbc_validation::IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+  ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.sqlite.ingest.profile", "bulk",
+                                     &error),
+              adbc_validation::IsOkStatus(&error));
+
+  for (int attempt = 0; attempt < 2; attempt++) {
+    SCOPED_TRACE("attempt " + std::to_string(attempt));
+    adbc_validation::Handle<struct ArrowSchema> schema;
+    struct ArrowError na_error;
+    ASSERT_THAT(
+        adbc_validation::MakeSchema(&schema.value, {{"ints", NANOARROW_TYPE_INT64},
+                                                    {"strs", NANOARROW_TYPE_STRING}}),
+        adbc_validation::IsOkErrno());
+    std::vector<std::optional<int64_t>> ints;
+    std::vector<std::optional<std::string>> strs;
+    for (int64_t i = 0; i < 1000; i++) {
+      ints.push_back(i % 10);
+      strs.push_back(std::to_string(i));
+    }
+    adbc_validation::Handle<struct ArrowArray> batch;
+    ASSERT_THAT((adbc_validation::MakeBatch<int64_t, std::string>(
+                    &schema.value, &batch.value, &na_error, ints, strs)),
+                adbc_validation::IsOkErrno(&na_error));
+
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                       "indexed_ingest", &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_MODE,
+                                       ADBC_INGEST_OPTION_MODE_APPEND, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementBind(&statement, &batch.value, &schema.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    int64_t rows_affected = 0;
+    if (attempt == 0) {
+      ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, &rows_affected, &error),
+                  adbc_validation::IsOkStatus(&error));
+      ASSERT_EQ(1000, rows_affected);
+    } else {
+      // The UNIQUE index is kept, and still enforced
+      ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, &rows_affected, &error),
+                  ::testing::Not(adbc_validation::IsOkStatus(&error)));
+    }
+
+    // The indexes were rebuilt, and the settings restored
+    std::vector<std::string> after;
+    ASSERT_NO_FATAL_FAILURE(get_state(&after));
+    ASSERT_EQ(before, after);
+  }
+}
+
+TEST_F(SqliteStatementTest, SqlPartitionedRowidRanges) {
+  ASSERT_THAT(quirks()->DropTable(&connection, "partitioned", &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetSqlQuery(
+                  &statement,
+                  "CREATE TABLE partitioned AS WITH RECURSIVE ints(x) AS (SELECT 1 UNION "
+                  "ALL SELECT x + 1 FROM ints WHERE x < 100) SELECT x FROM ints",
+                  &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+              adbc_validation::IsOkStatus(&error));
+
+  ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.sqlite.query.partition_count", "3",
+                                     &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetSqlQuery(
+                  &statement, "SELECT x FROM partitioned WHERE x % 2 = 0 OR x = 1;",
+                  &error),
+              adbc_validation::IsOkStatus(&error));
+
+  adbc_validation::Handle<struct ArrowSchema> schema;
+  adbc_validation::Handle<struct AdbcPartitions> partitions;
+  ASSERT_THAT(AdbcStatementExecutePartitions(&statement, &schema.value, &partitions.value,
+                                             nullptr, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_EQ(3, partitions->num_partitions);
+  ASSERT_EQ(1, schema->n_children);
+
+  // Every row is read exactly once across the partitions
+  std::vector<int64_t> seen;
+  for (size_t i = 0; i < partitions->num_partitions; i++) {
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcConnectionReadPartition(&connection, partitions->partitions[i],
+                                            partitions->partition_lengths[i],
+                                            &reader.stream.value, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    while (true) {
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      if (!reader.array->release) break;
+      for (int64_t row = 0; row < reader.array->length; row++) {
+        seen.push_back(ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], row));
+      }
+    }
+  }
+  std::sort(seen.begin(), seen.end());
+  std::vector<int64_t> expected = {1};
+  for (int64_t x = 2; x <= 100; x += 2) expected.push_back(x);
+  ASSERT_EQ(expected, seen);
+
+  // Queries that can't be split by rowid are a single partition, including
+  // those with aggregates nested in the select list
+  for (const char* query : {
+           "SELECT x % 3, count(*) FROM partitioned GROUP BY 1",
+           "SELECT abs(max(x)) FROM partitioned",
+           "SELECT coalesce(sum(x), 0) FROM partitioned",
+           "SELECT (count(*)) FROM partitioned",
+           "SELECT 1 + MIN (x) FROM partitioned WHERE x > 10",
+       }) {
+    SCOPED_TRACE(query);
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement, query, &error),
+                adbc_validation::IsOkStatus(&error));
+    adbc_validation::Handle<struct ArrowSchema> schema2;
+    adbc_validation::Handle<struct AdbcPartitions> partitions2;
+    ASSERT_THAT(AdbcStatementExecutePartitions(&statement, &schema2.value,
+                                               &partitions2.value, nullptr, &error),
+                adbc_validation::IsOkStatus(&error));
+    ASSERT_EQ(1, partitions2->num_partitions);
+  }
+
+  // A column that merely shares a name with an aggregate doesn't prevent
+  // splitting
+  ASSERT_THAT(AdbcStatementSetSqlQuery(&statement, "SELECT x AS max FROM partitioned",
+                                       &error),
+              adbc_validation::IsOkStatus(&error));
+  adbc_validation::Handle<struct ArrowSchema> schema3;
+  adbc_validation::Handle<struct AdbcPartitions> partitions3;
+  ASSERT_THAT(AdbcStatementExecutePartitions(&statement, &schema3.value,
+                                             &partitions3.value, nullptr, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_EQ(3, partitions3->num_partitions);
+}
+
 // -- SQLite Specific Tests ------------------------------------------
 
 constexpr size_t kInferRows = 16;
@@ -845,6 +1816,227 @@ TEST_F(SqliteReaderTest, MultiValueParams) {
   ASSERT_EQ(nullptr, reader.array->release);
 }
 
+TEST_F(SqliteReaderTest, DeclaredTypes) {
+  ASSERT_NO_FATAL_FAILURE(
+      Exec("CREATE TABLE foo (i BIGINT, s VARCHAR(16), d DOUBLE PRECISION, b BLOB)"));
+  // The first rows are all NULL, so inference alone would pick INT64
+  ASSERT_NO_FATAL_FAILURE(Exec(
+      "INSERT INTO foo VALUES (NULL, NULL, NULL, NULL), (NULL, NULL, NULL, NULL), "
+      "(1, 'foo', 2, X'0102'), (3, 4, 5.5, 'bar')"));
+
+  const std::string query = "SELECT * FROM foo";
+  ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(db, query.c_str(), query.size(), &stmt,
+                                          /*pzTail=*/nullptr));
+  struct AdbcSqliteReaderOptions options = {};
+  options.batch_size = 2;
+  options.use_declared_types = 1;
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcSqliteExportReaderWithOptions(db, stmt, /*binder=*/nullptr, &options,
+                                                &reader.stream.value, &error),
+              IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_EQ(4, reader.schema->n_children);
+  ASSERT_EQ(NANOARROW_TYPE_INT64, reader.fields[0].type);
+  ASSERT_EQ(NANOARROW_TYPE_STRING, reader.fields[1].type);
+  ASSERT_EQ(NANOARROW_TYPE_DOUBLE, reader.fields[2].type);
+  ASSERT_EQ(NANOARROW_TYPE_BINARY, reader.fields[3].type);
+
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_NO_FATAL_FAILURE(CompareArray<int64_t>(reader.array_view->children[0],
+                                                {std::nullopt, std::nullopt}));
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_NO_FATAL_FAILURE(CompareArray<int64_t>(reader.array_view->children[0], {1, 3}));
+  ASSERT_NO_FATAL_FAILURE(
+      CompareArray<std::string>(reader.array_view->children[1], {"foo", "4"}));
+  ASSERT_NO_FATAL_FAILURE(
+      CompareArray<double>(reader.array_view->children[2], {2.0, 5.5}));
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_EQ(nullptr, reader.array->release);
+}
+
+TEST_F(SqliteReaderTest, DeclaredTypesTemporal) {
+  // Without a precision, integers are Unix seconds (as with SQLite's
+  // 'unixepoch' modifier) and the timestamp unit is seconds
+  ASSERT_NO_FATAL_FAILURE(
+      Exec("CREATE TABLE foo (a DATETIME, b TIMESTAMP, c TIMESTAMP(3), d DATE)"));
+  ASSERT_NO_FATAL_FAILURE(
+      Exec("INSERT INTO foo VALUES (1700000000, '2023-11-14 22:13:20', "
+           "1700000000123, 1700000000), (NULL, NULL, NULL, '1970-01-02')"));
+
+  const std::string query = "SELECT * FROM foo";
+  ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(db, query.c_str(), query.size(), &stmt,
+                                          /*pzTail=*/nullptr));
+  struct AdbcSqliteReaderOptions options = {};
+  options.batch_size = kInferRows;
+  options.use_declared_types = 1;
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcSqliteExportReaderWithOptions(db, stmt, /*binder=*/nullptr, &options,
+                                                &reader.stream.value, &error),
+              IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_EQ(NANOARROW_TYPE_TIMESTAMP, reader.fields[0].type);
+  ASSERT_EQ(NANOARROW_TIME_UNIT_SECOND, reader.fields[0].time_unit);
+  ASSERT_EQ(NANOARROW_TYPE_TIMESTAMP, reader.fields[1].type);
+  ASSERT_EQ(NANOARROW_TIME_UNIT_SECOND, reader.fields[1].time_unit);
+  ASSERT_EQ(NANOARROW_TYPE_TIMESTAMP, reader.fields[2].type);
+  ASSERT_EQ(NANOARROW_TIME_UNIT_MILLI, reader.fields[2].time_unit);
+  ASSERT_EQ(NANOARROW_TYPE_DATE32, reader.fields[3].type);
+
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_NO_FATAL_FAILURE(
+      CompareArray<int64_t>(reader.array_view->children[0], {1700000000, std::nullopt}));
+  ASSERT_NO_FATAL_FAILURE(
+      CompareArray<int64_t>(reader.array_view->children[1], {1700000000, std::nullopt}));
+  ASSERT_NO_FATAL_FAILURE(CompareArray<int64_t>(reader.array_view->children[2],
+                                                {1700000000123, std::nullopt}));
+  ASSERT_NO_FATAL_FAILURE(
+      CompareArray<int32_t>(reader.array_view->children[3], {19675, 1}));
+}
+
+TEST_F(SqliteReaderTest, DeclaredTypesFallback) {
+  // Expressions have no declared type, so the schema is inferred
+  ASSERT_NO_FATAL_FAILURE(Exec("CREATE TABLE foo (i BIGINT)"));
+  ASSERT_NO_FATAL_FAILURE(Exec("INSERT INTO foo VALUES (1), (2)"));
+
+  const std::string query = "SELECT i, i * 1.5 AS d FROM foo";
+  ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(db, query.c_str(), query.size(), &stmt,
+                                          /*pzTail=*/nullptr));
+  struct AdbcSqliteReaderOptions options = {};
+  options.batch_size = kInferRows;
+  options.use_declared_types = 1;
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcSqliteExportReaderWithOptions(db, stmt, /*binder=*/nullptr, &options,
+                                                &reader.stream.value, &error),
+              IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_EQ(NANOARROW_TYPE_INT64, reader.fields[0].type);
+  ASSERT_EQ(NANOARROW_TYPE_DOUBLE, reader.fields[1].type);
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_NO_FATAL_FAILURE(
+      CompareArray<double>(reader.array_view->children[1], {1.5, 3.0}));
+}
+
+TEST_F(SqliteReaderTest, DeclaredTypesMismatch) {
+  // SQLite doesn't enforce declared types
+  ASSERT_NO_FATAL_FAILURE(Exec("CREATE TABLE foo (i INTEGER)"));
+  ASSERT_NO_FATAL_FAILURE(Exec("INSERT INTO foo VALUES (1), ('not an int')"));
+
+  const std::string query = "SELECT * FROM foo";
+  ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(db, query.c_str(), query.size(), &stmt,
+                                          /*pzTail=*/nullptr));
+  struct AdbcSqliteReaderOptions options = {};
+  options.batch_size = kInferRows;
+  options.use_declared_types = 1;
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcSqliteExportReaderWithOptions(db, stmt, /*binder=*/nullptr, &options,
+                                                &reader.stream.value, &error),
+              IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_EQ(NANOARROW_TYPE_INT64, reader.fields[0].type);
+  ASSERT_THAT(reader.MaybeNext(), adbc_validation::IsErrno(EIO, &reader.stream.value,
+                                                           /*error=*/nullptr));
+  ASSERT_THAT(reader.stream->get_last_error(&reader.stream.value),
+              ::testing::HasSubstr("expected INT64 but got STRING/BINARY"));
+}
+
+TEST_F(SqliteReaderTest, DictionaryEncoding) {
+  ASSERT_NO_FATAL_FAILURE(Exec("CREATE TABLE foo (i INTEGER, s TEXT, t TEXT)"));
+  ASSERT_NO_FATAL_FAILURE(
+      Exec("INSERT INTO foo VALUES (1, 'a', 'v'), (2, 'b', 'w'), (3, NULL, 'x'), "
+           "(4, 'a', 'y'), (5, 'c', 'z'), (6, 'a', '')"));
+
+  const std::string query = "SELECT * FROM foo";
+  ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(db, query.c_str(), query.size(), &stmt,
+                                          /*pzTail=*/nullptr));
+  struct AdbcSqliteReaderOptions options = {};
+  options.batch_size = 3;
+  options.dictionary_threshold = 2;
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcSqliteExportReaderWithOptions(db, stmt, /*binder=*/nullptr, &options,
+                                                &reader.stream.value, &error),
+              IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_EQ(3, reader.schema->n_children);
+  ASSERT_EQ(NANOARROW_TYPE_INT64, reader.fields[0].type);
+  // 's' has 2 distinct values in the first batch, 't' has 3
+  ASSERT_EQ(NANOARROW_TYPE_DICTIONARY, reader.fields[1].type);
+  ASSERT_EQ(NANOARROW_TYPE_INT32, reader.fields[1].storage_type);
+  ASSERT_EQ(std::string("u"), reader.schema->children[1]->dictionary->format);
+  ASSERT_EQ(NANOARROW_TYPE_STRING, reader.fields[2].type);
+
+  auto decode = [](struct ArrowArrayView* view) {
+    std::vector<std::optional<std::string>> values;
+    for (int64_t i = 0; i < view->length; i++) {
+      if (ArrowArrayViewIsNull(view, i)) {
+        values.push_back(std::nullopt);
+        continue;
+      }
+      int64_t index = ArrowArrayViewGetIntUnsafe(view, i);
+      struct ArrowStringView value =
+          ArrowArrayViewGetStringUnsafe(view->dictionary, index);
+      values.push_back(std::string(value.data, value.size_bytes));
+    }
+    return values;
+  };
+
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_EQ(2, reader.array_view->children[1]->dictionary->length);
+  ASSERT_THAT(decode(reader.array_view->children[1]),
+              ::testing::ElementsAre("a", "b", std::nullopt));
+  ASSERT_NO_FATAL_FAILURE(
+      CompareArray<std::string>(reader.array_view->children[2], {"v", "w", "x"}));
+
+  // Each batch has its own dictionary
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_EQ(2, reader.array_view->children[1]->dictionary->length);
+  ASSERT_THAT(decode(reader.array_view->children[1]),
+              ::testing::ElementsAre("a", "c", "a"));
+  ASSERT_NO_FATAL_FAILURE(
+      CompareArray<std::string>(reader.array_view->children[2], {"y", "z", ""}));
+
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_EQ(nullptr, reader.array->release);
+}
+
+TEST_F(SqliteReaderTest, DictionaryEncodingCap) {
+  // The first batch has one distinct value, later batches have more
+  ASSERT_NO_FATAL_FAILURE(Exec("CREATE TABLE foo (i INTEGER, s TEXT)"));
+  ASSERT_NO_FATAL_FAILURE(
+      Exec("INSERT INTO foo VALUES (1, 'a'), (2, 'a'), (3, 'a'), (4, 'b'), (5, 'c'), "
+           "(6, 'd'), (7, NULL), (8, 'b'), (9, 'e')"));
+
+  const std::string query = "SELECT * FROM foo";
+  ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(db, query.c_str(), query.size(), &stmt,
+                                          /*pzTail=*/nullptr));
+  struct AdbcSqliteReaderOptions options = {};
+  options.batch_size = 3;
+  options.dictionary_threshold = 2;
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcSqliteExportReaderWithOptions(db, stmt, /*binder=*/nullptr, &options,
+                                                &reader.stream.value, &error),
+              IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_EQ(NANOARROW_TYPE_DICTIONARY, reader.fields[1].type);
+
+  // A batch ends early rather than growing its dictionary past the
+  // threshold, and no row is lost or repeated
+  std::vector<std::vector<int64_t>> batches;
+  while (true) {
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    if (!reader.array->release) break;
+    ASSERT_LE(reader.array_view->children[1]->dictionary->length, 2);
+    std::vector<int64_t> ids;
+    for (int64_t row = 0; row < reader.array->length; row++) {
+      ids.push_back(ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], row));
+    }
+    batches.push_back(std::move(ids));
+  }
+  ASSERT_THAT(batches, ::testing::ElementsAre(::testing::ElementsAre(1, 2, 3),
+                                              ::testing::ElementsAre(4, 5),
+                                              ::testing::ElementsAre(6, 7, 8),
+                                              ::testing::ElementsAre(9)));
+}
+
 template <typename CType>
 class SqliteNumericParamTest : public SqliteReaderTest,
                                public ::testing::WithParamInterface<ArrowType> {
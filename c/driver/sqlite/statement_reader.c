@@ -18,10 +18,12 @@
 #include "statement_reader.h"
 
 #include <assert.h>
+#include <ctype.h>
 #include <inttypes.h>
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 
 #include <adbc.h>
@@ -56,6 +58,8 @@ AdbcStatusCode AdbcSqliteBinderSet(struct AdbcSqliteBinder* binder,
 
   binder->types =
       (enum ArrowType*)malloc(binder->schema.n_children * sizeof(enum ArrowType));
+  binder->time_units = (enum ArrowTimeUnit*)calloc(binder->schema.n_children,
+                                                   sizeof(enum ArrowTimeUnit));
 
   struct ArrowSchemaView view = {0};
   for (int i = 0; i < binder->schema.n_children; i++) {
@@ -96,6 +100,7 @@ AdbcStatusCode AdbcSqliteBinderSet(struct AdbcSqliteBinder* binder,
     }
 
     binder->types[i] = view.type;
+    binder->time_units[i] = view.time_unit;
   }
 
   return ADBC_STATUS_OK;
@@ -119,14 +124,58 @@ AdbcStatusCode AdbcSqliteBinderSetArrayStream(struct AdbcSqliteBinder* binder,
 }
 
 #define SECONDS_PER_DAY 86400
+// The Julian day number of the Unix epoch
+#define JULIAN_DAY_EPOCH 2440587.5
+
+// Large enough for any ISO 8601 date or timestamp we format
+#define ISO_STRING_BUFFER_SIZE 64
+
+// Write value as exactly `digits` decimal digits (zero-padded).
+static char* WriteDigits(char* out, int64_t value, int digits) {
+  for (int i = digits - 1; i >= 0; i--) {
+    out[i] = (char)('0' + value % 10);
+    value /= 10;
+  }
+  return out + digits;
+}
+
+// Format days since the Unix epoch as YYYY-MM-DD using civil calendar
+// arithmetic, which is much cheaper than gmtime + strftime. Returns the
+// end of the output, or NULL (writing nothing) if the year is outside
+// 0-9999, in which case callers fall back to strftime.
+static char* WriteIsoDate(int64_t days, char* out) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const int64_t day_of_era = days - era * 146097;
+  const int64_t year_of_era =
+      (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+  const int64_t day_of_year =
+      day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  const int64_t mp = (5 * day_of_year + 2) / 153;
+  const int64_t day = day_of_year - (153 * mp + 2) / 5 + 1;
+  const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+  const int64_t year = year_of_era + era * 400 + (month <= 2);
+  if (year < 0 || year > 9999) return NULL;
+
+  out = WriteDigits(out, year, 4);
+  *out++ = '-';
+  out = WriteDigits(out, month, 2);
+  *out++ = '-';
+  return WriteDigits(out, day, 2);
+}
 
 /*
-  Allocates to buf on success. Caller is responsible for freeing.
-  On failure sets error and contents of buf are undefined.
+  Writes a NUL-terminated string to buf, which must hold at least
+  ISO_STRING_BUFFER_SIZE bytes. On failure sets error and contents of buf
+  are undefined.
 */
-static AdbcStatusCode ArrowDate32ToIsoString(int32_t value, char** buf,
+static AdbcStatusCode ArrowDate32ToIsoString(int32_t value, char* buf,
                                              struct AdbcError* error) {
-  int strlen = 10;
+  char* end = WriteIsoDate(value, buf);
+  if (end) {
+    *end = '\0';
+    return ADBC_STATUS_OK;
+  }
 
 #if SIZEOF_TIME_T < 8
   if ((value > INT32_MAX / SECONDS_PER_DAY) || (value < INT32_MIN / SECONDS_PER_DAY)) {
@@ -155,49 +204,83 @@ static AdbcStatusCode ArrowDate32ToIsoString(int32_t value, char** buf,
   }
 #endif
 
-  char* tsstr = malloc(strlen + 1);
-  if (tsstr == NULL) {
-    return ADBC_STATUS_IO;
-  }
-
-  if (strftime(tsstr, strlen + 1, "%Y-%m-%d", &broken_down_time) == 0) {
+  if (strftime(buf, ISO_STRING_BUFFER_SIZE, "%Y-%m-%d", &broken_down_time) == 0) {
     SetError(error, "Call to strftime for date %" PRId32 " with failed", value);
-    free(tsstr);
     return ADBC_STATUS_INVALID_ARGUMENT;
   }
 
-  *buf = tsstr;
   return ADBC_STATUS_OK;
 }
 
-/*
-  Allocates to buf on success. Caller is responsible for freeing.
-  On failure sets error and contents of buf are undefined.
-*/
-static AdbcStatusCode ArrowTimestampToIsoString(int64_t value, enum ArrowTimeUnit unit,
-                                                char** buf, struct AdbcError* error) {
-  int scale = 1;
-  int strlen = 20;
-  int rem = 0;
-
+static int64_t ArrowTimeUnitScale(enum ArrowTimeUnit unit) {
   switch (unit) {
     case NANOARROW_TIME_UNIT_SECOND:
-      break;
+      return 1;
     case NANOARROW_TIME_UNIT_MILLI:
-      scale = 1000;
-      strlen = 24;
-      break;
+      return 1000;
     case NANOARROW_TIME_UNIT_MICRO:
-      scale = 1000000;
-      strlen = 27;
-      break;
+      return 1000000;
     case NANOARROW_TIME_UNIT_NANO:
-      scale = 1000000000;
-      strlen = 30;
-      break;
+      return 1000000000;
+  }
+  return 1;
+}
+
+int AdbcSqliteTemporalModeUnit(enum AdbcSqliteTemporalMode mode) {
+  switch (mode) {
+    case ADBC_SQLITE_TEMPORAL_UNIXEPOCH:
+      return NANOARROW_TIME_UNIT_SECOND;
+    case ADBC_SQLITE_TEMPORAL_UNIXEPOCH_MS:
+      return NANOARROW_TIME_UNIT_MILLI;
+    case ADBC_SQLITE_TEMPORAL_UNIXEPOCH_US:
+      return NANOARROW_TIME_UNIT_MICRO;
+    case ADBC_SQLITE_TEMPORAL_UNIXEPOCH_NS:
+      return NANOARROW_TIME_UNIT_NANO;
+    default:
+      return -1;
+  }
+}
+
+/// Convert a value in units of 1/from seconds to units of 1/to seconds,
+/// failing if that overflows or loses precision.
+static AdbcStatusCode ArrowEpochRescale(int64_t value, int64_t from, int64_t to, int col,
+                                        int64_t* out, struct AdbcError* error) {
+  if (to >= from) {
+    const int64_t factor = to / from;
+    if (value > INT64_MAX / factor || value < INT64_MIN / factor) {
+      SetError(error,
+               "Column %d has value %" PRId64
+               " which is out of range for the temporal mode",
+               col, value);
+      return ADBC_STATUS_INVALID_DATA;
+    }
+    *out = value * factor;
+  } else {
+    const int64_t divisor = from / to;
+    if (value % divisor != 0) {
+      SetError(error,
+               "Column %d has value %" PRId64
+               " which is more precise than the temporal mode can store",
+               col, value);
+      return ADBC_STATUS_INVALID_DATA;
+    }
+    *out = value / divisor;
   }
+  return ADBC_STATUS_OK;
+}
+
+/*
+  Writes a NUL-terminated string to buf, which must hold at least
+  ISO_STRING_BUFFER_SIZE bytes. On failure sets error and contents of buf
+  are undefined.
+*/
+static AdbcStatusCode ArrowTimestampToIsoString(int64_t value, enum ArrowTimeUnit unit,
+                                                char* buf, struct AdbcError* error) {
+  const int64_t scale = ArrowTimeUnitScale(unit);
+  const int strlen = ISO_STRING_BUFFER_SIZE;
+  int rem = 0;
 
-  rem = value % scale;
+  rem = (int)(value % scale);
   if (rem < 0) {
     value -= scale;
     rem = scale + rem;
@@ -205,6 +288,26 @@ static AdbcStatusCode ArrowTimestampToIsoString(int64_t value, enum ArrowTimeUni
 
   const int64_t seconds = value / scale;
 
+  const int64_t days =
+      seconds >= 0 ? seconds / SECONDS_PER_DAY : (seconds + 1) / SECONDS_PER_DAY - 1;
+  char* end = WriteIsoDate(days, buf);
+  if (end) {
+    const int64_t second_of_day = seconds - days * SECONDS_PER_DAY;
+    *end++ = 'T';
+    end = WriteDigits(end, second_of_day / 3600, 2);
+    *end++ = ':';
+    end = WriteDigits(end, (second_of_day / 60) % 60, 2);
+    *end++ = ':';
+    end = WriteDigits(end, second_of_day % 60, 2);
+    if (unit != NANOARROW_TIME_UNIT_SECOND) {
+      // 3, 6, or 9 fractional digits
+      *end++ = '.';
+      end = WriteDigits(end, rem, 3 * (int)unit);
+    }
+    *end = '\0';
+    return ADBC_STATUS_OK;
+  }
+
 #if SIZEOF_TIME_T < 8
   if ((seconds > INT32_MAX) || (seconds < INT32_MIN)) {
     SetError(error, "Timestamp %" PRId64 " with unit %d exceeds platform time_t bounds",
@@ -237,15 +340,10 @@ static AdbcStatusCode ArrowTimestampToIsoString(int64_t value, enum ArrowTimeUni
   }
 #endif
 
-  char* tsstr = malloc(strlen + 1);
-  if (tsstr == NULL) {
-    return ADBC_STATUS_IO;
-  }
-
+  char* tsstr = buf;
   if (strftime(tsstr, strlen, "%Y-%m-%dT%H:%M:%S", &broken_down_time) == 0) {
     SetError(error, "Call to strftime for timestamp %" PRId64 " with unit %d failed",
              value, unit);
-    free(tsstr);
     return ADBC_STATUS_INVALID_ARGUMENT;
   }
 
@@ -267,13 +365,14 @@ static AdbcStatusCode ArrowTimestampToIsoString(int64_t value, enum ArrowTimeUni
       break;
   }
 
-  *buf = tsstr;
   return ADBC_STATUS_OK;
 }
 
-AdbcStatusCode AdbcSqliteBinderBindNext(struct AdbcSqliteBinder* binder, sqlite3* conn,
-                                        sqlite3_stmt* stmt, char* finished,
-                                        struct AdbcError* error) {
+// Make sure a batch with unbound rows is loaded, and return the number of
+// unbound rows in it (or set finished if the stream is exhausted).
+static AdbcStatusCode AdbcSqliteBinderLoadBatch(struct AdbcSqliteBinder* binder,
+                                                int64_t* available, char* finished,
+                                                struct AdbcError* error) {
   struct ArrowError arrow_error = {0};
   int status = 0;
   while (!binder->array.release || binder->next_row >= binder->array.length) {
@@ -301,6 +400,7 @@ AdbcStatusCode AdbcSqliteBinderBindNext(struct AdbcSqliteBinder* binder, sqlite3
 
     if (!binder->array.release) {
       *finished = 1;
+      *available = 0;
       AdbcSqliteBinderRelease(binder);
       return ADBC_STATUS_OK;
     }
@@ -315,6 +415,175 @@ AdbcStatusCode AdbcSqliteBinderBindNext(struct AdbcSqliteBinder* binder, sqlite3
     binder->next_row = 0;
   }
 
+  *available = binder->array.length - binder->next_row;
+  *finished = 0;
+  return ADBC_STATUS_OK;
+}
+
+// Bind the value of column col at the given row of the current batch.
+static AdbcStatusCode AdbcSqliteBinderBindValue(struct AdbcSqliteBinder* binder,
+                                                sqlite3* conn, sqlite3_stmt* stmt,
+                                                int col, int64_t row, int param,
+                                                struct AdbcError* error) {
+  int status = 0;
+  if (ArrowArrayViewIsNull(binder->batch.children[col], row)) {
+    status = sqlite3_bind_null(stmt, param);
+  } else {
+    switch (binder->types[col]) {
+      case NANOARROW_TYPE_BINARY:
+      case NANOARROW_TYPE_LARGE_BINARY: {
+        struct ArrowBufferView value =
+            ArrowArrayViewGetBytesUnsafe(binder->batch.children[col], row);
+        status = sqlite3_bind_blob(stmt, param, value.data.as_char, value.size_bytes,
+                                   SQLITE_STATIC);
+        break;
+      }
+      case NANOARROW_TYPE_BOOL:
+      case NANOARROW_TYPE_UINT8:
+      case NANOARROW_TYPE_UINT16:
+      case NANOARROW_TYPE_UINT32:
+      case NANOARROW_TYPE_UINT64: {
+        uint64_t value = ArrowArrayViewGetUIntUnsafe(binder->batch.children[col], row);
+        if (value > INT64_MAX) {
+          SetError(error,
+                   "Column %d has unsigned integer value %" PRIu64
+                   "out of range of int64_t",
+                   col, value);
+          return ADBC_STATUS_INVALID_ARGUMENT;
+        }
+        status = sqlite3_bind_int64(stmt, param, (int64_t)value);
+        break;
+      }
+      case NANOARROW_TYPE_INT8:
+      case NANOARROW_TYPE_INT16:
+      case NANOARROW_TYPE_INT32:
+      case NANOARROW_TYPE_INT64: {
+        int64_t value = ArrowArrayViewGetIntUnsafe(binder->batch.children[col], row);
+        status = sqlite3_bind_int64(stmt, param, value);
+        break;
+      }
+      case NANOARROW_TYPE_FLOAT:
+      case NANOARROW_TYPE_DOUBLE: {
+        double value = ArrowArrayViewGetDoubleUnsafe(binder->batch.children[col], row);
+        status = sqlite3_bind_double(stmt, param, value);
+        break;
+      }
+      case NANOARROW_TYPE_STRING:
+      case NANOARROW_TYPE_LARGE_STRING: {
+        struct ArrowBufferView value =
+            ArrowArrayViewGetBytesUnsafe(binder->batch.children[col], row);
+        status = sqlite3_bind_text(stmt, param, value.data.as_char, value.size_bytes,
+                                   SQLITE_STATIC);
+        break;
+      }
+      case NANOARROW_TYPE_DICTIONARY: {
+        int64_t value_index =
+            ArrowArrayViewGetIntUnsafe(binder->batch.children[col], row);
+        if (ArrowArrayViewIsNull(binder->batch.children[col]->dictionary, value_index)) {
+          status = sqlite3_bind_null(stmt, param);
+        } else {
+          struct ArrowBufferView value = ArrowArrayViewGetBytesUnsafe(
+              binder->batch.children[col]->dictionary, value_index);
+          status = sqlite3_bind_text(stmt, param, value.data.as_char, value.size_bytes,
+                                     SQLITE_STATIC);
+        }
+        break;
+      }
+      case NANOARROW_TYPE_DATE32: {
+        int64_t value = ArrowArrayViewGetIntUnsafe(binder->batch.children[col], row);
+
+        if ((value > INT32_MAX) || (value < INT32_MIN)) {
+          SetError(error,
+                   "Column %d has value %" PRId64
+                   " which exceeds the expected range "
+                   "for an Arrow DATE32 type",
+                   col, value);
+          return ADBC_STATUS_INVALID_DATA;
+        }
+
+        switch (binder->temporal_mode) {
+          case ADBC_SQLITE_TEMPORAL_UNIXEPOCH:
+          case ADBC_SQLITE_TEMPORAL_UNIXEPOCH_MS:
+          case ADBC_SQLITE_TEMPORAL_UNIXEPOCH_US:
+          case ADBC_SQLITE_TEMPORAL_UNIXEPOCH_NS: {
+            const int64_t scale = ArrowTimeUnitScale(
+                (enum ArrowTimeUnit)AdbcSqliteTemporalModeUnit(binder->temporal_mode));
+            int64_t stored = 0;
+            RAISE_ADBC(ArrowEpochRescale(value * SECONDS_PER_DAY, /*from=*/1, scale, col,
+                                         &stored, error));
+            status = sqlite3_bind_int64(stmt, param, stored);
+            break;
+          }
+          case ADBC_SQLITE_TEMPORAL_JULIANDAY:
+            status = sqlite3_bind_double(stmt, param, (double)value + JULIAN_DAY_EPOCH);
+            break;
+          default: {
+            char tsstr[ISO_STRING_BUFFER_SIZE];
+            RAISE_ADBC(ArrowDate32ToIsoString((int32_t)value, tsstr, error));
+            // SQLITE_TRANSIENT ensures the value is copied during bind
+            status =
+                sqlite3_bind_text(stmt, param, tsstr, strlen(tsstr), SQLITE_TRANSIENT);
+            break;
+          }
+        }
+        break;
+      }
+      case NANOARROW_TYPE_TIMESTAMP: {
+        enum ArrowTimeUnit unit = binder->time_units[col];
+        int64_t value = ArrowArrayViewGetIntUnsafe(binder->batch.children[col], row);
+
+        switch (binder->temporal_mode) {
+          case ADBC_SQLITE_TEMPORAL_UNIXEPOCH:
+          case ADBC_SQLITE_TEMPORAL_UNIXEPOCH_MS:
+          case ADBC_SQLITE_TEMPORAL_UNIXEPOCH_US:
+          case ADBC_SQLITE_TEMPORAL_UNIXEPOCH_NS: {
+            const int64_t scale = ArrowTimeUnitScale(
+                (enum ArrowTimeUnit)AdbcSqliteTemporalModeUnit(binder->temporal_mode));
+            int64_t stored = 0;
+            RAISE_ADBC(ArrowEpochRescale(value, ArrowTimeUnitScale(unit), scale, col,
+                                         &stored, error));
+            status = sqlite3_bind_int64(stmt, param, stored);
+            break;
+          }
+          case ADBC_SQLITE_TEMPORAL_JULIANDAY: {
+            const double units_per_day =
+                (double)ArrowTimeUnitScale(unit) * SECONDS_PER_DAY;
+            status = sqlite3_bind_double(
+                stmt, param, (double)value / units_per_day + JULIAN_DAY_EPOCH);
+            break;
+          }
+          default: {
+            char tsstr[ISO_STRING_BUFFER_SIZE];
+            RAISE_ADBC(ArrowTimestampToIsoString(value, unit, tsstr, error));
+            // SQLITE_TRANSIENT ensures the value is copied during bind
+            status =
+                sqlite3_bind_text(stmt, param, tsstr, strlen(tsstr), SQLITE_TRANSIENT);
+            break;
+          }
+        }
+        break;
+      }
+      default:
+        SetError(error, "Column %d has unsupported type %s", col,
+                 ArrowTypeString(binder->types[col]));
+        return ADBC_STATUS_NOT_IMPLEMENTED;
+    }
+  }
+
+  if (status != SQLITE_OK) {
+    SetError(error, "Failed to bind parameter %d: %s", param, sqlite3_errmsg(conn));
+    return ADBC_STATUS_INTERNAL;
+  }
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode AdbcSqliteBinderBindNext(struct AdbcSqliteBinder* binder, sqlite3* conn,
+                                        sqlite3_stmt* stmt, char* finished,
+                                        struct AdbcError* error) {
+  int64_t available = 0;
+  RAISE_ADBC(AdbcSqliteBinderLoadBatch(binder, &available, finished, error));
+  if (*finished) return ADBC_STATUS_OK;
+
   if (sqlite3_reset(stmt) != SQLITE_OK) {
     SetError(error, "Failed to reset statement: %s", sqlite3_errmsg(conn));
     return ADBC_STATUS_INTERNAL;
@@ -325,127 +594,51 @@ AdbcStatusCode AdbcSqliteBinderBindNext(struct AdbcSqliteBinder* binder, sqlite3
   }
 
   for (int col = 0; col < binder->schema.n_children; col++) {
-    if (ArrowArrayViewIsNull(binder->batch.children[col], binder->next_row)) {
-      status = sqlite3_bind_null(stmt, col + 1);
-    } else {
-      switch (binder->types[col]) {
-        case NANOARROW_TYPE_BINARY:
-        case NANOARROW_TYPE_LARGE_BINARY: {
-          struct ArrowBufferView value =
-              ArrowArrayViewGetBytesUnsafe(binder->batch.children[col], binder->next_row);
-          status = sqlite3_bind_blob(stmt, col + 1, value.data.as_char, value.size_bytes,
-                                     SQLITE_STATIC);
-          break;
-        }
-        case NANOARROW_TYPE_BOOL:
-        case NANOARROW_TYPE_UINT8:
-        case NANOARROW_TYPE_UINT16:
-        case NANOARROW_TYPE_UINT32:
-        case NANOARROW_TYPE_UINT64: {
-          uint64_t value =
-              ArrowArrayViewGetUIntUnsafe(binder->batch.children[col], binder->next_row);
-          if (value > INT64_MAX) {
-            SetError(error,
-                     "Column %d has unsigned integer value %" PRIu64
-                     "out of range of int64_t",
-                     col, value);
-            return ADBC_STATUS_INVALID_ARGUMENT;
-          }
-          status = sqlite3_bind_int64(stmt, col + 1, (int64_t)value);
-          break;
-        }
-        case NANOARROW_TYPE_INT8:
-        case NANOARROW_TYPE_INT16:
-        case NANOARROW_TYPE_INT32:
-        case NANOARROW_TYPE_INT64: {
-          int64_t value =
-              ArrowArrayViewGetIntUnsafe(binder->batch.children[col], binder->next_row);
-          status = sqlite3_bind_int64(stmt, col + 1, value);
-          break;
-        }
-        case NANOARROW_TYPE_FLOAT:
-        case NANOARROW_TYPE_DOUBLE: {
-          double value = ArrowArrayViewGetDoubleUnsafe(binder->batch.children[col],
-                                                       binder->next_row);
-          status = sqlite3_bind_double(stmt, col + 1, value);
-          break;
-        }
-        case NANOARROW_TYPE_STRING:
-        case NANOARROW_TYPE_LARGE_STRING: {
-          struct ArrowBufferView value =
-              ArrowArrayViewGetBytesUnsafe(binder->batch.children[col], binder->next_row);
-          status = sqlite3_bind_text(stmt, col + 1, value.data.as_char, value.size_bytes,
-                                     SQLITE_STATIC);
-          break;
-        }
-        case NANOARROW_TYPE_DICTIONARY: {
-          int64_t value_index =
-              ArrowArrayViewGetIntUnsafe(binder->batch.children[col], binder->next_row);
-          if (ArrowArrayViewIsNull(binder->batch.children[col]->dictionary,
-                                   value_index)) {
-            status = sqlite3_bind_null(stmt, col + 1);
-          } else {
-            struct ArrowBufferView value = ArrowArrayViewGetBytesUnsafe(
-                binder->batch.children[col]->dictionary, value_index);
-            status = sqlite3_bind_text(stmt, col + 1, value.data.as_char,
-                                       value.size_bytes, SQLITE_STATIC);
-          }
-          break;
-        }
-        case NANOARROW_TYPE_DATE32: {
-          int64_t value =
-              ArrowArrayViewGetIntUnsafe(binder->batch.children[col], binder->next_row);
-          char* tsstr;
-
-          if ((value > INT32_MAX) || (value < INT32_MIN)) {
-            SetError(error,
-                     "Column %d has value %" PRId64
-                     " which exceeds the expected range "
-                     "for an Arrow DATE32 type",
-                     col, value);
-            return ADBC_STATUS_INVALID_DATA;
-          }
+    RAISE_ADBC(AdbcSqliteBinderBindValue(binder, conn, stmt, col, binder->next_row,
+                                         col + 1, error));
+  }
+
+  binder->next_row++;
+  *finished = 0;
+  return ADBC_STATUS_OK;
+}
 
-          RAISE_ADBC(ArrowDate32ToIsoString((int32_t)value, &tsstr, error));
-          // SQLITE_TRANSIENT ensures the value is copied during bind
-          status =
-              sqlite3_bind_text(stmt, col + 1, tsstr, strlen(tsstr), SQLITE_TRANSIENT);
+AdbcStatusCode AdbcSqliteBinderRowsAvailable(struct AdbcSqliteBinder* binder,
+                                             int64_t* available, char* finished,
+                                             struct AdbcError* error) {
+  return AdbcSqliteBinderLoadBatch(binder, available, finished, error);
+}
 
-          free(tsstr);
-          break;
-        }
-        case NANOARROW_TYPE_TIMESTAMP: {
-          struct ArrowSchemaView bind_schema_view;
-          RAISE_ADBC(ArrowSchemaViewInit(&bind_schema_view, binder->schema.children[col],
-                                         &arrow_error));
-          enum ArrowTimeUnit unit = bind_schema_view.time_unit;
-          int64_t value =
-              ArrowArrayViewGetIntUnsafe(binder->batch.children[col], binder->next_row);
-
-          char* tsstr;
-          RAISE_ADBC(ArrowTimestampToIsoString(value, unit, &tsstr, error));
-
-          // SQLITE_TRANSIENT ensures the value is copied during bind
-          status =
-              sqlite3_bind_text(stmt, col + 1, tsstr, strlen(tsstr), SQLITE_TRANSIENT);
-          free((char*)tsstr);
-          break;
-        }
-        default:
-          SetError(error, "Column %d has unsupported type %s", col,
-                   ArrowTypeString(binder->types[col]));
-          return ADBC_STATUS_NOT_IMPLEMENTED;
-      }
-    }
+AdbcStatusCode AdbcSqliteBinderBindRows(struct AdbcSqliteBinder* binder, sqlite3* conn,
+                                        sqlite3_stmt* stmt, int64_t num_rows,
+                                        struct AdbcError* error) {
+  const int num_columns = (int)binder->schema.n_children;
+  if (num_rows > binder->array.length - binder->next_row ||
+      (int64_t)sqlite3_bind_parameter_count(stmt) != num_rows * num_columns) {
+    SetError(error,
+             "Cannot bind %" PRId64 " rows of %d columns to a statement with %d "
+             "parameters",
+             num_rows, num_columns, sqlite3_bind_parameter_count(stmt));
+    return ADBC_STATUS_INTERNAL;
+  }
 
-    if (status != SQLITE_OK) {
-      SetError(error, "Failed to clear statement bindings: %s", sqlite3_errmsg(conn));
-      return ADBC_STATUS_INTERNAL;
+  if (sqlite3_reset(stmt) != SQLITE_OK) {
+    SetError(error, "Failed to reset statement: %s", sqlite3_errmsg(conn));
+    return ADBC_STATUS_INTERNAL;
+  }
+
+  // Every parameter is rebound, so there is no need to clear bindings.
+  // Bind column by column to stay within each column's buffers.
+  for (int col = 0; col < num_columns; col++) {
+    int param = col + 1;
+    for (int64_t i = 0; i < num_rows; i++) {
+      RAISE_ADBC(AdbcSqliteBinderBindValue(binder, conn, stmt, col, binder->next_row + i,
+                                           param, error));
+      param += num_columns;
     }
   }
 
-  binder->next_row++;
-  *finished = 0;
+  binder->next_row += num_rows;
   return ADBC_STATUS_OK;
 }
 
@@ -459,6 +652,9 @@ void AdbcSqliteBinderRelease(struct AdbcSqliteBinder* binder) {
   if (binder->types) {
     free(binder->types);
   }
+  if (binder->time_units) {
+    free(binder->time_units);
+  }
   if (binder->array.release) {
     binder->array.release(&binder->array);
   }
@@ -466,15 +662,130 @@ void AdbcSqliteBinderRelease(struct AdbcSqliteBinder* binder) {
   memset(binder, 0, sizeof(*binder));
 }
 
+// -- Dictionary encoding --------------------------------------------
+//
+// With a dictionary threshold, string columns whose first batch has at
+// most that many distinct values are read as dictionary<int32, utf8>.
+// Every batch gets its own dictionary, which is also capped at the
+// threshold: if a later row would add one more distinct value, the
+// batch ends before that row, so a column whose cardinality grows past
+// the first batch yields smaller batches rather than an unbounded
+// dictionary. Values are deduplicated with an open-addressing hash
+// table whose slots point back into the dictionary's own offsets/data
+// buffers, so strings are stored once.
+
+struct StatementReaderDictionary {
+  /// Dictionary index + 1 of the value in each slot, or 0 if empty.
+  int32_t* slots;
+  /// Number of slots (a power of two).
+  int64_t capacity;
+};
+
+static uint64_t StatementReaderHashBytes(const char* value, int64_t size) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (int64_t i = 0; i < size; i++) {
+    hash ^= (unsigned char)value[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static void StatementReaderDictionaryReset(struct StatementReaderDictionary* dict) {
+  if (dict->slots) memset(dict->slots, 0, dict->capacity * sizeof(int32_t));
+}
+
+static void StatementReaderDictionaryRelease(struct StatementReaderDictionary* dict) {
+  free(dict->slots);
+  dict->slots = NULL;
+  dict->capacity = 0;
+}
+
+/// Double the number of slots and re-insert the dictionary's values.
+static int StatementReaderDictionaryGrow(struct StatementReaderDictionary* dict,
+                                         struct ArrowArray* values) {
+  const int64_t capacity = dict->capacity ? dict->capacity * 2 : 64;
+  int32_t* slots = calloc(capacity, sizeof(int32_t));
+  if (!slots) return ENOMEM;
+
+  const int32_t* offsets = (const int32_t*)ArrowArrayBuffer(values, 1)->data;
+  const char* data = (const char*)ArrowArrayBuffer(values, 2)->data;
+  for (int64_t i = 0; i < values->length; i++) {
+    uint64_t slot =
+        StatementReaderHashBytes(data + offsets[i], offsets[i + 1] - offsets[i]) &
+        (capacity - 1);
+    while (slots[slot] != 0) slot = (slot + 1) & (capacity - 1);
+    slots[slot] = (int32_t)(i + 1);
+  }
+
+  free(dict->slots);
+  dict->slots = slots;
+  dict->capacity = capacity;
+  return 0;
+}
+
+/// Find the slot of a value in the dictionary (or the empty slot where
+/// it would go). Returns its index, or -1 if it is not present.
+static int32_t StatementReaderDictionaryFind(
+    const struct StatementReaderDictionary* dict, struct ArrowArray* values,
+    const char* value, int64_t size, uint64_t* slot_out) {
+  if (dict->capacity == 0) return -1;
+  const int32_t* offsets = (const int32_t*)ArrowArrayBuffer(values, 1)->data;
+  const char* data = (const char*)ArrowArrayBuffer(values, 2)->data;
+  uint64_t slot = StatementReaderHashBytes(value, size) & (dict->capacity - 1);
+  while (dict->slots[slot] != 0) {
+    const int32_t candidate = dict->slots[slot] - 1;
+    const int64_t candidate_size = offsets[candidate + 1] - offsets[candidate];
+    if (candidate_size == size &&
+        (size == 0 || memcmp(data + offsets[candidate], value, size) == 0)) {
+      return candidate;
+    }
+    slot = (slot + 1) & (dict->capacity - 1);
+  }
+  if (slot_out) *slot_out = slot;
+  return -1;
+}
+
+/// Look up a value in the dictionary, appending it if not yet present.
+static int StatementReaderDictionaryGetIndex(struct StatementReaderDictionary* dict,
+                                             struct ArrowArray* values,
+                                             const char* value, int64_t size,
+                                             int32_t* index) {
+  // Keep the load factor at or below 1/2
+  if ((values->length + 1) * 2 > dict->capacity) {
+    RAISE_NA(StatementReaderDictionaryGrow(dict, values));
+  }
+
+  uint64_t slot = 0;
+  *index = StatementReaderDictionaryFind(dict, values, value, size, &slot);
+  if (*index >= 0) return 0;
+
+  if (values->length >= INT32_MAX) return EOVERFLOW;
+  struct ArrowStringView view;
+  view.data = value;
+  view.size_bytes = size;
+  RAISE_NA(ArrowArrayAppendString(values, view));
+  *index = (int32_t)(values->length - 1);
+  dict->slots[slot] = *index + 1;
+  return 0;
+}
+
 struct StatementReader {
   sqlite3* db;
   sqlite3_stmt* stmt;
   enum ArrowType* types;
+  /// Per-column hash tables for dictionary-encoded columns (or NULL).
+  struct StatementReaderDictionary* dictionaries;
+  size_t dictionary_threshold;
+  /// Per-column time units for timestamp columns (or NULL).
+  enum ArrowTimeUnit* time_units;
   struct ArrowSchema schema;
   struct ArrowArray initial_batch;
   struct AdbcSqliteBinder* binder;
   struct ArrowError error;
   char done;
+  /// The statement is on a row that belongs to the next batch.
+  char row_pending;
   int batch_size;
 };
 
@@ -495,6 +806,46 @@ void StatementReaderSetError(struct StatementReader* reader) {
   reader->error.message[sizeof(reader->error.message) - 1] = '\0';
 }
 
+/// Append a (non-NULL) value to a dictionary-encoded column.
+static int StatementReaderAppendDictionary(struct StatementReader* reader, int col,
+                                           struct ArrowArray* out) {
+  // Let SQLite convert (sqlite3_column_bytes must come after _text)
+  const char* value = (const char*)sqlite3_column_text(reader->stmt, col);
+  int32_t index = 0;
+  RAISE_NA(StatementReaderDictionaryGetIndex(&reader->dictionaries[col],
+                                             out->dictionary, value,
+                                             sqlite3_column_bytes(reader->stmt, col),
+                                             &index));
+  return ArrowArrayAppendInt(out, index);
+}
+
+/// Check that the current row's values fit in the batch's dictionaries,
+/// i.e. no full dictionary would need another value.
+static char StatementReaderDictionariesFit(struct StatementReader* reader,
+                                           struct ArrowArray* out) {
+  if (!reader->dictionaries || reader->dictionary_threshold == 0) return 1;
+  for (int col = 0; col < reader->schema.n_children; col++) {
+    struct ArrowArray* values = out->children[col]->dictionary;
+    if (reader->types[col] != NANOARROW_TYPE_DICTIONARY ||
+        values->length < (int64_t)reader->dictionary_threshold ||
+        sqlite3_column_type(reader->stmt, col) == SQLITE_NULL) {
+      continue;
+    }
+    const char* value = (const char*)sqlite3_column_text(reader->stmt, col);
+    if (StatementReaderDictionaryFind(&reader->dictionaries[col], values, value,
+                                      sqlite3_column_bytes(reader->stmt, col),
+                                      /*slot_out=*/NULL) < 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static int StatementReaderAppendDate32(struct StatementReader* reader, int col,
+                                       struct ArrowArray* out);
+static int StatementReaderAppendTimestamp(struct StatementReader* reader, int col,
+                                          struct ArrowArray* out);
+
 int StatementReaderGetOneValue(struct StatementReader* reader, int col,
                                struct ArrowArray* out) {
   int sqlite_type = sqlite3_column_type(reader->stmt, col);
@@ -608,6 +959,13 @@ int StatementReaderGetOneValue(struct StatementReader* reader, int col,
       return ArrowArrayAppendBytes(out, value);
     }
 
+    case NANOARROW_TYPE_DICTIONARY:
+      return StatementReaderAppendDictionary(reader, col, out);
+    case NANOARROW_TYPE_DATE32:
+      return StatementReaderAppendDate32(reader, col, out);
+    case NANOARROW_TYPE_TIMESTAMP:
+      return StatementReaderAppendTimestamp(reader, col, out);
+
     default: {
       snprintf(reader->error.message, sizeof(reader->error.message),
                "[SQLite] Internal error: unknown inferred column type %d",
@@ -619,6 +977,164 @@ int StatementReaderGetOneValue(struct StatementReader* reader, int col,
   return 0;
 }
 
+// -- Date and timestamp columns ------------------------------------
+//
+// Columns of these types (which only come from declared types) accept
+// every format the binder can store: ISO 8601 text, integers since the
+// Unix epoch, and reals holding a Julian day number.
+
+static int64_t StatementReaderFloorDiv(int64_t value, int64_t divisor) {
+  int64_t quotient = value / divisor;
+  if (value % divisor != 0 && value < 0) quotient--;
+  return quotient;
+}
+
+/// Days since the Unix epoch of a (proleptic Gregorian) civil date.
+static int64_t StatementReaderDaysFromCivil(int64_t year, int64_t month, int64_t day) {
+  year -= month <= 2;
+  const int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const int64_t year_of_era = year - era * 400;
+  const int64_t day_of_year =
+      (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const int64_t day_of_era =
+      year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+static int StatementReaderParseDigits(const char* text, int size, int* pos, int digits,
+                                      int64_t* out) {
+  int64_t value = 0;
+  for (int i = 0; i < digits; i++) {
+    if (*pos >= size || !isdigit((unsigned char)text[*pos])) return EINVAL;
+    value = value * 10 + (text[(*pos)++] - '0');
+  }
+  *out = value;
+  return 0;
+}
+
+/// Parse YYYY-MM-DD[(T| )HH:MM[:SS[.fraction]]][Z] into units of 1/scale
+/// seconds since the Unix epoch (truncating extra fractional digits).
+static int StatementReaderParseIsoTimestamp(const char* text, int size, int64_t scale,
+                                            int64_t* out) {
+  int pos = 0;
+  int64_t year, month, day, hour = 0, minute = 0, second = 0, fraction = 0;
+  RAISE_NA(StatementReaderParseDigits(text, size, &pos, 4, &year));
+  if (pos >= size || text[pos++] != '-') return EINVAL;
+  RAISE_NA(StatementReaderParseDigits(text, size, &pos, 2, &month));
+  if (pos >= size || text[pos++] != '-') return EINVAL;
+  RAISE_NA(StatementReaderParseDigits(text, size, &pos, 2, &day));
+
+  if (pos < size && (text[pos] == 'T' || text[pos] == ' ')) {
+    pos++;
+    RAISE_NA(StatementReaderParseDigits(text, size, &pos, 2, &hour));
+    if (pos >= size || text[pos++] != ':') return EINVAL;
+    RAISE_NA(StatementReaderParseDigits(text, size, &pos, 2, &minute));
+    if (pos < size && text[pos] == ':') {
+      pos++;
+      RAISE_NA(StatementReaderParseDigits(text, size, &pos, 2, &second));
+      if (pos < size && text[pos] == '.') {
+        pos++;
+        int64_t digit_scale = 1;
+        if (pos >= size || !isdigit((unsigned char)text[pos])) return EINVAL;
+        while (pos < size && isdigit((unsigned char)text[pos])) {
+          if (digit_scale < scale) {
+            fraction = fraction * 10 + (text[pos] - '0');
+            digit_scale *= 10;
+          }
+          pos++;
+        }
+        fraction *= scale / digit_scale;
+      }
+    }
+  }
+  if (pos < size && text[pos] == 'Z') pos++;
+  if (pos != size || month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 ||
+      minute > 59 || second > 60) {
+    return EINVAL;
+  }
+
+  const int64_t seconds =
+      StatementReaderDaysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * 3600 +
+      minute * 60 + second;
+  if (seconds > INT64_MAX / scale - 1 || seconds < INT64_MIN / scale + 1) return ERANGE;
+  *out = seconds * scale + fraction;
+  return 0;
+}
+
+/// Get a date/timestamp value in units of 1/scale seconds since the
+/// Unix epoch. Integers are in units of the column's time unit (which
+/// for dates comes from the declared precision, e.g. DATE(3)).
+static int StatementReaderGetEpochValue(struct StatementReader* reader, int col,
+                                        int64_t scale, int64_t* out) {
+  switch (sqlite3_column_type(reader->stmt, col)) {
+    case SQLITE_INTEGER: {
+      const int64_t value = sqlite3_column_int64(reader->stmt, col);
+      const int64_t unit_scale = ArrowTimeUnitScale(reader->time_units[col]);
+      if (unit_scale >= scale) {
+        *out = StatementReaderFloorDiv(value, unit_scale / scale);
+      } else if (value > INT64_MAX / (scale / unit_scale) ||
+                 value < INT64_MIN / (scale / unit_scale)) {
+        snprintf(reader->error.message, sizeof(reader->error.message),
+                 "[SQLite] Timestamp in column %d is out of range", col);
+        return ERANGE;
+      } else {
+        *out = value * (scale / unit_scale);
+      }
+      return 0;
+    }
+    case SQLITE_FLOAT: {
+      const double julian_day = sqlite3_column_double(reader->stmt, col);
+      const double value = (julian_day - JULIAN_DAY_EPOCH) * SECONDS_PER_DAY * scale;
+      if (!(value > (double)INT64_MIN && value < (double)INT64_MAX)) {
+        snprintf(reader->error.message, sizeof(reader->error.message),
+                 "[SQLite] Julian day in column %d is out of range", col);
+        return ERANGE;
+      }
+      *out = llround(value);
+      return 0;
+    }
+    case SQLITE_TEXT: {
+      const char* value = (const char*)sqlite3_column_text(reader->stmt, col);
+      const int size = sqlite3_column_bytes(reader->stmt, col);
+      int status = StatementReaderParseIsoTimestamp(value, size, scale, out);
+      if (status != 0) {
+        snprintf(reader->error.message, sizeof(reader->error.message),
+                 "[SQLite] Could not parse '%.*s' in column %d as an ISO 8601 "
+                 "date/timestamp",
+                 size > 64 ? 64 : size, value, col);
+      }
+      return status;
+    }
+    default:
+      snprintf(reader->error.message, sizeof(reader->error.message),
+               "[SQLite] Type mismatch in column %d: expected DATE/TIMESTAMP but got "
+               "BINARY",
+               col);
+      return EIO;
+  }
+}
+
+static int StatementReaderAppendDate32(struct StatementReader* reader, int col,
+                                       struct ArrowArray* out) {
+  int64_t seconds = 0;
+  RAISE_NA(StatementReaderGetEpochValue(reader, col, /*scale=*/1, &seconds));
+  const int64_t days = StatementReaderFloorDiv(seconds, SECONDS_PER_DAY);
+  if (days > INT32_MAX || days < INT32_MIN) {
+    snprintf(reader->error.message, sizeof(reader->error.message),
+             "[SQLite] Date in column %d is out of range of DATE32", col);
+    return ERANGE;
+  }
+  return ArrowArrayAppendInt(out, days);
+}
+
+static int StatementReaderAppendTimestamp(struct StatementReader* reader, int col,
+                                          struct ArrowArray* out) {
+  int64_t value = 0;
+  RAISE_NA(StatementReaderGetEpochValue(
+      reader, col, ArrowTimeUnitScale(reader->time_units[col]), &value));
+  return ArrowArrayAppendInt(out, value);
+}
+
 int StatementReaderGetNext(struct ArrowArrayStream* self, struct ArrowArray* out) {
   if (!self->release || !self->private_data) {
     return EINVAL;
@@ -636,12 +1152,19 @@ int StatementReaderGetNext(struct ArrowArrayStream* self, struct ArrowArray* out
 
   RAISE_NA(ArrowArrayInitFromSchema(out, &reader->schema, &reader->error));
   RAISE_NA(ArrowArrayStartAppending(out));
+  for (int col = 0; col < reader->schema.n_children; col++) {
+    // Each batch starts a new dictionary
+    if (reader->types[col] == NANOARROW_TYPE_DICTIONARY) {
+      StatementReaderDictionaryReset(&reader->dictionaries[col]);
+    }
+  }
   int64_t batch_size = 0;
   int status = 0;
 
   sqlite3_mutex_enter(sqlite3_db_mutex(reader->db));
   while (batch_size < reader->batch_size) {
-    int rc = sqlite3_step(reader->stmt);
+    int rc = reader->row_pending ? SQLITE_ROW : sqlite3_step(reader->stmt);
+    reader->row_pending = 0;
     if (rc == SQLITE_DONE) {
       if (!reader->binder) {
         reader->done = 1;
@@ -679,6 +1202,15 @@ int StatementReaderGetNext(struct ArrowArrayStream* self, struct ArrowArray* out
       break;
     }
 
+    if (batch_size > 0 && !StatementReaderDictionariesFit(reader, out)) {
+      // Start the next batch (and its dictionaries) with this row
+      reader->row_pending = 1;
+      break;
+    }
+
+    // Values are appended one cell at a time. Per-type loops writing into
+    // buffers reserved for the whole batch made no measurable difference
+    // in sqlite-benchmark, since reads are bound by sqlite3_step itself.
     for (int col = 0; col < reader->schema.n_children; col++) {
       status = StatementReaderGetOneValue(reader, col, out->children[col]);
       if (status != 0) break;
@@ -715,6 +1247,12 @@ int StatementReaderGetSchema(struct ArrowArrayStream* self, struct ArrowSchema*
 void StatementReaderRelease(struct ArrowArrayStream* self) {
   if (self->private_data) {
     struct StatementReader* reader = (struct StatementReader*)self->private_data;
+    if (reader->dictionaries) {
+      for (int col = 0; col < reader->schema.n_children; col++) {
+        StatementReaderDictionaryRelease(&reader->dictionaries[col]);
+      }
+      free(reader->dictionaries);
+    }
     if (reader->schema.release) {
       reader->schema.release(&reader->schema);
     }
@@ -724,6 +1262,9 @@ void StatementReaderRelease(struct ArrowArrayStream* self) {
     if (reader->types) {
       free(reader->types);
     }
+    if (reader->time_units) {
+      free(reader->time_units);
+    }
     if (reader->binder) {
       AdbcSqliteBinderRelease(reader->binder);
     }
@@ -756,8 +1297,10 @@ void StatementReaderRelease(struct ArrowArrayStream* self) {
 //   for maximum flexibility for later values
 // - Make this more flexible (e.g. choose whether to attempt to cast
 //   incompatible values, or insert a null, instead of erroring)
-// - Add the option to try to use SQLite's designated type for a
-//   column, instead of inferring the type (where possible).
+//
+// Alternatively, the schema can be taken from the declared types of the
+// columns (see StatementReaderInitFromDeclaredTypes), in which case
+// nothing is buffered up front.
 
 /// Initialize buffers for the first (type-inferred) batch of data.
 /// Use raw buffers since the types may change.
@@ -778,6 +1321,98 @@ AdbcStatusCode StatementReaderInitializeInfer(int num_columns, size_t infer_rows
   return ADBC_STATUS_OK;
 }  // NOLINT(whitespace/indent)
 
+/// Dictionary-encode a string column of the first batch. Leaves the
+/// column alone if it has more than reader->dictionary_threshold
+/// distinct values.
+static int StatementReaderInferDictionary(struct StatementReader* reader, int col,
+                                          char* encoded) {
+  struct ArrowArray* arr = reader->initial_batch.children[col];
+  struct StatementReaderDictionary* dict = &reader->dictionaries[col];
+  const uint8_t* validity = ArrowArrayValidityBitmap(arr)->buffer.data;
+  const int32_t* offsets = (const int32_t*)ArrowArrayBuffer(arr, 1)->data;
+  const char* data = (const char*)ArrowArrayBuffer(arr, 2)->data;
+
+  struct ArrowArray out;
+  RAISE_NA(ArrowArrayInitFromType(&out, NANOARROW_TYPE_INT32));
+  int status = ArrowArrayAllocateDictionary(&out);
+  if (status == 0) {
+    status = ArrowArrayInitFromType(out.dictionary, NANOARROW_TYPE_STRING);
+  }
+  if (status == 0) status = ArrowArrayStartAppending(out.dictionary);
+
+  struct ArrowBuffer indices;
+  ArrowBufferInit(&indices);
+  if (status == 0) status = ArrowBufferReserve(&indices, arr->length * sizeof(int32_t));
+
+  for (int64_t row = 0; status == 0 && row < arr->length; row++) {
+    int32_t index = 0;
+    if (ArrowBitGet(validity, row)) {
+      status = StatementReaderDictionaryGetIndex(dict, out.dictionary,
+                                                 data + offsets[row],
+                                                 offsets[row + 1] - offsets[row], &index);
+      if (out.dictionary->length > (int64_t)reader->dictionary_threshold) break;
+    }
+    ArrowBufferAppendUnsafe(&indices, &index, sizeof(index));
+  }
+
+  *encoded = status == 0 &&
+             out.dictionary->length <= (int64_t)reader->dictionary_threshold;
+  if (*encoded) {
+    status = ArrowArrayFinishBuildingDefault(out.dictionary, NULL);
+  }
+  if (status != 0 || !*encoded) {
+    *encoded = 0;
+    ArrowBufferReset(&indices);
+    out.release(&out);
+    return status;
+  }
+
+  // Reuse the validity bitmap, and replace the string column
+  ArrowArraySetValidityBitmap(&out, ArrowArrayValidityBitmap(arr));
+  (void)ArrowArraySetBuffer(&out, 1, &indices);
+  out.length = arr->length;
+  out.null_count = arr->null_count;
+  arr->release(arr);
+  ArrowArrayMove(&out, arr);
+  return 0;
+}
+
+/// Dictionary-encode the low-cardinality string columns of the first
+/// batch, and update the schema and column types to match.
+static AdbcStatusCode StatementReaderInferDictionaries(struct StatementReader* reader,
+                                                       enum ArrowType* current_type,
+                                                       struct AdbcError* error) {
+  const int64_t num_columns = reader->schema.n_children;
+  reader->dictionaries = calloc(num_columns, sizeof(struct StatementReaderDictionary));
+  if (!reader->dictionaries) {
+    SetError(error, "[SQLite] Failed to allocate dictionaries");
+    return ADBC_STATUS_INTERNAL;
+  }
+
+  for (int col = 0; col < num_columns; col++) {
+    if (current_type[col] != NANOARROW_TYPE_STRING) continue;
+
+    char encoded = 0;
+    int status = StatementReaderInferDictionary(reader, col, &encoded);
+    if (status != 0) {
+      SetError(error, "[SQLite] Failed to dictionary-encode column %d: %s", col,
+               strerror(status));
+      return ADBC_STATUS_INTERNAL;
+    } else if (!encoded) {
+      StatementReaderDictionaryRelease(&reader->dictionaries[col]);
+      continue;
+    }
+
+    struct ArrowSchema* field = reader->schema.children[col];
+    CHECK_NA(INTERNAL, ArrowSchemaSetType(field, NANOARROW_TYPE_INT32), error);
+    CHECK_NA(INTERNAL, ArrowSchemaAllocateDictionary(field), error);
+    CHECK_NA(INTERNAL, ArrowSchemaInitFromType(field->dictionary, NANOARROW_TYPE_STRING),
+             error);
+    current_type[col] = NANOARROW_TYPE_DICTIONARY;
+  }
+  return ADBC_STATUS_OK;
+}
+
 /// Finalize the first (type-inferred) batch of data.
 AdbcStatusCode StatementReaderInferFinalize(
     sqlite3_stmt* stmt, int num_columns, int64_t num_rows, struct StatementReader* reader,
@@ -820,6 +1455,10 @@ AdbcStatusCode StatementReaderInferFinalize(
     }
     arr->length = num_rows;
   }
+
+  if (reader->dictionary_threshold > 0) {
+    return StatementReaderInferDictionaries(reader, current_type, error);
+  }
   return ADBC_STATUS_OK;
 }
 
@@ -1114,15 +1753,204 @@ AdbcStatusCode StatementReaderInferOneValue(
   return ADBC_STATUS_OK;
 }  // NOLINT(whitespace/indent)
 
+// -- Declared type reader -------------------------------------------
+
+/// Map a declared column type to an Arrow type using SQLite's rules for
+/// column affinity (https://www.sqlite.org/datatype3.html#affname).
+/// Returns NANOARROW_TYPE_UNINITIALIZED for columns without a declared
+/// type (e.g. expressions) or with NUMERIC affinity, whose values may
+/// be integers, reals, or text.
+static enum ArrowType StatementReaderDeclaredType(const char* declared_type,
+                                                  enum ArrowTimeUnit* unit) {
+  if (declared_type == NULL) return NANOARROW_TYPE_UNINITIALIZED;
+
+  char upper[64];
+  size_t len = strlen(declared_type);
+  if (len >= sizeof(upper)) len = sizeof(upper) - 1;
+  for (size_t i = 0; i < len; i++) {
+    upper[i] = (char)toupper((unsigned char)declared_type[i]);
+  }
+  upper[len] = '\0';
+
+  // Temporal types aren't an affinity, but are recognized by name. The
+  // precision of e.g. TIMESTAMP(p) gives the time unit of the column's
+  // integers (and of a timestamp column itself); without one, integers
+  // are seconds, as with SQLite's 'unixepoch' modifier.
+  const char* precision = strchr(upper, '(');
+  const int digits = precision ? atoi(precision + 1) : 0;
+  if (digits <= 0) {
+    *unit = NANOARROW_TIME_UNIT_SECOND;
+  } else if (digits <= 3) {
+    *unit = NANOARROW_TIME_UNIT_MILLI;
+  } else if (digits <= 6) {
+    *unit = NANOARROW_TIME_UNIT_MICRO;
+  } else {
+    *unit = NANOARROW_TIME_UNIT_NANO;
+  }
+  if (strstr(upper, "TIMESTAMP") || strstr(upper, "DATETIME")) {
+    return NANOARROW_TYPE_TIMESTAMP;
+  } else if (strstr(upper, "DATE")) {
+    return NANOARROW_TYPE_DATE32;
+  } else if (strstr(upper, "INT")) {
+    return NANOARROW_TYPE_INT64;
+  } else if (strstr(upper, "CHAR") || strstr(upper, "CLOB") || strstr(upper, "TEXT")) {
+    return NANOARROW_TYPE_STRING;
+  } else if (strstr(upper, "BLOB") || len == 0) {
+    return NANOARROW_TYPE_BINARY;
+  } else if (strstr(upper, "REAL") || strstr(upper, "FLOA") || strstr(upper, "DOUB")) {
+    return NANOARROW_TYPE_DOUBLE;
+  }
+  return NANOARROW_TYPE_UNINITIALIZED;
+}
+
+/// Build the schema from the declared column types. Sets *resolved to 0
+/// (and leaves the reader untouched) if some column's type can't be
+/// determined this way.
+static AdbcStatusCode StatementReaderInitFromDeclaredTypes(struct StatementReader* reader,
+                                                           char* resolved,
+                                                           struct AdbcError* error) {
+  const int num_columns = sqlite3_column_count(reader->stmt);
+  enum ArrowType* types = malloc(num_columns * sizeof(enum ArrowType));
+  enum ArrowTimeUnit* time_units = calloc(num_columns, sizeof(enum ArrowTimeUnit));
+  *resolved = 0;
+  for (int col = 0; col < num_columns; col++) {
+    types[col] = StatementReaderDeclaredType(sqlite3_column_decltype(reader->stmt, col),
+                                             &time_units[col]);
+    if (types[col] == NANOARROW_TYPE_UNINITIALIZED) {
+      free(types);
+      free(time_units);
+      return ADBC_STATUS_OK;
+    }
+  }
+
+  ArrowSchemaInit(&reader->schema);
+  int na_res = ArrowSchemaSetTypeStruct(&reader->schema, num_columns);
+  for (int col = 0; na_res == 0 && col < num_columns; col++) {
+    struct ArrowSchema* field = reader->schema.children[col];
+    if (types[col] == NANOARROW_TYPE_TIMESTAMP) {
+      na_res = ArrowSchemaSetTypeDateTime(field, types[col], time_units[col],
+                                          /*timezone=*/NULL);
+    } else {
+      na_res = ArrowSchemaSetType(field, types[col]);
+    }
+    if (na_res == 0) {
+      na_res = ArrowSchemaSetName(field, sqlite3_column_name(reader->stmt, col));
+    }
+  }
+  if (na_res != 0) {
+    SetError(error, "[SQLite] Failed to build schema: (%d) %s", na_res,
+             strerror(na_res));
+    free(types);
+    free(time_units);
+    return ADBC_STATUS_INTERNAL;
+  }
+
+  reader->types = types;
+  reader->time_units = time_units;
+  *resolved = 1;
+  return ADBC_STATUS_OK;
+}
+
+/// Take the schema from the caller, checking that the reader can produce
+/// it for this statement.
+static AdbcStatusCode StatementReaderInitFromSchema(struct StatementReader* reader,
+                                                    const struct ArrowSchema* schema,
+                                                    struct AdbcError* error) {
+  const int num_columns = sqlite3_column_count(reader->stmt);
+  if (schema->n_children != num_columns) {
+    SetError(error, "[SQLite] Expected %" PRId64 " result columns but the query has %d",
+             schema->n_children, num_columns);
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+
+  enum ArrowType* types = malloc(num_columns * sizeof(enum ArrowType));
+  enum ArrowTimeUnit* time_units = calloc(num_columns, sizeof(enum ArrowTimeUnit));
+  for (int col = 0; col < num_columns; col++) {
+    struct ArrowSchemaView view;
+    struct ArrowError na_error;
+    if (ArrowSchemaViewInit(&view, schema->children[col], &na_error) != 0) {
+      SetError(error, "[SQLite] Invalid schema for column %d: %s", col,
+               na_error.message);
+      free(types);
+      free(time_units);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    types[col] = view.type;
+    time_units[col] = view.time_unit;
+    if (view.type == NANOARROW_TYPE_DATE32) {
+      // The unit of integer dates comes from the declared precision
+      (void)StatementReaderDeclaredType(sqlite3_column_decltype(reader->stmt, col),
+                                        &time_units[col]);
+    }
+    switch (view.type) {
+      case NANOARROW_TYPE_INT64:
+      case NANOARROW_TYPE_DOUBLE:
+      case NANOARROW_TYPE_STRING:
+      case NANOARROW_TYPE_BINARY:
+      case NANOARROW_TYPE_DATE32:
+        continue;
+      case NANOARROW_TYPE_TIMESTAMP:
+        if (view.timezone == NULL || view.timezone[0] == '\0') continue;
+        break;
+      case NANOARROW_TYPE_DICTIONARY: {
+        struct ArrowSchemaView value_view;
+        if (view.storage_type == NANOARROW_TYPE_INT32 &&
+            ArrowSchemaViewInit(&value_view, schema->children[col]->dictionary,
+                                NULL) == 0 &&
+            value_view.type == NANOARROW_TYPE_STRING) {
+          continue;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    SetError(error, "[SQLite] Can't read column %d as %s", col,
+             ArrowTypeString(view.type));
+    free(types);
+    free(time_units);
+    return ADBC_STATUS_NOT_IMPLEMENTED;
+  }
+
+  reader->dictionaries = calloc(num_columns, sizeof(struct StatementReaderDictionary));
+  int na_res = ENOMEM;
+  if (reader->dictionaries) {
+    na_res = ArrowSchemaDeepCopy((struct ArrowSchema*)schema, &reader->schema);
+  }
+  if (na_res != 0) {
+    SetError(error, "[SQLite] Failed to copy schema: (%d) %s", na_res, strerror(na_res));
+    free(reader->dictionaries);
+    reader->dictionaries = NULL;
+    free(types);
+    free(time_units);
+    return ADBC_STATUS_INTERNAL;
+  }
+  reader->types = types;
+  reader->time_units = time_units;
+  return ADBC_STATUS_OK;
+}
+
 AdbcStatusCode AdbcSqliteExportReader(sqlite3* db, sqlite3_stmt* stmt,
                                       struct AdbcSqliteBinder* binder, size_t batch_size,
                                       struct ArrowArrayStream* stream,
                                       struct AdbcError* error) {
+  struct AdbcSqliteReaderOptions options;
+  memset(&options, 0, sizeof(options));
+  options.batch_size = batch_size;
+  return AdbcSqliteExportReaderWithOptions(db, stmt, binder, &options, stream, error);
+}
+
+AdbcStatusCode AdbcSqliteExportReaderWithOptions(
+    sqlite3* db, sqlite3_stmt* stmt, struct AdbcSqliteBinder* binder,
+    const struct AdbcSqliteReaderOptions* options, struct ArrowArrayStream* stream,
+    struct AdbcError* error) {
+  const size_t batch_size = options->batch_size;
   struct StatementReader* reader = malloc(sizeof(struct StatementReader));
   memset(reader, 0, sizeof(struct StatementReader));
   reader->db = db;
   reader->stmt = stmt;
   reader->batch_size = batch_size;
+  reader->dictionary_threshold = options->dictionary_threshold;
 
   stream->private_data = reader;
   stream->release = StatementReaderRelease;
@@ -1132,6 +1960,45 @@ AdbcStatusCode AdbcSqliteExportReader(sqlite3* db, sqlite3_stmt* stmt,
 
   sqlite3_mutex_enter(sqlite3_db_mutex(db));
 
+  if (options->schema) {
+    // No rows are read up front; the first GetNext starts streaming
+    AdbcStatusCode status = StatementReaderInitFromSchema(reader, options->schema, error);
+    if (status == ADBC_STATUS_OK) {
+      if (binder) {
+        char finished = 0;
+        status = AdbcSqliteBinderBindNext(binder, db, stmt, &finished, error);
+        if (finished) reader->done = 1;
+      }
+    }
+    sqlite3_mutex_leave(sqlite3_db_mutex(db));
+    if (status != ADBC_STATUS_OK) {
+      // The binder still belongs to the caller
+      StatementReaderRelease(stream);
+    } else {
+      reader->binder = binder;
+    }
+    return status;
+  }
+
+  if (options->use_declared_types) {
+    char resolved = 0;
+    AdbcStatusCode status =
+        StatementReaderInitFromDeclaredTypes(reader, &resolved, error);
+    if (status == ADBC_STATUS_OK && resolved) {
+      // No rows are read up front; the first GetNext starts streaming
+      if (binder) {
+        char finished = 0;
+        status = AdbcSqliteBinderBindNext(binder, db, stmt, &finished, error);
+        if (finished) reader->done = 1;
+      }
+      reader->binder = binder;
+    }
+    if (status != ADBC_STATUS_OK || resolved) {
+      sqlite3_mutex_leave(sqlite3_db_mutex(db));
+      return status;
+    }
+  }
+
   const int num_columns = sqlite3_column_count(stmt);
   struct ArrowBitmap* validity = malloc(num_columns * sizeof(struct ArrowBitmap));
   struct ArrowBuffer* data = malloc(num_columns * sizeof(struct ArrowBuffer));
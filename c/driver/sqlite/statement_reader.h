@@ -27,12 +27,40 @@
 extern "C" {
 #endif
 
+/// \brief How date and timestamp parameters are stored in SQLite.
+///
+/// These follow the formats understood by SQLite's date and time functions.
+enum AdbcSqliteTemporalMode {
+  /// ISO 8601 text, e.g. 2023-01-01T12:00:00.000 (the default).
+  ADBC_SQLITE_TEMPORAL_ISO8601 = 0,
+  /// An integer number of seconds since the Unix epoch. Values with a
+  /// fractional second can't be stored this way and are an error.
+  ADBC_SQLITE_TEMPORAL_UNIXEPOCH,
+  /// A real: the (fractional) Julian day number.
+  ADBC_SQLITE_TEMPORAL_JULIANDAY,
+  /// An integer number of milliseconds since the Unix epoch.
+  ADBC_SQLITE_TEMPORAL_UNIXEPOCH_MS,
+  /// An integer number of microseconds since the Unix epoch.
+  ADBC_SQLITE_TEMPORAL_UNIXEPOCH_US,
+  /// An integer number of nanoseconds since the Unix epoch.
+  ADBC_SQLITE_TEMPORAL_UNIXEPOCH_NS,
+};
+
+/// \brief The time unit of a Unix epoch temporal mode, or -1 if the mode
+///   does not store integers.
+ADBC_EXPORT
+int AdbcSqliteTemporalModeUnit(enum AdbcSqliteTemporalMode mode);
+
 /// \brief Helper to manage binding data to a SQLite statement.
 struct ADBC_EXPORT AdbcSqliteBinder {
   // State
   struct ArrowSchema schema;
   struct ArrowArrayStream params;
   enum ArrowType* types;
+  enum ArrowTimeUnit* time_units;
+
+  // Options (reset along with the state)
+  enum AdbcSqliteTemporalMode temporal_mode;
 
   // Scratch space
   struct ArrowArray array;
@@ -53,6 +81,21 @@ ADBC_EXPORT
 AdbcStatusCode AdbcSqliteBinderBindNext(struct AdbcSqliteBinder* binder, sqlite3* conn,
                                         sqlite3_stmt* stmt, char* finished,
                                         struct AdbcError* error);
+/// \brief Get the number of rows left in the current parameter batch,
+///   fetching the next batch if the current one is exhausted.
+///
+/// Used with AdbcSqliteBinderBindRows to bind several rows per statement.
+/// Rows are never bound across batches.
+ADBC_EXPORT
+AdbcStatusCode AdbcSqliteBinderRowsAvailable(struct AdbcSqliteBinder* binder,
+                                             int64_t* available, char* finished,
+                                             struct AdbcError* error);
+/// \brief Bind the next num_rows rows of the current batch to a statement
+///   with num_rows * (number of columns) parameters, row-major.
+ADBC_EXPORT
+AdbcStatusCode AdbcSqliteBinderBindRows(struct AdbcSqliteBinder* binder, sqlite3* conn,
+                                        sqlite3_stmt* stmt, int64_t num_rows,
+                                        struct AdbcError* error);
 ADBC_EXPORT
 void AdbcSqliteBinderRelease(struct AdbcSqliteBinder* binder);
 
@@ -69,6 +112,39 @@ AdbcStatusCode AdbcSqliteExportReader(sqlite3* db, sqlite3_stmt* stmt,
                                       struct ArrowArrayStream* stream,
                                       struct AdbcError* error);
 
+/// \brief Options controlling how a result set is read.
+struct ADBC_EXPORT AdbcSqliteReaderOptions {
+  /// How many rows to read per batch (and to infer the Arrow schema).
+  size_t batch_size;
+  /// If nonzero, derive the Arrow schema from the declared types of the
+  /// result columns (following SQLite's type affinity rules) instead of
+  /// inferring it from the first batch. This is only possible if every
+  /// column is a table column with INTEGER, TEXT, BLOB, or REAL affinity;
+  /// otherwise the schema is inferred as usual.
+  char use_declared_types;
+  /// If nonzero, read string columns as dictionary<int32, utf8> when the
+  /// first batch has at most this many distinct values in the column.
+  /// Each batch carries its own dictionary of at most this many values;
+  /// a batch ends early rather than exceed it. Ignored when the schema is
+  /// taken from declared types.
+  size_t dictionary_threshold;
+  /// If non-NULL, read the result with this schema instead of inferring
+  /// it or taking it from declared types (e.g., so that every partition of
+  /// a result set has the same schema). Columns may be int64, double,
+  /// string, binary, date32, timestamp (without a time zone), or
+  /// dictionary<int32, string>. Values are converted as for an inferred
+  /// schema, and values that can't be converted are an error.
+  const struct ArrowSchema* schema;
+};
+
+/// \brief Initialize an ArrowArrayStream from a sqlite3_stmt.
+/// \see AdbcSqliteExportReader
+ADBC_EXPORT
+AdbcStatusCode AdbcSqliteExportReaderWithOptions(
+    sqlite3* db, sqlite3_stmt* stmt, struct AdbcSqliteBinder* binder,
+    const struct AdbcSqliteReaderOptions* options, struct ArrowArrayStream* stream,
+    struct AdbcError* error);
+
 #ifdef __cplusplus
 }
 #endif
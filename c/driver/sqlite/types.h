@@ -29,19 +29,70 @@ struct SqliteDatabase {
   sqlite3* db;
   char* uri;
   size_t connection_count;
+
+  // -- Options applied to every connection ----------------
+  char* journal_mode;
+  char has_cache_size;
+  int64_t cache_size;
+  char has_mmap_size;
+  int64_t mmap_size;
+
+  // -- Pool of read-only connections ----------------------
+  // Used only to read partitions; see SqliteDatabaseAcquireReader.
+  sqlite3_mutex* pool_mutex;
+  int pool_size;
+  sqlite3** idle_readers;
+  int num_idle_readers;
+  int num_active_readers;
+};
+
+// A prepared statement kept for reuse, keyed by its SQL text
+struct SqliteStatementCacheEntry {
+  uint64_t hash;
+  uint64_t last_used;
+  // The schema version the statement was prepared against
+  int64_t schema_version;
+  sqlite3_stmt* stmt;
+};
+
+// A per-connection LRU cache of prepared statements (see
+// SqliteStatementCacheAcquire)
+struct SqliteStatementCache {
+  struct SqliteStatementCacheEntry* entries;
+  int size;
+  int capacity;
+  uint64_t clock;
+  // Statements handed out by SqliteStatementCacheAcquire
+  struct SqliteStatementCacheEntry* checked_out;
+  int num_checked_out;
+  int checked_out_capacity;
+  // PRAGMA schema_version, to detect stale statements
+  sqlite3_stmt* version_stmt;
+  int64_t hits;
+  int64_t misses;
 };
 
 struct SqliteConnection {
   sqlite3* conn;
+  struct SqliteDatabase* database;
   char active_transaction;
   char load_extension;
 
   // Temporarily store an extension to load (need both entrypoint and path)
   char* extension_path;
+
+  struct SqliteStatementCache statement_cache;
+  // The number of tables per batch of AdbcConnectionGetObjects
+  int get_objects_batch_tables;
+  // GetObjects streams that are still open; they read through this
+  // connection, so it can't be released until they are
+  int num_get_objects_streams;
 };
 
 struct SqliteStatement {
   sqlite3* conn;
+  // The cache of the owning connection
+  struct SqliteStatementCache* statement_cache;
 
   // -- Query state -----------------------------------------
 
@@ -58,7 +109,15 @@ struct SqliteStatement {
   char* target_table;
   char append;
   char temporary;
+  char bulk_ingest;
 
   // -- Query options ---------------------------------------
   int batch_size;
+  int partition_count;
+  char use_declared_types;
+  int dictionary_threshold;
+  enum AdbcSqliteTemporalMode temporal_mode;
+  // Whether temporal_mode was set explicitly; only then does bulk
+  // ingestion declare date/timestamp columns with temporal types
+  char temporal_mode_set;
 };
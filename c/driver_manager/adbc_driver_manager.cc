@@ -20,12 +20,26 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #if defined(_WIN32)
 #include <windows.h>  // Must come first
@@ -34,6 +48,8 @@
 #include <strsafe.h>
 #else
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif  // defined(_WIN32)
 
 namespace {
@@ -115,6 +131,17 @@ struct ManagedLibrary {
     // release() from the DLL - how to handle this?
   }
 
+  /// Actually unload the DLL (see AdbcDriverManagerUnloadDrivers).
+  void Unload() {
+    if (!handle) return;
+#if defined(_WIN32)
+    FreeLibrary(handle);
+#else
+    dlclose(handle);
+#endif  // defined(_WIN32)
+    handle = nullptr;
+  }
+
   AdbcStatusCode Load(const char* library, struct AdbcError* error) {
     std::string error_message;
 #if defined(_WIN32)
@@ -213,6 +240,26 @@ struct ManagedLibrary {
     return ADBC_STATUS_OK;
   }
 
+  /// The resolved path of the loaded DLL, given a symbol from it (or
+  /// fallback if it can't be determined).
+  std::string Path(void* symbol, const char* fallback) const {
+#if defined(_WIN32)
+    char buffer[MAX_PATH];
+    DWORD length = GetModuleFileNameA(handle, buffer, MAX_PATH);
+    if (length == 0 || length == MAX_PATH) return fallback;
+    return std::string(buffer, length);
+#else
+    Dl_info info;
+    if (dladdr(symbol, &info) == 0 || !info.dli_fname) return fallback;
+    // Resolve relative paths and symlinks
+    char* resolved = realpath(info.dli_fname, nullptr);
+    if (!resolved) return info.dli_fname;
+    std::string path = resolved;
+    free(resolved);
+    return path;
+#endif  // defined(_WIN32)
+  }
+
 #if defined(_WIN32)
   // The loaded DLL
   HMODULE handle;
@@ -221,15 +268,148 @@ struct ManagedLibrary {
 #endif  // defined(_WIN32)
 };
 
+/// A driver DLL loaded by AdbcLoadDriver, shared by every AdbcDriver
+/// loaded from it.
+struct CachedDriver {
+  ManagedLibrary handle;
+  AdbcDriverInitFunc init_func = nullptr;
+
+  // The function table filled in by init_func.  Only kept for drivers
+  // that don't store state in the table (private_data), so that it can
+  // be copied instead of initializing the driver again.
+  bool has_driver = false;
+  struct AdbcDriver driver = {};
+
+  // The number of AdbcDriver instances loaded from this entry
+  int64_t refcount = 0;
+};
+
+/// Process-wide cache of driver DLLs, keyed by the resolved path of the
+/// DLL, the entrypoint found in it, and the ADBC version, so that a DLL
+/// named in different ways (e.g. "adbc_driver_sqlite" and an absolute
+/// path) is loaded once.  The driver names passed to AdbcLoadDriver are
+/// remembered as aliases of the entries they resolved to.
+///
+/// Entries stay loaded after their last AdbcDriver is released, so that
+/// repeatedly creating databases for the same driver doesn't go through
+/// the dynamic loader (and symbol resolution) each time.
+class DriverCache {
+ public:
+  static DriverCache& Get() {
+    // Leaked so that drivers may be released during static destruction
+    static DriverCache* cache = new DriverCache();
+    return *cache;
+  }
+
+  /// Find or load the DLL for a driver and take a reference to it.
+  ///
+  /// If the function table is cached, it is copied into driver and
+  /// initialized is set.
+  AdbcStatusCode Acquire(const char* driver_name, const char* entrypoint, int version,
+                         struct AdbcDriver* driver, CachedDriver** out,
+                         bool* initialized, struct AdbcError* error);
+
+  /// Cache the function table of a driver just initialized from entry,
+  /// if it can be reused.
+  void Store(CachedDriver* entry, int version, const struct AdbcDriver* driver);
+
+  /// Drop a reference taken by Acquire.
+  void Unref(CachedDriver* entry);
+
+  /// Unload all DLLs that are not in use.  Returns the number of DLLs
+  /// still in use.
+  size_t Unload();
+
+  /// The number of DLLs loaded.
+  size_t Size();
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<CachedDriver>> entries_;
+  // Keyed by the driver name, entrypoint, and version as passed
+  std::unordered_map<std::string, CachedDriver*> aliases_;
+};
+
+/// The number of bytes of the AdbcDriver that a given version fills in.
+size_t DriverSize(int version) {
+  return version == ADBC_VERSION_1_0_0 ? ADBC_DRIVER_1_0_0_SIZE : ADBC_DRIVER_1_1_0_SIZE;
+}
+
+class MemoryAccount;
+class Tracer;
+
+/// Options of a statement that the driver manager implements itself.
+struct ManagerStatementOptions {
+  // The number of batches to read ahead of the consumer (0 to disable)
+  int64_t readahead_batches = 0;
+  // The number of bytes to read ahead of the consumer (0 for no limit)
+  int64_t readahead_bytes = 0;
+  // The number of rows and/or bytes to reassemble batches into (0 to
+  // disable each)
+  int64_t rebatch_rows = 0;
+  int64_t rebatch_bytes = 0;
+
+  // If caching results, whether the statement opted in, its connection,
+  // the query of the statement (if read-only), and its bound parameters
+  // (see ResultCacheKey)
+  bool cache_enabled = false;
+  const struct AdbcConnection* connection = nullptr;
+  std::string cache_query;
+  std::string cache_parameters;
+  // Whether the bound parameters are unknown (so results can't be cached)
+  bool cache_parameters_unknown = false;
+
+  // If accounting for memory, the limit of the statement (0 for none),
+  // and the account of its result streams (or for connections, that of
+  // the connection)
+  int64_t memory_limit = 0;
+  std::shared_ptr<MemoryAccount> memory;
+};
+
+/// The state of a connection that its result sets depend on, as last set
+/// through the driver manager (see ResultCacheKey).
+struct ManagerConnectionOptions {
+  bool autocommit = true;
+  std::string current_catalog;
+  std::string current_db_schema;
+};
+
 /// Hold the driver DLL and the driver release callback in the driver struct.
 struct ManagerDriverState {
   // The original release callback
   AdbcStatusCode (*driver_release)(struct AdbcDriver* driver, struct AdbcError* error);
 
-  ManagedLibrary handle;
+  // The cache entry of the driver DLL (if loaded by AdbcLoadDriver)
+  CachedDriver* entry = nullptr;
+
+  // If tracing is enabled for the database, where to record calls
+  Tracer* tracer = nullptr;
+
+  // Whether to collect AdbcDriverManagerStreamMetrics for result streams
+  bool stream_metrics = false;
+
+  // If caching results (see ResultCache), how long they stay valid,
+  // what identifies the database in their keys, and the state of its
+  // connections (guarded by connection_mutex)
+  int64_t result_cache_ttl_ns = 0;
+  std::string result_cache_database;
+  std::unordered_map<const struct AdbcConnection*, ManagerConnectionOptions>
+      connection_options;
+
+  // If accounting for memory, the account of the database, and those of
+  // its connections
+  std::shared_ptr<MemoryAccount> memory;
+  std::mutex connection_mutex;
+  std::unordered_map<const struct AdbcConnection*, std::shared_ptr<MemoryAccount>>
+      connection_memory;
+
+  // The ManagerStatementOptions of statements that set any
+  std::mutex statement_mutex;
+  std::unordered_map<const struct AdbcStatement*, ManagerStatementOptions>
+      statement_options;
 };
 
-/// Unload the driver DLL.
+/// Release the driver and its reference to the driver DLL.
 static AdbcStatusCode ReleaseDriver(struct AdbcDriver* driver, struct AdbcError* error) {
   AdbcStatusCode status = ADBC_STATUS_OK;
 
@@ -240,327 +420,3171 @@ static AdbcStatusCode ReleaseDriver(struct AdbcDriver* driver, struct AdbcError*
   if (state->driver_release) {
     status = state->driver_release(driver, error);
   }
-  state->handle.Release();
+  if (state->entry) DriverCache::Get().Unref(state->entry);
 
   driver->private_manager = nullptr;
   delete state;
   return status;
 }
 
-// ArrowArrayStream wrapper to support AdbcErrorFromArrayStream
+/// Attach a ManagerDriverState to a driver, if it doesn't have one yet.
+ManagerDriverState* InitManagerState(struct AdbcDriver* driver) {
+  if (!driver->private_manager) {
+    ManagerDriverState* state = new ManagerDriverState;
+    state->driver_release = driver->release;
+    driver->release = &ReleaseDriver;
+    driver->private_manager = state;
+  }
+  return reinterpret_cast<ManagerDriverState*>(driver->private_manager);
+}
 
-struct ErrorArrayStream {
-  struct ArrowArrayStream stream;
-  struct AdbcDriver* private_driver;
-};
+// Tracing
+
+/// The width in bytes of the values of a fixed-width type (other than
+/// boolean), or -1 if the format string isn't one.
+int64_t FixedWidthBytes(const char* format) {
+  switch (format[0]) {
+    case 'c':
+    case 'C':
+      return 1;
+    case 'e':
+    case 's':
+    case 'S':
+      return 2;
+    case 'i':
+    case 'I':
+    case 'f':
+      return 4;
+    case 'l':
+    case 'L':
+    case 'g':
+      return 8;
+    case 'd':
+      // decimal128 unless the bit width is given as 256
+      return std::strstr(format, ",256") ? 32 : 16;
+    case 'w':
+      if (format[1] == ':') return std::strtoll(format + 2, nullptr, 10);
+      return -1;
+    case 't':
+      if (format[1] == 'd' && format[2] == 'D') {
+        return 4;
+      } else if (format[1] == 't' && (format[2] == 's' || format[2] == 'm')) {
+        return 4;
+      } else if (format[1] == 'i') {
+        return format[2] == 'M' ? 4 : format[2] == 'D' ? 8 : 16;
+      }
+      return 8;
+    default:
+      return -1;
+  }
+}
 
-void ErrorArrayStreamRelease(struct ArrowArrayStream* stream) {
-  if (stream->release != ErrorArrayStreamRelease || !stream->private_data) return;
+/// The size in bytes of the buffers of an array (and its children),
+/// counting only the slice of each buffer that the array covers, where
+/// that can be determined from the format string.
+int64_t ArrowArrayBufferSize(const struct ArrowSchema* schema,
+                             const struct ArrowArray* array) {
+  if (!schema || !schema->format || !array || !array->buffers) return 0;
+  const char* format = schema->format;
+  const int64_t length = array->length;
+  const int64_t offset = array->offset;
+  int64_t size = 0;
+
+  // Validity bitmap
+  if (array->n_buffers > 0 && array->buffers[0]) size += (length + 7) / 8;
+
+  auto fixed_width = [&](int64_t bytes) {
+    if (array->n_buffers > 1 && array->buffers[1]) size += bytes * length;
+  };
+  auto offsets_and_data = [&](bool large, bool has_data) {
+    if (array->n_buffers < 2 || !array->buffers[1] || length == 0) return;
+    int64_t begin = 0, end = 0;
+    if (large) {
+      const auto* offsets = reinterpret_cast<const int64_t*>(array->buffers[1]);
+      begin = offsets[offset];
+      end = offsets[offset + length];
+      size += (length + 1) * 8;
+    } else {
+      const auto* offsets = reinterpret_cast<const int32_t*>(array->buffers[1]);
+      begin = offsets[offset];
+      end = offsets[offset + length];
+      size += (length + 1) * 4;
+    }
+    if (has_data) size += end - begin;
+  };
 
-  auto* private_data = reinterpret_cast<struct ErrorArrayStream*>(stream->private_data);
-  private_data->stream.release(&private_data->stream);
-  delete private_data;
-  std::memset(stream, 0, sizeof(*stream));
-}
+  switch (format[0]) {
+    case 'b':
+      fixed_width(0);
+      if (array->n_buffers > 1 && array->buffers[1]) size += (length + 7) / 8;
+      break;
+    case 'u':
+    case 'z':
+      offsets_and_data(/*large=*/false, /*has_data=*/true);
+      break;
+    case 'U':
+    case 'Z':
+      offsets_and_data(/*large=*/true, /*has_data=*/true);
+      break;
+    case 'v':
+      // String/binary views: variadic buffer sizes are not known here
+      fixed_width(16);
+      break;
+    case '+':
+      switch (format[1]) {
+        case 'l':
+        case 'm':
+          offsets_and_data(/*large=*/false, /*has_data=*/false);
+          break;
+        case 'L':
+          offsets_and_data(/*large=*/true, /*has_data=*/false);
+          break;
+        case 'u':
+          // Type ids, and for dense unions, offsets
+          size += length * (format[2] == 'd' ? 5 : 1);
+          break;
+        default:
+          break;
+      }
+      for (int64_t i = 0; i < schema->n_children && i < array->n_children; i++) {
+        size += ArrowArrayBufferSize(schema->children[i], array->children[i]);
+      }
+      break;
+    default:
+      fixed_width(std::max<int64_t>(0, FixedWidthBytes(format)));
+      break;
+  }
 
-const char* ErrorArrayStreamGetLastError(struct ArrowArrayStream* stream) {
-  if (stream->release != ErrorArrayStreamRelease || !stream->private_data) return nullptr;
-  auto* private_data = reinterpret_cast<struct ErrorArrayStream*>(stream->private_data);
-  return private_data->stream.get_last_error(&private_data->stream);
+  if (schema->dictionary && array->dictionary) {
+    size += ArrowArrayBufferSize(schema->dictionary, array->dictionary);
+  }
+  return size;
 }
 
-int ErrorArrayStreamGetNext(struct ArrowArrayStream* stream, struct ArrowArray* array) {
-  if (stream->release != ErrorArrayStreamRelease || !stream->private_data) return EINVAL;
-  auto* private_data = reinterpret_cast<struct ErrorArrayStream*>(stream->private_data);
-  return private_data->stream.get_next(&private_data->stream, array);
+/// The number of non-null buffers of an array (and its children).
+int64_t ArrowArrayBufferCount(const struct ArrowArray* array) {
+  if (!array) return 0;
+  int64_t count = 0;
+  for (int64_t i = 0; array->buffers && i < array->n_buffers; i++) {
+    if (array->buffers[i]) count++;
+  }
+  for (int64_t i = 0; array->children && i < array->n_children; i++) {
+    count += ArrowArrayBufferCount(array->children[i]);
+  }
+  return count + ArrowArrayBufferCount(array->dictionary);
 }
 
-int ErrorArrayStreamGetSchema(struct ArrowArrayStream* stream,
-                              struct ArrowSchema* schema) {
-  if (stream->release != ErrorArrayStreamRelease || !stream->private_data) return EINVAL;
-  auto* private_data = reinterpret_cast<struct ErrorArrayStream*>(stream->private_data);
-  return private_data->stream.get_schema(&private_data->stream, schema);
+/// A monotonic timestamp in nanoseconds.
+int64_t MonotonicNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
 }
 
-// Default stubs
+/// Records calls into the driver and batches read from result sets, and
+/// writes them to a file in the Chrome trace event format (JSON array
+/// format), which can be loaded into chrome://tracing or Perfetto.
+///
+/// There is one tracer per output file, shared by all databases tracing
+/// to that file, and it lives for the rest of the process.  Events are
+/// buffered and appended to the file as the buffer fills up and when a
+/// database is released (the trace is never closed with a ']', which the
+/// format allows).  Summaries of the latency of each function are also
+/// written when a database is released (at most once a second) and at
+/// exit.
+class Tracer {
+ public:
+  /// Get the tracer for a file, creating (and truncating) the file if
+  /// this is the first use of it in this process.
+  static AdbcStatusCode Open(const std::string& path, Tracer** out,
+                             struct AdbcError* error) {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.tracers.find(path);
+    if (it == registry.tracers.end()) {
+      std::FILE* file = std::fopen(path.c_str(), "w");
+      if (!file) {
+        SetError(error, "[DriverManager] Could not open trace file '" + path +
+                            "': " + std::strerror(errno));
+        return ADBC_STATUS_INVALID_ARGUMENT;
+      }
+      std::fputs("[\n", file);
+      if (registry.tracers.empty()) std::atexit(FlushAll);
+      it = registry.tracers.emplace(path, std::unique_ptr<Tracer>(new Tracer(file)))
+               .first;
+    }
+    *out = it->second.get();
+    return ADBC_STATUS_OK;
+  }
 
-int ErrorGetDetailCount(const struct AdbcError* error) { return 0; }
+  /// Nanoseconds since the tracer was created.
+  int64_t Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - epoch_)
+        .count();
+  }
 
-struct AdbcErrorDetail ErrorGetDetail(const struct AdbcError* error, int index) {
-  return {nullptr, nullptr, 0};
-}
+  /// Record a call to an ADBC function.
+  void RecordCall(const char* name, int64_t start, AdbcStatusCode status) {
+    Event event;
+    event.name = name;
+    event.start = start;
+    event.duration = Now() - start;
+    event.status = status;
 
-const struct AdbcError* ErrorFromArrayStream(struct ArrowArrayStream* stream,
-                                             AdbcStatusCode* status) {
-  return nullptr;
-}
+    std::lock_guard<std::mutex> lock(mutex_);
+    RecordLocked(event, &calls_[name]);
+  }
 
-void ErrorArrayStreamInit(struct ArrowArrayStream* out,
-                          struct AdbcDriver* private_driver) {
-  if (!out || !out->release ||
-      // Don't bother wrapping if driver didn't claim support
-      private_driver->ErrorFromArrayStream == ErrorFromArrayStream) {
-    return;
+  /// Record a call to get_next on a result set from the given function.
+  /// time_to_first_batch is the time since that function was called,
+  /// if this is the first batch, or else -1.
+  void RecordBatch(const char* source, int64_t start, int64_t index, int64_t rows,
+                   int64_t bytes, int64_t time_to_first_batch) {
+    Event event;
+    event.name = "ArrowArrayStream.get_next";
+    event.source = source;
+    event.start = start;
+    event.duration = Now() - start;
+    event.batch = index;
+    event.rows = rows;
+    event.bytes = bytes;
+    event.time_to_first_batch = time_to_first_batch;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (time_to_first_batch >= 0) {
+      first_batches_[source].Add(time_to_first_batch);
+    }
+    RecordLocked(event, &batches_[source]);
   }
-  struct ErrorArrayStream* private_data = new ErrorArrayStream;
-  private_data->stream = *out;
-  private_data->private_driver = private_driver;
-  out->get_last_error = ErrorArrayStreamGetLastError;
-  out->get_next = ErrorArrayStreamGetNext;
-  out->get_schema = ErrorArrayStreamGetSchema;
-  out->release = ErrorArrayStreamRelease;
-  out->private_data = private_data;
-}
 
-AdbcStatusCode DatabaseGetOption(struct AdbcDatabase* database, const char* key,
-                                 char* value, size_t* length, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
-}
+  /// Write out buffered events, and a summary of latencies so far
+  /// (unless one was written recently and force is not set).
+  void Flush(bool force = false) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    WriteEvents();
+    const int64_t now = Now();
+    if (!force && last_summary_ >= 0 && now - last_summary_ < kSummaryInterval) {
+      std::fflush(file_);
+      return;
+    }
+    last_summary_ = now;
+    auto write_stats = [&](const char* kind,
+                           const std::unordered_map<std::string, Stats>& stats) {
+      for (const auto& it : stats) {
+        std::string line = "{\"name\":\"";
+        line += kind;
+        line += "\",\"cat\":\"adbc.stats\",\"ph\":\"i\",\"s\":\"p\",\"ts\":";
+        AppendMicros(&line, now);
+        line += ",\"pid\":" + std::to_string(pid_);
+        line += ",\"tid\":0,\"args\":{\"function\":\"";
+        line += it.first;
+        line += "\",";
+        it.second.AppendJson(&line);
+        line += "}},\n";
+        std::fputs(line.c_str(), file_);
+      }
+    };
+    write_stats("latency", calls_);
+    write_stats("get_next latency", batches_);
+    write_stats("time to first batch", first_batches_);
+    std::fflush(file_);
+  }
 
-AdbcStatusCode DatabaseGetOptionBytes(struct AdbcDatabase* database, const char* key,
-                                      uint8_t* value, size_t* length,
-                                      struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
-}
+ private:
+  /// A histogram of durations, in buckets of powers of two nanoseconds.
+  struct Stats {
+    static constexpr int kNumBuckets = 40;
+
+    int64_t count = 0;
+    int64_t total = 0;
+    int64_t min = 0;
+    int64_t max = 0;
+    int64_t buckets[kNumBuckets] = {};
+
+    void Add(int64_t duration) {
+      if (count == 0 || duration < min) min = duration;
+      if (duration > max) max = duration;
+      count++;
+      total += duration;
+      int bucket = 0;
+      while (bucket < kNumBuckets - 1 && (int64_t(1) << (bucket + 1)) <= duration) {
+        bucket++;
+      }
+      buckets[bucket]++;
+    }
 
-AdbcStatusCode DatabaseGetOptionInt(struct AdbcDatabase* database, const char* key,
-                                    int64_t* value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
-}
+    void AppendJson(std::string* out) const {
+      *out += "\"count\":" + std::to_string(count) + ",\"total_us\":";
+      AppendMicros(out, total);
+      *out += ",\"min_us\":";
+      AppendMicros(out, min);
+      *out += ",\"max_us\":";
+      AppendMicros(out, max);
+      // Keyed by the upper bound of each bucket
+      *out += ",\"histogram_us\":{";
+      bool first = true;
+      for (int i = 0; i < kNumBuckets; i++) {
+        if (buckets[i] == 0) continue;
+        if (!first) *out += ',';
+        first = false;
+        *out += "\"<";
+        AppendMicros(out, int64_t(1) << (i + 1));
+        *out += "\":" + std::to_string(buckets[i]);
+      }
+      *out += '}';
+    }
+  };
 
-AdbcStatusCode DatabaseGetOptionDouble(struct AdbcDatabase* database, const char* key,
-                                       double* value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
-}
+  struct Event {
+    const char* name = nullptr;
+    // For batches, the function that returned the result set
+    const char* source = nullptr;
+    int64_t start = 0;
+    int64_t duration = 0;
+    uint64_t thread = 0;
+    AdbcStatusCode status = ADBC_STATUS_OK;
+    int64_t batch = -1;
+    int64_t rows = 0;
+    int64_t bytes = 0;
+    int64_t time_to_first_batch = -1;
+  };
 
-AdbcStatusCode DatabaseSetOption(struct AdbcDatabase* database, const char* key,
-                                 const char* value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  // Flush after this many buffered events
+  static constexpr size_t kMaxBufferedEvents = 8192;
+  // The minimum time between summaries (in nanoseconds)
+  static constexpr int64_t kSummaryInterval = 1000000000;
 
-AdbcStatusCode DatabaseSetOptionBytes(struct AdbcDatabase* database, const char* key,
-                                      const uint8_t* value, size_t length,
-                                      struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  struct Registry {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::unique_ptr<Tracer>> tracers;
+  };
 
-AdbcStatusCode DatabaseSetOptionInt(struct AdbcDatabase* database, const char* key,
-                                    int64_t value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  static Registry& GetRegistry() {
+    // Leaked, as tracers are flushed at exit
+    static Registry* registry = new Registry();
+    return *registry;
+  }
 
-AdbcStatusCode DatabaseSetOptionDouble(struct AdbcDatabase* database, const char* key,
-                                       double value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  static void FlushAll() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& it : registry.tracers) it.second->Flush(/*force=*/true);
+  }
 
-AdbcStatusCode ConnectionCancel(struct AdbcConnection* connection,
-                                struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  explicit Tracer(std::FILE* file)
+      : file_(file), epoch_(std::chrono::steady_clock::now()) {
+#if defined(_WIN32)
+    pid_ = static_cast<int64_t>(GetCurrentProcessId());
+#else
+    pid_ = static_cast<int64_t>(getpid());
+#endif  // defined(_WIN32)
+  }
 
-AdbcStatusCode ConnectionCommit(struct AdbcConnection*, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  /// A small, stable ID for the calling thread.
+  static uint64_t ThreadId() {
+    static std::atomic<uint64_t> next_id(1);
+    thread_local uint64_t id = next_id++;
+    return id;
+  }
 
-AdbcStatusCode ConnectionGetInfo(struct AdbcConnection* connection,
-                                 const uint32_t* info_codes, size_t info_codes_length,
-                                 struct ArrowArrayStream* out, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  static void AppendMicros(std::string* out, int64_t nanos) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(nanos) / 1000.0);
+    *out += buffer;
+  }
 
-AdbcStatusCode ConnectionGetObjects(struct AdbcConnection*, int, const char*, const char*,
-                                    const char*, const char**, const char*,
-                                    struct ArrowArrayStream*, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  void RecordLocked(Event event, Stats* stats) {
+    event.thread = ThreadId();
+    stats->Add(event.duration);
+    events_.push_back(event);
+    if (events_.size() >= kMaxBufferedEvents) {
+      WriteEvents();
+      std::fflush(file_);
+    }
+  }
 
-AdbcStatusCode ConnectionGetOption(struct AdbcConnection* connection, const char* key,
-                                   char* value, size_t* length, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
-}
+  void WriteEvents() {
+    std::string line;
+    for (const Event& event : events_) {
+      line = "{\"name\":\"";
+      line += event.name;
+      line += "\",\"cat\":\"adbc\",\"ph\":\"X\",\"ts\":";
+      AppendMicros(&line, event.start);
+      line += ",\"dur\":";
+      AppendMicros(&line, event.duration);
+      line += ",\"pid\":" + std::to_string(pid_);
+      line += ",\"tid\":" + std::to_string(event.thread);
+      line += ",\"args\":{";
+      if (event.source) {
+        line += "\"source\":\"";
+        line += event.source;
+        line += "\",\"batch\":" + std::to_string(event.batch);
+        line += ",\"rows\":" + std::to_string(event.rows);
+        line += ",\"bytes\":" + std::to_string(event.bytes);
+        if (event.time_to_first_batch >= 0) {
+          line += ",\"time_to_first_batch_us\":";
+          AppendMicros(&line, event.time_to_first_batch);
+        }
+      } else {
+        line += "\"status\":\"";
+        line += AdbcStatusCodeMessage(event.status);
+        line += '"';
+      }
+      line += "}},\n";
+      std::fputs(line.c_str(), file_);
+    }
+    events_.clear();
+  }
 
-AdbcStatusCode ConnectionGetOptionBytes(struct AdbcConnection* connection,
-                                        const char* key, uint8_t* value, size_t* length,
-                                        struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
-}
+  std::mutex mutex_;
+  std::FILE* file_;
+  int64_t pid_;
+  int64_t last_summary_ = -1;
+  const std::chrono::steady_clock::time_point epoch_;
+  std::vector<Event> events_;
+  std::unordered_map<std::string, Stats> calls_;
+  std::unordered_map<std::string, Stats> batches_;
+  std::unordered_map<std::string, Stats> first_batches_;
+};
 
-AdbcStatusCode ConnectionGetOptionInt(struct AdbcConnection* connection, const char* key,
-                                      int64_t* value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
+/// Get the tracer of a database, if tracing is enabled.
+Tracer* GetTracer(const struct AdbcDriver* driver) {
+  if (!driver || !driver->private_manager) return nullptr;
+  return reinterpret_cast<const ManagerDriverState*>(driver->private_manager)->tracer;
 }
 
-AdbcStatusCode ConnectionGetOptionDouble(struct AdbcConnection* connection,
-                                         const char* key, double* value,
-                                         struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
-}
+/// Times a call to an ADBC function, if tracing is enabled.
+class TraceSpan {
+ public:
+  TraceSpan(const struct AdbcDriver* driver, const char* name)
+      : tracer_(GetTracer(driver)), name_(name), start_(tracer_ ? tracer_->Now() : 0) {}
 
-AdbcStatusCode ConnectionGetStatistics(struct AdbcConnection*, const char*, const char*,
-                                       const char*, char, struct ArrowArrayStream*,
-                                       struct AdbcError*) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  /// Record the call (with the status it returns).
+  AdbcStatusCode Finish(AdbcStatusCode status) {
+    if (tracer_) tracer_->RecordCall(name_, start_, status);
+    return status;
+  }
 
-AdbcStatusCode ConnectionGetStatisticNames(struct AdbcConnection*,
-                                           struct ArrowArrayStream*, struct AdbcError*) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  Tracer* tracer() const { return tracer_; }
+  const char* name() const { return name_; }
+  int64_t start() const { return start_; }
 
-AdbcStatusCode ConnectionGetTableSchema(struct AdbcConnection*, const char*, const char*,
-                                        const char*, struct ArrowSchema*,
-                                        struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+ private:
+  Tracer* tracer_;
+  const char* name_;
+  int64_t start_;
+};
 
-AdbcStatusCode ConnectionGetTableTypes(struct AdbcConnection*, struct ArrowArrayStream*,
-                                       struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+/// Wait on a condition variable until the predicate holds.
+///
+/// This loops on wait_for instead of calling wait: with GCC 12 and newer,
+/// the latter needs a newer libstdc++ at run time (GLIBCXX_3.4.30) than
+/// some distributions (e.g. conda-forge) ship.
+template <typename Predicate>
+void WaitOn(std::condition_variable* cv, std::unique_lock<std::mutex>* lock,
+            Predicate predicate) {
+  while (!cv->wait_for(*lock, std::chrono::seconds(1), predicate)) {
+  }
 }
 
-AdbcStatusCode ConnectionReadPartition(struct AdbcConnection* connection,
-                                       const uint8_t* serialized_partition,
-                                       size_t serialized_length,
-                                       struct ArrowArrayStream* out,
-                                       struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+/// Reads batches from a stream on a background thread, ahead of the
+/// consumer, up to a number of batches and (optionally) bytes, so that
+/// the driver produces the next batch while the consumer processes the
+/// current one.  Reading stops at the end of the stream or the first
+/// error, so the stream's error state is that of the last batch read.
+class Readahead {
+ public:
+  Readahead(struct ArrowArrayStream* stream, int64_t max_batches, int64_t max_bytes)
+      : stream_(stream),
+        max_batches_(static_cast<size_t>(max_batches)),
+        max_bytes_(max_bytes),
+        thread_([this] { Run(); }) {}
+
+  ~Readahead() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    for (auto& batch : queue_) batch.array.release(&batch.array);
+  }
 
-AdbcStatusCode ConnectionRollback(struct AdbcConnection*, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  /// Get the next batch, waiting for the background thread if needed.
+  int GetNext(struct ArrowArray* out) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Wait(&lock, [this] { return !queue_.empty() || done_; });
+    if (queue_.empty()) {
+      if (status_ != 0) return status_;
+      std::memset(out, 0, sizeof(*out));
+      return 0;
+    }
+    *out = queue_.front().array;
+    queued_bytes_ -= queue_.front().bytes;
+    queue_.pop_front();
+    lock.unlock();
+    cv_.notify_all();
+    return 0;
+  }
 
-AdbcStatusCode ConnectionSetOption(struct AdbcConnection*, const char*, const char*,
-                                   struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  // The other methods of the stream can't be called concurrently with
+  // get_next
 
-AdbcStatusCode ConnectionSetOptionBytes(struct AdbcConnection*, const char*,
-                                        const uint8_t*, size_t, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  int GetSchema(struct ArrowSchema* out) {
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+    return stream_->get_schema(stream_, out);
+  }
 
-AdbcStatusCode ConnectionSetOptionInt(struct AdbcConnection* connection, const char* key,
-                                      int64_t value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  const char* GetLastError() {
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+    return stream_->get_last_error(stream_);
+  }
 
-AdbcStatusCode ConnectionSetOptionDouble(struct AdbcConnection* connection,
-                                         const char* key, double value,
-                                         struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  const struct AdbcError* GetError(struct AdbcDriver* driver, AdbcStatusCode* status) {
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+    return driver->ErrorFromArrayStream(stream_, status);
+  }
 
-AdbcStatusCode StatementBind(struct AdbcStatement*, struct ArrowArray*,
-                             struct ArrowSchema*, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+ private:
+  struct Batch {
+    struct ArrowArray array;
+    int64_t bytes;
+  };
 
-AdbcStatusCode StatementBindStream(struct AdbcStatement*, struct ArrowArrayStream*,
-                                   struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+  template <typename Predicate>
+  void Wait(std::unique_lock<std::mutex>* lock, Predicate predicate) {
+    WaitOn(&cv_, lock, predicate);
+  }
+
+  void Run() {
+    // To size batches
+    struct ArrowSchema schema = {};
+    if (GetSchema(&schema) != 0) std::memset(&schema, 0, sizeof(schema));
+
+    bool done = false;
+    while (!done) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        Wait(&lock, [this] {
+          return stop_ || (queue_.size() < max_batches_ &&
+                           (max_bytes_ <= 0 || queued_bytes_ < max_bytes_));
+        });
+        if (stop_) break;
+      }
+
+      struct ArrowArray array = {};
+      int status;
+      {
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        status = stream_->get_next(stream_, &array);
+      }
+      done = status != 0 || !array.release;
+      // Some drivers leave a partial batch behind on error
+      if (status != 0 && array.release) array.release(&array);
+      const int64_t bytes = done ? 0 : ArrowArrayBufferSize(&schema, &array);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (done) {
+          status_ = status;
+          done_ = true;
+        } else {
+          queue_.push_back({array, bytes});
+          queued_bytes_ += bytes;
+        }
+      }
+      cv_.notify_all();
+    }
+    if (schema.release) schema.release(&schema);
+  }
+
+  struct ArrowArrayStream* stream_;
+  const size_t max_batches_;
+  const int64_t max_bytes_;
+
+  // Guards calls into stream_
+  std::mutex stream_mutex_;
+
+  // Guards the rest of the state
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Batch> queue_;
+  int64_t queued_bytes_ = 0;
+  int status_ = 0;
+  bool done_ = false;
+  bool stop_ = false;
+
+  std::thread thread_;
+};
+
+// Rebatching
+
+/// Private data of the arrays made by Rebatcher.  Each array (and each of
+/// its children, which may be moved out of it) keeps the batches that it
+/// points into alive, and owns any buffers that were copied.
+struct RebatchedArray {
+  std::vector<std::shared_ptr<struct ArrowArray>> sources;
+  std::vector<std::vector<uint8_t>> owned_buffers;
+  std::vector<const void*> buffers;
+  std::vector<struct ArrowArray> children;
+  std::vector<struct ArrowArray*> child_pointers;
+  struct ArrowArray dictionary = {};
+};
+
+void RebatchedArrayRelease(struct ArrowArray* array) {
+  auto* private_data = reinterpret_cast<RebatchedArray*>(array->private_data);
+  for (auto& child : private_data->children) {
+    if (child.release) child.release(&child);
+  }
+  if (private_data->dictionary.release) {
+    private_data->dictionary.release(&private_data->dictionary);
+  }
+  delete private_data;
+  array->release = nullptr;
+}
+
+/// Initialize an array, leaving its buffers and children to be filled in.
+RebatchedArray* RebatchedArrayInit(struct ArrowArray* out, int64_t n_children) {
+  auto* private_data = new RebatchedArray;
+  private_data->children.resize(n_children);
+  for (auto& child : private_data->children) {
+    private_data->child_pointers.push_back(&child);
+  }
+  std::memset(out, 0, sizeof(*out));
+  out->n_children = n_children;
+  out->children = n_children > 0 ? private_data->child_pointers.data() : nullptr;
+  out->release = RebatchedArrayRelease;
+  out->private_data = private_data;
+  return private_data;
+}
+
+void SetBuffers(RebatchedArray* private_data, struct ArrowArray* out) {
+  out->n_buffers = static_cast<int64_t>(private_data->buffers.size());
+  out->buffers = private_data->buffers.data();
+}
+
+/// Move an array into shared ownership.
+std::shared_ptr<struct ArrowArray> ShareArray(struct ArrowArray* array) {
+  std::shared_ptr<struct ArrowArray> shared(new ArrowArray(*array),
+                                            [](struct ArrowArray* batch) {
+                                              if (batch->release) batch->release(batch);
+                                              delete batch;
+                                            });
+  array->release = nullptr;
+  return shared;
+}
+
+/// Make a view of [offset, offset + length) of an array (relative to its
+/// own offset) that source keeps alive, without copying.
+void SliceArray(const std::shared_ptr<struct ArrowArray>& source,
+                const struct ArrowSchema* schema, const struct ArrowArray* array,
+                int64_t offset, int64_t length, struct ArrowArray* out) {
+  RebatchedArray* private_data = RebatchedArrayInit(out, array->n_children);
+  private_data->sources.push_back(source);
+  private_data->buffers.assign(array->buffers, array->buffers + array->n_buffers);
+  SetBuffers(private_data, out);
+  out->length = length;
+  out->null_count = (offset == 0 && length == array->length) || array->null_count == 0
+                        ? array->null_count
+                        : -1;
+
+  // Push the slice down into the children of a struct without a validity
+  // bitmap, so that consumers that ignore the struct's offset (as many do
+  // for the top-level struct of a batch) see the slice
+  const bool push_down = std::strcmp(schema->format, "+s") == 0 &&
+                         (array->n_buffers == 0 || !array->buffers[0]);
+  out->offset = push_down ? 0 : array->offset + offset;
+  for (int64_t i = 0; i < array->n_children; i++) {
+    const struct ArrowArray* child = array->children[i];
+    if (push_down) {
+      SliceArray(source, schema->children[i], child, array->offset + offset, length,
+                 &private_data->children[i]);
+    } else {
+      SliceArray(source, schema->children[i], child, 0, child->length,
+                 &private_data->children[i]);
+    }
+  }
+  if (array->dictionary) {
+    SliceArray(source, schema->dictionary, array->dictionary, 0,
+               array->dictionary->length, &private_data->dictionary);
+    out->dictionary = &private_data->dictionary;
+  }
+}
+
+/// A range of rows of a batch read from the driver.
+struct RebatchPiece {
+  std::shared_ptr<struct ArrowArray> batch;
+  int64_t offset;
+  int64_t length;
+};
+
+bool GetBit(const void* bits, int64_t i) {
+  return (reinterpret_cast<const uint8_t*>(bits)[i >> 3] >> (i & 7)) & 1;
+}
+
+void SetBit(uint8_t* bits, int64_t i) {
+  bits[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+}
+
+/// Whether Rebatcher can concatenate columns of a type.
+bool CanConcatenate(const struct ArrowSchema* schema) {
+  if (schema->dictionary || schema->n_children > 0) return false;
+  switch (schema->format[0]) {
+    case 'n':
+    case 'b':
+    case 'u':
+    case 'z':
+    case 'U':
+    case 'Z':
+      return true;
+    default:
+      return FixedWidthBytes(schema->format) > 0;
+  }
+}
+
+/// Concatenate the offsets and data of a string/binary column of the
+/// pieces.  Returns false if the offsets would overflow.
+template <typename OffsetType>
+bool ConcatenateBinary(int64_t column, const std::vector<RebatchPiece>& pieces,
+                       int64_t length, std::vector<uint8_t>* offsets_buffer,
+                       std::vector<uint8_t>* data_buffer) {
+  offsets_buffer->resize((length + 1) * sizeof(OffsetType));
+  auto* offsets = reinterpret_cast<OffsetType*>(offsets_buffer->data());
+  offsets[0] = 0;
+  int64_t position = 0;
+  for (const auto& piece : pieces) {
+    const struct ArrowArray* array = piece.batch->children[column];
+    const int64_t start = piece.batch->offset + array->offset + piece.offset;
+    const auto* source = reinterpret_cast<const OffsetType*>(array->buffers[1]);
+    const OffsetType begin = source[start];
+    const OffsetType end = source[start + piece.length];
+    if (static_cast<int64_t>(offsets[position]) + (end - begin) >
+        static_cast<int64_t>(std::numeric_limits<OffsetType>::max())) {
+      return false;
+    }
+    for (int64_t i = 0; i < piece.length; i++) {
+      offsets[position + i + 1] = offsets[position] + (source[start + i + 1] - begin);
+    }
+    const auto* data = reinterpret_cast<const uint8_t*>(array->buffers[2]);
+    data_buffer->insert(data_buffer->end(), data + begin, data + end);
+    position += piece.length;
+  }
+  return true;
+}
+
+/// Concatenate a column of the pieces into out.  Returns false if it
+/// can't be done (see ConcatenateBinary).
+bool ConcatenateColumn(const struct ArrowSchema* schema, int64_t column,
+                       const std::vector<RebatchPiece>& pieces, int64_t length,
+                       struct ArrowArray* out) {
+  const char format = schema->format[0];
+  RebatchedArray* private_data = RebatchedArrayInit(out, 0);
+  out->length = length;
+  if (format == 'n') {
+    out->null_count = length;
+    return true;
+  }
+
+  const bool binary = format == 'u' || format == 'z' || format == 'U' || format == 'Z';
+  auto& buffers = private_data->owned_buffers;
+  buffers.resize(binary ? 3 : 2);
+  // Buffers may be empty, but not null
+  for (auto& buffer : buffers) buffer.reserve(1);
+
+  // Copy a bitmap (the validity bitmap, or the values of a boolean
+  // column), returning the number of unset bits (-1 if there is none)
+  auto concatenate_bits = [&](int buffer, std::vector<uint8_t>* out_bits) -> int64_t {
+    bool any = false;
+    for (const auto& piece : pieces) {
+      const struct ArrowArray* array = piece.batch->children[column];
+      any = any || (array->buffers[buffer] && (buffer > 0 || array->null_count != 0));
+    }
+    if (!any) return -1;
+    out_bits->assign((length + 7) / 8, 0);
+    int64_t unset = 0;
+    int64_t position = 0;
+    for (const auto& piece : pieces) {
+      const struct ArrowArray* array = piece.batch->children[column];
+      const int64_t start = piece.batch->offset + array->offset + piece.offset;
+      const void* bits = array->buffers[buffer];
+      for (int64_t i = 0; i < piece.length; i++) {
+        if (!bits || GetBit(bits, start + i)) {
+          SetBit(out_bits->data(), position + i);
+        } else {
+          unset++;
+        }
+      }
+      position += piece.length;
+    }
+    return unset;
+  };
+
+  const int64_t null_count = concatenate_bits(0, &buffers[0]);
+  out->null_count = std::max<int64_t>(0, null_count);
+  private_data->buffers.push_back(null_count > 0 ? buffers[0].data() : nullptr);
+
+  if (format == 'b') {
+    if (concatenate_bits(1, &buffers[1]) < 0) buffers[1].assign((length + 7) / 8, 0);
+  } else if (format == 'u' || format == 'z') {
+    if (!ConcatenateBinary<int32_t>(column, pieces, length, &buffers[1], &buffers[2])) {
+      return false;
+    }
+  } else if (binary) {
+    if (!ConcatenateBinary<int64_t>(column, pieces, length, &buffers[1], &buffers[2])) {
+      return false;
+    }
+  } else {
+    const int64_t width = FixedWidthBytes(schema->format);
+    buffers[1].resize(length * width);
+    int64_t position = 0;
+    for (const auto& piece : pieces) {
+      const struct ArrowArray* array = piece.batch->children[column];
+      const int64_t start = piece.batch->offset + array->offset + piece.offset;
+      std::memcpy(buffers[1].data() + position * width,
+                  reinterpret_cast<const uint8_t*>(array->buffers[1]) + start * width,
+                  piece.length * width);
+      position += piece.length;
+    }
+  }
+  for (size_t i = 1; i < buffers.size(); i++) {
+    private_data->buffers.push_back(buffers[i].data());
+  }
+  SetBuffers(private_data, out);
+  return true;
+}
+
+/// Copy the rows of the pieces (of batches of the given struct schema,
+/// whose columns must all be of flat types) into a new batch.  Returns
+/// false if it can't be done (see ConcatenateBinary).
+bool ConcatenatePieces(const struct ArrowSchema* schema,
+                       const std::vector<RebatchPiece>& pieces, int64_t length,
+                       struct ArrowArray* out) {
+  RebatchedArray* private_data = RebatchedArrayInit(out, schema->n_children);
+  private_data->buffers.push_back(nullptr);
+  SetBuffers(private_data, out);
+  out->length = length;
+  for (int64_t i = 0; i < schema->n_children; i++) {
+    if (!ConcatenateColumn(schema->children[i], i, pieces, length,
+                           &private_data->children[i])) {
+      out->release(out);
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Coalesces small batches of a stream and slices large ones, so that
+/// batches have (up to) a target number of rows, or of bytes (estimated
+/// from the average size of the rows read so far).  Slicing doesn't copy.
+/// Batches are only copied when one has to be assembled from several
+/// that are too small, and only if all columns are of flat types
+/// (otherwise, small batches are passed through as they are).
+class Rebatcher {
+ public:
+  Rebatcher(int64_t target_rows, int64_t target_bytes,
+            std::function<int(struct ArrowArray*)> get_next,
+            std::function<int(struct ArrowSchema*)> get_schema)
+      : target_rows_(target_rows),
+        target_bytes_(target_bytes),
+        get_next_(std::move(get_next)),
+        get_schema_(std::move(get_schema)) {}
+
+  ~Rebatcher() {
+    if (schema_.release) schema_.release(&schema_);
+  }
+
+  int GetNext(struct ArrowArray* out) {
+    if (!schema_.release) {
+      const int status = get_schema_(&schema_);
+      if (status != 0) return status;
+      can_concatenate_ = std::strcmp(schema_.format, "+s") == 0;
+      for (int64_t i = 0; i < schema_.n_children; i++) {
+        can_concatenate_ = can_concatenate_ && CanConcatenate(schema_.children[i]);
+      }
+    }
+
+    try {
+      // Read until there is enough for a batch, or the end (if an error
+      // occurs, the rows before it are returned first)
+      while (!done_ &&
+             (pending_.empty() || (can_concatenate_ && pending_rows_ < Target()))) {
+        struct ArrowArray array = {};
+        const int status = get_next_(&array);
+        if (status != 0 || !array.release) {
+          // Some drivers leave a partial batch behind on error
+          if (array.release) array.release(&array);
+          status_ = status;
+          done_ = true;
+          break;
+        }
+        if (array.length == 0) {
+          array.release(&array);
+          continue;
+        }
+        rows_read_ += array.length;
+        bytes_read_ += ArrowArrayBufferSize(&schema_, &array);
+        pending_rows_ += array.length;
+        pending_.push_back({ShareArray(&array), 0, array.length});
+      }
+      if (pending_.empty()) {
+        if (status_ != 0) return status_;
+        std::memset(out, 0, sizeof(*out));
+        return 0;
+      }
+
+      const int64_t length = std::min(Target(), pending_rows_);
+      if (pending_.front().length < length && can_concatenate_ &&
+          Concatenate(length, out)) {
+        Consume(length);
+      } else {
+        Consume(SliceFront(length, out));
+      }
+      return 0;
+    } catch (const std::bad_alloc&) {
+      return ENOMEM;
+    }
+  }
+
+ private:
+  int64_t Target() const {
+    int64_t target =
+        target_rows_ > 0 ? target_rows_ : std::numeric_limits<int64_t>::max();
+    if (target_bytes_ > 0 && rows_read_ > 0) {
+      const int64_t row_bytes = std::max<int64_t>(1, bytes_read_ / rows_read_);
+      target = std::min(target, std::max<int64_t>(1, target_bytes_ / row_bytes));
+    }
+    return target;
+  }
+
+  /// Return (up to) length rows of the first pending batch.
+  int64_t SliceFront(int64_t length, struct ArrowArray* out) {
+    RebatchPiece& front = pending_.front();
+    length = std::min(length, front.length);
+    if (front.offset == 0 && length == front.batch->length &&
+        front.batch.use_count() == 1) {
+      // Pass the batch through as it is
+      *out = *front.batch;
+      front.batch->release = nullptr;
+    } else {
+      SliceArray(front.batch, &schema_, front.batch.get(), front.offset, length, out);
+    }
+    return length;
+  }
+
+  /// Copy length rows of the pending batches into a new batch.
+  bool Concatenate(int64_t length, struct ArrowArray* out) {
+    std::vector<RebatchPiece> pieces;
+    for (int64_t remaining = length; remaining > 0;) {
+      const RebatchPiece& piece = pending_[pieces.size()];
+      pieces.push_back({piece.batch, piece.offset, std::min(remaining, piece.length)});
+      remaining -= pieces.back().length;
+    }
+    return ConcatenatePieces(&schema_, pieces, length, out);
+  }
+
+  /// Drop the first length pending rows.
+  void Consume(int64_t length) {
+    pending_rows_ -= length;
+    while (length > 0) {
+      RebatchPiece& front = pending_.front();
+      const int64_t consumed = std::min(length, front.length);
+      front.offset += consumed;
+      front.length -= consumed;
+      length -= consumed;
+      if (front.length == 0) pending_.pop_front();
+    }
+  }
+
+  const int64_t target_rows_;
+  const int64_t target_bytes_;
+  std::function<int(struct ArrowArray*)> get_next_;
+  std::function<int(struct ArrowSchema*)> get_schema_;
+
+  struct ArrowSchema schema_ = {};
+  bool can_concatenate_ = false;
+  std::deque<RebatchPiece> pending_;
+  int64_t pending_rows_ = 0;
+  int64_t rows_read_ = 0;
+  int64_t bytes_read_ = 0;
+  int status_ = 0;
+  bool done_ = false;
+};
+
+// Result cache
+
+/// Private data of a schema copied by SchemaDeepCopy.
+struct CopiedSchema {
+  std::string format;
+  std::string name;
+  std::string metadata;
+  std::vector<struct ArrowSchema> children;
+  std::vector<struct ArrowSchema*> child_pointers;
+  struct ArrowSchema dictionary = {};
+};
+
+void CopiedSchemaRelease(struct ArrowSchema* schema) {
+  auto* private_data = reinterpret_cast<CopiedSchema*>(schema->private_data);
+  for (auto& child : private_data->children) {
+    if (child.release) child.release(&child);
+  }
+  if (private_data->dictionary.release) {
+    private_data->dictionary.release(&private_data->dictionary);
+  }
+  delete private_data;
+  schema->release = nullptr;
+}
+
+/// The size in bytes of schema metadata (a count of pairs, followed by
+/// each key and value prefixed by its length).
+size_t MetadataSize(const char* metadata) {
+  if (!metadata) return 0;
+  int32_t count = 0;
+  std::memcpy(&count, metadata, sizeof(count));
+  size_t size = sizeof(count);
+  for (int32_t i = 0; i < 2 * count; i++) {
+    int32_t length = 0;
+    std::memcpy(&length, metadata + size, sizeof(length));
+    size += sizeof(length) + length;
+  }
+  return size;
+}
+
+void SchemaDeepCopy(const struct ArrowSchema* schema, struct ArrowSchema* out) {
+  auto* private_data = new CopiedSchema;
+  private_data->format = schema->format;
+  if (schema->name) private_data->name = schema->name;
+  private_data->metadata.assign(schema->metadata ? schema->metadata : "",
+                                MetadataSize(schema->metadata));
+  private_data->children.resize(schema->n_children);
+  for (auto& child : private_data->children) {
+    private_data->child_pointers.push_back(&child);
+  }
+
+  std::memset(out, 0, sizeof(*out));
+  out->format = private_data->format.c_str();
+  out->name = schema->name ? private_data->name.c_str() : nullptr;
+  out->metadata = schema->metadata ? private_data->metadata.data() : nullptr;
+  out->flags = schema->flags;
+  out->n_children = schema->n_children;
+  out->children = schema->n_children > 0 ? private_data->child_pointers.data() : nullptr;
+  out->release = CopiedSchemaRelease;
+  out->private_data = private_data;
+  for (int64_t i = 0; i < schema->n_children; i++) {
+    SchemaDeepCopy(schema->children[i], &private_data->children[i]);
+  }
+  if (schema->dictionary) {
+    SchemaDeepCopy(schema->dictionary, &private_data->dictionary);
+    out->dictionary = &private_data->dictionary;
+  }
+}
+
+/// A result set kept by ResultCache.
+struct CachedResult {
+  struct ArrowSchema schema = {};
+  std::vector<std::shared_ptr<struct ArrowArray>> batches;
+  int64_t bytes = 0;
+  // When the query was executed (in MonotonicNanos)
+  int64_t created = 0;
+
+  ~CachedResult() {
+    if (schema.release) schema.release(&schema);
+  }
+};
+
+/// The process-wide cache of result sets of read-only queries, for
+/// databases that enable it.  Result sets are kept as the batches read
+/// from the driver (which cache hits return views of), up to a total
+/// size, beyond which the least recently used are evicted.
+class ResultCache {
+ public:
+  static ResultCache& Get() {
+    // Leaked so that streams may be released during static destruction
+    static ResultCache* cache = new ResultCache();
+    return *cache;
+  }
+
+  /// Get a result set cached less than ttl_ns ago, if any.
+  std::shared_ptr<const CachedResult> Lookup(const std::string& key, int64_t ttl_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return nullptr;
+    if (MonotonicNanos() - it->second->second->created > ttl_ns) {
+      Erase(it);
+      return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    entries_.clear();
+    bytes_ = 0;
+  }
+
+  void Insert(const std::string& key, std::shared_ptr<const CachedResult> result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) Erase(it);
+    if (result->bytes > capacity_) return;
+    bytes_ += result->bytes;
+    lru_.emplace_front(key, std::move(result));
+    entries_[key] = lru_.begin();
+    Evict();
+  }
+
+  /// Evict the result sets of a database (see ResultCacheKey).
+  void EraseDatabase(const std::string& database) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      auto next = std::next(it);
+      if (it->first.compare(0, database.size() + 1, database + '\0') == 0) Erase(it);
+      it = next;
+    }
+  }
+
+  int64_t capacity() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+  }
+
+  void SetCapacity(int64_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    Evict();
+  }
+
+ private:
+  using Entry = std::pair<std::string, std::shared_ptr<const CachedResult>>;
+  using EntryMap = std::unordered_map<std::string, std::list<Entry>::iterator>;
+
+  void Erase(EntryMap::iterator it) {
+    bytes_ -= it->second->second->bytes;
+    lru_.erase(it->second);
+    entries_.erase(it);
+  }
+
+  void Evict() {
+    while (bytes_ > capacity_ && !lru_.empty()) Erase(entries_.find(lru_.back().first));
+  }
+
+  std::mutex mutex_;
+  // Most recently used first
+  std::list<Entry> lru_;
+  EntryMap entries_;
+  int64_t bytes_ = 0;
+  int64_t capacity_ = int64_t(64) * 1024 * 1024;
+};
+
+/// Serialize bound parameters (for the key of a result set), or return
+/// false if they aren't all of flat types (see CanConcatenate).
+bool SerializeParameters(const struct ArrowSchema* schema,
+                         const struct ArrowArray* array, std::string* out) {
+  if (!schema || !array || std::strcmp(schema->format, "+s") != 0) return false;
+  for (int64_t i = 0; i < schema->n_children; i++) {
+    if (!CanConcatenate(schema->children[i])) return false;
+  }
+
+  auto append = [out](const void* data, size_t size) {
+    out->append(reinterpret_cast<const char*>(data), size);
+  };
+  append(&array->length, sizeof(array->length));
+  for (int64_t i = 0; i < schema->n_children && i < array->n_children; i++) {
+    const char* format = schema->children[i]->format;
+    const struct ArrowArray* column = array->children[i];
+    out->append(format, std::strlen(format) + 1);
+    for (int64_t row = 0; row < array->length; row++) {
+      const int64_t index = array->offset + column->offset + row;
+      const bool valid = format[0] != 'n' &&
+                         (column->null_count == 0 || !column->buffers[0] ||
+                          GetBit(column->buffers[0], index));
+      out->push_back(valid ? 1 : 0);
+      if (!valid) continue;
+
+      const auto* values = reinterpret_cast<const uint8_t*>(column->buffers[1]);
+      if (format[0] == 'b') {
+        out->push_back(GetBit(values, index) ? 1 : 0);
+      } else if (format[0] == 'u' || format[0] == 'z') {
+        const auto* offsets = reinterpret_cast<const int32_t*>(values);
+        const int64_t length = offsets[index + 1] - offsets[index];
+        append(&length, sizeof(length));
+        append(reinterpret_cast<const uint8_t*>(column->buffers[2]) + offsets[index],
+               length);
+      } else if (format[0] == 'U' || format[0] == 'Z') {
+        const auto* offsets = reinterpret_cast<const int64_t*>(values);
+        const int64_t length = offsets[index + 1] - offsets[index];
+        append(&length, sizeof(length));
+        append(reinterpret_cast<const uint8_t*>(column->buffers[2]) + offsets[index],
+               length);
+      } else {
+        const int64_t width = FixedWidthBytes(format);
+        append(values + index * width, width);
+      }
+    }
+  }
+  return true;
+}
+
+// Memory accounting
+
+/// Counts the bytes of the batches that result streams have returned and
+/// the consumer has not yet released (see ArrowArrayBufferSize), for a
+/// database, connection, or statement.  Each account also counts towards
+/// its parent's, and may have a limit that fails streams that would
+/// exceed it.
+class MemoryAccount {
+ public:
+  MemoryAccount(const char* name, std::shared_ptr<MemoryAccount> parent, int64_t limit)
+      : name_(name), parent_(std::move(parent)), limit_(limit) {}
+
+  /// Count bytes towards this account and its ancestors, unless that
+  /// would put any of them over its limit.  Returns the account that
+  /// would go over, or nullptr.
+  const MemoryAccount* Reserve(int64_t bytes) {
+    for (MemoryAccount* account = this; account; account = account->parent_.get()) {
+      const int64_t current = account->current_.fetch_add(bytes) + bytes;
+      const int64_t limit = account->limit_.load();
+      if (limit > 0 && current > limit) {
+        for (MemoryAccount* undo = this; undo != account; undo = undo->parent_.get()) {
+          undo->current_.fetch_sub(bytes);
+        }
+        account->current_.fetch_sub(bytes);
+        return account;
+      }
+      int64_t peak = account->peak_.load();
+      while (current > peak && !account->peak_.compare_exchange_weak(peak, current)) {
+      }
+    }
+    return nullptr;
+  }
+
+  /// Stop counting bytes counted by Reserve.
+  void Release(int64_t bytes) {
+    for (MemoryAccount* account = this; account; account = account->parent_.get()) {
+      account->current_.fetch_sub(bytes);
+    }
+  }
+
+  const char* name() const { return name_; }
+  int64_t current() const { return current_.load(); }
+  int64_t peak() const { return peak_.load(); }
+  int64_t limit() const { return limit_.load(); }
+  void set_limit(int64_t limit) { limit_.store(limit); }
+
+ private:
+  const char* name_;
+  const std::shared_ptr<MemoryAccount> parent_;
+  std::atomic<int64_t> current_{0};
+  std::atomic<int64_t> peak_{0};
+  std::atomic<int64_t> limit_;
+};
+
+/// A batch returned to the consumer, whose bytes are counted until it is
+/// released.
+struct AccountedArray {
+  struct ArrowArray array;
+  std::shared_ptr<MemoryAccount> account;
+  int64_t bytes;
+};
+
+void AccountedArrayRelease(struct ArrowArray* array) {
+  auto* private_data = reinterpret_cast<AccountedArray*>(array->private_data);
+  private_data->array.release(&private_data->array);
+  private_data->account->Release(private_data->bytes);
+  delete private_data;
+  array->release = nullptr;
+}
+
+/// Count a batch towards an account until it is released.  If that would
+/// exceed a limit, release the batch and return an error message instead.
+std::string AccountArray(const std::shared_ptr<MemoryAccount>& account, int64_t bytes,
+                         struct ArrowArray* array) {
+  if (const MemoryAccount* over = account->Reserve(bytes)) {
+    array->release(array);
+    return "[DriverManager] Batch of " + std::to_string(bytes) +
+           " bytes would exceed the memory limit of the " + over->name() + " (" +
+           std::to_string(over->current()) + " of " + std::to_string(over->limit()) +
+           " bytes in use)";
+  }
+  AccountedArray* private_data;
+  try {
+    private_data = new AccountedArray{*array, account, bytes};
+  } catch (const std::bad_alloc&) {
+    account->Release(bytes);
+    array->release(array);
+    return "[DriverManager] Out of memory";
+  }
+  array->private_data = private_data;
+  array->release = AccountedArrayRelease;
+  return "";
+}
+
+// ArrowArrayStream wrapper to support AdbcErrorFromArrayStream
+
+struct ErrorArrayStream {
+  struct ArrowArrayStream stream = {};
+  struct AdbcDriver* private_driver = nullptr;
+
+  // If reading ahead, the reader of stream (which must only be used
+  // through it)
+  std::unique_ptr<Readahead> readahead;
+  // If rebatching, what reassembles the batches read from stream
+  std::unique_ptr<Rebatcher> rebatcher;
+
+  int GetNext(struct ArrowArray* out) {
+    if (rebatcher) return rebatcher->GetNext(out);
+    return ReadNext(out);
+  }
+
+  // If replaying a cached result set, the result set and the index of
+  // the next batch (stream is then unused)
+  std::shared_ptr<const CachedResult> cached;
+  size_t cached_index = 0;
+  // If caching the result set, its key and the batches so far
+  std::string cache_key;
+  std::shared_ptr<CachedResult> recording;
+
+  // If accounting for memory, the account of the batches returned, and
+  // if one would have exceeded a limit, the error (ending the stream)
+  std::shared_ptr<MemoryAccount> memory;
+  std::string memory_error;
+
+  /// Get the next batch from the driver (through readahead, if any) or
+  /// the cache.
+  int ReadNext(struct ArrowArray* out) {
+    if (cached) return ReadCached(out);
+    int status = readahead ? readahead->GetNext(out) : stream.get_next(&stream, out);
+    if (recording) {
+      try {
+        Record(status, out);
+      } catch (const std::bad_alloc&) {
+        recording.reset();
+        if (out->release) out->release(out);
+        return ENOMEM;
+      }
+    }
+    return status;
+  }
+
+  int ReadCached(struct ArrowArray* out) {
+    if (cached_index == cached->batches.size()) {
+      std::memset(out, 0, sizeof(*out));
+      return 0;
+    }
+    const std::shared_ptr<struct ArrowArray>& batch = cached->batches[cached_index];
+    try {
+      SliceArray(batch, &cached->schema, batch.get(), 0, batch->length, out);
+    } catch (const std::bad_alloc&) {
+      if (out->release) out->release(out);
+      return ENOMEM;
+    }
+    cached_index++;
+    return 0;
+  }
+
+  /// Add a batch read from the driver to the recording, replacing it with
+  /// a view of the kept batch, and cache the result set at its end.
+  void Record(int status, struct ArrowArray* out) {
+    if (status != 0) {
+      recording.reset();
+      return;
+    }
+    if (!recording->schema.release) {
+      struct ArrowSchema schema = {};
+      if (GetSchema(&schema) != 0) {
+        recording.reset();
+        return;
+      }
+      SchemaDeepCopy(&schema, &recording->schema);
+      schema.release(&schema);
+    }
+    if (!out->release) {
+      ResultCache::Get().Insert(cache_key, std::move(recording));
+      recording.reset();
+      return;
+    }
+    recording->bytes += ArrowArrayBufferSize(&recording->schema, out);
+    if (recording->bytes > ResultCache::Get().capacity()) {
+      recording.reset();
+      return;
+    }
+    std::shared_ptr<struct ArrowArray> batch = ShareArray(out);
+    recording->batches.push_back(batch);
+    SliceArray(batch, &recording->schema, batch.get(), 0, batch->length, out);
+  }
+
+  int GetSchema(struct ArrowSchema* out) {
+    if (cached) {
+      try {
+        SchemaDeepCopy(&cached->schema, out);
+      } catch (const std::bad_alloc&) {
+        if (out->release) out->release(out);
+        return ENOMEM;
+      }
+      return 0;
+    }
+    if (readahead) return readahead->GetSchema(out);
+    return stream.get_schema(&stream, out);
+  }
+
+  // If tracing, the function that returned the stream and when it was
+  // called
+  Tracer* tracer = nullptr;
+  const char* source = nullptr;
+  int64_t start = 0;
+  int64_t num_batches = 0;
+  // If tracing, collecting metrics, or accounting for memory, the schema
+  // of the stream (to size batches)
+  struct ArrowSchema schema = {};
+
+  // If collecting metrics, the counters so far, and when the stream was
+  // returned and get_next last returned (in MonotonicNanos)
+  bool collect_metrics = false;
+  struct AdbcDriverManagerStreamMetrics metrics = {};
+  int64_t created = 0;
+  int64_t last_return = 0;
+};
+
+void ErrorArrayStreamRelease(struct ArrowArrayStream* stream) {
+  if (stream->release != ErrorArrayStreamRelease || !stream->private_data) return;
+
+  auto* private_data = reinterpret_cast<struct ErrorArrayStream*>(stream->private_data);
+  private_data->rebatcher.reset();
+  private_data->readahead.reset();
+  if (private_data->stream.release) private_data->stream.release(&private_data->stream);
+  if (private_data->schema.release) private_data->schema.release(&private_data->schema);
+  delete private_data;
+  std::memset(stream, 0, sizeof(*stream));
+}
+
+const char* ErrorArrayStreamGetLastError(struct ArrowArrayStream* stream) {
+  if (stream->release != ErrorArrayStreamRelease || !stream->private_data) return nullptr;
+  auto* private_data = reinterpret_cast<struct ErrorArrayStream*>(stream->private_data);
+  if (!private_data->memory_error.empty()) return private_data->memory_error.c_str();
+  if (private_data->cached) return nullptr;
+  if (private_data->readahead) return private_data->readahead->GetLastError();
+  return private_data->stream.get_last_error(&private_data->stream);
+}
+
+int ErrorArrayStreamGetNext(struct ArrowArrayStream* stream, struct ArrowArray* array) {
+  if (stream->release != ErrorArrayStreamRelease || !stream->private_data) return EINVAL;
+  auto* private_data = reinterpret_cast<struct ErrorArrayStream*>(stream->private_data);
+  Tracer* tracer = private_data->tracer;
+  if (!tracer && !private_data->collect_metrics && !private_data->memory) {
+    return private_data->GetNext(array);
+  }
+  if (!private_data->memory_error.empty()) return ENOMEM;
+
+  if (!private_data->schema.release &&
+      private_data->GetSchema(&private_data->schema) != 0) {
+    std::memset(&private_data->schema, 0, sizeof(private_data->schema));
+  }
+  const int64_t trace_start = tracer ? tracer->Now() : 0;
+  const int64_t start = MonotonicNanos();
+  int status = private_data->GetNext(array);
+  const int64_t end = MonotonicNanos();
+  bool have_batch = status == 0 && array->release;
+  const int64_t bytes =
+      have_batch ? ArrowArrayBufferSize(&private_data->schema, array) : 0;
+  if (have_batch && private_data->memory) {
+    private_data->memory_error = AccountArray(private_data->memory, bytes, array);
+    if (!private_data->memory_error.empty()) {
+      status = ENOMEM;
+      have_batch = false;
+    }
+  }
+
+  if (private_data->collect_metrics) {
+    struct AdbcDriverManagerStreamMetrics* metrics = &private_data->metrics;
+    metrics->idle_ns += start - private_data->last_return;
+    metrics->get_next_ns += end - start;
+    metrics->max_get_next_ns = std::max(metrics->max_get_next_ns, end - start);
+    if (have_batch) {
+      if (metrics->num_batches == 0) {
+        metrics->first_batch_ns = end - private_data->created;
+      }
+      metrics->num_batches++;
+      metrics->num_rows += array->length;
+      metrics->buffer_bytes += bytes;
+      metrics->num_buffers += ArrowArrayBufferCount(array);
+    }
+    private_data->last_return = end;
+  }
+  if (tracer && have_batch) {
+    const int64_t time_to_first_batch =
+        private_data->num_batches == 0 ? tracer->Now() - private_data->start : -1;
+    tracer->RecordBatch(private_data->source, trace_start, private_data->num_batches++,
+                        array->length, bytes, time_to_first_batch);
+  }
+  return status;
+}
+
+int ErrorArrayStreamGetSchema(struct ArrowArrayStream* stream,
+                              struct ArrowSchema* schema) {
+  if (stream->release != ErrorArrayStreamRelease || !stream->private_data) return EINVAL;
+  auto* private_data = reinterpret_cast<struct ErrorArrayStream*>(stream->private_data);
+  return private_data->GetSchema(schema);
+}
+
+// Default stubs
+
+int ErrorGetDetailCount(const struct AdbcError* error) { return 0; }
+
+struct AdbcErrorDetail ErrorGetDetail(const struct AdbcError* error, int index) {
+  return {nullptr, nullptr, 0};
+}
+
+const struct AdbcError* ErrorFromArrayStream(struct ArrowArrayStream* stream,
+                                             AdbcStatusCode* status) {
+  return nullptr;
+}
+
+/// Wrap a result stream, or if cached is given, make a stream replaying
+/// it (in which case out need not be initialized).  If cache_key is
+/// given, the result set is cached once fully read.
+void ErrorArrayStreamInit(struct ArrowArrayStream* out,
+                          struct AdbcDriver* private_driver, const TraceSpan& span,
+                          const ManagerStatementOptions& options = {},
+                          std::shared_ptr<const CachedResult> cached = nullptr,
+                          const std::string& cache_key = "") {
+  const auto* state =
+      reinterpret_cast<const ManagerDriverState*>(private_driver->private_manager);
+  const bool collect_metrics = state && state->stream_metrics;
+  if (!out || (!cached && !out->release) ||
+      // Don't bother wrapping if driver didn't claim support (and we
+      // aren't tracing, collecting metrics, reading ahead, rebatching,
+      // caching, or accounting for memory)
+      (private_driver->ErrorFromArrayStream == ErrorFromArrayStream &&
+       !span.tracer() && !collect_metrics && options.readahead_batches <= 0 &&
+       options.rebatch_rows <= 0 && options.rebatch_bytes <= 0 && !cached &&
+       cache_key.empty() && !options.memory)) {
+    return;
+  }
+  struct ErrorArrayStream* private_data = new ErrorArrayStream;
+  if (cached) {
+    private_data->cached = std::move(cached);
+  } else {
+    private_data->stream = *out;
+    if (!cache_key.empty()) {
+      private_data->cache_key = cache_key;
+      private_data->recording = std::make_shared<CachedResult>();
+      private_data->recording->created = MonotonicNanos();
+    }
+  }
+  private_data->private_driver = private_driver;
+  private_data->memory = options.memory;
+  private_data->tracer = span.tracer();
+  private_data->source = span.name();
+  private_data->start = span.start();
+  if (collect_metrics) {
+    private_data->collect_metrics = true;
+    private_data->metrics.first_batch_ns = -1;
+    private_data->created = private_data->last_return = MonotonicNanos();
+  }
+  if (options.readahead_batches > 0 && !private_data->cached) {
+    private_data->readahead.reset(new Readahead(
+        &private_data->stream, options.readahead_batches, options.readahead_bytes));
+  }
+  if (options.rebatch_rows > 0 || options.rebatch_bytes > 0) {
+    private_data->rebatcher.reset(new Rebatcher(
+        options.rebatch_rows, options.rebatch_bytes,
+        [private_data](struct ArrowArray* array) {
+          return private_data->ReadNext(array);
+        },
+        [private_data](struct ArrowSchema* schema) {
+          return private_data->GetSchema(schema);
+        }));
+  }
+  out->get_last_error = ErrorArrayStreamGetLastError;
+  out->get_next = ErrorArrayStreamGetNext;
+  out->get_schema = ErrorArrayStreamGetSchema;
+  out->release = ErrorArrayStreamRelease;
+  out->private_data = private_data;
+}
+
+AdbcStatusCode DatabaseGetOption(struct AdbcDatabase* database, const char* key,
+                                 char* value, size_t* length, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode DatabaseGetOptionBytes(struct AdbcDatabase* database, const char* key,
+                                      uint8_t* value, size_t* length,
+                                      struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode DatabaseGetOptionInt(struct AdbcDatabase* database, const char* key,
+                                    int64_t* value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode DatabaseGetOptionDouble(struct AdbcDatabase* database, const char* key,
+                                       double* value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode DatabaseSetOption(struct AdbcDatabase* database, const char* key,
+                                 const char* value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode DatabaseSetOptionBytes(struct AdbcDatabase* database, const char* key,
+                                      const uint8_t* value, size_t length,
+                                      struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode DatabaseSetOptionInt(struct AdbcDatabase* database, const char* key,
+                                    int64_t value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode DatabaseSetOptionDouble(struct AdbcDatabase* database, const char* key,
+                                       double value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionCancel(struct AdbcConnection* connection,
+                                struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionCommit(struct AdbcConnection*, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionGetInfo(struct AdbcConnection* connection,
+                                 const uint32_t* info_codes, size_t info_codes_length,
+                                 struct ArrowArrayStream* out, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionGetObjects(struct AdbcConnection*, int, const char*, const char*,
+                                    const char*, const char**, const char*,
+                                    struct ArrowArrayStream*, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionGetOption(struct AdbcConnection* connection, const char* key,
+                                   char* value, size_t* length, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode ConnectionGetOptionBytes(struct AdbcConnection* connection,
+                                        const char* key, uint8_t* value, size_t* length,
+                                        struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode ConnectionGetOptionInt(struct AdbcConnection* connection, const char* key,
+                                      int64_t* value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode ConnectionGetOptionDouble(struct AdbcConnection* connection,
+                                         const char* key, double* value,
+                                         struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode ConnectionGetStatistics(struct AdbcConnection*, const char*, const char*,
+                                       const char*, char, struct ArrowArrayStream*,
+                                       struct AdbcError*) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionGetStatisticNames(struct AdbcConnection*,
+                                           struct ArrowArrayStream*, struct AdbcError*) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionGetTableSchema(struct AdbcConnection*, const char*, const char*,
+                                        const char*, struct ArrowSchema*,
+                                        struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionGetTableTypes(struct AdbcConnection*, struct ArrowArrayStream*,
+                                       struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionReadPartition(struct AdbcConnection* connection,
+                                       const uint8_t* serialized_partition,
+                                       size_t serialized_length,
+                                       struct ArrowArrayStream* out,
+                                       struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionRollback(struct AdbcConnection*, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionSetOption(struct AdbcConnection*, const char*, const char*,
+                                   struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionSetOptionBytes(struct AdbcConnection*, const char*,
+                                        const uint8_t*, size_t, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionSetOptionInt(struct AdbcConnection* connection, const char* key,
+                                      int64_t value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode ConnectionSetOptionDouble(struct AdbcConnection* connection,
+                                         const char* key, double value,
+                                         struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementBind(struct AdbcStatement*, struct ArrowArray*,
+                             struct ArrowSchema*, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementBindStream(struct AdbcStatement*, struct ArrowArrayStream*,
+                                   struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementCancel(struct AdbcStatement* statement, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementExecutePartitions(struct AdbcStatement* statement,
+                                          struct ArrowSchema* schema,
+                                          struct AdbcPartitions* partitions,
+                                          int64_t* rows_affected,
+                                          struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementExecuteSchema(struct AdbcStatement* statement,
+                                      struct ArrowSchema* schema,
+                                      struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementGetOption(struct AdbcStatement* statement, const char* key,
+                                  char* value, size_t* length, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode StatementGetOptionBytes(struct AdbcStatement* statement, const char* key,
+                                       uint8_t* value, size_t* length,
+                                       struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode StatementGetOptionInt(struct AdbcStatement* statement, const char* key,
+                                     int64_t* value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode StatementGetOptionDouble(struct AdbcStatement* statement, const char* key,
+                                        double* value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_FOUND;
+}
+
+AdbcStatusCode StatementGetParameterSchema(struct AdbcStatement* statement,
+                                           struct ArrowSchema* schema,
+                                           struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementPrepare(struct AdbcStatement*, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementSetOption(struct AdbcStatement*, const char*, const char*,
+                                  struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementSetOptionBytes(struct AdbcStatement*, const char*, const uint8_t*,
+                                       size_t, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementSetOptionInt(struct AdbcStatement* statement, const char* key,
+                                     int64_t value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementSetOptionDouble(struct AdbcStatement* statement, const char* key,
+                                        double value, struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementSetSqlQuery(struct AdbcStatement*, const char*,
+                                    struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode StatementSetSubstraitPlan(struct AdbcStatement*, const uint8_t*, size_t,
+                                         struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+/// Options that can be applied to many databases or connections at
+/// once (see AdbcDriverManagerOptionProfileNew).
+struct OptionProfile {
+  enum class Type { kString, kBytes, kInt, kDouble };
+  struct Option {
+    Type type;
+    std::string key;
+    // The value of string and bytes options
+    std::string value;
+    int64_t int_value = 0;
+    double double_value = 0.0;
+  };
+
+  // In the order they were first set
+  std::vector<Option> options;
+  // Set once the profile is applied, after which it can't be changed
+  std::atomic<bool> frozen{false};
+
+  const Option* Find(Type type, const char* key) const {
+    for (const auto& option : options) {
+      if (option.type == type && option.key == key) return &option;
+    }
+    return nullptr;
+  }
+
+  AdbcStatusCode Set(Option option, struct AdbcError* error) {
+    if (frozen.load()) {
+      SetError(error, "[DriverManager] Option profile can't be changed once applied");
+      return ADBC_STATUS_INVALID_STATE;
+    }
+    for (auto& existing : options) {
+      if (existing.type == option.type && existing.key == option.key) {
+        existing = std::move(option);
+        return ADBC_STATUS_OK;
+      }
+    }
+    options.push_back(std::move(option));
+    return ADBC_STATUS_OK;
+  }
+};
+
+/// Set the options of a profile on a database or connection through the
+/// given functions (the driver's or the driver manager's), except those
+/// that skip returns true for.
+template <typename Object, typename Skip>
+AdbcStatusCode SetProfileOptions(
+    const OptionProfile& profile, Object* object,
+    AdbcStatusCode (*set)(Object*, const char*, const char*, struct AdbcError*),
+    AdbcStatusCode (*set_bytes)(Object*, const char*, const uint8_t*, size_t,
+                                struct AdbcError*),
+    AdbcStatusCode (*set_int)(Object*, const char*, int64_t, struct AdbcError*),
+    AdbcStatusCode (*set_double)(Object*, const char*, double, struct AdbcError*),
+    Skip skip, struct AdbcError* error) {
+  for (const auto& option : profile.options) {
+    if (skip(option)) continue;
+    AdbcStatusCode status = ADBC_STATUS_OK;
+    const char* key = option.key.c_str();
+    switch (option.type) {
+      case OptionProfile::Type::kString:
+        status = set(object, key, option.value.c_str(), error);
+        break;
+      case OptionProfile::Type::kBytes:
+        status = set_bytes(object, key,
+                           reinterpret_cast<const uint8_t*>(option.value.data()),
+                           option.value.size(), error);
+        break;
+      case OptionProfile::Type::kInt:
+        status = set_int(object, key, option.int_value, error);
+        break;
+      case OptionProfile::Type::kDouble:
+        status = set_double(object, key, option.double_value, error);
+        break;
+    }
+    if (status != ADBC_STATUS_OK) return status;
+  }
+  return ADBC_STATUS_OK;
+}
+
+/// Temporary state while the database is being configured.
+struct TempDatabase {
+  std::unordered_map<std::string, std::string> options;
+  std::unordered_map<std::string, std::string> bytes_options;
+  std::unordered_map<std::string, int64_t> int_options;
+  std::unordered_map<std::string, double> double_options;
+  std::string driver;
+  std::string entrypoint;
+  AdbcDriverInitFunc init_func = nullptr;
+  // Where to write a trace of calls to the driver, if anywhere
+  std::string trace_path;
+  // Whether to collect AdbcDriverManagerStreamMetrics
+  bool stream_metrics = false;
+  // How long cached results stay valid (0 to not cache them)
+  int64_t result_cache_ttl_ms = 0;
+  // Whether to account for the memory of result streams, and the limit
+  // of the database (0 for none)
+  bool memory_accounting = false;
+  int64_t memory_limit = 0;
+};
+
+/// Temporary state while the database is being configured.
+struct TempConnection {
+  // The profile applied to the connection, if any (options set on the
+  // connection itself take precedence)
+  std::shared_ptr<const OptionProfile> profile;
+  std::unordered_map<std::string, std::string> options;
+  std::unordered_map<std::string, std::string> bytes_options;
+  std::unordered_map<std::string, int64_t> int_options;
+  std::unordered_map<std::string, double> double_options;
+};
+
+/// Find an option saved on a connection before Init, whether set on the
+/// connection or its profile.
+template <typename T>
+const T* FindTempOption(const TempConnection& args,
+                        const std::unordered_map<std::string, T>& options,
+                        OptionProfile::Type type, const char* key,
+                        T OptionProfile::Option::*member) {
+  const auto it = options.find(key);
+  if (it != options.end()) return &it->second;
+  if (!args.profile) return nullptr;
+  const OptionProfile::Option* option = args.profile->Find(type, key);
+  return option ? &(option->*member) : nullptr;
+}
+
+static const char kDefaultEntrypoint[] = "AdbcDriverInit";
+// Database option/environment variable to enable tracing (see Tracer)
+static const char kTraceOption[] = "adbc.driver_manager.trace.path";
+static const char kTraceEnvVar[] = "ADBC_DRIVER_MANAGER_TRACE";
+// Database option to collect AdbcDriverManagerStreamMetrics
+static const char kStreamMetricsOption[] = "adbc.driver_manager.stream_metrics";
+// Database option to cache results of read-only queries (see ResultCache),
+// and statement option to opt in to it
+static const char kResultCacheTtlOption[] = "adbc.driver_manager.result_cache.ttl_ms";
+static const char kResultCacheEnabledOption[] =
+    "adbc.driver_manager.result_cache.enabled";
+// Database option to account for the memory of result streams (see
+// MemoryAccount), and database/statement option to limit it
+static const char kMemoryAccountingOption[] = "adbc.driver_manager.memory.accounting";
+static const char kMemoryLimitOption[] = "adbc.driver_manager.memory.limit_bytes";
+// Database/connection/statement options to read memory accounts
+static const char kMemoryCurrentOption[] = "adbc.driver_manager.memory.current_bytes";
+static const char kMemoryPeakOption[] = "adbc.driver_manager.memory.peak_bytes";
+// Statement options to read result sets ahead (see Readahead)
+static const char kReadaheadBatchesOption[] = "adbc.driver_manager.readahead.batches";
+static const char kReadaheadBytesOption[] = "adbc.driver_manager.readahead.bytes";
+// Statement options to reassemble result sets (see Rebatcher)
+static const char kRebatchRowsOption[] = "adbc.driver_manager.rebatch.rows";
+static const char kRebatchBytesOption[] = "adbc.driver_manager.rebatch.bytes";
+
+/// Get a statement option that the driver manager implements, or nullptr
+/// if the key is not one.
+int64_t* FindManagerStatementOption(ManagerStatementOptions* options, const char* key) {
+  if (std::strcmp(key, kReadaheadBatchesOption) == 0) return &options->readahead_batches;
+  if (std::strcmp(key, kReadaheadBytesOption) == 0) return &options->readahead_bytes;
+  if (std::strcmp(key, kRebatchRowsOption) == 0) return &options->rebatch_rows;
+  if (std::strcmp(key, kRebatchBytesOption) == 0) return &options->rebatch_bytes;
+  if (std::strcmp(key, kMemoryLimitOption) == 0) return &options->memory_limit;
+  return nullptr;
+}
+
+bool IsManagerStatementOption(const char* key) {
+  ManagerStatementOptions options;
+  return FindManagerStatementOption(&options, key) != nullptr;
+}
+
+/// Result streams of connections have no options, other than the memory
+/// account of the connection.
+ManagerStatementOptions GetStreamOptions(const struct AdbcConnection* connection) {
+  auto* state = reinterpret_cast<ManagerDriverState*>(
+      connection->private_driver->private_manager);
+  if (!state || !state->memory) return {};
+  ManagerStatementOptions options;
+  std::lock_guard<std::mutex> lock(state->connection_mutex);
+  const auto it = state->connection_memory.find(connection);
+  if (it != state->connection_memory.end()) options.memory = it->second;
+  return options;
+}
+
+ManagerStatementOptions GetStreamOptions(const struct AdbcStatement* statement) {
+  auto* state = reinterpret_cast<ManagerDriverState*>(
+      statement->private_driver->private_manager);
+  if (!state) return {};
+  std::lock_guard<std::mutex> lock(state->statement_mutex);
+  const auto it = state->statement_options.find(statement);
+  if (it == state->statement_options.end()) return {};
+  return it->second;
+}
+
+AdbcStatusCode SetManagerStatementOption(struct AdbcStatement* statement,
+                                         const char* key, int64_t value,
+                                         struct AdbcError* error) {
+  if (value < 0) {
+    SetError(error, std::string("[DriverManager] Invalid value for ") + key + ": " +
+                        std::to_string(value));
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  ManagerDriverState* state = InitManagerState(statement->private_driver);
+  std::lock_guard<std::mutex> lock(state->statement_mutex);
+  ManagerStatementOptions* options = &state->statement_options[statement];
+  if (std::strcmp(key, kMemoryLimitOption) == 0) {
+    if (!options->memory) {
+      SetError(error, std::string("[DriverManager] Can't set ") + key +
+                          " unless the database sets " + kMemoryAccountingOption);
+      return ADBC_STATUS_INVALID_STATE;
+    }
+    options->memory->set_limit(value);
+  }
+  *FindManagerStatementOption(options, key) = value;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode SetManagerStatementOption(struct AdbcStatement* statement,
+                                         const char* key, const char* value,
+                                         struct AdbcError* error) {
+  char* end = nullptr;
+  errno = 0;
+  const int64_t parsed = std::strtoll(value, &end, 10);
+  if (errno != 0 || end == value || *end != '\0') {
+    SetError(error, std::string("[DriverManager] Invalid value for ") + key + ": " +
+                        value);
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  return SetManagerStatementOption(statement, key, parsed, error);
+}
+
+int64_t GetManagerStatementOption(const struct AdbcStatement* statement,
+                                  const char* key) {
+  ManagerStatementOptions options = GetStreamOptions(statement);
+  return *FindManagerStatementOption(&options, key);
+}
+
+AdbcStatusCode SetMemoryLimit(TempDatabase* args, int64_t value,
+                              struct AdbcError* error) {
+  if (value < 0) {
+    SetError(error, std::string("[DriverManager] Invalid value for ") +
+                        kMemoryLimitOption + ": " + std::to_string(value));
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  args->memory_limit = value;
+  return ADBC_STATUS_OK;
+}
 
-AdbcStatusCode StatementCancel(struct AdbcStatement* statement, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+/// Get a counter of a memory account, if accounting for memory and the
+/// key is one.
+bool GetMemoryCounter(const MemoryAccount* account, const char* key, int64_t* value) {
+  if (!account) return false;
+  if (std::strcmp(key, kMemoryCurrentOption) == 0) {
+    *value = account->current();
+  } else if (std::strcmp(key, kMemoryPeakOption) == 0) {
+    *value = account->peak();
+  } else if (std::strcmp(key, kMemoryLimitOption) == 0) {
+    *value = account->limit();
+  } else {
+    return false;
+  }
+  return true;
 }
 
-AdbcStatusCode StatementExecutePartitions(struct AdbcStatement* statement,
-                                          struct ArrowSchema* schema,
-                                          struct AdbcPartitions* partitions,
-                                          int64_t* rows_affected,
-                                          struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+const MemoryAccount* GetMemoryAccount(const struct AdbcDriver* driver) {
+  const auto* state =
+      reinterpret_cast<const ManagerDriverState*>(driver->private_manager);
+  return state ? state->memory.get() : nullptr;
 }
 
-AdbcStatusCode StatementExecuteSchema(struct AdbcStatement* statement,
-                                      struct ArrowSchema* schema,
+AdbcStatusCode SetResultCacheTtl(TempDatabase* args, int64_t value,
+                                 struct AdbcError* error) {
+  if (value < 0) {
+    SetError(error, std::string("[DriverManager] Invalid value for ") +
+                        kResultCacheTtlOption + ": " + std::to_string(value));
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  args->result_cache_ttl_ms = value;
+  return ADBC_STATUS_OK;
+}
+
+/// Identify a database in the keys of its cached results.  Each database
+/// is distinct, even if opened with the same options (e.g. two in-memory
+/// databases), so result sets are never shared between databases.
+std::string ResultCacheDatabaseKey() {
+  static std::atomic<uint64_t> next_database{0};
+  return std::to_string(next_database++);
+}
+
+AdbcStatusCode SetResultCacheEnabled(struct AdbcStatement* statement, const char* value,
+                                     struct AdbcError* error) {
+  bool enabled = false;
+  if (std::strcmp(value, ADBC_OPTION_VALUE_ENABLED) == 0) {
+    enabled = true;
+  } else if (std::strcmp(value, ADBC_OPTION_VALUE_DISABLED) != 0) {
+    SetError(error, std::string("[DriverManager] Invalid value for ") +
+                        kResultCacheEnabledOption + ": " + value);
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  auto* state = reinterpret_cast<ManagerDriverState*>(
+      statement->private_driver->private_manager);
+  if (!state || state->result_cache_ttl_ns <= 0) {
+    SetError(error, std::string("[DriverManager] Can't set ") +
+                        kResultCacheEnabledOption + " unless the database sets " +
+                        kResultCacheTtlOption);
+    return ADBC_STATUS_INVALID_STATE;
+  }
+  std::lock_guard<std::mutex> lock(state->statement_mutex);
+  state->statement_options[statement].cache_enabled = enabled;
+  return ADBC_STATUS_OK;
+}
+
+/// Record a connection option that result sets depend on, if the
+/// database caches results.
+void UpdateResultCacheConnection(const struct AdbcConnection* connection,
+                                 const char* key, const std::string& value) {
+  auto* state = reinterpret_cast<ManagerDriverState*>(
+      connection->private_driver->private_manager);
+  if (!state || state->result_cache_ttl_ns <= 0) return;
+  std::lock_guard<std::mutex> lock(state->connection_mutex);
+  ManagerConnectionOptions* options = &state->connection_options[connection];
+  if (std::strcmp(key, ADBC_CONNECTION_OPTION_AUTOCOMMIT) == 0) {
+    options->autocommit = value != ADBC_OPTION_VALUE_DISABLED;
+  } else if (std::strcmp(key, ADBC_CONNECTION_OPTION_CURRENT_CATALOG) == 0) {
+    options->current_catalog = value;
+  } else if (std::strcmp(key, ADBC_CONNECTION_OPTION_CURRENT_DB_SCHEMA) == 0) {
+    options->current_db_schema = value;
+  }
+}
+
+/// Get a string option of a connection from its driver, if it has one.
+bool GetDriverConnectionOption(const struct AdbcConnection* connection, const char* key,
+                               std::string* out) {
+  auto* mutable_connection = const_cast<struct AdbcConnection*>(connection);
+  struct AdbcError error = {};
+  std::string value(64, '\0');
+  size_t length = value.size();
+  AdbcStatusCode status = connection->private_driver->ConnectionGetOption(
+      mutable_connection, key, &value[0], &length, &error);
+  if (status == ADBC_STATUS_OK && length > value.size()) {
+    value.resize(length);
+    status = connection->private_driver->ConnectionGetOption(
+        mutable_connection, key, &value[0], &length, &error);
+  }
+  if (error.release) error.release(&error);
+  if (status != ADBC_STATUS_OK || length == 0 || length > value.size()) return false;
+  value.resize(length - 1);
+  *out = std::move(value);
+  return true;
+}
+
+/// Get the key of the result set of a statement, or an empty string if
+/// it can't be cached: the statement didn't opt in, its query isn't
+/// read-only, its parameters are unknown, or its connection is in a
+/// transaction (whose writes, or locks, the cached result set wouldn't
+/// reflect).  Besides the database, query, and parameters, the key has
+/// the current catalog and schema of the connection, as the driver
+/// reports them or else as last set through the driver manager.
+std::string ResultCacheKey(const struct AdbcStatement* statement,
+                           const ManagerStatementOptions& options) {
+  auto* state = reinterpret_cast<ManagerDriverState*>(
+      statement->private_driver->private_manager);
+  if (!state || state->result_cache_ttl_ns <= 0 || !options.cache_enabled ||
+      !options.connection || options.cache_query.empty() ||
+      options.cache_parameters_unknown || ResultCache::Get().capacity() == 0) {
+    return "";
+  }
+
+  ManagerConnectionOptions session;
+  {
+    std::lock_guard<std::mutex> lock(state->connection_mutex);
+    const auto it = state->connection_options.find(options.connection);
+    if (it != state->connection_options.end()) session = it->second;
+  }
+  std::string value;
+  if (GetDriverConnectionOption(options.connection, ADBC_CONNECTION_OPTION_AUTOCOMMIT,
+                                &value)) {
+    session.autocommit = value != ADBC_OPTION_VALUE_DISABLED;
+  }
+  if (!session.autocommit) return "";
+  if (GetDriverConnectionOption(options.connection,
+                                ADBC_CONNECTION_OPTION_CURRENT_CATALOG, &value)) {
+    session.current_catalog = std::move(value);
+  }
+  if (GetDriverConnectionOption(options.connection,
+                                ADBC_CONNECTION_OPTION_CURRENT_DB_SCHEMA, &value)) {
+    session.current_db_schema = std::move(value);
+  }
+
+  std::string key = state->result_cache_database;
+  const std::string* parts[] = {&session.current_catalog, &session.current_db_schema,
+                                &options.cache_query};
+  for (const std::string* part : parts) {
+    key += '\0';
+    key += std::to_string(part->size());
+    key += '\0';
+    key += *part;
+  }
+  key += options.cache_parameters;
+  return key;
+}
+
+/// Update what ResultCacheKey uses for a statement, if its database
+/// caches results.
+template <typename Update>
+void UpdateResultCacheKey(struct AdbcStatement* statement, Update update) {
+  auto* state = reinterpret_cast<ManagerDriverState*>(
+      statement->private_driver->private_manager);
+  if (!state || state->result_cache_ttl_ns <= 0) return;
+  std::lock_guard<std::mutex> lock(state->statement_mutex);
+  update(&state->statement_options[statement]);
+}
+
+// Multiplex driver (see AdbcDriverManagerMultiplexInit)
+
+/// A fixed set of threads that run tasks in the order submitted.
+class WorkerPool {
+ public:
+  explicit WorkerPool(size_t num_threads) {
+    for (size_t i = 0; i < num_threads; i++) {
+      threads_.emplace_back([this] { Run(); });
+    }
+  }
+
+  /// Finish the tasks submitted so far and stop the threads.
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) thread.join();
+  }
+
+  void Submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+  /// Run task(i) for each i in [0, n) on the pool, and wait for all of
+  /// them.  Must not be called from a task of the same pool.
+  void ParallelFor(size_t n, const std::function<void(size_t)>& task) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t remaining = n;
+    for (size_t i = 0; i < n; i++) {
+      Submit([&, i] {
+        task(i);
+        std::lock_guard<std::mutex> lock(mutex);
+        remaining--;
+        cv.notify_all();
+      });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    WaitOn(&cv, &lock, [&] { return remaining == 0; });
+  }
+
+ private:
+  void Run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        WaitOn(&cv_, &lock, [this] { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) return;
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stop_ = false;
+  std::vector<std::thread> threads_;
+};
+
+static const char kMultiplexShardPrefix[] = "adbc.driver_manager.multiplex.shard.";
+static const char kMultiplexThreadsOption[] = "adbc.driver_manager.multiplex.threads";
+static const char kMultiplexOrderByOption[] = "adbc.driver_manager.multiplex.order_by";
+static const char kMultiplexShardColumnOption[] =
+    "adbc.driver_manager.multiplex.shard_column";
+// To catch typos (e.g. a missing '.') before allocating that many shards
+constexpr size_t kMaxMultiplexShards = 4096;
+// Executions block a thread each, so have a few even on small machines
+constexpr size_t kMinAsyncThreads = 8;
+
+/// Run a function for each shard, concurrently if given a pool, and
+/// return the status of the first shard (by index) that fails.
+AdbcStatusCode ForEachShard(
+    WorkerPool* pool, size_t num_shards,
+    const std::function<AdbcStatusCode(size_t, struct AdbcError*)>& function,
+    struct AdbcError* error) {
+  std::vector<AdbcStatusCode> statuses(num_shards, ADBC_STATUS_OK);
+  std::vector<struct AdbcError> errors(num_shards);
+  for (auto& shard_error : errors) std::memset(&shard_error, 0, sizeof(shard_error));
+  auto task = [&](size_t i) { statuses[i] = function(i, &errors[i]); };
+  if (pool && num_shards > 1) {
+    pool->ParallelFor(num_shards, task);
+  } else {
+    for (size_t i = 0; i < num_shards; i++) task(i);
+  }
+
+  AdbcStatusCode status = ADBC_STATUS_OK;
+  for (size_t i = 0; i < num_shards; i++) {
+    if (statuses[i] != ADBC_STATUS_OK && status == ADBC_STATUS_OK) {
+      status = statuses[i];
+      SetError(error, "[Multiplex] Shard " + std::to_string(i) + ": " +
+                          (errors[i].message ? errors[i].message
+                                             : AdbcStatusCodeMessage(status)));
+    }
+    if (errors[i].release) errors[i].release(&errors[i]);
+  }
+  return status;
+}
+
+struct MultiplexDatabase {
+  // Options set before Init, for all shards and for each shard
+  std::vector<std::pair<std::string, std::string>> common_options;
+  std::vector<std::vector<std::pair<std::string, std::string>>> shard_options;
+  int64_t num_threads = 0;
+
+  std::vector<struct AdbcDatabase> shards;
+  std::unique_ptr<WorkerPool> pool;
+};
+
+struct MultiplexConnection {
+  // Options set before Init
+  std::vector<std::pair<std::string, std::string>> options;
+
+  MultiplexDatabase* database = nullptr;
+  std::vector<struct AdbcConnection> shards;
+};
+
+struct MultiplexStatement {
+  MultiplexConnection* connection = nullptr;
+  std::vector<struct AdbcStatement> shards;
+  // The column that the result sets of the shards are ordered by, if any
+  std::string order_by;
+  // The name of the column to add with the index of each row's shard
+  std::string shard_column;
+};
+
+AdbcStatusCode MultiplexDatabaseNew(struct AdbcDatabase* database,
+                                    struct AdbcError* error) {
+  database->private_data = new MultiplexDatabase;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode MultiplexDatabaseSetOption(struct AdbcDatabase* database, const char* key,
+                                          const char* value, struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexDatabase*>(database->private_data);
+  const bool initialized = !private_data->shards.empty();
+  if (std::strcmp(key, kMultiplexThreadsOption) == 0 && !initialized) {
+    char* end = nullptr;
+    errno = 0;
+    const int64_t threads = std::strtoll(value, &end, 10);
+    if (errno != 0 || end == value || *end != '\0' || threads <= 0) {
+      SetError(error, std::string("[Multiplex] Invalid value for ") + key + ": " + value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    private_data->num_threads = threads;
+    return ADBC_STATUS_OK;
+  }
+
+  const size_t prefix_length = std::strlen(kMultiplexShardPrefix);
+  if (std::strncmp(key, kMultiplexShardPrefix, prefix_length) != 0) {
+    SetError(error, std::string("[Multiplex] Unknown database option ") + key + "=" +
+                        value);
+    return ADBC_STATUS_NOT_IMPLEMENTED;
+  }
+  // <index or *>.<key>
+  const char* shard = key + prefix_length;
+  const char* shard_key = std::strchr(shard, '.');
+  bool all = shard_key == shard + 1 && shard[0] == '*';
+  char* end = nullptr;
+  errno = 0;
+  const uint64_t index = all ? 0 : std::strtoull(shard, &end, 10);
+  if (!shard_key || shard_key[1] == '\0' ||
+      (!all && (errno != 0 || end != shard_key || !std::isdigit(shard[0]) ||
+                index >= kMaxMultiplexShards ||
+                (initialized && index >= private_data->shards.size())))) {
+    SetError(error, std::string("[Multiplex] Invalid database option ") + key +
+                        " (expected " + kMultiplexShardPrefix +
+                        "<shard index or *>.<key>)");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  shard_key++;
+
+  if (initialized) {
+    return ForEachShard(
+        nullptr, all ? private_data->shards.size() : 1,
+        [&](size_t i, struct AdbcError* shard_error) {
+          return AdbcDatabaseSetOption(&private_data->shards[all ? i : index], shard_key,
+                                       value, shard_error);
+        },
+        error);
+  }
+  if (all) {
+    private_data->common_options.emplace_back(shard_key, value);
+  } else {
+    if (private_data->shard_options.size() <= index) {
+      private_data->shard_options.resize(index + 1);
+    }
+    private_data->shard_options[index].emplace_back(shard_key, value);
+  }
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode MultiplexDatabaseRelease(struct AdbcDatabase* database,
+                                        struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexDatabase*>(database->private_data);
+  if (!private_data) return ADBC_STATUS_INVALID_STATE;
+  AdbcStatusCode status = ForEachShard(
+      nullptr, private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) -> AdbcStatusCode {
+        struct AdbcDatabase* shard = &private_data->shards[i];
+        if (!shard->private_data && !shard->private_driver) return ADBC_STATUS_OK;
+        return AdbcDatabaseRelease(shard, shard_error);
+      },
+      error);
+  delete private_data;
+  database->private_data = nullptr;
+  return status;
+}
+
+AdbcStatusCode MultiplexDatabaseInit(struct AdbcDatabase* database,
+                                     struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexDatabase*>(database->private_data);
+  const size_t num_shards = private_data->shard_options.size();
+  if (num_shards == 0) {
+    SetError(error, std::string("[Multiplex] Must set options of at least one shard (") +
+                        kMultiplexShardPrefix + "<shard index>.<key>)");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0; i < num_shards; i++) {
+    if (private_data->shard_options[i].empty()) {
+      SetError(error, "[Multiplex] No options set for shard " + std::to_string(i));
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+  }
+
+  private_data->pool.reset(new WorkerPool(private_data->num_threads > 0
+                                              ? private_data->num_threads
+                                              : num_shards));
+  std::vector<struct AdbcDatabase> shards(num_shards);
+  for (auto& shard : shards) std::memset(&shard, 0, sizeof(shard));
+  AdbcStatusCode status = ForEachShard(
+      private_data->pool.get(), num_shards,
+      [&](size_t i, struct AdbcError* shard_error) {
+        AdbcStatusCode status = AdbcDatabaseNew(&shards[i], shard_error);
+        if (status != ADBC_STATUS_OK) return status;
+        for (const auto& options :
+             {private_data->common_options, private_data->shard_options[i]}) {
+          for (const auto& option : options) {
+            status = AdbcDatabaseSetOption(&shards[i], option.first.c_str(),
+                                           option.second.c_str(), shard_error);
+            if (status != ADBC_STATUS_OK) return status;
+          }
+        }
+        return AdbcDatabaseInit(&shards[i], shard_error);
+      },
+      error);
+  if (status != ADBC_STATUS_OK) {
+    for (auto& shard : shards) {
+      if (shard.private_data || shard.private_driver) {
+        AdbcDatabaseRelease(&shard, nullptr);
+      }
+    }
+    return status;
+  }
+  private_data->shards = std::move(shards);
+  private_data->common_options.clear();
+  private_data->shard_options.clear();
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode MultiplexConnectionNew(struct AdbcConnection* connection,
                                       struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+  connection->private_data = new MultiplexConnection;
+  return ADBC_STATUS_OK;
 }
 
-AdbcStatusCode StatementGetOption(struct AdbcStatement* statement, const char* key,
-                                  char* value, size_t* length, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
+AdbcStatusCode MultiplexConnectionSetOption(struct AdbcConnection* connection,
+                                            const char* key, const char* value,
+                                            struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexConnection*>(connection->private_data);
+  if (!private_data->database) {
+    private_data->options.emplace_back(key, value);
+    return ADBC_STATUS_OK;
+  }
+  return ForEachShard(
+      nullptr, private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) {
+        return AdbcConnectionSetOption(&private_data->shards[i], key, value, shard_error);
+      },
+      error);
 }
 
-AdbcStatusCode StatementGetOptionBytes(struct AdbcStatement* statement, const char* key,
-                                       uint8_t* value, size_t* length,
+AdbcStatusCode MultiplexConnectionRelease(struct AdbcConnection* connection,
+                                          struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexConnection*>(connection->private_data);
+  if (!private_data) return ADBC_STATUS_INVALID_STATE;
+  AdbcStatusCode status = ForEachShard(
+      nullptr, private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) -> AdbcStatusCode {
+        struct AdbcConnection* shard = &private_data->shards[i];
+        if (!shard->private_data && !shard->private_driver) return ADBC_STATUS_OK;
+        return AdbcConnectionRelease(shard, shard_error);
+      },
+      error);
+  delete private_data;
+  connection->private_data = nullptr;
+  return status;
+}
+
+AdbcStatusCode MultiplexConnectionInit(struct AdbcConnection* connection,
+                                       struct AdbcDatabase* database,
                                        struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
+  auto* private_data = reinterpret_cast<MultiplexConnection*>(connection->private_data);
+  auto* database_data = reinterpret_cast<MultiplexDatabase*>(database->private_data);
+  const size_t num_shards = database_data->shards.size();
+  std::vector<struct AdbcConnection> shards(num_shards);
+  for (auto& shard : shards) std::memset(&shard, 0, sizeof(shard));
+  AdbcStatusCode status = ForEachShard(
+      database_data->pool.get(), num_shards,
+      [&](size_t i, struct AdbcError* shard_error) {
+        AdbcStatusCode status = AdbcConnectionNew(&shards[i], shard_error);
+        if (status != ADBC_STATUS_OK) return status;
+        for (const auto& option : private_data->options) {
+          status = AdbcConnectionSetOption(&shards[i], option.first.c_str(),
+                                           option.second.c_str(), shard_error);
+          if (status != ADBC_STATUS_OK) return status;
+        }
+        return AdbcConnectionInit(&shards[i], &database_data->shards[i], shard_error);
+      },
+      error);
+  if (status != ADBC_STATUS_OK) {
+    for (auto& shard : shards) {
+      if (shard.private_data || shard.private_driver) {
+        AdbcConnectionRelease(&shard, nullptr);
+      }
+    }
+    return status;
+  }
+  private_data->database = database_data;
+  private_data->shards = std::move(shards);
+  private_data->options.clear();
+  return ADBC_STATUS_OK;
 }
 
-AdbcStatusCode StatementGetOptionInt(struct AdbcStatement* statement, const char* key,
-                                     int64_t* value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
+AdbcStatusCode MultiplexConnectionCommit(struct AdbcConnection* connection,
+                                         struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexConnection*>(connection->private_data);
+  return ForEachShard(
+      private_data->database->pool.get(), private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) {
+        return AdbcConnectionCommit(&private_data->shards[i], shard_error);
+      },
+      error);
 }
 
-AdbcStatusCode StatementGetOptionDouble(struct AdbcStatement* statement, const char* key,
-                                        double* value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
+AdbcStatusCode MultiplexConnectionRollback(struct AdbcConnection* connection,
+                                           struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexConnection*>(connection->private_data);
+  return ForEachShard(
+      private_data->database->pool.get(), private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) {
+        return AdbcConnectionRollback(&private_data->shards[i], shard_error);
+      },
+      error);
 }
 
-AdbcStatusCode StatementGetParameterSchema(struct AdbcStatement* statement,
-                                           struct ArrowSchema* schema,
+AdbcStatusCode MultiplexStatementRelease(struct AdbcStatement* statement,
+                                         struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexStatement*>(statement->private_data);
+  if (!private_data) return ADBC_STATUS_INVALID_STATE;
+  AdbcStatusCode status = ForEachShard(
+      nullptr, private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) -> AdbcStatusCode {
+        struct AdbcStatement* shard = &private_data->shards[i];
+        if (!shard->private_data && !shard->private_driver) return ADBC_STATUS_OK;
+        return AdbcStatementRelease(shard, shard_error);
+      },
+      error);
+  delete private_data;
+  statement->private_data = nullptr;
+  return status;
+}
+
+AdbcStatusCode MultiplexStatementNew(struct AdbcConnection* connection,
+                                     struct AdbcStatement* statement,
+                                     struct AdbcError* error) {
+  auto* connection_data =
+      reinterpret_cast<MultiplexConnection*>(connection->private_data);
+  auto* private_data = new MultiplexStatement;
+  private_data->connection = connection_data;
+  private_data->shards.resize(connection_data->shards.size());
+  for (auto& shard : private_data->shards) std::memset(&shard, 0, sizeof(shard));
+  statement->private_data = private_data;
+  AdbcStatusCode status = ForEachShard(
+      nullptr, private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) {
+        return AdbcStatementNew(&connection_data->shards[i], &private_data->shards[i],
+                                shard_error);
+      },
+      error);
+  if (status != ADBC_STATUS_OK) MultiplexStatementRelease(statement, nullptr);
+  return status;
+}
+
+AdbcStatusCode MultiplexStatementSetSqlQuery(struct AdbcStatement* statement,
+                                             const char* query, struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexStatement*>(statement->private_data);
+  return ForEachShard(
+      nullptr, private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) {
+        return AdbcStatementSetSqlQuery(&private_data->shards[i], query, shard_error);
+      },
+      error);
+}
+
+AdbcStatusCode MultiplexStatementSetOption(struct AdbcStatement* statement,
+                                           const char* key, const char* value,
                                            struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+  auto* private_data = reinterpret_cast<MultiplexStatement*>(statement->private_data);
+  if (std::strcmp(key, kMultiplexOrderByOption) == 0) {
+    private_data->order_by = value;
+    return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, kMultiplexShardColumnOption) == 0) {
+    private_data->shard_column = value;
+    return ADBC_STATUS_OK;
+  }
+  return ForEachShard(
+      nullptr, private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) {
+        return AdbcStatementSetOption(&private_data->shards[i], key, value, shard_error);
+      },
+      error);
 }
 
-AdbcStatusCode StatementPrepare(struct AdbcStatement*, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+AdbcStatusCode MultiplexStatementSetOptionInt(struct AdbcStatement* statement,
+                                              const char* key, int64_t value,
+                                              struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexStatement*>(statement->private_data);
+  return ForEachShard(
+      nullptr, private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) {
+        return AdbcStatementSetOptionInt(&private_data->shards[i], key, value,
+                                         shard_error);
+      },
+      error);
 }
 
-AdbcStatusCode StatementSetOption(struct AdbcStatement*, const char*, const char*,
-                                  struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+AdbcStatusCode MultiplexStatementPrepare(struct AdbcStatement* statement,
+                                         struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexStatement*>(statement->private_data);
+  return ForEachShard(
+      private_data->connection->database->pool.get(), private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) {
+        return AdbcStatementPrepare(&private_data->shards[i], shard_error);
+      },
+      error);
+}
+
+AdbcStatusCode MultiplexStatementBind(struct AdbcStatement* statement,
+                                      struct ArrowArray* values,
+                                      struct ArrowSchema* schema,
+                                      struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexStatement*>(statement->private_data);
+  // Each shard gets a view of the parameters
+  std::shared_ptr<struct ArrowArray> shared = ShareArray(values);
+  AdbcStatusCode status = ForEachShard(
+      nullptr, private_data->shards.size(),
+      [&](size_t i, struct AdbcError* shard_error) {
+        struct ArrowSchema shard_schema;
+        struct ArrowArray shard_values;
+        SchemaDeepCopy(schema, &shard_schema);
+        SliceArray(shared, schema, shared.get(), 0, shared->length, &shard_values);
+        return AdbcStatementBind(&private_data->shards[i], &shard_values, &shard_schema,
+                                 shard_error);
+      },
+      error);
+  schema->release(schema);
+  return status;
+}
+
+/// Add a column to a schema made by SchemaDeepCopy.
+void AppendSchemaColumn(struct ArrowSchema* schema, const char* format,
+                        const std::string& name) {
+  struct ArrowSchema column = {};
+  column.format = format;
+  column.name = name.c_str();
+  auto* private_data = reinterpret_cast<CopiedSchema*>(schema->private_data);
+  private_data->children.emplace_back();
+  SchemaDeepCopy(&column, &private_data->children.back());
+  private_data->child_pointers.clear();
+  for (auto& child : private_data->children) {
+    private_data->child_pointers.push_back(&child);
+  }
+  schema->n_children = static_cast<int64_t>(private_data->children.size());
+  schema->children = private_data->child_pointers.data();
+}
+
+/// Add a non-nullable int32 column to an array made by SliceArray or
+/// ConcatenatePieces (with a value for each row, counting its offset).
+void AppendInt32Column(struct ArrowArray* array, const std::vector<int32_t>& values) {
+  auto* private_data = reinterpret_cast<RebatchedArray*>(array->private_data);
+  private_data->children.emplace_back();
+  struct ArrowArray* column = &private_data->children.back();
+  RebatchedArray* column_data = RebatchedArrayInit(column, 0);
+  const auto* bytes = reinterpret_cast<const uint8_t*>(values.data());
+  // Buffers may be empty, but not null
+  column_data->owned_buffers.emplace_back(1);
+  column_data->owned_buffers[0].assign(bytes, bytes + values.size() * sizeof(int32_t));
+  column_data->buffers = {nullptr, column_data->owned_buffers[0].data()};
+  SetBuffers(column_data, column);
+  column->length = static_cast<int64_t>(values.size());
+
+  private_data->child_pointers.clear();
+  for (auto& child : private_data->children) {
+    private_data->child_pointers.push_back(&child);
+  }
+  array->n_children = static_cast<int64_t>(private_data->children.size());
+  array->children = private_data->child_pointers.data();
+}
+
+/// Whether two schemas have the same types (ignoring names, metadata, and
+/// nullability).
+bool SameTypes(const struct ArrowSchema* a, const struct ArrowSchema* b) {
+  if (std::strcmp(a->format, b->format) != 0 || a->n_children != b->n_children ||
+      !a->dictionary != !b->dictionary) {
+    return false;
+  }
+  for (int64_t i = 0; i < a->n_children; i++) {
+    if (!SameTypes(a->children[i], b->children[i])) return false;
+  }
+  return !a->dictionary || SameTypes(a->dictionary, b->dictionary);
+}
+
+/// Compare the (non-null) values at two indices of two arrays of the same
+/// type: negative, 0, or positive if the first is less, equal, or greater.
+using CompareFunc = int (*)(const struct ArrowArray*, int64_t, const struct ArrowArray*,
+                            int64_t);
+
+template <typename T>
+int CompareFixedWidth(const struct ArrowArray* a, int64_t i, const struct ArrowArray* b,
+                      int64_t j) {
+  const T x = reinterpret_cast<const T*>(a->buffers[1])[i];
+  const T y = reinterpret_cast<const T*>(b->buffers[1])[j];
+  return (y < x) - (x < y);
+}
+
+template <typename OffsetType>
+int CompareBinary(const struct ArrowArray* a, int64_t i, const struct ArrowArray* b,
+                  int64_t j) {
+  const auto* a_offsets = reinterpret_cast<const OffsetType*>(a->buffers[1]);
+  const auto* b_offsets = reinterpret_cast<const OffsetType*>(b->buffers[1]);
+  const int64_t a_length = a_offsets[i + 1] - a_offsets[i];
+  const int64_t b_length = b_offsets[j + 1] - b_offsets[j];
+  const int result =
+      std::memcmp(reinterpret_cast<const uint8_t*>(a->buffers[2]) + a_offsets[i],
+                  reinterpret_cast<const uint8_t*>(b->buffers[2]) + b_offsets[j],
+                  static_cast<size_t>(std::min(a_length, b_length)));
+  if (result != 0) return result;
+  return (b_length < a_length) - (a_length < b_length);
+}
+
+/// Get the comparison for an ordering column, or nullptr if the type
+/// isn't supported.
+CompareFunc GetCompareFunc(const char* format) {
+  if (format[0] != '\0' && format[1] == '\0') {
+    switch (format[0]) {
+      case 'c':
+        return CompareFixedWidth<int8_t>;
+      case 'C':
+        return CompareFixedWidth<uint8_t>;
+      case 's':
+        return CompareFixedWidth<int16_t>;
+      case 'S':
+        return CompareFixedWidth<uint16_t>;
+      case 'i':
+        return CompareFixedWidth<int32_t>;
+      case 'I':
+        return CompareFixedWidth<uint32_t>;
+      case 'l':
+        return CompareFixedWidth<int64_t>;
+      case 'L':
+        return CompareFixedWidth<uint64_t>;
+      case 'f':
+        return CompareFixedWidth<float>;
+      case 'g':
+        return CompareFixedWidth<double>;
+      case 'u':
+      case 'z':
+        return CompareBinary<int32_t>;
+      case 'U':
+      case 'Z':
+        return CompareBinary<int64_t>;
+      default:
+        return nullptr;
+    }
+  }
+  // Dates, times, timestamps, and durations (not intervals)
+  if (format[0] != 't' || format[1] == 'i') return nullptr;
+  switch (FixedWidthBytes(format)) {
+    case 4:
+      return CompareFixedWidth<int32_t>;
+    case 8:
+      return CompareFixedWidth<int64_t>;
+    default:
+      return nullptr;
+  }
 }
 
-AdbcStatusCode StatementSetOptionBytes(struct AdbcStatement*, const char*, const uint8_t*,
-                                       size_t, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
-}
+/// The result stream of the multiplex driver.  The shards' streams are
+/// read ahead concurrently (see Readahead).  Their batches are returned
+/// in turn, or if ordering by a column, merged: runs of rows are taken
+/// from whichever shard is next in order, and copied into batches (of up
+/// to the largest size the shards returned) if all columns are of flat
+/// types, or returned as they are otherwise.
+class MultiplexReader {
+ public:
+  MultiplexReader(std::vector<struct ArrowArrayStream> streams, std::string order_by,
+                  std::string shard_column)
+      : streams_(std::move(streams)),
+        order_by_(std::move(order_by)),
+        shard_column_(std::move(shard_column)),
+        heads_(streams_.size()) {
+    for (auto& stream : streams_) {
+      readaheads_.emplace_back(new Readahead(&stream, /*max_batches=*/2,
+                                             /*max_bytes=*/0));
+    }
+    for (size_t i = 0; i < streams_.size(); i++) active_.push_back(i);
+  }
+
+  ~MultiplexReader() {
+    heads_.clear();
+    readaheads_.clear();
+    for (auto& stream : streams_) stream.release(&stream);
+    if (schema_.release) schema_.release(&schema_);
+    if (shard_schema_.release) shard_schema_.release(&shard_schema_);
+  }
+
+  int GetSchema(struct ArrowSchema* out) {
+    const int status = Init();
+    if (status != 0) return status;
+    try {
+      SchemaDeepCopy(&schema_, out);
+    } catch (const std::bad_alloc&) {
+      if (out->release) out->release(out);
+      return ENOMEM;
+    }
+    return 0;
+  }
+
+  int GetNext(struct ArrowArray* out) {
+    const int status = Init();
+    if (status != 0) return status;
+    try {
+      return order_by_.empty() ? GetNextInTurn(out) : GetNextInOrder(out);
+    } catch (const std::bad_alloc&) {
+      return ENOMEM;
+    }
+  }
+
+  const char* GetLastError() {
+    return last_error_.empty() ? nullptr : last_error_.c_str();
+  }
+
+ private:
+  /// The next unread row of a shard.
+  struct Head {
+    std::shared_ptr<struct ArrowArray> batch;
+    int64_t position = 0;
+    bool done = false;
+  };
+
+  int Error(int status, const std::string& message) {
+    last_error_ = "[Multiplex] " + message;
+    return status;
+  }
+
+  int ShardError(size_t shard, int status) {
+    const char* message = readaheads_[shard]->GetLastError();
+    return Error(status, "Shard " + std::to_string(shard) + ": " +
+                             (message ? message : std::strerror(status)));
+  }
+
+  /// Get and check the schemas of the shards (once).
+  int Init() {
+    if (init_status_ >= 0) return init_status_;
+    init_status_ = 0;
+    for (size_t i = 0; i < readaheads_.size() && init_status_ == 0; i++) {
+      struct ArrowSchema schema = {};
+      int status = readaheads_[i]->GetSchema(&schema);
+      if (status != 0) {
+        init_status_ = ShardError(i, status);
+      } else if (i == 0) {
+        shard_schema_ = schema;
+        schema.release = nullptr;
+      } else if (!SameTypes(&shard_schema_, &schema)) {
+        init_status_ = Error(EINVAL, "Shard " + std::to_string(i) +
+                                         " returned different types than shard 0");
+      }
+      if (schema.release) schema.release(&schema);
+    }
+    if (init_status_ != 0) return init_status_;
+
+    SchemaDeepCopy(&shard_schema_, &schema_);
+    if (!shard_column_.empty()) AppendSchemaColumn(&schema_, "i", shard_column_);
+    can_concatenate_ = std::strcmp(shard_schema_.format, "+s") == 0;
+    for (int64_t i = 0; i < shard_schema_.n_children; i++) {
+      can_concatenate_ = can_concatenate_ && CanConcatenate(shard_schema_.children[i]);
+      const char* name = shard_schema_.children[i]->name;
+      if (name && order_by_ == name) {
+        order_column_ = i;
+      }
+    }
+    if (!order_by_.empty()) {
+      if (order_column_ < 0) {
+        init_status_ = Error(EINVAL, "No column named " + order_by_ + " to order by");
+      } else if (!(compare_ = GetCompareFunc(
+                       shard_schema_.children[order_column_]->format))) {
+        init_status_ =
+            Error(EINVAL, "Can't order by column " + order_by_ + " of type " +
+                              shard_schema_.children[order_column_]->format);
+      }
+    }
+    return init_status_;
+  }
+
+  /// Return the next batch of the next shard that has one.
+  int GetNextInTurn(struct ArrowArray* out) {
+    while (!active_.empty()) {
+      cursor_ %= active_.size();
+      const size_t shard = active_[cursor_];
+      struct ArrowArray array = {};
+      const int status = readaheads_[shard]->GetNext(&array);
+      if (status != 0) return ShardError(shard, status);
+      if (!array.release) {
+        active_.erase(active_.begin() + cursor_);
+        continue;
+      }
+      cursor_++;
+      if (shard_column_.empty()) {
+        *out = array;
+        return 0;
+      }
+      std::shared_ptr<struct ArrowArray> batch = ShareArray(&array);
+      SliceArray(batch, &shard_schema_, batch.get(), 0, batch->length, out);
+      AppendInt32Column(out, std::vector<int32_t>(out->offset + out->length,
+                                                  static_cast<int32_t>(shard)));
+      return 0;
+    }
+    std::memset(out, 0, sizeof(*out));
+    return 0;
+  }
+
+  /// Make sure the head of a shard has a row, unless the shard is done.
+  int Fill(size_t shard) {
+    Head& head = heads_[shard];
+    while (!head.done && (!head.batch || head.position == head.batch->length)) {
+      head.batch.reset();
+      head.position = 0;
+      struct ArrowArray array = {};
+      const int status = readaheads_[shard]->GetNext(&array);
+      if (status != 0) return ShardError(shard, status);
+      if (!array.release) {
+        head.done = true;
+      } else {
+        batch_rows_ = std::max(batch_rows_, array.length);
+        head.batch = ShareArray(&array);
+      }
+    }
+    return 0;
+  }
+
+  /// Compare the row of a shard's current batch at an index with the
+  /// head of another shard (nulls first).
+  int Compare(size_t shard, int64_t position, size_t other) const {
+    const struct ArrowArray* a = heads_[shard].batch.get();
+    const struct ArrowArray* b = heads_[other].batch.get();
+    const struct ArrowArray* a_column = a->children[order_column_];
+    const struct ArrowArray* b_column = b->children[order_column_];
+    const int64_t i = a->offset + a_column->offset + position;
+    const int64_t j = b->offset + b_column->offset + heads_[other].position;
+    const bool a_null = a_column->null_count != 0 && a_column->buffers[0] &&
+                        !GetBit(a_column->buffers[0], i);
+    const bool b_null = b_column->null_count != 0 && b_column->buffers[0] &&
+                        !GetBit(b_column->buffers[0], j);
+    if (a_null || b_null) return b_null - a_null;
+    return compare_(a_column, i, b_column, j);
+  }
+
+  /// Whether a shard's row at an index comes before the head of another.
+  bool Before(size_t shard, int64_t position, size_t other) const {
+    const int result = Compare(shard, position, other);
+    return result < 0 || (result == 0 && shard < other);
+  }
+
+  /// Merge the next rows of the shards into a batch.
+  int GetNextInOrder(struct ArrowArray* out) {
+    std::vector<RebatchPiece> pieces;
+    std::vector<size_t> piece_shards;
+    int64_t length = 0;
+    while (status_ == 0 && (length == 0 || (can_concatenate_ && length < batch_rows_))) {
+      // Find the shard with the first row, and the one after it
+      size_t first = heads_.size();
+      size_t second = heads_.size();
+      for (size_t i = 0; i < heads_.size() && status_ == 0; i++) {
+        status_ = Fill(i);
+        if (status_ != 0 || heads_[i].done) continue;
+        if (first == heads_.size() || Before(i, heads_[i].position, first)) {
+          second = first;
+          first = i;
+        } else if (second == heads_.size() || Before(i, heads_[i].position, second)) {
+          second = i;
+        }
+      }
+      if (status_ != 0 || first == heads_.size()) break;
+
+      // Take the rows of the first shard that come before the second's
+      Head& head = heads_[first];
+      const int64_t limit = std::min(head.batch->length - head.position,
+                                     std::max<int64_t>(1, batch_rows_ - length));
+      int64_t run = 1;
+      while (run < limit &&
+             (second == heads_.size() || Before(first, head.position + run, second))) {
+        run++;
+      }
+      pieces.push_back({head.batch, head.position, run});
+      piece_shards.push_back(first);
+      head.position += run;
+      length += run;
+    }
+
+    // If an error occurs, the rows before it are returned first
+    if (pieces.empty()) {
+      if (status_ != 0) return status_;
+      std::memset(out, 0, sizeof(*out));
+      return 0;
+    }
+    if (pieces.size() == 1) {
+      const RebatchPiece& piece = pieces[0];
+      SliceArray(piece.batch, &shard_schema_, piece.batch.get(), piece.offset,
+                 piece.length, out);
+    } else if (!ConcatenatePieces(&shard_schema_, pieces, length, out)) {
+      return Error(EOVERFLOW, "Merged batch is too large");
+    }
+    if (!shard_column_.empty()) {
+      std::vector<int32_t> shards(out->offset, 0);
+      for (size_t i = 0; i < pieces.size(); i++) {
+        shards.insert(shards.end(), pieces[i].length,
+                      static_cast<int32_t>(piece_shards[i]));
+      }
+      AppendInt32Column(out, shards);
+    }
+    return 0;
+  }
+
+  std::vector<struct ArrowArrayStream> streams_;
+  std::vector<std::unique_ptr<Readahead>> readaheads_;
+  const std::string order_by_;
+  const std::string shard_column_;
+
+  // The status of Init (-1 if not yet called)
+  int init_status_ = -1;
+  // The schema of the shards' result sets, and that of the stream
+  struct ArrowSchema shard_schema_ = {};
+  struct ArrowSchema schema_ = {};
+  bool can_concatenate_ = false;
+  std::string last_error_;
+
+  // Without ordering, the shards not yet done and the one to read next
+  std::vector<size_t> active_;
+  size_t cursor_ = 0;
+
+  // With ordering
+  int64_t order_column_ = -1;
+  CompareFunc compare_ = nullptr;
+  std::vector<Head> heads_;
+  int64_t batch_rows_ = 1;
+  int status_ = 0;
+};
 
-AdbcStatusCode StatementSetOptionInt(struct AdbcStatement* statement, const char* key,
-                                     int64_t value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+void MultiplexStreamRelease(struct ArrowArrayStream* stream) {
+  delete reinterpret_cast<MultiplexReader*>(stream->private_data);
+  std::memset(stream, 0, sizeof(*stream));
 }
 
-AdbcStatusCode StatementSetOptionDouble(struct AdbcStatement* statement, const char* key,
-                                        double value, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+int MultiplexStreamGetNext(struct ArrowArrayStream* stream, struct ArrowArray* out) {
+  return reinterpret_cast<MultiplexReader*>(stream->private_data)->GetNext(out);
 }
 
-AdbcStatusCode StatementSetSqlQuery(struct AdbcStatement*, const char*,
-                                    struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+int MultiplexStreamGetSchema(struct ArrowArrayStream* stream, struct ArrowSchema* out) {
+  return reinterpret_cast<MultiplexReader*>(stream->private_data)->GetSchema(out);
 }
 
-AdbcStatusCode StatementSetSubstraitPlan(struct AdbcStatement*, const uint8_t*, size_t,
-                                         struct AdbcError* error) {
-  return ADBC_STATUS_NOT_IMPLEMENTED;
+const char* MultiplexStreamGetLastError(struct ArrowArrayStream* stream) {
+  return reinterpret_cast<MultiplexReader*>(stream->private_data)->GetLastError();
 }
 
-/// Temporary state while the database is being configured.
-struct TempDatabase {
-  std::unordered_map<std::string, std::string> options;
-  std::unordered_map<std::string, std::string> bytes_options;
-  std::unordered_map<std::string, int64_t> int_options;
-  std::unordered_map<std::string, double> double_options;
-  std::string driver;
-  std::string entrypoint;
-  AdbcDriverInitFunc init_func = nullptr;
-};
+AdbcStatusCode MultiplexStatementExecuteQuery(struct AdbcStatement* statement,
+                                              struct ArrowArrayStream* out,
+                                              int64_t* rows_affected,
+                                              struct AdbcError* error) {
+  auto* private_data = reinterpret_cast<MultiplexStatement*>(statement->private_data);
+  const size_t num_shards = private_data->shards.size();
+  std::vector<struct ArrowArrayStream> streams(num_shards);
+  for (auto& stream : streams) std::memset(&stream, 0, sizeof(stream));
+  std::vector<int64_t> shard_rows_affected(num_shards, -1);
+  AdbcStatusCode status = ForEachShard(
+      private_data->connection->database->pool.get(), num_shards,
+      [&](size_t i, struct AdbcError* shard_error) {
+        return AdbcStatementExecuteQuery(&private_data->shards[i],
+                                         out ? &streams[i] : nullptr,
+                                         &shard_rows_affected[i], shard_error);
+      },
+      error);
+  if (status != ADBC_STATUS_OK) {
+    for (auto& stream : streams) {
+      if (stream.release) stream.release(&stream);
+    }
+    return status;
+  }
 
-/// Temporary state while the database is being configured.
-struct TempConnection {
-  std::unordered_map<std::string, std::string> options;
-  std::unordered_map<std::string, std::string> bytes_options;
-  std::unordered_map<std::string, int64_t> int_options;
-  std::unordered_map<std::string, double> double_options;
-};
+  if (rows_affected) {
+    *rows_affected = 0;
+    for (const int64_t rows : shard_rows_affected) {
+      *rows_affected = rows < 0 || *rows_affected < 0 ? -1 : *rows_affected + rows;
+    }
+  }
+  if (out) {
+    out->private_data = new MultiplexReader(std::move(streams), private_data->order_by,
+                                            private_data->shard_column);
+    out->get_next = MultiplexStreamGetNext;
+    out->get_schema = MultiplexStreamGetSchema;
+    out->get_last_error = MultiplexStreamGetLastError;
+    out->release = MultiplexStreamRelease;
+  }
+  return ADBC_STATUS_OK;
+}
 
-static const char kDefaultEntrypoint[] = "AdbcDriverInit";
+// Asynchronous execution (see AdbcDriverManagerStatementExecuteQueryAsync)
+
+/// The threads that run asynchronous executions, shared by all drivers.
+WorkerPool& AsyncPool() {
+  // Leaked so that executions may still be finishing during static
+  // destruction
+  static WorkerPool* pool = new WorkerPool(
+      std::max<size_t>(kMinAsyncThreads, std::thread::hardware_concurrency()));
+  return *pool;
+}
 }  // namespace
 
 // Other helpers (intentionally not in an anonymous namespace so they can be tested)
@@ -625,6 +3649,96 @@ std::string AdbcDriverManagerDefaultEntrypoint(const std::string& driver) {
   return entrypoint;
 }
 
+/// Whether a query only reads, as far as can be told without parsing it
+/// (for the result cache).  It must be a single statement starting with
+/// SELECT, WITH, or VALUES, and not contain keywords that write or lock
+/// (as in data-modifying CTEs, SELECT INTO, or FOR UPDATE/SHARE) or call
+/// sequence functions.  Quoted text and comments are skipped.  This errs
+/// on the side of refusing queries, but can't know of every function
+/// with side effects.
+ADBC_EXPORT
+bool AdbcDriverManagerIsReadOnlyQuery(const char* query) {
+  // Keywords, upper-cased, with quoted strings and identifiers as "'"
+  std::vector<std::string> words;
+  bool ended = false;
+  const char* p = query;
+  while (*p) {
+    const unsigned char c = static_cast<unsigned char>(*p);
+    if (std::isspace(c)) {
+      p++;
+      continue;
+    } else if (c == '-' && p[1] == '-') {
+      while (*p && *p != '\n') p++;
+      continue;
+    } else if (c == '/' && p[1] == '*') {
+      p = std::strstr(p + 2, "*/");
+      if (!p) return false;
+      p += 2;
+      continue;
+    }
+    if (ended) return false;
+
+    if (c == '\'' || c == '"' || c == '`') {
+      // Doubled quotes just end and start a quoted word again
+      p = std::strchr(p + 1, c);
+      if (!p) return false;
+      p++;
+      words.emplace_back("'");
+    } else if (c == '$' && (std::isalpha(static_cast<unsigned char>(p[1])) ||
+                            p[1] == '_' || p[1] == '$')) {
+      // PostgreSQL dollar quoting, $tag$...$tag$
+      const char* tag_end = std::strchr(p + 1, '$');
+      if (!tag_end) return false;
+      const std::string tag(p, tag_end + 1);
+      p = std::strstr(tag_end + 1, tag.c_str());
+      if (!p) return false;
+      p += tag.size();
+      words.emplace_back("'");
+    } else if (std::isalnum(c) || c == '_') {
+      std::string word;
+      while (std::isalnum(static_cast<unsigned char>(*p)) || *p == '_' || *p == '$') {
+        word.push_back(
+            static_cast<char>(std::toupper(static_cast<unsigned char>(*p))));
+        p++;
+      }
+      words.push_back(std::move(word));
+    } else {
+      ended = c == ';';
+      p++;
+    }
+  }
+
+  if (words.empty() ||
+      (words[0] != "SELECT" && words[0] != "WITH" && words[0] != "VALUES")) {
+    return false;
+  }
+  static const char* kRefused[] = {
+      // Writes
+      "INSERT", "UPDATE", "DELETE", "MERGE", "UPSERT", "INTO", "CREATE", "DROP", "ALTER",
+      "TRUNCATE", "GRANT", "REVOKE", "CALL", "EXEC", "EXECUTE", "COPY",
+      // Locks
+      "LOCK",
+      // Sequences
+      "NEXTVAL", "SETVAL", "LASTVAL", "CURRVAL"};
+  for (size_t i = 0; i < words.size(); i++) {
+    for (const char* refused : kRefused) {
+      if (words[i] == refused) return false;
+    }
+    if (i + 1 < words.size()) {
+      // FOR SHARE, FOR KEY SHARE, NEXT VALUE FOR (FOR UPDATE is caught above)
+      if (words[i] == "FOR" && (words[i + 1] == "SHARE" || words[i + 1] == "KEY")) {
+        return false;
+      }
+      if (words[i] == "NEXT" && words[i + 1] == "VALUE") return false;
+    }
+  }
+  return true;
+}
+
+/// The number of driver DLLs in the cache of AdbcLoadDriver.
+ADBC_EXPORT
+size_t AdbcDriverManagerCachedDriverCount() { return DriverCache::Get().Size(); }
+
 // Direct implementations of API methods
 
 int AdbcErrorGetDetailCount(const struct AdbcError* error) {
@@ -649,8 +3763,12 @@ const struct AdbcError* AdbcErrorFromArrayStream(struct ArrowArrayStream* stream
     return nullptr;
   }
   auto* private_data = reinterpret_cast<struct ErrorArrayStream*>(stream->private_data);
-  auto* error =
-      private_data->private_driver->ErrorFromArrayStream(&private_data->stream, status);
+  if (private_data->cached || !private_data->memory_error.empty()) return nullptr;
+  const struct AdbcError* error =
+      private_data->readahead
+          ? private_data->readahead->GetError(private_data->private_driver, status)
+          : private_data->private_driver->ErrorFromArrayStream(&private_data->stream,
+                                                               status);
   if (error) {
     const_cast<struct AdbcError*>(error)->private_driver = private_data->private_driver;
   }
@@ -663,13 +3781,16 @@ const struct AdbcError* AdbcErrorFromArrayStream(struct ArrowArrayStream* stream
     (ERROR)->private_driver = (SOURCE)->private_driver;              \
   }
 
-#define WRAP_STREAM(EXPR, OUT, SOURCE)                   \
-  if (!(OUT)) {                                          \
-    /* Happens for ExecuteQuery where out is optional */ \
-    return EXPR;                                         \
-  }                                                      \
-  AdbcStatusCode status_code = EXPR;                     \
-  ErrorArrayStreamInit(OUT, (SOURCE)->private_driver);   \
+#define TRACE_CALL(SOURCE) TraceSpan trace_span((SOURCE)->private_driver, __func__)
+
+#define WRAP_STREAM(EXPR, OUT, SOURCE)                            \
+  if (!(OUT)) {                                                   \
+    /* Happens for ExecuteQuery where out is optional */          \
+    return trace_span.Finish(EXPR);                               \
+  }                                                               \
+  AdbcStatusCode status_code = trace_span.Finish(EXPR);           \
+  ErrorArrayStreamInit(OUT, (SOURCE)->private_driver, trace_span, \
+                       GetStreamOptions(SOURCE));                 \
   return status_code;
 
 AdbcStatusCode AdbcDatabaseNew(struct AdbcDatabase* database, struct AdbcError* error) {
@@ -684,8 +3805,9 @@ AdbcStatusCode AdbcDatabaseGetOption(struct AdbcDatabase* database, const char*
                                      struct AdbcError* error) {
   if (database->private_driver) {
     INIT_ERROR(error, database);
-    return database->private_driver->DatabaseGetOption(database, key, value, length,
-                                                       error);
+    TRACE_CALL(database);
+    return trace_span.Finish(
+        database->private_driver->DatabaseGetOption(database, key, value, length, error));
   }
   const auto* args = reinterpret_cast<const TempDatabase*>(database->private_data);
   const std::string* result = nullptr;
@@ -714,8 +3836,9 @@ AdbcStatusCode AdbcDatabaseGetOptionBytes(struct AdbcDatabase* database, const c
                                           struct AdbcError* error) {
   if (database->private_driver) {
     INIT_ERROR(error, database);
-    return database->private_driver->DatabaseGetOptionBytes(database, key, value, length,
-                                                            error);
+    TRACE_CALL(database);
+    return trace_span.Finish(database->private_driver->DatabaseGetOptionBytes(
+        database, key, value, length, error));
   }
   const auto* args = reinterpret_cast<const TempDatabase*>(database->private_data);
   const auto it = args->bytes_options.find(key);
@@ -736,7 +3859,12 @@ AdbcStatusCode AdbcDatabaseGetOptionInt(struct AdbcDatabase* database, const cha
                                         int64_t* value, struct AdbcError* error) {
   if (database->private_driver) {
     INIT_ERROR(error, database);
-    return database->private_driver->DatabaseGetOptionInt(database, key, value, error);
+    TRACE_CALL(database);
+    if (GetMemoryCounter(GetMemoryAccount(database->private_driver), key, value)) {
+      return trace_span.Finish(ADBC_STATUS_OK);
+    }
+    return trace_span.Finish(
+        database->private_driver->DatabaseGetOptionInt(database, key, value, error));
   }
   const auto* args = reinterpret_cast<const TempDatabase*>(database->private_data);
   const auto it = args->int_options.find(key);
@@ -751,7 +3879,9 @@ AdbcStatusCode AdbcDatabaseGetOptionDouble(struct AdbcDatabase* database, const
                                            double* value, struct AdbcError* error) {
   if (database->private_driver) {
     INIT_ERROR(error, database);
-    return database->private_driver->DatabaseGetOptionDouble(database, key, value, error);
+    TRACE_CALL(database);
+    return trace_span.Finish(
+        database->private_driver->DatabaseGetOptionDouble(database, key, value, error));
   }
   const auto* args = reinterpret_cast<const TempDatabase*>(database->private_data);
   const auto it = args->double_options.find(key);
@@ -766,7 +3896,9 @@ AdbcStatusCode AdbcDatabaseSetOption(struct AdbcDatabase* database, const char*
                                      const char* value, struct AdbcError* error) {
   if (database->private_driver) {
     INIT_ERROR(error, database);
-    return database->private_driver->DatabaseSetOption(database, key, value, error);
+    TRACE_CALL(database);
+    return trace_span.Finish(
+        database->private_driver->DatabaseSetOption(database, key, value, error));
   }
 
   TempDatabase* args = reinterpret_cast<TempDatabase*>(database->private_data);
@@ -774,6 +3906,48 @@ AdbcStatusCode AdbcDatabaseSetOption(struct AdbcDatabase* database, const char*
     args->driver = value;
   } else if (std::strcmp(key, "entrypoint") == 0) {
     args->entrypoint = value;
+  } else if (std::strcmp(key, kTraceOption) == 0) {
+    args->trace_path = value;
+  } else if (std::strcmp(key, kResultCacheTtlOption) == 0) {
+    char* end = nullptr;
+    errno = 0;
+    const int64_t parsed = std::strtoll(value, &end, 10);
+    if (errno != 0 || end == value || *end != '\0') {
+      SetError(error, std::string("[DriverManager] Invalid value for ") +
+                          kResultCacheTtlOption + ": " + value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return SetResultCacheTtl(args, parsed, error);
+  } else if (std::strcmp(key, kMemoryLimitOption) == 0) {
+    char* end = nullptr;
+    errno = 0;
+    const int64_t parsed = std::strtoll(value, &end, 10);
+    if (errno != 0 || end == value || *end != '\0') {
+      SetError(error, std::string("[DriverManager] Invalid value for ") +
+                          kMemoryLimitOption + ": " + value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return SetMemoryLimit(args, parsed, error);
+  } else if (std::strcmp(key, kMemoryAccountingOption) == 0) {
+    if (std::strcmp(value, ADBC_OPTION_VALUE_ENABLED) == 0) {
+      args->memory_accounting = true;
+    } else if (std::strcmp(value, ADBC_OPTION_VALUE_DISABLED) == 0) {
+      args->memory_accounting = false;
+    } else {
+      SetError(error, std::string("[DriverManager] Invalid value for ") +
+                          kMemoryAccountingOption + ": " + value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+  } else if (std::strcmp(key, kStreamMetricsOption) == 0) {
+    if (std::strcmp(value, ADBC_OPTION_VALUE_ENABLED) == 0) {
+      args->stream_metrics = true;
+    } else if (std::strcmp(value, ADBC_OPTION_VALUE_DISABLED) == 0) {
+      args->stream_metrics = false;
+    } else {
+      SetError(error, std::string("[DriverManager] Invalid value for ") +
+                          kStreamMetricsOption + ": " + value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
   } else {
     args->options[key] = value;
   }
@@ -785,8 +3959,9 @@ AdbcStatusCode AdbcDatabaseSetOptionBytes(struct AdbcDatabase* database, const c
                                           struct AdbcError* error) {
   if (database->private_driver) {
     INIT_ERROR(error, database);
-    return database->private_driver->DatabaseSetOptionBytes(database, key, value, length,
-                                                            error);
+    TRACE_CALL(database);
+    return trace_span.Finish(database->private_driver->DatabaseSetOptionBytes(
+        database, key, value, length, error));
   }
 
   TempDatabase* args = reinterpret_cast<TempDatabase*>(database->private_data);
@@ -798,10 +3973,17 @@ AdbcStatusCode AdbcDatabaseSetOptionInt(struct AdbcDatabase* database, const cha
                                         int64_t value, struct AdbcError* error) {
   if (database->private_driver) {
     INIT_ERROR(error, database);
-    return database->private_driver->DatabaseSetOptionInt(database, key, value, error);
+    TRACE_CALL(database);
+    return trace_span.Finish(
+        database->private_driver->DatabaseSetOptionInt(database, key, value, error));
   }
 
   TempDatabase* args = reinterpret_cast<TempDatabase*>(database->private_data);
+  if (std::strcmp(key, kResultCacheTtlOption) == 0) {
+    return SetResultCacheTtl(args, value, error);
+  } else if (std::strcmp(key, kMemoryLimitOption) == 0) {
+    return SetMemoryLimit(args, value, error);
+  }
   args->int_options[key] = value;
   return ADBC_STATUS_OK;
 }
@@ -810,7 +3992,9 @@ AdbcStatusCode AdbcDatabaseSetOptionDouble(struct AdbcDatabase* database, const
                                            double value, struct AdbcError* error) {
   if (database->private_driver) {
     INIT_ERROR(error, database);
-    return database->private_driver->DatabaseSetOptionDouble(database, key, value, error);
+    TRACE_CALL(database);
+    return trace_span.Finish(
+        database->private_driver->DatabaseSetOptionDouble(database, key, value, error));
   }
 
   TempDatabase* args = reinterpret_cast<TempDatabase*>(database->private_data);
@@ -858,6 +4042,25 @@ AdbcStatusCode AdbcDatabaseInit(struct AdbcDatabase* database, struct AdbcError*
     status = AdbcLoadDriver(args->driver.c_str(), nullptr, ADBC_VERSION_1_1_0,
                             database->private_driver, error);
   }
+  if (status == ADBC_STATUS_OK) {
+    ManagerDriverState* state = InitManagerState(database->private_driver);
+    state->stream_metrics = args->stream_metrics;
+    if (args->memory_accounting || args->memory_limit > 0) {
+      state->memory =
+          std::make_shared<MemoryAccount>("database", nullptr, args->memory_limit);
+    }
+    if (args->result_cache_ttl_ms > 0) {
+      constexpr int64_t kMaxTtlMs = std::numeric_limits<int64_t>::max() / 1000000;
+      state->result_cache_ttl_ns =
+          std::min(args->result_cache_ttl_ms, kMaxTtlMs) * 1000000;
+      state->result_cache_database = ResultCacheDatabaseKey();
+    }
+    const char* trace_path = std::getenv(kTraceEnvVar);
+    if (!args->trace_path.empty()) trace_path = args->trace_path.c_str();
+    if (trace_path && *trace_path) {
+      status = Tracer::Open(trace_path, &state->tracer, error);
+    }
+  }
   if (status != ADBC_STATUS_OK) {
     // Restore private_data so it will be released by AdbcDatabaseRelease
     database->private_data = args;
@@ -884,6 +4087,7 @@ AdbcStatusCode AdbcDatabaseInit(struct AdbcDatabase* database, struct AdbcError*
   delete args;
 
   INIT_ERROR(error, database);
+  TRACE_CALL(database);
   for (const auto& option : options) {
     status = database->private_driver->DatabaseSetOption(database, option.first.c_str(),
                                                          option.second.c_str(), error);
@@ -920,7 +4124,7 @@ AdbcStatusCode AdbcDatabaseInit(struct AdbcDatabase* database, struct AdbcError*
     database->private_data = nullptr;
     return status;
   }
-  return database->private_driver->DatabaseInit(database, error);
+  return trace_span.Finish(database->private_driver->DatabaseInit(database, error));
 }
 
 AdbcStatusCode AdbcDatabaseRelease(struct AdbcDatabase* database,
@@ -935,7 +4139,16 @@ AdbcStatusCode AdbcDatabaseRelease(struct AdbcDatabase* database,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, database);
-  auto status = database->private_driver->DatabaseRelease(database, error);
+  TRACE_CALL(database);
+  auto status =
+      trace_span.Finish(database->private_driver->DatabaseRelease(database, error));
+  if (trace_span.tracer()) trace_span.tracer()->Flush();
+  if (const auto* state = reinterpret_cast<const ManagerDriverState*>(
+          database->private_driver->private_manager)) {
+    if (state->result_cache_ttl_ns > 0) {
+      ResultCache::Get().EraseDatabase(state->result_cache_database);
+    }
+  }
   if (database->private_driver->release) {
     database->private_driver->release(database->private_driver, error);
   }
@@ -951,7 +4164,9 @@ AdbcStatusCode AdbcConnectionCancel(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionCancel(connection, error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(
+      connection->private_driver->ConnectionCancel(connection, error));
 }
 
 AdbcStatusCode AdbcConnectionCommit(struct AdbcConnection* connection,
@@ -960,7 +4175,9 @@ AdbcStatusCode AdbcConnectionCommit(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionCommit(connection, error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(
+      connection->private_driver->ConnectionCommit(connection, error));
 }
 
 AdbcStatusCode AdbcConnectionGetInfo(struct AdbcConnection* connection,
@@ -971,6 +4188,7 @@ AdbcStatusCode AdbcConnectionGetInfo(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
+  TRACE_CALL(connection);
   WRAP_STREAM(connection->private_driver->ConnectionGetInfo(
                   connection, info_codes, info_codes_length, out, error),
               out, connection);
@@ -986,6 +4204,7 @@ AdbcStatusCode AdbcConnectionGetObjects(struct AdbcConnection* connection, int d
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
+  TRACE_CALL(connection);
   WRAP_STREAM(connection->private_driver->ConnectionGetObjects(
                   connection, depth, catalog, db_schema, table_name, table_types,
                   column_name, stream, error),
@@ -1002,19 +4221,22 @@ AdbcStatusCode AdbcConnectionGetOption(struct AdbcConnection* connection, const
   if (!connection->private_driver) {
     // Init not yet called, get the saved option
     const auto* args = reinterpret_cast<const TempConnection*>(connection->private_data);
-    const auto it = args->options.find(key);
-    if (it == args->options.end()) {
+    const std::string* result =
+        FindTempOption(*args, args->options, OptionProfile::Type::kString, key,
+                       &OptionProfile::Option::value);
+    if (!result) {
       return ADBC_STATUS_NOT_FOUND;
     }
-    if (*length >= it->second.size() + 1) {
-      std::memcpy(value, it->second.c_str(), it->second.size() + 1);
+    if (*length >= result->size() + 1) {
+      std::memcpy(value, result->c_str(), result->size() + 1);
     }
-    *length = it->second.size() + 1;
+    *length = result->size() + 1;
     return ADBC_STATUS_OK;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionGetOption(connection, key, value, length,
-                                                         error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(connection->private_driver->ConnectionGetOption(
+      connection, key, value, length, error));
 }
 
 AdbcStatusCode AdbcConnectionGetOptionBytes(struct AdbcConnection* connection,
@@ -1027,19 +4249,22 @@ AdbcStatusCode AdbcConnectionGetOptionBytes(struct AdbcConnection* connection,
   if (!connection->private_driver) {
     // Init not yet called, get the saved option
     const auto* args = reinterpret_cast<const TempConnection*>(connection->private_data);
-    const auto it = args->bytes_options.find(key);
-    if (it == args->options.end()) {
+    const std::string* result =
+        FindTempOption(*args, args->bytes_options, OptionProfile::Type::kBytes, key,
+                       &OptionProfile::Option::value);
+    if (!result) {
       return ADBC_STATUS_NOT_FOUND;
     }
-    if (*length >= it->second.size() + 1) {
-      std::memcpy(value, it->second.data(), it->second.size() + 1);
+    if (*length >= result->size() + 1) {
+      std::memcpy(value, result->data(), result->size() + 1);
     }
-    *length = it->second.size() + 1;
+    *length = result->size() + 1;
     return ADBC_STATUS_OK;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionGetOptionBytes(connection, key, value,
-                                                              length, error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(connection->private_driver->ConnectionGetOptionBytes(
+      connection, key, value, length, error));
 }
 
 AdbcStatusCode AdbcConnectionGetOptionInt(struct AdbcConnection* connection,
@@ -1052,16 +4277,22 @@ AdbcStatusCode AdbcConnectionGetOptionInt(struct AdbcConnection* connection,
   if (!connection->private_driver) {
     // Init not yet called, get the saved option
     const auto* args = reinterpret_cast<const TempConnection*>(connection->private_data);
-    const auto it = args->int_options.find(key);
-    if (it == args->int_options.end()) {
+    const int64_t* result =
+        FindTempOption(*args, args->int_options, OptionProfile::Type::kInt, key,
+                       &OptionProfile::Option::int_value);
+    if (!result) {
       return ADBC_STATUS_NOT_FOUND;
     }
-    *value = it->second;
+    *value = *result;
     return ADBC_STATUS_OK;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionGetOptionInt(connection, key, value,
-                                                            error);
+  TRACE_CALL(connection);
+  if (GetMemoryCounter(GetStreamOptions(connection).memory.get(), key, value)) {
+    return trace_span.Finish(ADBC_STATUS_OK);
+  }
+  return trace_span.Finish(
+      connection->private_driver->ConnectionGetOptionInt(connection, key, value, error));
 }
 
 AdbcStatusCode AdbcConnectionGetOptionDouble(struct AdbcConnection* connection,
@@ -1074,16 +4305,19 @@ AdbcStatusCode AdbcConnectionGetOptionDouble(struct AdbcConnection* connection,
   if (!connection->private_driver) {
     // Init not yet called, get the saved option
     const auto* args = reinterpret_cast<const TempConnection*>(connection->private_data);
-    const auto it = args->double_options.find(key);
-    if (it == args->double_options.end()) {
+    const double* result =
+        FindTempOption(*args, args->double_options, OptionProfile::Type::kDouble, key,
+                       &OptionProfile::Option::double_value);
+    if (!result) {
       return ADBC_STATUS_NOT_FOUND;
     }
-    *value = it->second;
+    *value = *result;
     return ADBC_STATUS_OK;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionGetOptionDouble(connection, key, value,
-                                                               error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(connection->private_driver->ConnectionGetOptionDouble(
+      connection, key, value, error));
 }
 
 AdbcStatusCode AdbcConnectionGetStatistics(struct AdbcConnection* connection,
@@ -1095,6 +4329,7 @@ AdbcStatusCode AdbcConnectionGetStatistics(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
+  TRACE_CALL(connection);
   WRAP_STREAM(
       connection->private_driver->ConnectionGetStatistics(
           connection, catalog, db_schema, table_name, approximate == 1, out, error),
@@ -1108,6 +4343,7 @@ AdbcStatusCode AdbcConnectionGetStatisticNames(struct AdbcConnection* connection
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
+  TRACE_CALL(connection);
   WRAP_STREAM(
       connection->private_driver->ConnectionGetStatisticNames(connection, out, error),
       out, connection);
@@ -1122,8 +4358,9 @@ AdbcStatusCode AdbcConnectionGetTableSchema(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionGetTableSchema(
-      connection, catalog, db_schema, table_name, schema, error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(connection->private_driver->ConnectionGetTableSchema(
+      connection, catalog, db_schema, table_name, schema, error));
 }
 
 AdbcStatusCode AdbcConnectionGetTableTypes(struct AdbcConnection* connection,
@@ -1133,6 +4370,7 @@ AdbcStatusCode AdbcConnectionGetTableTypes(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
+  TRACE_CALL(connection);
   WRAP_STREAM(
       connection->private_driver->ConnectionGetTableTypes(connection, stream, error),
       stream, connection);
@@ -1150,6 +4388,7 @@ AdbcStatusCode AdbcConnectionInit(struct AdbcConnection* connection,
   }
   TempConnection* args = reinterpret_cast<TempConnection*>(connection->private_data);
   connection->private_data = nullptr;
+  std::shared_ptr<const OptionProfile> profile = std::move(args->profile);
   std::unordered_map<std::string, std::string> options = std::move(args->options);
   std::unordered_map<std::string, std::string> bytes_options =
       std::move(args->bytes_options);
@@ -1161,7 +4400,41 @@ AdbcStatusCode AdbcConnectionInit(struct AdbcConnection* connection,
   auto status = database->private_driver->ConnectionNew(connection, error);
   if (status != ADBC_STATUS_OK) return status;
   connection->private_driver = database->private_driver;
+  if (auto* state = reinterpret_cast<ManagerDriverState*>(
+          database->private_driver->private_manager)) {
+    if (state->memory) {
+      std::lock_guard<std::mutex> lock(state->connection_mutex);
+      state->connection_memory[connection] =
+          std::make_shared<MemoryAccount>("connection", state->memory, 0);
+    }
+  }
 
+  if (profile) {
+    // Leave out the options the connection overrides
+    const bool overridden = !options.empty() || !bytes_options.empty() ||
+                            !int_options.empty() || !double_options.empty();
+    auto skip = [&](const OptionProfile::Option& option) {
+      if (!overridden) return false;
+      switch (option.type) {
+        case OptionProfile::Type::kString:
+          return options.count(option.key) > 0;
+        case OptionProfile::Type::kBytes:
+          return bytes_options.count(option.key) > 0;
+        case OptionProfile::Type::kInt:
+          return int_options.count(option.key) > 0;
+        case OptionProfile::Type::kDouble:
+          return double_options.count(option.key) > 0;
+      }
+      return false;
+    };
+    status = SetProfileOptions(*profile, connection,
+                               database->private_driver->ConnectionSetOption,
+                               database->private_driver->ConnectionSetOptionBytes,
+                               database->private_driver->ConnectionSetOptionInt,
+                               database->private_driver->ConnectionSetOptionDouble,
+                               skip, error);
+    if (status != ADBC_STATUS_OK) return status;
+  }
   for (const auto& option : options) {
     status = database->private_driver->ConnectionSetOption(
         connection, option.first.c_str(), option.second.c_str(), error);
@@ -1185,7 +4458,15 @@ AdbcStatusCode AdbcConnectionInit(struct AdbcConnection* connection,
     if (status != ADBC_STATUS_OK) return status;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionInit(connection, database, error);
+  TRACE_CALL(connection);
+  status = trace_span.Finish(
+      connection->private_driver->ConnectionInit(connection, database, error));
+  if (status == ADBC_STATUS_OK) {
+    for (const auto& option : options) {
+      UpdateResultCacheConnection(connection, option.first.c_str(), option.second);
+    }
+  }
+  return status;
 }
 
 AdbcStatusCode AdbcConnectionNew(struct AdbcConnection* connection,
@@ -1207,6 +4488,7 @@ AdbcStatusCode AdbcConnectionReadPartition(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
+  TRACE_CALL(connection);
   WRAP_STREAM(connection->private_driver->ConnectionReadPartition(
                   connection, serialized_partition, serialized_length, out, error),
               out, connection);
@@ -1224,7 +4506,15 @@ AdbcStatusCode AdbcConnectionRelease(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
-  auto status = connection->private_driver->ConnectionRelease(connection, error);
+  TRACE_CALL(connection);
+  auto status = trace_span.Finish(
+      connection->private_driver->ConnectionRelease(connection, error));
+  if (auto* state = reinterpret_cast<ManagerDriverState*>(
+          connection->private_driver->private_manager)) {
+    std::lock_guard<std::mutex> lock(state->connection_mutex);
+    state->connection_memory.erase(connection);
+    state->connection_options.erase(connection);
+  }
   connection->private_driver = nullptr;
   return status;
 }
@@ -1235,7 +4525,9 @@ AdbcStatusCode AdbcConnectionRollback(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionRollback(connection, error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(
+      connection->private_driver->ConnectionRollback(connection, error));
 }
 
 AdbcStatusCode AdbcConnectionSetOption(struct AdbcConnection* connection, const char* key,
@@ -1251,7 +4543,11 @@ AdbcStatusCode AdbcConnectionSetOption(struct AdbcConnection* connection, const
     return ADBC_STATUS_OK;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionSetOption(connection, key, value, error);
+  TRACE_CALL(connection);
+  auto status = trace_span.Finish(
+      connection->private_driver->ConnectionSetOption(connection, key, value, error));
+  if (status == ADBC_STATUS_OK) UpdateResultCacheConnection(connection, key, value);
+  return status;
 }
 
 AdbcStatusCode AdbcConnectionSetOptionBytes(struct AdbcConnection* connection,
@@ -1268,8 +4564,9 @@ AdbcStatusCode AdbcConnectionSetOptionBytes(struct AdbcConnection* connection,
     return ADBC_STATUS_OK;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionSetOptionBytes(connection, key, value,
-                                                              length, error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(connection->private_driver->ConnectionSetOptionBytes(
+      connection, key, value, length, error));
 }
 
 AdbcStatusCode AdbcConnectionSetOptionInt(struct AdbcConnection* connection,
@@ -1286,8 +4583,9 @@ AdbcStatusCode AdbcConnectionSetOptionInt(struct AdbcConnection* connection,
     return ADBC_STATUS_OK;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionSetOptionInt(connection, key, value,
-                                                            error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(
+      connection->private_driver->ConnectionSetOptionInt(connection, key, value, error));
 }
 
 AdbcStatusCode AdbcConnectionSetOptionDouble(struct AdbcConnection* connection,
@@ -1304,8 +4602,9 @@ AdbcStatusCode AdbcConnectionSetOptionDouble(struct AdbcConnection* connection,
     return ADBC_STATUS_OK;
   }
   INIT_ERROR(error, connection);
-  return connection->private_driver->ConnectionSetOptionDouble(connection, key, value,
-                                                               error);
+  TRACE_CALL(connection);
+  return trace_span.Finish(connection->private_driver->ConnectionSetOptionDouble(
+      connection, key, value, error));
 }
 
 AdbcStatusCode AdbcStatementBind(struct AdbcStatement* statement,
@@ -1315,7 +4614,14 @@ AdbcStatusCode AdbcStatementBind(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementBind(statement, values, schema, error);
+  TRACE_CALL(statement);
+  UpdateResultCacheKey(statement, [&](ManagerStatementOptions* options) {
+    options->cache_parameters.clear();
+    options->cache_parameters_unknown =
+        !SerializeParameters(schema, values, &options->cache_parameters);
+  });
+  return trace_span.Finish(
+      statement->private_driver->StatementBind(statement, values, schema, error));
 }
 
 AdbcStatusCode AdbcStatementBindStream(struct AdbcStatement* statement,
@@ -1325,7 +4631,13 @@ AdbcStatusCode AdbcStatementBindStream(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementBindStream(statement, stream, error);
+  TRACE_CALL(statement);
+  UpdateResultCacheKey(statement, [](ManagerStatementOptions* options) {
+    options->cache_parameters.clear();
+    options->cache_parameters_unknown = true;
+  });
+  return trace_span.Finish(
+      statement->private_driver->StatementBindStream(statement, stream, error));
 }
 
 AdbcStatusCode AdbcStatementCancel(struct AdbcStatement* statement,
@@ -1334,7 +4646,8 @@ AdbcStatusCode AdbcStatementCancel(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementCancel(statement, error);
+  TRACE_CALL(statement);
+  return trace_span.Finish(statement->private_driver->StatementCancel(statement, error));
 }
 
 // XXX: cpplint gets confused here if declared as 'struct ArrowSchema* schema'
@@ -1347,8 +4660,9 @@ AdbcStatusCode AdbcStatementExecutePartitions(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementExecutePartitions(
-      statement, schema, partitions, rows_affected, error);
+  TRACE_CALL(statement);
+  return trace_span.Finish(statement->private_driver->StatementExecutePartitions(
+      statement, schema, partitions, rows_affected, error));
 }
 
 AdbcStatusCode AdbcStatementExecuteQuery(struct AdbcStatement* statement,
@@ -1359,9 +4673,39 @@ AdbcStatusCode AdbcStatementExecuteQuery(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  WRAP_STREAM(statement->private_driver->StatementExecuteQuery(statement, out,
-                                                               rows_affected, error),
-              out, statement);
+  TRACE_CALL(statement);
+  if (!out) {
+    return trace_span.Finish(statement->private_driver->StatementExecuteQuery(
+        statement, out, rows_affected, error));
+  }
+
+  const ManagerStatementOptions options = GetStreamOptions(statement);
+  const std::string cache_key = ResultCacheKey(statement, options);
+  std::shared_ptr<const CachedResult> cached;
+  if (!cache_key.empty()) {
+    const auto* state = reinterpret_cast<const ManagerDriverState*>(
+        statement->private_driver->private_manager);
+    cached = ResultCache::Get().Lookup(cache_key, state->result_cache_ttl_ns);
+  }
+  AdbcStatusCode status_code;
+  if (cached) {
+    std::memset(out, 0, sizeof(*out));
+    if (rows_affected) *rows_affected = -1;
+    status_code = trace_span.Finish(ADBC_STATUS_OK);
+  } else {
+    status_code = trace_span.Finish(statement->private_driver->StatementExecuteQuery(
+        statement, out, rows_affected, error));
+  }
+  ErrorArrayStreamInit(out, statement->private_driver, trace_span, options,
+                       std::move(cached), status_code == ADBC_STATUS_OK ? cache_key : "");
+  if (!options.cache_parameters.empty()) {
+    // Drivers may consume the parameters; don't assume they're still bound
+    UpdateResultCacheKey(statement, [](ManagerStatementOptions* updated) {
+      updated->cache_parameters.clear();
+      updated->cache_parameters_unknown = true;
+    });
+  }
+  return status_code;
 }
 
 AdbcStatusCode AdbcStatementExecuteSchema(struct AdbcStatement* statement,
@@ -1371,7 +4715,9 @@ AdbcStatusCode AdbcStatementExecuteSchema(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementExecuteSchema(statement, schema, error);
+  TRACE_CALL(statement);
+  return trace_span.Finish(
+      statement->private_driver->StatementExecuteSchema(statement, schema, error));
 }
 
 AdbcStatusCode AdbcStatementGetOption(struct AdbcStatement* statement, const char* key,
@@ -1381,8 +4727,21 @@ AdbcStatusCode AdbcStatementGetOption(struct AdbcStatement* statement, const cha
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementGetOption(statement, key, value, length,
-                                                       error);
+  TRACE_CALL(statement);
+  if (IsManagerStatementOption(key) || std::strcmp(key, kResultCacheEnabledOption) == 0) {
+    const std::string result =
+        IsManagerStatementOption(key)
+            ? std::to_string(GetManagerStatementOption(statement, key))
+            : (GetStreamOptions(statement).cache_enabled ? ADBC_OPTION_VALUE_ENABLED
+                                                         : ADBC_OPTION_VALUE_DISABLED);
+    if (*length >= result.size() + 1) {
+      std::memcpy(value, result.c_str(), result.size() + 1);
+    }
+    *length = result.size() + 1;
+    return trace_span.Finish(ADBC_STATUS_OK);
+  }
+  return trace_span.Finish(statement->private_driver->StatementGetOption(
+      statement, key, value, length, error));
 }
 
 AdbcStatusCode AdbcStatementGetOptionBytes(struct AdbcStatement* statement,
@@ -1392,8 +4751,9 @@ AdbcStatusCode AdbcStatementGetOptionBytes(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementGetOptionBytes(statement, key, value, length,
-                                                            error);
+  TRACE_CALL(statement);
+  return trace_span.Finish(statement->private_driver->StatementGetOptionBytes(
+      statement, key, value, length, error));
 }
 
 AdbcStatusCode AdbcStatementGetOptionInt(struct AdbcStatement* statement, const char* key,
@@ -1402,7 +4762,15 @@ AdbcStatusCode AdbcStatementGetOptionInt(struct AdbcStatement* statement, const
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementGetOptionInt(statement, key, value, error);
+  TRACE_CALL(statement);
+  if (GetMemoryCounter(GetStreamOptions(statement).memory.get(), key, value)) {
+    return trace_span.Finish(ADBC_STATUS_OK);
+  } else if (IsManagerStatementOption(key)) {
+    *value = GetManagerStatementOption(statement, key);
+    return trace_span.Finish(ADBC_STATUS_OK);
+  }
+  return trace_span.Finish(
+      statement->private_driver->StatementGetOptionInt(statement, key, value, error));
 }
 
 AdbcStatusCode AdbcStatementGetOptionDouble(struct AdbcStatement* statement,
@@ -1412,8 +4780,9 @@ AdbcStatusCode AdbcStatementGetOptionDouble(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementGetOptionDouble(statement, key, value,
-                                                             error);
+  TRACE_CALL(statement);
+  return trace_span.Finish(
+      statement->private_driver->StatementGetOptionDouble(statement, key, value, error));
 }
 
 AdbcStatusCode AdbcStatementGetParameterSchema(struct AdbcStatement* statement,
@@ -1423,7 +4792,9 @@ AdbcStatusCode AdbcStatementGetParameterSchema(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementGetParameterSchema(statement, schema, error);
+  TRACE_CALL(statement);
+  return trace_span.Finish(
+      statement->private_driver->StatementGetParameterSchema(statement, schema, error));
 }
 
 AdbcStatusCode AdbcStatementNew(struct AdbcConnection* connection,
@@ -1433,8 +4804,23 @@ AdbcStatusCode AdbcStatementNew(struct AdbcConnection* connection,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, connection);
-  auto status = connection->private_driver->StatementNew(connection, statement, error);
+  TRACE_CALL(connection);
+  auto status = trace_span.Finish(
+      connection->private_driver->StatementNew(connection, statement, error));
   statement->private_driver = connection->private_driver;
+  if (status == ADBC_STATUS_OK) {
+    UpdateResultCacheKey(statement, [connection](ManagerStatementOptions* options) {
+      options->connection = connection;
+    });
+    std::shared_ptr<MemoryAccount> parent = GetStreamOptions(connection).memory;
+    if (parent) {
+      auto* state = reinterpret_cast<ManagerDriverState*>(
+          connection->private_driver->private_manager);
+      std::lock_guard<std::mutex> lock(state->statement_mutex);
+      state->statement_options[statement].memory =
+          std::make_shared<MemoryAccount>("statement", std::move(parent), 0);
+    }
+  }
   return status;
 }
 
@@ -1444,7 +4830,8 @@ AdbcStatusCode AdbcStatementPrepare(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementPrepare(statement, error);
+  TRACE_CALL(statement);
+  return trace_span.Finish(statement->private_driver->StatementPrepare(statement, error));
 }
 
 AdbcStatusCode AdbcStatementRelease(struct AdbcStatement* statement,
@@ -1453,7 +4840,14 @@ AdbcStatusCode AdbcStatementRelease(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  auto status = statement->private_driver->StatementRelease(statement, error);
+  TRACE_CALL(statement);
+  auto status = trace_span.Finish(
+      statement->private_driver->StatementRelease(statement, error));
+  if (auto* state = reinterpret_cast<ManagerDriverState*>(
+          statement->private_driver->private_manager)) {
+    std::lock_guard<std::mutex> lock(state->statement_mutex);
+    state->statement_options.erase(statement);
+  }
   statement->private_driver = nullptr;
   return status;
 }
@@ -1464,7 +4858,20 @@ AdbcStatusCode AdbcStatementSetOption(struct AdbcStatement* statement, const cha
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementSetOption(statement, key, value, error);
+  TRACE_CALL(statement);
+  if (IsManagerStatementOption(key)) {
+    return trace_span.Finish(SetManagerStatementOption(statement, key, value, error));
+  }
+  if (std::strcmp(key, kResultCacheEnabledOption) == 0) {
+    return trace_span.Finish(SetResultCacheEnabled(statement, value, error));
+  }
+  if (std::strcmp(key, ADBC_INGEST_OPTION_TARGET_TABLE) == 0) {
+    UpdateResultCacheKey(statement, [](ManagerStatementOptions* options) {
+      options->cache_query.clear();
+    });
+  }
+  return trace_span.Finish(
+      statement->private_driver->StatementSetOption(statement, key, value, error));
 }
 
 AdbcStatusCode AdbcStatementSetOptionBytes(struct AdbcStatement* statement,
@@ -1474,8 +4881,9 @@ AdbcStatusCode AdbcStatementSetOptionBytes(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementSetOptionBytes(statement, key, value, length,
-                                                            error);
+  TRACE_CALL(statement);
+  return trace_span.Finish(statement->private_driver->StatementSetOptionBytes(
+      statement, key, value, length, error));
 }
 
 AdbcStatusCode AdbcStatementSetOptionInt(struct AdbcStatement* statement, const char* key,
@@ -1484,7 +4892,12 @@ AdbcStatusCode AdbcStatementSetOptionInt(struct AdbcStatement* statement, const
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementSetOptionInt(statement, key, value, error);
+  TRACE_CALL(statement);
+  if (IsManagerStatementOption(key)) {
+    return trace_span.Finish(SetManagerStatementOption(statement, key, value, error));
+  }
+  return trace_span.Finish(
+      statement->private_driver->StatementSetOptionInt(statement, key, value, error));
 }
 
 AdbcStatusCode AdbcStatementSetOptionDouble(struct AdbcStatement* statement,
@@ -1494,8 +4907,9 @@ AdbcStatusCode AdbcStatementSetOptionDouble(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementSetOptionDouble(statement, key, value,
-                                                             error);
+  TRACE_CALL(statement);
+  return trace_span.Finish(
+      statement->private_driver->StatementSetOptionDouble(statement, key, value, error));
 }
 
 AdbcStatusCode AdbcStatementSetSqlQuery(struct AdbcStatement* statement,
@@ -1504,7 +4918,12 @@ AdbcStatusCode AdbcStatementSetSqlQuery(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementSetSqlQuery(statement, query, error);
+  TRACE_CALL(statement);
+  UpdateResultCacheKey(statement, [query](ManagerStatementOptions* options) {
+    options->cache_query = AdbcDriverManagerIsReadOnlyQuery(query) ? query : "";
+  });
+  return trace_span.Finish(
+      statement->private_driver->StatementSetSqlQuery(statement, query, error));
 }
 
 AdbcStatusCode AdbcStatementSetSubstraitPlan(struct AdbcStatement* statement,
@@ -1514,8 +4933,12 @@ AdbcStatusCode AdbcStatementSetSubstraitPlan(struct AdbcStatement* statement,
     return ADBC_STATUS_INVALID_STATE;
   }
   INIT_ERROR(error, statement);
-  return statement->private_driver->StatementSetSubstraitPlan(statement, plan, length,
-                                                              error);
+  TRACE_CALL(statement);
+  UpdateResultCacheKey(statement, [](ManagerStatementOptions* options) {
+    options->cache_query.clear();
+  });
+  return trace_span.Finish(statement->private_driver->StatementSetSubstraitPlan(
+      statement, plan, length, error));
 }
 
 const char* AdbcStatusCodeMessage(AdbcStatusCode code) {
@@ -1545,11 +4968,410 @@ const char* AdbcStatusCodeMessage(AdbcStatusCode code) {
 #undef CASE
 }
 
+// Driver cache
+
+AdbcStatusCode DriverCache::Acquire(const char* driver_name, const char* entrypoint,
+                                    int version, struct AdbcDriver* driver,
+                                    CachedDriver** out, bool* initialized,
+                                    struct AdbcError* error) {
+  std::string alias = driver_name;
+  alias += '\0';
+  if (entrypoint) alias += entrypoint;
+  alias += '\0';
+  alias += std::to_string(version);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto alias_it = aliases_.find(alias);
+  if (alias_it == aliases_.end()) {
+    ManagedLibrary handle;
+    AdbcStatusCode status = handle.Load(driver_name, error);
+    if (status != ADBC_STATUS_OK) return status;
+
+    void* load_handle = nullptr;
+    std::string entrypoint_name;
+    if (entrypoint) {
+      entrypoint_name = entrypoint;
+      status = handle.Lookup(entrypoint, &load_handle, error);
+    } else {
+      entrypoint_name = AdbcDriverManagerDefaultEntrypoint(driver_name);
+      status = handle.Lookup(entrypoint_name.c_str(), &load_handle, error);
+      if (status != ADBC_STATUS_OK) {
+        entrypoint_name = kDefaultEntrypoint;
+        status = handle.Lookup(kDefaultEntrypoint, &load_handle, error);
+      }
+    }
+    if (status != ADBC_STATUS_OK) {
+      // Not cached, so don't keep the DLL either
+      handle.Unload();
+      return status;
+    }
+
+    std::string key = handle.Path(load_handle, driver_name);
+    key += '\0';
+    key += entrypoint_name;
+    key += '\0';
+    key += std::to_string(version);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      auto entry = std::make_unique<CachedDriver>();
+      entry->handle = std::move(handle);
+      entry->init_func = reinterpret_cast<AdbcDriverInitFunc>(load_handle);
+      it = entries_.emplace(std::move(key), std::move(entry)).first;
+    } else {
+      // Already loaded under another name; drop the reference just taken
+      handle.Unload();
+    }
+    alias_it = aliases_.emplace(std::move(alias), it->second.get()).first;
+  }
+
+  CachedDriver* entry = alias_it->second;
+  entry->refcount++;
+  *initialized = entry->has_driver;
+  if (entry->has_driver) {
+    std::memcpy(driver, &entry->driver, DriverSize(version));
+  }
+  *out = entry;
+  return ADBC_STATUS_OK;
+}
+
+void DriverCache::Store(CachedDriver* entry, int version,
+                        const struct AdbcDriver* driver) {
+  if (driver->private_data) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entry->has_driver) return;
+  std::memcpy(&entry->driver, driver, DriverSize(version));
+  entry->has_driver = true;
+}
+
+void DriverCache::Unref(CachedDriver* entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entry->refcount--;
+}
+
+size_t DriverCache::Unload() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = aliases_.begin(); it != aliases_.end();) {
+    if (it->second->refcount > 0) {
+      ++it;
+    } else {
+      it = aliases_.erase(it);
+    }
+  }
+  size_t in_use = 0;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second->refcount > 0) {
+      in_use++;
+      ++it;
+      continue;
+    }
+    it->second->handle.Unload();
+    it = entries_.erase(it);
+  }
+  return in_use;
+}
+
+size_t DriverCache::Size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+AdbcStatusCode AdbcDriverManagerUnloadDrivers(struct AdbcError* error) {
+  // Cached results may have been allocated by the drivers
+  ResultCache::Get().Clear();
+  size_t in_use = DriverCache::Get().Unload();
+  if (in_use > 0) {
+    SetError(error, "[DriverManager] " + std::to_string(in_use) +
+                        " driver(s) still in use and not unloaded");
+    return ADBC_STATUS_INVALID_STATE;
+  }
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode AdbcDriverManagerMultiplexInit(int version, void* raw_driver,
+                                              struct AdbcError* error) {
+  if (version != ADBC_VERSION_1_0_0 && version != ADBC_VERSION_1_1_0) {
+    return ADBC_STATUS_NOT_IMPLEMENTED;
+  }
+  auto* driver = reinterpret_cast<struct AdbcDriver*>(raw_driver);
+  std::memset(driver, 0,
+              version == ADBC_VERSION_1_1_0 ? ADBC_DRIVER_1_1_0_SIZE
+                                            : ADBC_DRIVER_1_0_0_SIZE);
+  driver->DatabaseNew = MultiplexDatabaseNew;
+  driver->DatabaseSetOption = MultiplexDatabaseSetOption;
+  driver->DatabaseInit = MultiplexDatabaseInit;
+  driver->DatabaseRelease = MultiplexDatabaseRelease;
+  driver->ConnectionNew = MultiplexConnectionNew;
+  driver->ConnectionSetOption = MultiplexConnectionSetOption;
+  driver->ConnectionInit = MultiplexConnectionInit;
+  driver->ConnectionRelease = MultiplexConnectionRelease;
+  driver->ConnectionCommit = MultiplexConnectionCommit;
+  driver->ConnectionRollback = MultiplexConnectionRollback;
+  driver->StatementNew = MultiplexStatementNew;
+  driver->StatementSetSqlQuery = MultiplexStatementSetSqlQuery;
+  driver->StatementSetOption = MultiplexStatementSetOption;
+  driver->StatementPrepare = MultiplexStatementPrepare;
+  driver->StatementBind = MultiplexStatementBind;
+  driver->StatementExecuteQuery = MultiplexStatementExecuteQuery;
+  driver->StatementRelease = MultiplexStatementRelease;
+  if (version == ADBC_VERSION_1_1_0) {
+    driver->StatementSetOptionInt = MultiplexStatementSetOptionInt;
+  }
+  return ADBC_STATUS_OK;
+}
+
+struct AdbcDriverManagerOptionProfile {
+  std::shared_ptr<OptionProfile> profile;
+};
+
+AdbcStatusCode AdbcDriverManagerOptionProfileNew(
+    struct AdbcDriverManagerOptionProfile** profile, struct AdbcError* error) {
+  if (!profile) {
+    SetError(error, "[DriverManager] Must provide non-NULL profile");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  *profile = new AdbcDriverManagerOptionProfile{std::make_shared<OptionProfile>()};
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode AdbcDriverManagerOptionProfileSetOption(
+    struct AdbcDriverManagerOptionProfile* profile, const char* key, const char* value,
+    struct AdbcError* error) {
+  return profile->profile->Set({OptionProfile::Type::kString, key, value}, error);
+}
+
+AdbcStatusCode AdbcDriverManagerOptionProfileSetOptionBytes(
+    struct AdbcDriverManagerOptionProfile* profile, const char* key,
+    const uint8_t* value, size_t length, struct AdbcError* error) {
+  return profile->profile->Set(
+      {OptionProfile::Type::kBytes, key,
+       std::string(reinterpret_cast<const char*>(value), length)},
+      error);
+}
+
+AdbcStatusCode AdbcDriverManagerOptionProfileSetOptionInt(
+    struct AdbcDriverManagerOptionProfile* profile, const char* key, int64_t value,
+    struct AdbcError* error) {
+  return profile->profile->Set({OptionProfile::Type::kInt, key, "", value}, error);
+}
+
+AdbcStatusCode AdbcDriverManagerOptionProfileSetOptionDouble(
+    struct AdbcDriverManagerOptionProfile* profile, const char* key, double value,
+    struct AdbcError* error) {
+  return profile->profile->Set({OptionProfile::Type::kDouble, key, "", 0, value},
+                               error);
+}
+
+AdbcStatusCode AdbcDriverManagerOptionProfileRelease(
+    struct AdbcDriverManagerOptionProfile* profile, struct AdbcError* error) {
+  delete profile;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode AdbcDriverManagerDatabaseSetOptionProfile(
+    struct AdbcDatabase* database, const struct AdbcDriverManagerOptionProfile* profile,
+    struct AdbcError* error) {
+  if (!database->private_data) {
+    SetError(error, "[DriverManager] Must call AdbcDatabaseNew first");
+    return ADBC_STATUS_INVALID_STATE;
+  }
+  profile->profile->frozen.store(true);
+  return SetProfileOptions(
+      *profile->profile, database, AdbcDatabaseSetOption, AdbcDatabaseSetOptionBytes,
+      AdbcDatabaseSetOptionInt, AdbcDatabaseSetOptionDouble,
+      [](const OptionProfile::Option&) { return false; }, error);
+}
+
+AdbcStatusCode AdbcDriverManagerConnectionSetOptionProfile(
+    struct AdbcConnection* connection,
+    const struct AdbcDriverManagerOptionProfile* profile, struct AdbcError* error) {
+  if (!connection->private_data) {
+    SetError(error, "[DriverManager] Must call AdbcConnectionNew first");
+    return ADBC_STATUS_INVALID_STATE;
+  }
+  profile->profile->frozen.store(true);
+  if (connection->private_driver) {
+    return SetProfileOptions(
+        *profile->profile, connection, AdbcConnectionSetOption,
+        AdbcConnectionSetOptionBytes, AdbcConnectionSetOptionInt,
+        AdbcConnectionSetOptionDouble,
+        [](const OptionProfile::Option&) { return false; }, error);
+  }
+  auto* args = reinterpret_cast<TempConnection*>(connection->private_data);
+  args->profile = profile->profile;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode AdbcDriverManagerSetResultCacheSize(int64_t max_bytes,
+                                                  struct AdbcError* error) {
+  if (max_bytes < 0) {
+    SetError(error, "[DriverManager] Result cache size must be non-negative, not " +
+                        std::to_string(max_bytes));
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  ResultCache::Get().SetCapacity(max_bytes);
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode AdbcDriverManagerGetStreamMetrics(
+    struct ArrowArrayStream* stream, struct AdbcDriverManagerStreamMetrics* metrics,
+    struct AdbcError* error) {
+  if (!stream || !metrics) {
+    SetError(error, "[DriverManager] Must provide non-NULL stream and metrics");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  const auto* private_data = reinterpret_cast<const ErrorArrayStream*>(
+      stream->release == ErrorArrayStreamRelease ? stream->private_data : nullptr);
+  if (!private_data || !private_data->collect_metrics) {
+    SetError(error, std::string("[DriverManager] Stream metrics are not collected for "
+                                "this stream (set ") +
+                        kStreamMetricsOption + " on the database)");
+    return ADBC_STATUS_INVALID_STATE;
+  }
+  *metrics = private_data->metrics;
+  return ADBC_STATUS_OK;
+}
+
+struct AdbcDriverManagerAsyncExecution {
+  struct AdbcStatement* statement = nullptr;
+  struct ArrowArrayStream* out = nullptr;
+  int64_t* rows_affected = nullptr;
+  AdbcDriverManagerAsyncCallback callback = nullptr;
+  void* user_data = nullptr;
+
+  // The result, once done
+  AdbcStatusCode status = ADBC_STATUS_OK;
+  struct AdbcError error = {};
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done = false;
+  // If requested, a pipe whose read end becomes readable once done
+  int fds[2] = {-1, -1};
+
+  void Run() {
+    status = AdbcStatementExecuteQuery(statement, out, rows_affected, &error);
+    if (callback) callback(this, status, user_data);
+    // Notify with the lock held, since the execution may be released as
+    // soon as it is unlocked
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+#if !defined(_WIN32)
+    if (fds[1] >= 0) std::ignore = write(fds[1], "", 1);
+#endif  // !defined(_WIN32)
+    cv.notify_all();
+  }
+};
+
+AdbcStatusCode AdbcDriverManagerStatementExecuteQueryAsync(
+    struct AdbcStatement* statement, struct ArrowArrayStream* out, int64_t* rows_affected,
+    AdbcDriverManagerAsyncCallback callback, void* user_data,
+    struct AdbcDriverManagerAsyncExecution** execution, struct AdbcError* error) {
+  if (!statement || !execution) {
+    SetError(error, "[DriverManager] Must provide non-NULL statement and execution");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  } else if (!statement->private_driver) {
+    return ADBC_STATUS_INVALID_STATE;
+  }
+  auto* state = new AdbcDriverManagerAsyncExecution;
+  state->statement = statement;
+  state->out = out;
+  state->rows_affected = rows_affected;
+  state->callback = callback;
+  state->user_data = user_data;
+  if (error && error->vendor_code == ADBC_ERROR_VENDOR_CODE_PRIVATE_DATA) {
+    // So that the caller can get error details from the result
+    state->error.vendor_code = ADBC_ERROR_VENDOR_CODE_PRIVATE_DATA;
+  }
+  AsyncPool().Submit([state] { state->Run(); });
+  *execution = state;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode AdbcDriverManagerAsyncGetFd(
+    struct AdbcDriverManagerAsyncExecution* execution, int* fd, struct AdbcError* error) {
+  if (!execution || !fd) {
+    SetError(error, "[DriverManager] Must provide non-NULL execution and fd");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+#if defined(_WIN32)
+  SetError(error, "[DriverManager] Completion file descriptors are not supported on "
+                  "Windows");
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+#else
+  std::lock_guard<std::mutex> lock(execution->mutex);
+  if (execution->fds[0] < 0) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+      SetError(error, std::string("[DriverManager] Could not create pipe: ") +
+                          std::strerror(errno));
+      return ADBC_STATUS_IO;
+    }
+    for (const int pipe_fd : fds) fcntl(pipe_fd, F_SETFD, FD_CLOEXEC);
+    execution->fds[0] = fds[0];
+    execution->fds[1] = fds[1];
+    if (execution->done) std::ignore = write(fds[1], "", 1);
+  }
+  *fd = execution->fds[0];
+  return ADBC_STATUS_OK;
+#endif  // defined(_WIN32)
+}
+
+AdbcStatusCode AdbcDriverManagerAsyncWait(
+    struct AdbcDriverManagerAsyncExecution* execution, int64_t timeout_ms,
+    struct AdbcError* error) {
+  if (!execution) {
+    SetError(error, "[DriverManager] Must provide non-NULL execution");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  std::unique_lock<std::mutex> lock(execution->mutex);
+  auto done = [execution] { return execution->done; };
+  if (timeout_ms < 0) {
+    WaitOn(&execution->cv, &lock, done);
+  } else if (!execution->cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                     done)) {
+    return ADBC_STATUS_TIMEOUT;
+  }
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode AdbcDriverManagerAsyncCancel(
+    struct AdbcDriverManagerAsyncExecution* execution, struct AdbcError* error) {
+  if (!execution) {
+    SetError(error, "[DriverManager] Must provide non-NULL execution");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  {
+    std::lock_guard<std::mutex> lock(execution->mutex);
+    if (execution->done) return ADBC_STATUS_OK;
+  }
+  return AdbcStatementCancel(execution->statement, error);
+}
+
+AdbcStatusCode AdbcDriverManagerAsyncFinish(
+    struct AdbcDriverManagerAsyncExecution* execution, struct AdbcError* error) {
+  if (!execution) {
+    SetError(error, "[DriverManager] Must provide non-NULL execution");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+  std::ignore = AdbcDriverManagerAsyncWait(execution, -1, nullptr);
+  const AdbcStatusCode status = execution->status;
+  if (error && execution->error.release) {
+    if (error->release) error->release(error);
+    *error = execution->error;
+  } else if (execution->error.release) {
+    execution->error.release(&execution->error);
+  }
+#if !defined(_WIN32)
+  for (const int fd : execution->fds) {
+    if (fd >= 0) close(fd);
+  }
+#endif  // !defined(_WIN32)
+  delete execution;
+  return status;
+}
+
 AdbcStatusCode AdbcLoadDriver(const char* driver_name, const char* entrypoint,
                               int version, void* raw_driver, struct AdbcError* error) {
-  AdbcDriverInitFunc init_func;
-  std::string error_message;
-
   switch (version) {
     case ADBC_VERSION_1_0_0:
     case ADBC_VERSION_1_1_0:
@@ -1565,42 +5387,32 @@ AdbcStatusCode AdbcLoadDriver(const char* driver_name, const char* entrypoint,
   }
   auto* driver = reinterpret_cast<struct AdbcDriver*>(raw_driver);
 
-  ManagedLibrary library;
-  AdbcStatusCode status = library.Load(driver_name, error);
+  DriverCache& cache = DriverCache::Get();
+  CachedDriver* entry = nullptr;
+  bool initialized = false;
+  AdbcStatusCode status = cache.Acquire(driver_name, entrypoint, version, driver, &entry,
+                                        &initialized, error);
   if (status != ADBC_STATUS_OK) {
     // AdbcDatabaseInit tries to call this if set
     driver->release = nullptr;
     return status;
   }
 
-  void* load_handle = nullptr;
-  if (entrypoint) {
-    status = library.Lookup(entrypoint, &load_handle, error);
-  } else {
-    auto name = AdbcDriverManagerDefaultEntrypoint(driver_name);
-    status = library.Lookup(name.c_str(), &load_handle, error);
+  if (!initialized) {
+    status = AdbcLoadDriverFromInitFunc(entry->init_func, version, driver, error);
     if (status != ADBC_STATUS_OK) {
-      status = library.Lookup(kDefaultEntrypoint, &load_handle, error);
+      cache.Unref(entry);
+      return status;
     }
+    cache.Store(entry, version, driver);
   }
 
-  if (status != ADBC_STATUS_OK) {
-    library.Release();
-    return status;
-  }
-  init_func = reinterpret_cast<AdbcDriverInitFunc>(load_handle);
-
-  status = AdbcLoadDriverFromInitFunc(init_func, version, driver, error);
-  if (status == ADBC_STATUS_OK) {
-    ManagerDriverState* state = new ManagerDriverState;
-    state->driver_release = driver->release;
-    state->handle = std::move(library);
-    driver->release = &ReleaseDriver;
-    driver->private_manager = state;
-  } else {
-    library.Release();
-  }
-  return status;
+  ManagerDriverState* state = new ManagerDriverState;
+  state->driver_release = driver->release;
+  state->entry = entry;
+  driver->release = &ReleaseDriver;
+  driver->private_manager = state;
+  return ADBC_STATUS_OK;
 }
 
 AdbcStatusCode AdbcLoadDriverFromInitFunc(AdbcDriverInitFunc init_func, int version,
@@ -73,6 +73,276 @@ AdbcStatusCode AdbcDriverManagerDatabaseSetInitFunc(struct AdbcDatabase* databas
                                                     AdbcDriverInitFunc init_func,
                                                     struct AdbcError* error);
 
+/// \brief Unload driver libraries that are no longer in use.
+///
+/// AdbcLoadDriver (and hence AdbcDatabaseInit) keeps a process-wide
+/// cache of the driver libraries it loads, keyed by driver name,
+/// entrypoint, and ADBC version.  Loading the same driver again reuses
+/// the library and resolved entrypoint, and for drivers that keep no
+/// state in the AdbcDriver, copies the initialized function table
+/// instead of calling the entrypoint.  Libraries are reference counted
+/// by the AdbcDriver instances loaded from them, but stay loaded after
+/// the last one is released.
+///
+/// This unloads the libraries with no AdbcDriver in use.  Any other
+/// objects from those drivers (errors, streams, schemas, ...) must
+/// have been released beforehand.
+///
+/// \param[out] error An optional location to return an error message
+///   if necessary.
+/// \return ADBC_STATUS_INVALID_STATE if some libraries are still in use
+///   (they stay loaded).
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerUnloadDrivers(struct AdbcError* error);
+
+/// \brief Counters for a result stream returned by the driver manager.
+///
+/// Collected for each ArrowArrayStream returned by a database with the
+/// option "adbc.driver_manager.stream_metrics" set to "true".  Times
+/// are in nanoseconds, measured with a monotonic clock.
+struct AdbcDriverManagerStreamMetrics {
+  /// \brief The number of batches returned by get_next.
+  int64_t num_batches;
+  /// \brief The total length of the batches.
+  int64_t num_rows;
+  /// \brief The total size of the buffers of the batches (only counting
+  ///   the slices that the batches cover, where known).
+  int64_t buffer_bytes;
+  /// \brief The total number of non-null buffers of the batches (and
+  ///   their children and dictionaries), i.e. the number of allocations
+  ///   the consumer received, assuming one per buffer.
+  int64_t num_buffers;
+  /// \brief The time spent in get_next, i.e. waiting on the driver.
+  int64_t get_next_ns;
+  /// \brief The longest single call to get_next.
+  int64_t max_get_next_ns;
+  /// \brief The time between the stream being returned and the first
+  ///   call to get_next, plus the time between each call to get_next
+  ///   returning and the next call, i.e. spent in the consumer.
+  int64_t idle_ns;
+  /// \brief The time from the stream being returned until the first
+  ///   batch was returned (or -1 if none has been).
+  int64_t first_batch_ns;
+};
+
+/// \brief Get the counters for a result stream.
+///
+/// The stream must have been returned by a database with stream metrics
+/// enabled, and not yet released.  This must not be called concurrently
+/// with get_next on the same stream.
+///
+/// \param[in] stream The stream.
+/// \param[out] metrics The counters so far.
+/// \param[out] error An optional location to return an error message
+///   if necessary.
+/// \return ADBC_STATUS_INVALID_STATE if metrics are not collected for
+///   the stream.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerGetStreamMetrics(
+    struct ArrowArrayStream* stream, struct AdbcDriverManagerStreamMetrics* metrics,
+    struct AdbcError* error);
+
+/// \brief A set of options to apply to many databases or connections.
+///
+/// Applications that create many connections with the same options can
+/// build a profile of those options once, and apply it to each
+/// connection with a single call, instead of setting each option on
+/// each connection.  Applying a profile before AdbcConnectionInit only
+/// keeps a reference to it (options set on the connection itself take
+/// precedence); the options are set on the driver's connection in the
+/// order they were first set on the profile.
+///
+/// A profile can't be changed once it has been applied.  Applied
+/// profiles stay alive as long as connections use them, so it may be
+/// released at any time.
+struct AdbcDriverManagerOptionProfile;
+
+/// \brief Create an empty option profile.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerOptionProfileNew(
+    struct AdbcDriverManagerOptionProfile** profile, struct AdbcError* error);
+
+/// \brief Set a string option on a profile.
+/// \return ADBC_STATUS_INVALID_STATE if the profile has been applied.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerOptionProfileSetOption(
+    struct AdbcDriverManagerOptionProfile* profile, const char* key, const char* value,
+    struct AdbcError* error);
+
+/// \brief Set a bytestring option on a profile.
+/// \return ADBC_STATUS_INVALID_STATE if the profile has been applied.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerOptionProfileSetOptionBytes(
+    struct AdbcDriverManagerOptionProfile* profile, const char* key,
+    const uint8_t* value, size_t length, struct AdbcError* error);
+
+/// \brief Set an integer option on a profile.
+/// \return ADBC_STATUS_INVALID_STATE if the profile has been applied.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerOptionProfileSetOptionInt(
+    struct AdbcDriverManagerOptionProfile* profile, const char* key, int64_t value,
+    struct AdbcError* error);
+
+/// \brief Set a double option on a profile.
+/// \return ADBC_STATUS_INVALID_STATE if the profile has been applied.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerOptionProfileSetOptionDouble(
+    struct AdbcDriverManagerOptionProfile* profile, const char* key, double value,
+    struct AdbcError* error);
+
+/// \brief Release the caller's reference to a profile.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerOptionProfileRelease(
+    struct AdbcDriverManagerOptionProfile* profile, struct AdbcError* error);
+
+/// \brief Set the options of a profile on a database.
+///
+/// This is the same as calling AdbcDatabaseSetOption (etc.) for each
+/// option.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerDatabaseSetOptionProfile(
+    struct AdbcDatabase* database, const struct AdbcDriverManagerOptionProfile* profile,
+    struct AdbcError* error);
+
+/// \brief Set the options of a profile on a connection.
+///
+/// Before AdbcConnectionInit, this replaces any profile applied
+/// previously.  Afterwards, this is the same as calling
+/// AdbcConnectionSetOption (etc.) for each option.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerConnectionSetOptionProfile(
+    struct AdbcConnection* connection,
+    const struct AdbcDriverManagerOptionProfile* profile, struct AdbcError* error);
+
+/// \brief Set the size of the result cache.
+///
+/// Databases with the option "adbc.driver_manager.result_cache.ttl_ms"
+/// set to a positive number of milliseconds cache the result sets of
+/// read-only queries of statements that set the option
+/// "adbc.driver_manager.result_cache.enabled" to "true", in a
+/// process-wide cache, keyed by the database, the current catalog and
+/// schema of the connection, the SQL text, and the bound parameters.
+/// Executing the same query again within the TTL returns the cached
+/// batches (without copying them) instead of calling the driver.  A
+/// result set is only cached once it is fully read, and not while the
+/// connection is in a transaction.  When the cache is over its size,
+/// the least recently used result sets are evicted.
+///
+/// \param[in] max_bytes The total size of the buffers of cached result
+///   sets (64 MiB by default), or 0 to clear and disable the cache.
+/// \param[out] error An optional location to return an error message
+///   if necessary.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerSetResultCacheSize(int64_t max_bytes,
+                                                  struct AdbcError* error);
+
+/// \brief The entrypoint of a driver that fans out to several databases.
+///
+/// Pass this to AdbcDriverManagerDatabaseSetInitFunc to create a
+/// database made of shards: databases of any driver, configured with
+/// the options "adbc.driver_manager.multiplex.shard.<n>.<key>" for the
+/// shard with index n (counting from 0), or
+/// "adbc.driver_manager.multiplex.shard.*.<key>" for all shards.  The
+/// shards are initialized, and connections and statements made on each,
+/// concurrently on a pool of threads (by default, one per shard; see
+/// "adbc.driver_manager.multiplex.threads").
+///
+/// Statements execute the same query on every shard concurrently, and
+/// return a single stream of the shards' result sets (which must have
+/// the same types), read ahead concurrently.  Batches are returned in
+/// turn from each shard, unless the statement option
+/// "adbc.driver_manager.multiplex.order_by" names a column: then, if
+/// each shard's result set is sorted by that column (ascending, nulls
+/// first), so is the merged stream.  The statement option
+/// "adbc.driver_manager.multiplex.shard_column" adds a column of that
+/// name with the index of each row's shard.  Other options, bound
+/// parameters, commits, and rollbacks are applied to every shard.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerMultiplexInit(int version, void* driver,
+                                              struct AdbcError* error);
+
+/// \brief An execution started by
+///   AdbcDriverManagerStatementExecuteQueryAsync.
+struct AdbcDriverManagerAsyncExecution;
+
+/// \brief Called when an asynchronous execution finishes.
+///
+/// Called on a thread of the driver manager, before the execution is
+/// reported as done (so it must not wait on or finish the execution).
+typedef void (*AdbcDriverManagerAsyncCallback)(
+    struct AdbcDriverManagerAsyncExecution* execution, AdbcStatusCode status,
+    void* user_data);
+
+/// \brief Execute a statement without blocking.
+///
+/// This calls AdbcStatementExecuteQuery on a pool of threads shared by
+/// all drivers, so that applications (e.g. based on an event loop) need
+/// not dedicate a thread to each execution.  Completion can be awaited
+/// with a callback, a file descriptor, or AdbcDriverManagerAsyncWait.
+/// AdbcDriverManagerAsyncFinish must be called on every execution to
+/// get its result and release it.
+///
+/// Until the execution is done, the statement must only be used through
+/// AdbcDriverManagerAsyncCancel, and out and rows_affected must stay
+/// valid.
+///
+/// \param[in] statement The statement to execute.
+/// \param[out] out, rows_affected As for AdbcStatementExecuteQuery,
+///   filled in when the execution is done.
+/// \param[in] callback An optional function to call when done.
+/// \param[in] user_data Passed to the callback.
+/// \param[out] execution The execution started.
+/// \param[out] error An optional location to return an error message
+///   if necessary (errors of the execution itself are returned by
+///   AdbcDriverManagerAsyncFinish).
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerStatementExecuteQueryAsync(
+    struct AdbcStatement* statement, struct ArrowArrayStream* out, int64_t* rows_affected,
+    AdbcDriverManagerAsyncCallback callback, void* user_data,
+    struct AdbcDriverManagerAsyncExecution** execution, struct AdbcError* error);
+
+/// \brief Get a file descriptor that becomes readable when an execution
+///   is done, to poll along with others.
+///
+/// The descriptor belongs to the execution, and is closed by
+/// AdbcDriverManagerAsyncFinish.
+///
+/// \return ADBC_STATUS_NOT_IMPLEMENTED on Windows.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerAsyncGetFd(
+    struct AdbcDriverManagerAsyncExecution* execution, int* fd, struct AdbcError* error);
+
+/// \brief Wait for an execution to be done.
+///
+/// \param[in] execution The execution.
+/// \param[in] timeout_ms How long to wait at most, in milliseconds: 0
+///   to only check whether the execution is done, or -1 to wait
+///   indefinitely.
+/// \param[out] error An optional location to return an error message
+///   if necessary.
+/// \return ADBC_STATUS_OK if the execution is done, or
+///   ADBC_STATUS_TIMEOUT if not.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerAsyncWait(
+    struct AdbcDriverManagerAsyncExecution* execution, int64_t timeout_ms,
+    struct AdbcError* error);
+
+/// \brief Request to cancel an execution, through AdbcStatementCancel.
+///
+/// The execution must still be finished.  Does nothing if it is done.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerAsyncCancel(
+    struct AdbcDriverManagerAsyncExecution* execution, struct AdbcError* error);
+
+/// \brief Wait for an execution to be done, get its result, and release
+///   it.
+///
+/// \return The status returned by AdbcStatementExecuteQuery, whose
+///   error (if any) is returned in error.
+ADBC_EXPORT
+AdbcStatusCode AdbcDriverManagerAsyncFinish(
+    struct AdbcDriverManagerAsyncExecution* execution, struct AdbcError* error);
+
 /// \brief Get a human-friendly description of a status code.
 ADBC_EXPORT
 const char* AdbcStatusCodeMessage(AdbcStatusCode code);
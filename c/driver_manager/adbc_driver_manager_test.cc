@@ -18,16 +18,27 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#include <poll.h>
+#endif  // !defined(_WIN32)
+
 #include "adbc.h"
 #include "adbc_driver_manager.h"
 #include "validation/adbc_validation.h"
 #include "validation/adbc_validation_util.h"
 
 std::string AdbcDriverManagerDefaultEntrypoint(const std::string& filename);
+bool AdbcDriverManagerIsReadOnlyQuery(const char* query);
+size_t AdbcDriverManagerCachedDriverCount();
 
 // Tests of the SQLite example driver, except using the driver manager
 
@@ -111,6 +122,1085 @@ TEST_F(DriverManager, ConnectionOptions) {
   ASSERT_THAT(AdbcDatabaseRelease(&database, &error), IsOkStatus(&error));
 }
 
+TEST_F(DriverManager, OptionProfile) {
+  struct AdbcDriverManagerOptionProfile* database_profile = nullptr;
+  ASSERT_THAT(AdbcDriverManagerOptionProfileNew(&database_profile, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDriverManagerOptionProfileSetOption(database_profile, "driver",
+                                                      "adbc_driver_sqlite", &error),
+              IsOkStatus(&error));
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDriverManagerDatabaseSetOptionProfile(&database.value,
+                                                        database_profile, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDriverManagerOptionProfileRelease(database_profile, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+
+  struct AdbcDriverManagerOptionProfile* profile = nullptr;
+  ASSERT_THAT(AdbcDriverManagerOptionProfileNew(&profile, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDriverManagerOptionProfileSetOption(
+                  profile, "adbc.sqlite.statement_cache.capacity", "2", &error),
+              IsOkStatus(&error));
+  // The last value set wins
+  ASSERT_THAT(AdbcDriverManagerOptionProfileSetOption(
+                  profile, "adbc.sqlite.statement_cache.capacity", "-1", &error),
+              IsOkStatus(&error));
+
+  std::vector<adbc_validation::Handle<struct AdbcConnection>> connections(2);
+  for (auto& connection : connections) {
+    ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcDriverManagerConnectionSetOptionProfile(&connection.value, profile, &error),
+        IsOkStatus(&error));
+  }
+  // Profiles can't be changed once applied, and are kept alive by their
+  // connections
+  ASSERT_THAT(AdbcDriverManagerOptionProfileSetOption(
+                  profile, "adbc.sqlite.statement_cache.capacity", "4", &error),
+              IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+  error.release(&error);
+  ASSERT_THAT(AdbcDriverManagerOptionProfileRelease(profile, &error),
+              IsOkStatus(&error));
+
+  char buffer[16];
+  size_t length = sizeof(buffer);
+  ASSERT_THAT(AdbcConnectionGetOption(&connections[0].value,
+                                      "adbc.sqlite.statement_cache.capacity", buffer,
+                                      &length, &error),
+              IsOkStatus(&error));
+  ASSERT_STREQ("-1", buffer);
+
+  // The profile's options are set on the driver's connection
+  ASSERT_THAT(AdbcConnectionInit(&connections[0].value, &database.value, &error),
+              IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+  ASSERT_THAT(error.message,
+              ::testing::HasSubstr("adbc.sqlite.statement_cache.capacity=-1"));
+  error.release(&error);
+
+  // Options of the connection take precedence
+  ASSERT_THAT(AdbcConnectionSetOption(&connections[1].value,
+                                      "adbc.sqlite.statement_cache.capacity", "5",
+                                      &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connections[1].value, &database.value, &error),
+              IsOkStatus(&error));
+}
+
+TEST_F(DriverManager, DriverCache) {
+  // Loading the same driver again reuses the library and function table
+  struct AdbcDriver driver2 = {};
+  ASSERT_THAT(AdbcLoadDriver("adbc_driver_sqlite", nullptr, ADBC_VERSION_1_1_0, &driver2,
+                             &error),
+              IsOkStatus(&error));
+  ASSERT_EQ(driver.DatabaseNew, driver2.DatabaseNew);
+  ASSERT_EQ(driver.StatementExecuteQuery, driver2.StatementExecuteQuery);
+  ASSERT_NE(driver.private_manager, driver2.private_manager);
+
+  // Libraries in use are not unloaded
+  ASSERT_THAT(AdbcDriverManagerUnloadDrivers(&error),
+              IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+  error.release(&error);
+  ASSERT_THAT(driver2.release(&driver2, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDriverManagerUnloadDrivers(&error),
+              IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+  error.release(&error);
+  ASSERT_THAT(driver.release(&driver, &error), IsOkStatus(&error));
+  driver.release = nullptr;
+  ASSERT_THAT(AdbcDriverManagerUnloadDrivers(&error), IsOkStatus(&error));
+
+  // The driver is loaded again as needed
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database.value, "driver", "adbc_driver_sqlite", &error),
+      IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseRelease(&database.value, &error), IsOkStatus(&error));
+}
+
+#if !defined(_WIN32)
+TEST_F(DriverManager, DriverCacheResolvedPath) {
+  // Loading the driver by its absolute path reuses the library loaded by name
+  Dl_info info;
+  ASSERT_NE(0, dladdr(reinterpret_cast<void*>(driver.DatabaseNew), &info));
+  const std::string path = info.dli_fname;
+  ASSERT_EQ('/', path[0]) << path;
+  const size_t num_cached = AdbcDriverManagerCachedDriverCount();
+
+  struct AdbcDriver driver2 = {};
+  ASSERT_THAT(
+      AdbcLoadDriver(path.c_str(), nullptr, ADBC_VERSION_1_1_0, &driver2, &error),
+      IsOkStatus(&error));
+  ASSERT_EQ(num_cached, AdbcDriverManagerCachedDriverCount());
+  ASSERT_EQ(driver.DatabaseNew, driver2.DatabaseNew);
+
+  // Both names are dropped with the library once it is unused
+  ASSERT_THAT(driver2.release(&driver2, &error), IsOkStatus(&error));
+  ASSERT_THAT(driver.release(&driver, &error), IsOkStatus(&error));
+  driver.release = nullptr;
+  ASSERT_THAT(AdbcDriverManagerUnloadDrivers(&error), IsOkStatus(&error));
+  ASSERT_EQ(0, AdbcDriverManagerCachedDriverCount());
+  ASSERT_THAT(AdbcLoadDriver(path.c_str(), nullptr, ADBC_VERSION_1_1_0, &driver2, &error),
+              IsOkStatus(&error));
+  ASSERT_EQ(1, AdbcDriverManagerCachedDriverCount());
+  ASSERT_THAT(driver2.release(&driver2, &error), IsOkStatus(&error));
+}
+#endif  // !defined(_WIN32)
+
+TEST_F(DriverManager, Trace) {
+  const std::string path = ::testing::TempDir() + "adbc_driver_manager_trace.json";
+  {
+    adbc_validation::Handle<struct AdbcDatabase> database;
+    adbc_validation::Handle<struct AdbcConnection> connection;
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcDatabaseSetOption(&database.value, "driver", "adbc_driver_sqlite", &error),
+        IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseSetOption(&database.value, "adbc.driver_manager.trace.path",
+                                      path.c_str(), &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionInit(&connection.value, &database.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value,
+                                         "SELECT 1 UNION ALL SELECT 2", &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          nullptr, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(2, reader.array->length);
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(nullptr, reader.array->release);
+  }
+
+  // Events are written out when the database is released
+  std::string trace;
+  {
+    std::FILE* file = std::fopen(path.c_str(), "r");
+    ASSERT_NE(nullptr, file);
+    char buffer[4096];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      trace.append(buffer, read);
+    }
+    std::fclose(file);
+  }
+  std::remove(path.c_str());
+  ASSERT_EQ(0, trace.rfind("[\n", 0));
+  ASSERT_THAT(trace, ::testing::HasSubstr(
+                         R"("name":"AdbcStatementExecuteQuery","cat":"adbc","ph":"X")"));
+  ASSERT_THAT(trace, ::testing::HasSubstr(R"("args":{"status":"OK"})"));
+  ASSERT_THAT(trace, ::testing::HasSubstr(
+                         R"("source":"AdbcStatementExecuteQuery","batch":0,"rows":2,)"
+                         R"("bytes":17,"time_to_first_batch_us":)"));
+  ASSERT_THAT(trace, ::testing::HasSubstr(
+                         R"("args":{"function":"AdbcStatementExecuteQuery","count":1,)"));
+
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database.value, "driver", "adbc_driver_sqlite", &error),
+      IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database.value, "adbc.driver_manager.trace.path",
+                                    "/this/directory/does/not/exist/trace.json", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database.value, &error),
+              IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+}
+
+TEST_F(DriverManager, StreamMetrics) {
+  for (const bool enabled : {true, false}) {
+    SCOPED_TRACE(enabled);
+    adbc_validation::Handle<struct AdbcDatabase> database;
+    adbc_validation::Handle<struct AdbcConnection> connection;
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcDatabaseSetOption(&database.value, "driver", "adbc_driver_sqlite", &error),
+        IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcDatabaseSetOption(&database.value, "adbc.driver_manager.stream_metrics",
+                              enabled ? "true" : "false", &error),
+        IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionInit(&connection.value, &database.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value,
+                                         "SELECT 1 UNION ALL SELECT 2", &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          nullptr, &error),
+                IsOkStatus(&error));
+
+    struct AdbcDriverManagerStreamMetrics metrics = {};
+    if (!enabled) {
+      ASSERT_THAT(
+          AdbcDriverManagerGetStreamMetrics(&reader.stream.value, &metrics, &error),
+          IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+      error.release(&error);
+      continue;
+    }
+
+    ASSERT_THAT(AdbcDriverManagerGetStreamMetrics(&reader.stream.value, &metrics, &error),
+                IsOkStatus(&error));
+    ASSERT_EQ(0, metrics.num_batches);
+    ASSERT_EQ(-1, metrics.first_batch_ns);
+
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(2, reader.array->length);
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(nullptr, reader.array->release);
+
+    ASSERT_THAT(AdbcDriverManagerGetStreamMetrics(&reader.stream.value, &metrics, &error),
+                IsOkStatus(&error));
+    ASSERT_EQ(1, metrics.num_batches);
+    ASSERT_EQ(2, metrics.num_rows);
+    // Validity bitmap and int64 data
+    ASSERT_EQ(17, metrics.buffer_bytes);
+    ASSERT_EQ(2, metrics.num_buffers);
+    ASSERT_GT(metrics.get_next_ns, 0);
+    ASSERT_LE(metrics.max_get_next_ns, metrics.get_next_ns);
+    ASSERT_GE(metrics.idle_ns, 0);
+    ASSERT_GE(metrics.first_batch_ns, 0);
+  }
+
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database.value, "adbc.driver_manager.stream_metrics",
+                                    "maybe", &error),
+              IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+}
+
+TEST_F(DriverManager, Readahead) {
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  adbc_validation::Handle<struct AdbcConnection> connection;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database.value, "driver", "adbc_driver_sqlite", &error),
+      IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection.value, &database.value, &error),
+              IsOkStatus(&error));
+
+  {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value, "adbc.sqlite.query.batch_rows",
+                                       "2", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                       "adbc.driver_manager.readahead.batches", "2",
+                                       &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOptionInt(&statement.value,
+                                          "adbc.driver_manager.readahead.bytes", 64,
+                                          &error),
+                IsOkStatus(&error));
+    int64_t batches = 0;
+    ASSERT_THAT(AdbcStatementGetOptionInt(&statement.value,
+                                          "adbc.driver_manager.readahead.batches",
+                                          &batches, &error),
+                IsOkStatus(&error));
+    ASSERT_EQ(2, batches);
+    char buffer[16];
+    size_t length = sizeof(buffer);
+    ASSERT_THAT(AdbcStatementGetOption(&statement.value,
+                                       "adbc.driver_manager.readahead.bytes", buffer,
+                                       &length, &error),
+                IsOkStatus(&error));
+    ASSERT_EQ("64", std::string(buffer, length - 1));
+
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                       "adbc.driver_manager.readahead.batches", "-1",
+                                       &error),
+                IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+    error.release(&error);
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                       "adbc.driver_manager.readahead.batches", "two",
+                                       &error),
+                IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+    error.release(&error);
+
+    ASSERT_THAT(
+        AdbcStatementSetSqlQuery(&statement.value,
+                                 "WITH RECURSIVE t(x) AS (SELECT 1 UNION ALL SELECT x + 1"
+                                 " FROM t WHERE x < 9) SELECT x FROM t",
+                                 &error),
+        IsOkStatus(&error));
+    for (const bool consume : {true, false}) {
+      SCOPED_TRACE(consume);
+      adbc_validation::StreamReader reader;
+      ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                            nullptr, &error),
+                  IsOkStatus(&error));
+      ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      ASSERT_EQ(2, reader.array->length);
+      // Release the stream while the driver is still being read
+      if (!consume) continue;
+
+      std::vector<int64_t> values;
+      while (reader.array->release) {
+        for (int64_t i = 0; i < reader.array->length; i++) {
+          values.push_back(ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], i));
+        }
+        ASSERT_NO_FATAL_FAILURE(reader.Next());
+      }
+      ASSERT_EQ(std::vector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8, 9}), values);
+    }
+  }
+
+  // Errors are returned once the batches before them are consumed
+  {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value, "adbc.sqlite.query.batch_rows",
+                                       "1", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOptionInt(&statement.value,
+                                          "adbc.driver_manager.readahead.batches", 4,
+                                          &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value,
+                                         "SELECT 1 UNION ALL SELECT 'foo'", &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          nullptr, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(1, reader.array->length);
+
+    struct ArrowArray array = {};
+    ASSERT_NE(0, reader.stream->get_next(&reader.stream.value, &array));
+    ASSERT_THAT(reader.stream->get_last_error(&reader.stream.value),
+                ::testing::HasSubstr("Type mismatch"));
+    // The error stays put
+    ASSERT_NE(0, reader.stream->get_next(&reader.stream.value, &array));
+  }
+}
+
+TEST_F(DriverManager, Rebatch) {
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  adbc_validation::Handle<struct AdbcConnection> connection;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database.value, "driver", "adbc_driver_sqlite", &error),
+      IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection.value, &database.value, &error),
+              IsOkStatus(&error));
+
+  struct Case {
+    const char* batch_rows;
+    int64_t rows;
+    int64_t bytes;
+    int64_t readahead;
+    std::vector<int64_t> lengths;
+  };
+  for (const auto& test_case : std::vector<Case>{
+           // Coalesce small batches
+           {"2", 4, 0, 0, {4, 4, 1}},
+           // Slice large batches (and coalesce the remainders)
+           {"5", 2, 0, 0, {2, 2, 2, 2, 1}},
+           // Batches of the right size are passed through
+           {"3", 3, 0, 0, {3, 3, 3}},
+           // Target a size in bytes (about 14 bytes per row)
+           {"9", 0, 30, 0, {2, 2, 2, 2, 1}},
+           // Works with readahead
+           {"1", 5, 0, 2, {5, 4}},
+       }) {
+    SCOPED_TRACE(std::string("batch_rows=") + test_case.batch_rows +
+                 " rows=" + std::to_string(test_case.rows) +
+                 " bytes=" + std::to_string(test_case.bytes));
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value, "adbc.sqlite.query.batch_rows",
+                                       test_case.batch_rows, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOptionInt(&statement.value,
+                                          "adbc.driver_manager.rebatch.rows",
+                                          test_case.rows, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOptionInt(&statement.value,
+                                          "adbc.driver_manager.rebatch.bytes",
+                                          test_case.bytes, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOptionInt(&statement.value,
+                                          "adbc.driver_manager.readahead.batches",
+                                          test_case.readahead, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcStatementSetSqlQuery(
+            &statement.value,
+            "WITH RECURSIVE t(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM t WHERE "
+            "x < 9) SELECT CASE WHEN x % 3 = 0 THEN NULL ELSE x END, 'v' || x FROM t",
+            &error),
+        IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          nullptr, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+
+    std::vector<int64_t> lengths;
+    std::vector<int64_t> values;
+    std::vector<std::string> strings;
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    while (reader.array->release) {
+      lengths.push_back(reader.array->length);
+      for (int64_t i = 0; i < reader.array->length; i++) {
+        struct ArrowArrayView* column = reader.array_view->children[0];
+        values.push_back(ArrowArrayViewIsNull(column, i)
+                             ? -1
+                             : ArrowArrayViewGetIntUnsafe(column, i));
+        const struct ArrowStringView view =
+            ArrowArrayViewGetStringUnsafe(reader.array_view->children[1], i);
+        strings.emplace_back(view.data, view.size_bytes);
+      }
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+    }
+    ASSERT_EQ(test_case.lengths, lengths);
+    ASSERT_EQ(std::vector<int64_t>({1, 2, -1, 4, 5, -1, 7, 8, -1}), values);
+    ASSERT_EQ(std::vector<std::string>(
+                  {"v1", "v2", "v3", "v4", "v5", "v6", "v7", "v8", "v9"}),
+              strings);
+  }
+}
+
+TEST_F(DriverManager, ResultCache) {
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  adbc_validation::Handle<struct AdbcConnection> connection;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database.value, "driver", "adbc_driver_sqlite", &error),
+      IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database.value, "uri",
+                                    "file:result_cache?mode=memory&cache=shared", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database.value,
+                                    "adbc.driver_manager.result_cache.ttl_ms", "600000",
+                                    &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection.value, &database.value, &error),
+              IsOkStatus(&error));
+
+  // Execute a query (binding parameter, if any) and read the first column
+  bool cache = true;
+  auto query = [&](const char* sql, std::vector<int64_t> parameters,
+                   std::vector<int64_t>* values, int64_t* rows_affected) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, sql, &error),
+                IsOkStatus(&error));
+    if (cache) {
+      ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                         "adbc.driver_manager.result_cache.enabled",
+                                         ADBC_OPTION_VALUE_ENABLED, &error),
+                  IsOkStatus(&error));
+    }
+    if (!parameters.empty()) {
+      adbc_validation::Handle<struct ArrowSchema> schema;
+      adbc_validation::Handle<struct ArrowArray> array;
+      struct ArrowError na_error;
+      ASSERT_THAT(
+          adbc_validation::MakeSchema(&schema.value, {{"", NANOARROW_TYPE_INT64}}),
+          adbc_validation::IsOkErrno());
+      std::vector<std::optional<int64_t>> column(parameters.begin(), parameters.end());
+      ASSERT_THAT(adbc_validation::MakeBatch<int64_t>(&schema.value, &array.value,
+                                                      &na_error, column),
+                  adbc_validation::IsOkErrno());
+      ASSERT_THAT(
+          AdbcStatementBind(&statement.value, &array.value, &schema.value, &error),
+          IsOkStatus(&error));
+    }
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          rows_affected, &error),
+                IsOkStatus(&error));
+    if (!values) return;
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    while (reader.array->release) {
+      for (int64_t i = 0; i < reader.array->length; i++) {
+        values->push_back(ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], i));
+      }
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+    }
+  };
+  auto select = [&](const char* sql, std::vector<int64_t> parameters = {}) {
+    std::vector<int64_t> values;
+    query(sql, parameters, &values, nullptr);
+    return values;
+  };
+
+  ASSERT_NO_FATAL_FAILURE(query("CREATE TABLE t (x INTEGER)", {}, nullptr, nullptr));
+  ASSERT_NO_FATAL_FAILURE(query("INSERT INTO t VALUES (1), (2)", {}, nullptr, nullptr));
+  ASSERT_EQ(std::vector<int64_t>({1, 2}), select("SELECT x FROM t ORDER BY x"));
+
+  // Cache hits don't see writes in the meantime
+  ASSERT_NO_FATAL_FAILURE(query("INSERT INTO t VALUES (3)", {}, nullptr, nullptr));
+  int64_t rows_affected = 0;
+  std::vector<int64_t> values;
+  ASSERT_NO_FATAL_FAILURE(
+      query("SELECT x FROM t ORDER BY x", {}, &values, &rows_affected));
+  ASSERT_EQ(std::vector<int64_t>({1, 2}), values);
+  ASSERT_EQ(-1, rows_affected);
+  // Only statements that opt in use the cache
+  cache = false;
+  ASSERT_EQ(std::vector<int64_t>({1, 2, 3}), select("SELECT x FROM t ORDER BY x"));
+  cache = true;
+  // Nor inside transactions, whose writes the cache wouldn't see
+  ASSERT_THAT(
+      AdbcConnectionSetOption(&connection.value, ADBC_CONNECTION_OPTION_AUTOCOMMIT,
+                              ADBC_OPTION_VALUE_DISABLED, &error),
+      IsOkStatus(&error));
+  ASSERT_EQ(std::vector<int64_t>({1, 2, 3}), select("SELECT x FROM t ORDER BY x"));
+  ASSERT_THAT(AdbcConnectionRollback(&connection.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcConnectionSetOption(&connection.value, ADBC_CONNECTION_OPTION_AUTOCOMMIT,
+                              ADBC_OPTION_VALUE_ENABLED, &error),
+      IsOkStatus(&error));
+  ASSERT_EQ(std::vector<int64_t>({1, 2}), select("SELECT x FROM t ORDER BY x"));
+  // The key is the exact SQL text
+  ASSERT_EQ(std::vector<int64_t>({1, 2, 3}), select(" SELECT x FROM t ORDER BY x"));
+
+  // Bound parameters are part of the key
+  const char* parameterized = "SELECT x FROM t WHERE x >= ? ORDER BY x";
+  ASSERT_EQ(std::vector<int64_t>({2, 3}), select(parameterized, {2}));
+  ASSERT_NO_FATAL_FAILURE(query("INSERT INTO t VALUES (4)", {}, nullptr, nullptr));
+  ASSERT_EQ(std::vector<int64_t>({2, 3}), select(parameterized, {2}));
+  ASSERT_EQ(std::vector<int64_t>({3, 4}), select(parameterized, {3}));
+
+  // Partially read result sets aren't cached
+  ASSERT_NO_FATAL_FAILURE(query("SELECT x FROM t", {}, nullptr, nullptr));
+  ASSERT_EQ(std::vector<int64_t>({1, 2, 3, 4}), select("SELECT x FROM t"));
+
+  // Queries that start with WITH but write are run every time
+  ASSERT_NO_FATAL_FAILURE(query("CREATE TABLE u (x INTEGER)", {}, nullptr, nullptr));
+  for (int i = 0; i < 2; i++) {
+    ASSERT_NO_FATAL_FAILURE(
+        query("WITH v(x) AS (VALUES (10)) INSERT INTO u SELECT x FROM v", {}, nullptr,
+              nullptr));
+  }
+  ASSERT_EQ(std::vector<int64_t>({2}), select("SELECT COUNT(*) FROM u"));
+
+  // A size of 0 clears the cache
+  ASSERT_THAT(AdbcDriverManagerSetResultCacheSize(0, &error), IsOkStatus(&error));
+  ASSERT_EQ(std::vector<int64_t>({1, 2, 3, 4}), select("SELECT x FROM t ORDER BY x"));
+  ASSERT_THAT(AdbcDriverManagerSetResultCacheSize(64 * 1024 * 1024, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDriverManagerSetResultCacheSize(-1, &error),
+              IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+
+  {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                       "adbc.driver_manager.result_cache.enabled",
+                                       "maybe", &error),
+                IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+  }
+
+  adbc_validation::Handle<struct AdbcDatabase> invalid;
+  ASSERT_THAT(AdbcDatabaseNew(&invalid.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&invalid.value,
+                                    "adbc.driver_manager.result_cache.ttl_ms", "soon",
+                                    &error),
+              IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+  ASSERT_THAT(AdbcDatabaseSetOptionInt(&invalid.value,
+                                       "adbc.driver_manager.result_cache.ttl_ms", -1,
+                                       &error),
+              IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+}
+
+TEST_F(DriverManager, ResultCacheDatabases) {
+  struct Opened {
+    adbc_validation::Handle<struct AdbcDatabase> database;
+    adbc_validation::Handle<struct AdbcConnection> connection;
+  };
+  auto open = [&](Opened* opened, const char* ttl_ms) {
+    ASSERT_THAT(AdbcDatabaseNew(&opened->database.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseSetOption(&opened->database.value, "driver",
+                                      "adbc_driver_sqlite", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcDatabaseSetOption(&opened->database.value, "uri", ":memory:", &error),
+        IsOkStatus(&error));
+    if (ttl_ms) {
+      ASSERT_THAT(AdbcDatabaseSetOption(&opened->database.value,
+                                        "adbc.driver_manager.result_cache.ttl_ms", ttl_ms,
+                                        &error),
+                  IsOkStatus(&error));
+    }
+    ASSERT_THAT(AdbcDatabaseInit(&opened->database.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionNew(&opened->connection.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionInit(&opened->connection.value, &opened->database.value,
+                                   &error),
+                IsOkStatus(&error));
+  };
+  auto select = [&](Opened* opened, const char* sql, int64_t* value) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&opened->connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, sql, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                       "adbc.driver_manager.result_cache.enabled",
+                                       ADBC_OPTION_VALUE_ENABLED, &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          nullptr, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(1, reader.array->length);
+    *value = ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], 0);
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+  };
+
+  auto execute = [&](Opened* opened, const char* sql) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&opened->connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, sql, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+                IsOkStatus(&error));
+  };
+
+  // Two in-memory databases with the same options don't share results
+  Opened first, second;
+  ASSERT_NO_FATAL_FAILURE(open(&first, "600000"));
+  ASSERT_NO_FATAL_FAILURE(open(&second, "600000"));
+  ASSERT_NO_FATAL_FAILURE(execute(&first, "CREATE TABLE t AS SELECT 1 AS x"));
+  ASSERT_NO_FATAL_FAILURE(execute(&second, "CREATE TABLE t AS SELECT 2 AS x"));
+  int64_t value = 0;
+  ASSERT_NO_FATAL_FAILURE(select(&first, "SELECT x FROM t", &value));
+  ASSERT_EQ(1, value);
+  ASSERT_NO_FATAL_FAILURE(select(&second, "SELECT x FROM t", &value));
+  ASSERT_EQ(2, value);
+  ASSERT_NO_FATAL_FAILURE(execute(&first, "UPDATE t SET x = 3"));
+  ASSERT_NO_FATAL_FAILURE(select(&first, "SELECT x FROM t", &value));
+  ASSERT_EQ(1, value);
+
+  // Statements can only opt in if the database caches results
+  Opened uncached;
+  ASSERT_NO_FATAL_FAILURE(open(&uncached, nullptr));
+  adbc_validation::Handle<struct AdbcStatement> statement;
+  ASSERT_THAT(AdbcStatementNew(&uncached.connection.value, &statement.value, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                     "adbc.driver_manager.result_cache.enabled",
+                                     ADBC_OPTION_VALUE_ENABLED, &error),
+              IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+}
+
+TEST_F(DriverManager, MemoryAccounting) {
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  adbc_validation::Handle<struct AdbcConnection> connection;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database.value, "driver", "adbc_driver_sqlite", &error),
+      IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database.value,
+                                    "adbc.driver_manager.memory.accounting", "true",
+                                    &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection.value, &database.value, &error),
+              IsOkStatus(&error));
+
+  adbc_validation::Handle<struct AdbcStatement> statement;
+  auto new_statement = [&]() {
+    if (statement->private_driver) {
+      ASSERT_THAT(AdbcStatementRelease(&statement.value, &error), IsOkStatus(&error));
+    }
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value, "adbc.sqlite.query.batch_rows",
+                                       "3", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcStatementSetSqlQuery(
+            &statement.value,
+            "WITH RECURSIVE t(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM t WHERE "
+            "x < 9) SELECT x, 'v' || x FROM t",
+            &error),
+        IsOkStatus(&error));
+  };
+  ASSERT_NO_FATAL_FAILURE(new_statement());
+
+  // The counters of the statement, its connection, and its database
+  auto counters = [&](const char* key) {
+    std::vector<int64_t> values(3, -1);
+    EXPECT_THAT(AdbcStatementGetOptionInt(&statement.value, key, &values[0], &error),
+                IsOkStatus(&error));
+    EXPECT_THAT(AdbcConnectionGetOptionInt(&connection.value, key, &values[1], &error),
+                IsOkStatus(&error));
+    EXPECT_THAT(AdbcDatabaseGetOptionInt(&database.value, key, &values[2], &error),
+                IsOkStatus(&error));
+    return values;
+  };
+  const char* current = "adbc.driver_manager.memory.current_bytes";
+  const char* peak = "adbc.driver_manager.memory.peak_bytes";
+  ASSERT_EQ(std::vector<int64_t>({0, 0, 0}), counters(current));
+
+  // Batches count until they're released
+  int64_t batch_bytes = 0;
+  int64_t second_bytes = 0;
+  {
+    adbc_validation::Handle<struct ArrowArrayStream> stream;
+    ASSERT_THAT(
+        AdbcStatementExecuteQuery(&statement.value, &stream.value, nullptr, &error),
+        IsOkStatus(&error));
+    adbc_validation::Handle<struct ArrowArray> first;
+    adbc_validation::Handle<struct ArrowArray> second;
+    ASSERT_EQ(0, stream->get_next(&stream.value, &first.value));
+    ASSERT_NE(nullptr, first->release);
+    batch_bytes = counters(current)[0];
+    ASSERT_GT(batch_bytes, 0);
+    ASSERT_EQ(std::vector<int64_t>(3, batch_bytes), counters(current));
+    ASSERT_EQ(0, stream->get_next(&stream.value, &second.value));
+    second_bytes = counters(current)[0] - batch_bytes;
+    ASSERT_GT(second_bytes, 0);
+    ASSERT_EQ(std::vector<int64_t>(3, batch_bytes + second_bytes), counters(current));
+    first->release(&first.value);
+    ASSERT_EQ(std::vector<int64_t>(3, second_bytes), counters(current));
+  }
+  ASSERT_EQ(std::vector<int64_t>({0, 0, 0}), counters(current));
+  ASSERT_EQ(std::vector<int64_t>(3, batch_bytes + second_bytes), counters(peak));
+
+  // A limit fails the stream, and keeps failing it
+  ASSERT_NO_FATAL_FAILURE(new_statement());
+  ASSERT_THAT(AdbcStatementSetOptionInt(&statement.value,
+                                        "adbc.driver_manager.memory.limit_bytes",
+                                        batch_bytes + 1, &error),
+              IsOkStatus(&error));
+  {
+    adbc_validation::Handle<struct ArrowArrayStream> stream;
+    ASSERT_THAT(
+        AdbcStatementExecuteQuery(&statement.value, &stream.value, nullptr, &error),
+        IsOkStatus(&error));
+    adbc_validation::Handle<struct ArrowArray> first;
+    adbc_validation::Handle<struct ArrowArray> second;
+    ASSERT_EQ(0, stream->get_next(&stream.value, &first.value));
+    ASSERT_EQ(ENOMEM, stream->get_next(&stream.value, &second.value));
+    ASSERT_EQ(nullptr, second->release);
+    ASSERT_THAT(stream->get_last_error(&stream.value),
+                ::testing::HasSubstr("memory limit of the statement"));
+    first->release(&first.value);
+    ASSERT_EQ(ENOMEM, stream->get_next(&stream.value, &second.value));
+  }
+  ASSERT_EQ(std::vector<int64_t>({0, 0, 0}), counters(current));
+
+  // Limits need accounting to be enabled, and can't be negative
+  adbc_validation::Handle<struct AdbcDatabase> plain;
+  adbc_validation::Handle<struct AdbcConnection> plain_connection;
+  adbc_validation::Handle<struct AdbcStatement> plain_statement;
+  ASSERT_THAT(AdbcDatabaseNew(&plain.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&plain.value, "driver", "adbc_driver_sqlite", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&plain.value,
+                                    "adbc.driver_manager.memory.limit_bytes", "lots",
+                                    &error),
+              IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+  error.release(&error);
+  ASSERT_THAT(AdbcDatabaseInit(&plain.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionNew(&plain_connection.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&plain_connection.value, &plain.value, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementNew(&plain_connection.value, &plain_statement.value, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetOption(&plain_statement.value,
+                                     "adbc.driver_manager.memory.limit_bytes", "1024",
+                                     &error),
+              IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+  error.release(&error);
+}
+
+TEST_F(DriverManager, Multiplex) {
+  constexpr int kShards = 3;
+  auto shard_uri = [](int shard) {
+    return "file:multiplex" + std::to_string(shard) + "?mode=memory&cache=shared";
+  };
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  adbc_validation::Handle<struct AdbcConnection> connection;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDriverManagerDatabaseSetInitFunc(
+                  &database.value, AdbcDriverManagerMultiplexInit, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database.value,
+                                    "adbc.driver_manager.multiplex.shard.*.driver",
+                                    "adbc_driver_sqlite", &error),
+              IsOkStatus(&error));
+  for (int i = 0; i < kShards; i++) {
+    const std::string key =
+        "adbc.driver_manager.multiplex.shard." + std::to_string(i) + ".uri";
+    ASSERT_THAT(AdbcDatabaseSetOption(&database.value, key.c_str(),
+                                      shard_uri(i).c_str(), &error),
+                IsOkStatus(&error));
+  }
+  ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection.value, &database.value, &error),
+              IsOkStatus(&error));
+
+  // Execute a query on all shards, and read the first column (and the
+  // shard column, if any)
+  auto query = [&](struct AdbcConnection* on, const char* sql,
+                   const std::vector<std::pair<std::string, std::string>>& options,
+                   std::vector<int64_t>* values, std::vector<int64_t>* shards) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(on, &statement.value, &error), IsOkStatus(&error));
+    for (const auto& option : options) {
+      ASSERT_THAT(AdbcStatementSetOption(&statement.value, option.first.c_str(),
+                                         option.second.c_str(), &error),
+                  IsOkStatus(&error));
+    }
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, sql, &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          nullptr, &error),
+                IsOkStatus(&error));
+    if (!values) return;
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_EQ(shards ? 3 : 2, reader.schema->n_children);
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    while (reader.array->release) {
+      for (int64_t i = 0; i < reader.array->length; i++) {
+        struct ArrowArrayView* column = reader.array_view->children[0];
+        values->push_back(ArrowArrayViewIsNull(column, i)
+                              ? -1
+                              : ArrowArrayViewGetIntUnsafe(column, i));
+        if (shards) {
+          shards->push_back(
+              ArrowArrayViewGetIntUnsafe(reader.array_view->children[2], i));
+        }
+      }
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+    }
+  };
+
+  // Create the table on every shard, then insert each shard's rows (with
+  // x % 3 == shard, and a null on shard 0) through its own database
+  ASSERT_NO_FATAL_FAILURE(query(&connection.value, "CREATE TABLE t (x INTEGER, y TEXT)",
+                                {}, nullptr, nullptr));
+  for (int i = 0; i < kShards; i++) {
+    adbc_validation::Handle<struct AdbcDatabase> shard_database;
+    adbc_validation::Handle<struct AdbcConnection> shard_connection;
+    ASSERT_THAT(AdbcDatabaseNew(&shard_database.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseSetOption(&shard_database.value, "driver",
+                                      "adbc_driver_sqlite", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseSetOption(&shard_database.value, "uri",
+                                      shard_uri(i).c_str(), &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseInit(&shard_database.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionNew(&shard_connection.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcConnectionInit(&shard_connection.value, &shard_database.value, &error),
+        IsOkStatus(&error));
+    const std::string insert =
+        "INSERT INTO t WITH RECURSIVE s(x) AS (SELECT " + std::to_string(i) +
+        " UNION ALL SELECT x + 3 FROM s WHERE x < 12) SELECT x, 'v' || x FROM s" +
+        (i == 0 ? " UNION ALL SELECT NULL, 'null'" : "");
+    ASSERT_NO_FATAL_FAILURE(
+        query(&shard_connection.value, insert.c_str(), {}, nullptr, nullptr));
+  }
+  std::vector<int64_t> sorted = {-1};
+  for (int64_t x = 0; x < 15; x++) sorted.push_back(x);
+
+  // Without ordering, each shard's batches are returned in turn
+  const std::vector<std::pair<std::string, std::string>> small_batches = {
+      {"adbc.sqlite.query.batch_rows", "2"}};
+  std::vector<int64_t> values;
+  std::vector<int64_t> shards;
+  auto options = small_batches;
+  options.emplace_back("adbc.driver_manager.multiplex.shard_column", "shard");
+  ASSERT_NO_FATAL_FAILURE(
+      query(&connection.value, "SELECT x, y FROM t", options, &values, &shards));
+  ASSERT_EQ(sorted.size(), values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    ASSERT_EQ(values[i] < 0 ? 0 : values[i] % 3, shards[i]) << values[i];
+  }
+  std::sort(values.begin(), values.end());
+  ASSERT_EQ(sorted, values);
+
+  // With ordering, the shards' sorted result sets are merged
+  options.emplace_back("adbc.driver_manager.multiplex.order_by", "x");
+  values.clear();
+  shards.clear();
+  ASSERT_NO_FATAL_FAILURE(query(&connection.value, "SELECT x, y FROM t ORDER BY x",
+                                options, &values, &shards));
+  ASSERT_EQ(sorted, values);
+  for (size_t i = 0; i < values.size(); i++) {
+    ASSERT_EQ(values[i] < 0 ? 0 : values[i] % 3, shards[i]) << values[i];
+  }
+  values.clear();
+  options = small_batches;
+  options.emplace_back("adbc.driver_manager.multiplex.order_by", "x");
+  ASSERT_NO_FATAL_FAILURE(query(&connection.value, "SELECT x, y FROM t ORDER BY x",
+                                options, &values, nullptr));
+  ASSERT_EQ(sorted, values);
+
+  // Options of the multiplex driver are checked by AdbcDatabaseInit
+  for (const char* key : {"adbc.driver_manager.multiplex.shard.x.uri",
+                          "adbc.driver_manager.multiplex.shard.0"}) {
+    adbc_validation::Handle<struct AdbcDatabase> invalid;
+    ASSERT_THAT(AdbcDatabaseNew(&invalid.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcDriverManagerDatabaseSetInitFunc(
+                    &invalid.value, AdbcDriverManagerMultiplexInit, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseSetOption(&invalid.value, key, "", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseInit(&invalid.value, &error),
+                IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+    error.release(&error);
+  }
+
+  // Ordering needs a column of a supported type
+  adbc_validation::Handle<struct AdbcStatement> statement;
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetOption(&statement.value,
+                                     "adbc.driver_manager.multiplex.order_by", "z",
+                                     &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, "SELECT x, y FROM t", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value, nullptr,
+                                        &error),
+              IsOkStatus(&error));
+  struct ArrowSchema schema = {};
+  ASSERT_EQ(EINVAL, reader.stream->get_schema(&reader.stream.value, &schema));
+  ASSERT_THAT(reader.stream->get_last_error(&reader.stream.value),
+              ::testing::HasSubstr("No column named z"));
+}
+
+TEST_F(DriverManager, AsyncExecution) {
+  adbc_validation::Handle<struct AdbcDatabase> database;
+  ASSERT_THAT(AdbcDatabaseNew(&database.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcDatabaseSetOption(&database.value, "driver", "adbc_driver_sqlite", &error),
+      IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database.value, &error), IsOkStatus(&error));
+
+  // Run several executions at once, each on its own connection
+  constexpr int kExecutions = 4;
+  struct Execution {
+    adbc_validation::Handle<struct AdbcConnection> connection;
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    adbc_validation::StreamReader reader;
+    int64_t rows_affected = 0;
+    struct AdbcDriverManagerAsyncExecution* execution = nullptr;
+    std::atomic<int> callbacks{0};
+    AdbcStatusCode callback_status = ADBC_STATUS_UNKNOWN;
+  };
+  std::vector<std::unique_ptr<Execution>> executions;
+  for (int i = 0; i < kExecutions; i++) {
+    executions.emplace_back(new Execution);
+    Execution* execution = executions.back().get();
+    ASSERT_THAT(AdbcConnectionNew(&execution->connection.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcConnectionInit(&execution->connection.value, &database.value, &error),
+        IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementNew(&execution->connection.value,
+                                 &execution->statement.value, &error),
+                IsOkStatus(&error));
+    // The last one fails
+    const std::string query = i == kExecutions - 1
+                                  ? "SELECT * FROM nonexistent"
+                                  : "SELECT " + std::to_string(i) + " AS x";
+    ASSERT_THAT(
+        AdbcStatementSetSqlQuery(&execution->statement.value, query.c_str(), &error),
+        IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcDriverManagerStatementExecuteQueryAsync(
+            &execution->statement.value, &execution->reader.stream.value,
+            &execution->rows_affected,
+            [](struct AdbcDriverManagerAsyncExecution*, AdbcStatusCode status,
+               void* user_data) {
+              auto* execution = reinterpret_cast<Execution*>(user_data);
+              execution->callback_status = status;
+              execution->callbacks++;
+            },
+            execution, &execution->execution, &error),
+        IsOkStatus(&error));
+  }
+
+  for (int i = 0; i < kExecutions; i++) {
+    Execution* execution = executions[i].get();
+#if !defined(_WIN32)
+    // Wait on the file descriptor, as an event loop would
+    struct pollfd fd = {};
+    fd.events = POLLIN;
+    ASSERT_THAT(AdbcDriverManagerAsyncGetFd(execution->execution, &fd.fd, &error),
+                IsOkStatus(&error));
+    ASSERT_EQ(1, poll(&fd, 1, /*timeout=*/60000));
+#endif  // !defined(_WIN32)
+    ASSERT_THAT(AdbcDriverManagerAsyncWait(execution->execution, -1, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcDriverManagerAsyncWait(execution->execution, 0, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcDriverManagerAsyncCancel(execution->execution, &error),
+                IsOkStatus(&error));
+    ASSERT_EQ(1, execution->callbacks.load());
+    const AdbcStatusCode status =
+        AdbcDriverManagerAsyncFinish(execution->execution, &error);
+    ASSERT_EQ(execution->callback_status, status);
+    if (i == kExecutions - 1) {
+      ASSERT_NE(ADBC_STATUS_OK, status);
+      ASSERT_THAT(error.message, ::testing::HasSubstr("nonexistent"));
+      error.release(&error);
+      continue;
+    }
+    ASSERT_THAT(status, IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(execution->reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(execution->reader.Next());
+    ASSERT_EQ(1, execution->reader.array->length);
+    ASSERT_EQ(i,
+              ArrowArrayViewGetIntUnsafe(execution->reader.array_view->children[0], 0));
+  }
+
+  struct AdbcDriverManagerAsyncExecution* execution = nullptr;
+  ASSERT_THAT(AdbcDriverManagerStatementExecuteQueryAsync(nullptr, nullptr, nullptr,
+                                                          nullptr, nullptr, &execution,
+                                                          &error),
+              IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+  error.release(&error);
+}
+
 TEST_F(DriverManager, MultiDriverTest) {
   // Make sure two distinct drivers work in the same process (basic smoke test)
   adbc_validation::Handle<struct AdbcError> error;
@@ -175,6 +1265,8 @@ class SqliteQuirks : public adbc_validation::DriverQuirks {
 
   std::string BindParameter(int index) const override { return "?"; }
 
+  bool supports_partitioned_data() const override { return true; }
+
   ArrowType IngestSelectRoundTripType(ArrowType ingest_type) const override {
     switch (ingest_type) {
       case NANOARROW_TYPE_BOOL:
@@ -321,4 +1413,49 @@ TEST(AdbcDriverManagerInternal, AdbcDriverManagerDefaultEntrypoint) {
     EXPECT_EQ("AdbcProprietaryEngineInit", ::AdbcDriverManagerDefaultEntrypoint(driver));
   }
 }
+
+TEST(AdbcDriverManagerInternal, AdbcDriverManagerIsReadOnlyQuery) {
+  for (const auto& query : {
+           "SELECT 1",
+           "  (select * FROM t) ",
+           "WITH v AS (SELECT 1) SELECT * FROM v;",
+           "VALUES (1), (2)",
+           "SELECT updated_at, \"insert\", 'DELETE' FROM t -- FOR UPDATE",
+           "SELECT /* INTO */ x FROM t WHERE s = 'it''s'",
+           "SELECT $$ UPDATE $$, $tag$ nextval('s') $tag$",
+           "SELECT x FROM t FOR READ ONLY",
+       }) {
+    SCOPED_TRACE(query);
+    EXPECT_TRUE(::AdbcDriverManagerIsReadOnlyQuery(query));
+  }
+
+  for (const auto& query : {
+           "",
+           "INSERT INTO t VALUES (1)",
+           "EXPLAIN SELECT 1",
+           // Data-modifying CTEs
+           "WITH d AS (DELETE FROM t RETURNING *) SELECT * FROM d",
+           "WITH u AS (UPDATE t SET x = 1 RETURNING x) SELECT x FROM u",
+           "WITH v AS (SELECT 1) INSERT INTO t SELECT * FROM v",
+           // SELECT INTO
+           "SELECT * INTO backup FROM t",
+           // Row locks
+           "SELECT * FROM t FOR UPDATE",
+           "SELECT * FROM t FOR NO KEY UPDATE",
+           "SELECT * FROM t FOR SHARE",
+           "SELECT * FROM t FOR KEY SHARE",
+           "SELECT * FROM t LOCK IN SHARE MODE",
+           // Sequences
+           "SELECT nextval('s')",
+           "SELECT NEXT VALUE FOR s",
+           "SELECT setval('s', 1)",
+           // Several statements, or unterminated quotes and comments
+           "SELECT 1; DELETE FROM t",
+           "SELECT 'a",
+           "SELECT 1 /* comment",
+       }) {
+    SCOPED_TRACE(query);
+    EXPECT_FALSE(::AdbcDriverManagerIsReadOnlyQuery(query));
+  }
+}
 }  // namespace adbc